@@ -77,17 +77,15 @@ namespace ns3 {
     };
 
     void shuffle_array_ip(std::vector< std::vector<Ipv6Address> >& arrayf, Ptr<UniformRandomVariable> shuffles, int64_t stream, int size) {
-        //Shuffles std::vector array a random number of times.
-        std::vector< std::vector<Ipv6Address> > array_;
-        array_ = arrayf;
-        std::vector<int> content_chunks(size);
-        std::iota(std::begin(content_chunks), std::end(content_chunks), 1);
+        //Permutes the producers of every domain with the same single Fisher-Yates pass, in place.
         Ptr<UniformRandomVariable> Rpro = CreateObject<UniformRandomVariable> ();
         Rpro->SetStream(stream);
-        shuffle_array(content_chunks, Rpro);
-        for (int jdx = 0; jdx < ((int) arrayf.size()); jdx++) {
-            for (int idx = 0; idx < ((int) arrayf[jdx].size()); idx++) {
-                arrayf[jdx][content_chunks[idx] - 1] = array_[jdx][idx];
+        for (int idx = size - 1; idx > 0; idx--) {
+            uint32_t jdx = Rpro->GetInteger(0, idx);
+            for (int dom = 0; dom < ((int) arrayf.size()); dom++) {
+                if (idx < (int) arrayf[dom].size() && (int) jdx < (int) arrayf[dom].size()) {
+                    std::swap(arrayf[dom][idx], arrayf[dom][jdx]);
+                }
             }
         }
     };
@@ -22,9 +22,13 @@ namespace ns3 {
             NetDeviceContainer LrWpanDevice[], NetDeviceContainer SixLowpanDevice[], NetDeviceContainer CSMADevice[],
             Ipv6InterfaceContainer i_6lowpan[], Ipv6InterfaceContainer i_csma[],
             std::vector< std::vector<Ipv6Address> > &IPv6Bucket, std::vector< std::vector<Ipv6Address> > &AddrResBucket,
-            NodeContainer &endnodes, NodeContainer &br, NodeContainer & backhaul) {
+            NodeContainer &endnodes, NodeContainer &br, NodeContainer & backhaul, std::string routing, double warmup) {
 
         //This function installs 6LowPAN stack on nodes if IP is selected as networking protocol.
+        //Routing modes:
+        // - ripng:         RIPng keeps running (its update rate is reduced at the end of the warm-up).
+        // - ripng-freeze:  RIPng runs during the warm-up, then the routing tables are frozen.
+        // - static:        The routes RIPng would converge to are installed in static routing at t=0.
 
         int subn = 0;
         RipNgHelper ripNgRouting;
@@ -35,10 +39,13 @@ namespace ns3 {
         Ipv6AddressHelper ipv6;
 
         //Install internet stack.
+        NS_ABORT_MSG_UNLESS(routing == "ripng" || routing == "ripng-freeze" || routing == "static", "Unknown routing mode " << routing);
         listRH.Add(ripNgRouting, 0);
         internetv6.SetIpv4StackInstall(false);
         internetv6.Install(endnodes);
-        internetv6.SetRoutingHelper(listRH);
+        if (routing != "static") {
+            internetv6.SetRoutingHelper(listRH);
+        }
         internetv6.Install(br);
         internetv6.Install(backhaul);
         // Ptr<OutputStreamWrapper> routingStream = Create<OutputStreamWrapper> ("Routing table.txt", ios_base::trunc);
@@ -73,6 +80,13 @@ namespace ns3 {
 
         }
 
+        NodeContainer routers(br, backhaul);
+        if (routing == "static") {
+            ripNgRouting.PopulateConvergedRoutes(routers);
+        } else if (routing == "ripng-freeze") {
+            ripNgRouting.Freeze(routers, Seconds(warmup));
+        }
+
         //Create IPv6AddrResBucket.
         for (int idx = 0; idx < node_head; idx++) {
             for (int jdx = 0; jdx < node_periph; jdx++) {
@@ -94,7 +108,7 @@ namespace ns3 {
             Ipv6InterfaceContainer i_6lowpan[], int &simtime, int &report_time_cu, BriteTopologyHelper & briteth, int &payloadsize,
             std::string zm_q, std::string zm_s, int &con_leaf, int &con_inside, int &con_gtw,
             double &min_freq, double &max_freq, bool &useIPCache, double &freshness,
-            int &cache) {
+            int &cache, double app_start) {
 
         //This function installs the specific IP applications. 
 
@@ -180,7 +194,7 @@ namespace ns3 {
                 std::cout << "sel_node_leaf " << sel_node->GetId() << std::endl;
                 client.SetIPv6Bucket(apps.Get(0), AddrResBucketLeaf);
                 NS_LOG_INFO("Size of generated bucket: " << AddrResBucketLeaf.size());
-                apps.Start(Seconds(120.0 + start_delay));
+                apps.Start(Seconds(app_start + start_delay));
                 apps.Stop(Seconds(simtime - 5));
             }
         }
@@ -200,7 +214,7 @@ namespace ns3 {
                 apps = client.Install(sel_node);
                 std::cout << "sel_node_inside " << sel_node->GetId() << std::endl;
                 client.SetIPv6Bucket(apps.Get(0), AddrResBucket[idx]);
-                apps.Start(Seconds(120.0 + start_delay));
+                apps.Start(Seconds(app_start + start_delay));
                 apps.Stop(Seconds(simtime - 5));
             }
         }
@@ -220,7 +234,7 @@ namespace ns3 {
                 }
                 apps = client.Install(sel_node);
                 client.SetIPv6Bucket(apps.Get(0), AddrResBucket[idx]);
-                apps.Start(Seconds(120.0 + start_delay));
+                apps.Start(Seconds(app_start + start_delay));
                 apps.Stop(Seconds(simtime - 5));
             }
         }
@@ -6,7 +6,7 @@ namespace ns3 {
     void NDN_stack(int &node_head, int &node_periph, NodeContainer iot[], NodeContainer & backhaul, NodeContainer &endnodes,
             BriteTopologyHelper &bth, int &simtime, int &report_time_cu, int &con_leaf, int &con_inside, int &con_gtw,
             int &cache, double &freshness, bool &ipbackhaul, int &payloadsize, std::string zm_q, std::string zm_s,
-            double &min_freq, double &max_freq) {
+            double &min_freq, double &max_freq, bool &cc, bool &ndncompress) {
 
         //This function installs NDN stack on nodes if ndn is selected as networking protocol.
 
@@ -16,7 +16,7 @@ namespace ns3 {
         double start_delay; //Prevent nodes from starting at the same time.
         ndn::StackHelper ndnHelper;
         ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
-        ndn::AppHelper consumerHelper("ns3::ndn::ConsumerZipfMandelbrotV2");
+        ndn::AppHelper consumerHelper(cc ? "ns3::ndn::ConsumerZipfAimd" : "ns3::ndn::ConsumerZipfMandelbrotV2");
         ndn::AppHelper producerHelper("ns3::ndn::Producer");
         Ptr<UniformRandomVariable> Rinterval = CreateObject<UniformRandomVariable> (); //Random variable for transmission interval
         Rinterval->SetStream(2);
@@ -39,6 +39,11 @@ namespace ns3 {
             ndnHelper.SetOldContentStore("ns3::ndn::cs::Nocache");
         }
 
+        //Compress Interest and Data on the 802.15.4 links
+        if (ndncompress) {
+            ndnHelper.setLowPanCompression(true, {prefix});
+        }
+
         // Install NDN stack on iot endnodes
         for (int jdx = 0; jdx < node_head; jdx++) {
             ndnHelper.Install(iot[jdx]);
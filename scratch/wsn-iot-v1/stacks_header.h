@@ -41,20 +41,20 @@ namespace ns3 {
     void NDN_stack(int &node_head, int &node_periph, NodeContainer iot[], NodeContainer & backhaul, NodeContainer &endnodes,
             BriteTopologyHelper &bth, int &simtime, int &report_time_cu, int &con_leaf, int &con_inside, int &con_gtw,
             int &cache, double &freshness, bool &ipbackhaul, int &payloadsize, std::string zm_q, std::string zm_s,
-            double &min_freq, double &max_freq);
+            double &min_freq, double &max_freq, bool &cc, bool &ndncompress);
 
     void sixlowpan_stack(int &node_periph, int &node_head, int &totnumcontents, BriteTopologyHelper &bth,
             NetDeviceContainer LrWpanDevice[], NetDeviceContainer SixLowpanDevice[], NetDeviceContainer CSMADevice[],
             Ipv6InterfaceContainer i_6lowpan[], Ipv6InterfaceContainer i_csma[],
             std::vector< std::vector<Ipv6Address> > &IPv6Bucket, std::vector< std::vector<Ipv6Address> > &AddrResBucket,
-            NodeContainer &endnodes, NodeContainer &br, NodeContainer & backhaul);
+            NodeContainer &endnodes, NodeContainer &br, NodeContainer & backhaul, std::string routing, double warmup);
 
     void sixlowpan_apps(int &node_periph, int &node_head, NodeContainer iot[], NodeContainer all,
             std::vector< std::vector<Ipv6Address> > &AddrResBucket, ApplicationContainer &apps,
             Ipv6InterfaceContainer i_6lowpan[], int &simtime, int &report_time_cu, BriteTopologyHelper & briteth, int &payloadsize,
             std::string zm_q, std::string zm_s, int &con_leaf, int &con_inside, int &con_gtw,
             double &min_freq, double &max_freq, bool &useIPCache, double &freshness,
-            int &cache);
+            int &cache, double app_start);
 
 }
 #endif /* NDN_HEADER_H */
@@ -11,6 +11,7 @@
 #include "src/network/model/node.h"
 #include "ns3/brite-module.h"
 #include "ns3/flow-monitor-module.h"
+#include "ns3/mpi-interface.h"
 #include "helper/ndn-stack-helper.hpp"
 #include "src/ndnSIM/helper/ndn-global-routing-helper.hpp"
 #include "ns3/ndnSIM-module.h"
@@ -22,6 +23,8 @@
 #include "boost/filesystem.hpp" 
 #include <string>
 #include <vector>
+#include <set>
+#include <sstream>
 
 #include "stacks_header.h"
 #include "g_function_header.h"
@@ -39,6 +42,24 @@ namespace ns3 {
     }
      */
 
+    //Pcap node filter: capture only on the listed nodes.
+    static bool PcapNodeFilter(const std::set<uint32_t> *nodes, Ptr<Node> node) {
+        return nodes->count(node->GetId()) > 0;
+    }
+
+    //MPI: applications are installed on every node, only run those of the nodes of this process.
+    static void SuppressRemoteApplications(Time never) {
+        for (NodeList::Iterator it = NodeList::Begin(); it != NodeList::End(); ++it) {
+            if ((*it)->GetSystemId() == MpiInterface::GetSystemId()) {
+                continue;
+            }
+            for (uint32_t idx = 0; idx < (*it)->GetNApplications(); idx++) {
+                (*it)->GetApplication(idx)->SetStartTime(never);
+                (*it)->GetApplication(idx)->SetStopTime(never);
+            }
+        }
+    }
+
     int main(int argc, char **argv) {
 
         //Variables and simulation configuration
@@ -74,6 +95,20 @@ namespace ns3 {
         int dtracefreq = 10000;
         std::string zm_q = "0.7";
         std::string zm_s = "0.7";
+        std::string routing = "ripng";
+        double warmup = 120;
+        double flowstream = 0;
+        bool pcapasync = false;
+        bool pcapmerge = false;
+        uint32_t pcapsnaplen = 0;
+        std::string pcapnodes = "";
+        bool cc = false;
+        bool ndncompress = false;
+        bool mpi = false;
+        bool nullmsg = false;
+        std::string britecache = "";
+        std::string topology = "";
+        std::string savetopology = "";
 
         CommandLine cmd;
         cmd.AddValue("verbose", "turn on log components", verbose); //Not implemented
@@ -100,8 +135,31 @@ namespace ns3 {
         cmd.AddValue("dtracefreq", "Averaging period for droptrace file.", dtracefreq);
         cmd.AddValue("ipcache", "Enable IP caching on gateway", useIPCache);
         cmd.AddValue("report_time_cu", "Report time for CU metric", report_time_cu);
+        cmd.AddValue("routing", "IP routing: ripng, ripng-freeze (frozen after warmup) or static (converged routes at t=0)", routing);
+        cmd.AddValue("warmup", "RIPng warm-up time in seconds before IP consumers start", warmup);
+        cmd.AddValue("flowstream", "Stream flow statistics to Flows.csv every flowstream seconds instead of writing Flows.xml (0 = off)", flowstream);
+        cmd.AddValue("pcapasync", "Write pcap files from a background thread", pcapasync);
+        cmd.AddValue("pcapmerge", "Write one pcapng file per channel instead of one pcap file per device", pcapmerge);
+        cmd.AddValue("pcapsnaplen", "Maximum number of bytes captured per packet (0 = whole packet)", pcapsnaplen);
+        cmd.AddValue("pcapnodes", "Comma separated ids of the nodes to capture on (empty = all nodes)", pcapnodes);
+        cmd.AddValue("cc", "Congestion control: AIMD window for NDN consumers, CoCoA for CoAP clients (Frequency becomes an upper bound)", cc);
+        cmd.AddValue("ndncompress", "Compress the NDN packets on the 802.15.4 links, with /SensorData as prefix context", ndncompress);
+        cmd.AddValue("mpi", "Distribute the simulation over the MPI processes it is started with (mpirun -np N)", mpi);
+        cmd.AddValue("nullmsg", "Use the null message MPI synchronization instead of the granted time window one", nullmsg);
+        cmd.AddValue("britecache", "Directory caching the BRITE topologies, generated once per configuration and seed (empty = off)", britecache);
+        cmd.AddValue("topology", "Read the backhaul from an annotated topology file instead of running BRITE", topology);
+        cmd.AddValue("savetopology", "Write the backhaul to an annotated topology file", savetopology);
         cmd.Parse(argc, argv);
 
+        //MPI
+        uint32_t systemCount = 1;
+        if (mpi) {
+            GlobalValue::Bind("SimulatorImplementationType",
+                    StringValue(nullmsg ? "ns3::NullMessageSimulatorImpl" : "ns3::DistributedSimulatorImpl"));
+            MpiInterface::Enable(&argc, &argv);
+            systemCount = MpiInterface::GetSize();
+        }
+
         //Random variables
         RngSeedManager::SetSeed(1);
         RngSeedManager::SetRun(rngfeed);
@@ -162,8 +220,37 @@ namespace ns3 {
         //BriteTopologyHelper bth(std::string("src/brite/examples/conf_files/RTBarabasi20.conf"));
         BriteTopologyHelper bth(std::string("./TD_ASBarabasi_RTWaxman.conf"));
         bth.AssignStreams(3);
-        backhaul = bth.BuildBriteTopology2();
-        br.Create(node_head);
+        if (!britecache.empty()) {
+            bth.SetCacheDirectory(britecache);
+        }
+        if (!topology.empty()) {
+            bth.ReadAnnotatedTopology(topology);
+        }
+        if (mpi) {
+            // Every leaf router may carry a domain: its sensor nodes and its border router.
+            backhaul = bth.BuildBriteTopology2(systemCount, node_head * (node_periph + 1));
+            if (MpiInterface::GetSystemId() == 0) {
+                bth.PrintPartition(std::cout);
+            }
+        } else {
+            backhaul = bth.BuildBriteTopology2();
+        }
+        if (!savetopology.empty()) {
+            bth.WriteAnnotatedTopology(savetopology);
+        }
+
+        // Select the leaf node of each domain first, so that the domain is created on its system.
+        Ptr<UniformRandomVariable> Rnode = CreateObject<UniformRandomVariable> (); //Random number for selecting random leafnode.
+        Rnode->SetStream(1);
+        std::vector<Ptr<Node> > domain_leaf;
+        for (int jdx = 0; jdx < node_head; jdx++) {
+            Ptr<Node> cur_blnode = SelectRandomLeafNode(bth, Rnode);
+            bth.SetConnectedLeaf(cur_blnode);
+            domain_leaf.push_back(cur_blnode);
+        }
+        for (int jdx = 0; jdx < node_head; jdx++) {
+            br.Add(CreateObject<Node> (domain_leaf[jdx]->GetSystemId()));
+        }
         routers.Add(backhaul);
         routers.Add(br);
         //totalnodes = node_head* node_periph + node_head + bth.GetNNodesTopology();
@@ -181,17 +268,12 @@ namespace ns3 {
         NetDeviceContainer LrWpanDevice[node_head];
         NetDeviceContainer CSMADevice[node_head];
         Ptr<ListPositionAllocator> BorderRouterPositionAlloc = CreateObject<ListPositionAllocator> ();
-        Ptr<UniformRandomVariable> Rnode = CreateObject<UniformRandomVariable> (); //Random number for selecting random leafnode.
-        Rnode->SetStream(1);
         for (int jdx = 0; jdx < node_head; jdx++) {
-            Ptr<Node> cur_blnode;
             //Add BR and master to csma-NodeContainers
             border_backhaul[jdx].Add(br.Get(jdx));
-            cur_blnode = SelectRandomLeafNode(bth, Rnode);
-            border_backhaul[jdx].Add(cur_blnode);
-            bth.SetConnectedLeaf(cur_blnode);
+            border_backhaul[jdx].Add(domain_leaf[jdx]);
             //Add BR and WSN nodes to IoT[] domain
-            iot[jdx].Create(node_periph);
+            iot[jdx].Create(node_periph, domain_leaf[jdx]->GetSystemId());
             endnodes.Add(iot[jdx]); // Add iot[] container to endnodes container before adding br.
             iot[jdx].Add(br.Get(jdx));
 
@@ -271,7 +353,7 @@ namespace ns3 {
 
         if (ndn) {
             NDN_stack(node_head, node_periph, iot, backhaul, endnodes, bth, simtime, report_time_cu, con_leaf, con_inside, con_gtw,
-                    cache, freshness, ipbackhaul, payloadsize, zm_q, zm_s, min_freq, max_freq);
+                    cache, freshness, ipbackhaul, payloadsize, zm_q, zm_s, min_freq, max_freq, cc, ndncompress);
             ndn::AppDelayTracer::InstallAll("app-delays-trace.txt");
             L2RateTracer::InstallAll("drop-trace.txt", Seconds(dtracefreq));
         }
@@ -295,10 +377,11 @@ namespace ns3 {
 
         if (!ndn) {
             NS_LOG_INFO("Installing 6lowpan stack.");
-            sixlowpan_stack(node_periph, node_head, totnumcontents, bth, LrWpanDevice, SixLowpanDevice, CSMADevice, i_6lowpan, i_csma, IPv6Bucket, AddrResBucket, endnodes, br, backhaul);
+            Config::SetDefault("ns3::CoapClient::CongestionControl", BooleanValue(cc));
+            sixlowpan_stack(node_periph, node_head, totnumcontents, bth, LrWpanDevice, SixLowpanDevice, CSMADevice, i_6lowpan, i_csma, IPv6Bucket, AddrResBucket, endnodes, br, backhaul, routing, warmup);
 
             NS_LOG_INFO("Creating Applications.");
-            sixlowpan_apps(node_periph, node_head, iot, all, AddrResBucket, apps, i_6lowpan, simtime, report_time_cu, bth, payloadsize, zm_q, zm_s, con_leaf, con_inside, con_gtw, min_freq, max_freq, useIPCache, freshness, cache);
+            sixlowpan_apps(node_periph, node_head, iot, all, AddrResBucket, apps, i_6lowpan, simtime, report_time_cu, bth, payloadsize, zm_q, zm_s, con_leaf, con_inside, con_gtw, min_freq, max_freq, useIPCache, freshness, cache, routing == "static" ? 1.0 : warmup);
         }
 
 
@@ -312,7 +395,13 @@ namespace ns3 {
 
         if (!ndn) {
             flowMonitor = flowHelper.InstallAll();
-            Simulator::Schedule(Seconds(120), &ReduceRouteFreq, routers);
+            if (flowstream > 0) {
+                //Convert with flowmon-stream-to-xml.
+                flowMonitor->EnableStreamingExport("Flows.csv", Seconds(flowstream), true, true);
+            }
+            if (routing == "ripng") {
+                Simulator::Schedule(Seconds(warmup), &ReduceRouteFreq, routers);
+            }
         }
 
 
@@ -320,22 +409,52 @@ namespace ns3 {
         //anim.EnablePacketMetadata(true);
 
         if (pcaptracing) {
+            Config::SetDefault("ns3::PcapFileWrapper::Asynchronous", BooleanValue(pcapasync));
+            if (pcapsnaplen > 0) {
+                Config::SetDefault("ns3::PcapFileWrapper::CaptureSize", UintegerValue(pcapsnaplen));
+            }
+            std::set<uint32_t> pcapNodeIds;
+            std::istringstream pcapNodeList(pcapnodes);
+            std::string pcapNodeId;
+            while (std::getline(pcapNodeList, pcapNodeId, ',')) {
+                pcapNodeIds.insert(std::stoul(pcapNodeId));
+            }
+            Callback<bool, Ptr<Node> > pcapFilter;
+            if (!pcapNodeIds.empty()) {
+                pcapFilter = MakeBoundCallback(&PcapNodeFilter, &pcapNodeIds);
+            }
+
+            csma.SetPcapNodeFilter(pcapFilter);
+            csma.SetPcapMergeChannels(pcapmerge);
             csma.EnablePcapAll(std::string("traces/csma"), true);
 
             for (int jdx = 0; jdx < node_head; jdx++) {
-                lrWpanHelper[jdx].EnablePcapAll(std::string("traces/6lowpan/wsn"), true);
+                lrWpanHelper[jdx].SetPcapNodeFilter(pcapFilter);
+                lrWpanHelper[jdx].SetPcapMergeChannels(pcapmerge);
+                lrWpanHelper[jdx].EnablePcap(std::string("traces/6lowpan/wsn"), LrWpanDevice[jdx], true);
             }
 
         }
 
 
+        if (mpi) {
+            SuppressRemoteApplications(Seconds(simtime + 1));
+        }
+
         NS_LOG_INFO("Run Simulation.");
         Simulator::Stop(Seconds(simtime));
         Simulator::Run();
         if (!ndn) {
-            flowMonitor->SerializeToXmlFile("Flows.xml", true, true);
+            if (flowstream > 0) {
+                flowMonitor->StopStreamingExport();
+            } else {
+                flowMonitor->SerializeToXmlFile("Flows.xml", true, true);
+            }
         }
         Simulator::Destroy();
+        if (mpi) {
+            MpiInterface::Disable();
+        }
         NS_LOG_INFO("Done.");
 
         return 0;
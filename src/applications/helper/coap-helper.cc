@@ -64,6 +64,11 @@ namespace ns3 {
         app->GetObject<CoapServer>()->SetIPv6Bucket(bucket);
     }
 
+    void
+    CoapServerHelper::SetContentDirectory(Ptr<Application> app, Ptr<CoapContentDirectory> directory) {
+        app->GetObject<CoapServer>()->SetContentDirectory(directory);
+    }
+
     Ptr<Application>
     CoapServerHelper::InstallPriv(Ptr<Node> node) const {
         Ptr<Application> app = m_factory.Create<CoapServer> ();
@@ -110,6 +115,11 @@ namespace ns3 {
         app->GetObject<CoapCacheGtw>()->SetIPv6Bucket(bucket);
     }
 
+    void
+    CoapCacheGtwHelper::SetContentDirectory(Ptr<Application> app, Ptr<CoapContentDirectory> directory) {
+        app->GetObject<CoapCacheGtw>()->SetContentDirectory(directory);
+    }
+
     Ptr<Application>
     CoapCacheGtwHelper::InstallPriv(Ptr<Node> node) const {
         Ptr<Application> app = m_factory.Create<CoapCacheGtw> ();
@@ -135,6 +145,11 @@ namespace ns3 {
         app->GetObject<CoapClient>()->SetIPv6Bucket(bucket);
     }
 
+    void
+    CoapClientHelper::SetContentDirectory(Ptr<Application> app, Ptr<CoapContentDirectory> directory) {
+        app->GetObject<CoapClient>()->SetContentDirectory(directory);
+    }
+
     void
     CoapClientHelper::SetFill(Ptr<Application> app, std::string fill) {
         app->GetObject<CoapClient>()->SetFill(fill);
@@ -171,6 +186,21 @@ namespace ns3 {
         return apps;
     }
 
+    int64_t
+    CoapClientHelper::AssignStreams(NodeContainer c, int64_t stream) {
+        int64_t currentStream = stream;
+        for (NodeContainer::Iterator i = c.Begin(); i != c.End(); ++i) {
+            Ptr<Node> node = *i;
+            for (uint32_t j = 0; j < node->GetNApplications(); j++) {
+                Ptr<CoapClient> client = DynamicCast<CoapClient> (node->GetApplication(j));
+                if (client) {
+                    currentStream += client->AssignStreams(currentStream);
+                }
+            }
+        }
+        return (currentStream - stream);
+    }
+
     Ptr<Application>
     CoapClientHelper::InstallPriv(Ptr<Node> node) const {
         Ptr<Application> app = m_factory.Create<CoapClient> ();
@@ -26,6 +26,7 @@
 #include "ns3/object-factory.h"
 #include "ns3/ipv4-address.h"
 #include "ns3/ipv6-address.h"
+#include "ns3/coap-content-directory.h"
 
 namespace ns3 {
 
@@ -95,6 +96,13 @@ namespace ns3 {
 
         void SetIPv6Bucket(Ptr<Application> app, std::vector<Ipv6Address> &bucket);
 
+        /**
+         * Pass the content directory of the domain to the application.
+         *
+         * \param app Smart pointer to the application (real type must be CoapServer).
+         * \param directory The directory, which may be shared by all the applications of the domain.
+         */
+        void SetContentDirectory(Ptr<Application> app, Ptr<CoapContentDirectory> directory);
 
     private:
         /**
@@ -170,6 +178,13 @@ namespace ns3 {
 
         void SetIPv6Bucket(Ptr<Application> app, std::vector<Ipv6Address> &bucket);
 
+        /**
+         * Pass the content directory of the domain to the application.
+         *
+         * \param app Smart pointer to the application (real type must be CoapCacheGtw).
+         * \param directory The directory, which may be shared by all the applications of the domain.
+         */
+        void SetContentDirectory(Ptr<Application> app, Ptr<CoapContentDirectory> directory);
 
     private:
         /**
@@ -303,6 +318,27 @@ namespace ns3 {
 
         void SetIPv6Bucket(Ptr<Application> app, std::vector<Ipv6Address>& bucket);
 
+        /**
+         * Pass the content directory of the domain to the application.
+         *
+         * \param app Smart pointer to the application (real type must be CoapClient).
+         * \param directory The directory, which may be shared by all the applications of the domain.
+         */
+        void SetContentDirectory(Ptr<Application> app, Ptr<CoapContentDirectory> directory);
+
+        /**
+         * Assign a fixed random variable stream number to the random variables
+         * used by the CoapClient applications of the nodes.  Return the number of
+         * streams that have been assigned.  The Install() method should have
+         * previously been called by the user.
+         *
+         * \param c NodeContainer of the set of nodes whose CoapClient applications
+         *          should be modified to use fixed streams
+         * \param stream first stream index to use
+         * \return the number of stream indices assigned by this helper
+         */
+        int64_t AssignStreams(NodeContainer c, int64_t stream);
+
     private:
         /**
          * Install an ns3::CoapClient on the node configured with all the
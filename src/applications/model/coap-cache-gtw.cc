@@ -106,9 +106,17 @@ namespace ns3 {
 
     void
     CoapCacheGtw::SetIPv6Bucket(std::vector<Ipv6Address> bucket) {
-        m_IPv6Bucket = std::vector<Ipv6Address> (bucket.size() + 1);
-        m_IPv6Bucket = bucket;
+        // content i is served at bucket[i]
+        Ptr<CoapContentDirectory> directory = Create<CoapContentDirectory> ();
+        for (std::vector<Ipv6Address>::const_iterator it = bucket.begin(); it != bucket.end(); ++it) {
+            directory->Add(*it, m_port);
+        }
+        SetContentDirectory(directory);
+    }
 
+    void
+    CoapCacheGtw::SetContentDirectory(Ptr<CoapContentDirectory> directory) {
+        m_directory = directory;
     }
 
     void
@@ -204,7 +212,7 @@ namespace ns3 {
 
         //std::cout << "%%%%%%%%%%%%%%" << TimeStep(m_event_save.GetTs()).GetSeconds() << " " << m_report_time_T.GetSeconds() << std::endl;
         if (m_event_save.GetTs() == 0) {
-            std::cout << "@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@@ Scheduled!" << std::endl;
+            NS_LOG_DEBUG("Scheduled the cache utilization report");
             m_event_save = Simulator::Schedule(m_report_time_T - Simulator::Now(), &CoapCacheGtw::SaveToFile, this, Simulator::GetContext());
         }
     }
@@ -333,10 +341,8 @@ namespace ns3 {
                         received_packet->AddPacketTag(coaptag);
                         socket->SetIpv6HopLimit(63);
                         socket->SendTo(received_packet, 0, std::get<0>(m_pendingreqs[idx]));
-                        m_pendingreqs.erase(m_pendingreqs.begin() + idx);
-
                         AddToCache(std::get<2>(m_pendingreqs[idx]));
-                        std::get<2>(m_pendingreqs[idx]);
+                        m_pendingreqs.erase(m_pendingreqs.begin() + idx);
                         break;
                     }
                 }
@@ -366,11 +372,13 @@ namespace ns3 {
 
     void
     CoapCacheGtw::CacheMiss(Ptr<Socket> socket, Ptr<Packet> received_packet, uint32_t & sq, CoapPacketTag & coaptag, Address & from) {
-        NS_LOG_INFO("Cache miss! Transmitting to: " << m_IPv6Bucket[sq] << " SEQ: " << sq);
+        NS_ASSERT_MSG(m_directory && sq < m_directory->GetN(), "Request for content " << sq << " missing from the directory");
+        const CoapContentDirectory::Entry &producer = m_directory->Resolve(sq);
+        NS_LOG_INFO("Cache miss! Transmitting to: " << producer.address << " SEQ: " << sq);
         m_pendingreqs.push_back(std::make_tuple(from, coaptag.GetT(), sq));
         Packet repsonsep(*received_packet);
         repsonsep.AddPacketTag(coaptag);
-        socket->SendTo(&repsonsep, 0, Inet6SocketAddress(m_IPv6Bucket[sq], m_port));
+        socket->SendTo(&repsonsep, 0, Inet6SocketAddress(producer.address, producer.port));
     }
 
     void
@@ -28,6 +28,7 @@
 #include "ns3/trace-source-accessor.h"
 #include "ns3/traced-callback.h"
 #include "ns3/coap-packet-tag.h"
+#include "ns3/coap-content-directory.h"
 
 namespace ns3 {
 
@@ -65,6 +66,12 @@ namespace ns3 {
 
 
         void SetIPv6Bucket(std::vector<Ipv6Address> bucket);
+
+        /**
+         * \brief Set the directory the requests missing the cache are forwarded with
+         * \param directory the directory, shared with the other applications of the domain
+         */
+        void SetContentDirectory(Ptr<CoapContentDirectory> directory);
         void SetReportTime(int time);
         int GetReportTime(void) const;
         void CacheHit(Ptr<Socket> socket, Ptr<Packet> received_packet, uint32_t & sq, CoapPacketTag & coaptag, Address &from);
@@ -136,7 +143,7 @@ namespace ns3 {
 
         std::vector<std::pair<uint32_t, Time>> m_cache; //Sequence, time
         std::vector<std::tuple<Address, uint64_t, uint32_t>> m_pendingreqs; //Adress, time, sequence
-        std::vector<Ipv6Address> m_IPv6Bucket;
+        Ptr<CoapContentDirectory> m_directory; //!< Producer of every content
         Ipv6Address m_ownip;
     };
 
@@ -39,6 +39,8 @@
 #include "ns3/internet-module.h"
 #include "ns3/applications-module.h"
 #include <string>
+#include <cmath>
+#include <algorithm>
 
 
 
@@ -81,6 +83,11 @@ namespace ns3 {
                 BooleanValue(false),
                 MakeBooleanAccessor(&CoapClient::iamgtw),
                 MakeBooleanChecker())
+                .AddAttribute("Proxy", "The server of all the requests, such as the cache of a gateway. "
+                "Any to send the requests to the producers of the content directory.",
+                Ipv6AddressValue(Ipv6Address::GetAny()),
+                MakeIpv6AddressAccessor(&CoapClient::m_proxy),
+                MakeIpv6AddressChecker())
                 .AddTraceSource("Tx", "A new packet is created and is sent",
                 MakeTraceSourceAccessor(&CoapClient::m_txTrace),
                 "ns3::Packet::TracedCallback")
@@ -102,7 +109,29 @@ namespace ns3 {
                 .AddAttribute("RngStream", "Set Rng stream.", StringValue("-1"),
                 MakeUintegerAccessor(&CoapClient::SetRngStream,
                 &CoapClient::GetRngStream),
-                MakeUintegerChecker<uint32_t>());
+                MakeUintegerChecker<uint32_t>())
+
+                //CoCoA
+                .AddAttribute("CongestionControl",
+                "Retransmit requests on an adaptive RTO and limit the exchanges outstanding per server (CoCoA)",
+                BooleanValue(false),
+                MakeBooleanAccessor(&CoapClient::m_cocoa),
+                MakeBooleanChecker())
+                .AddAttribute("NStart",
+                "The maximum number of exchanges outstanding per server, with CongestionControl",
+                UintegerValue(1),
+                MakeUintegerAccessor(&CoapClient::m_nstart),
+                MakeUintegerChecker<uint32_t> (1))
+                .AddAttribute("MaxRetransmit",
+                "The number of retransmissions before an exchange is given up, with CongestionControl",
+                UintegerValue(4),
+                MakeUintegerAccessor(&CoapClient::m_maxRetransmit),
+                MakeUintegerChecker<uint32_t> ())
+                .AddAttribute("MaxBacklog",
+                "The maximum number of requests waiting for an exchange per server, with CongestionControl",
+                UintegerValue(100),
+                MakeUintegerAccessor(&CoapClient::m_maxBacklog),
+                MakeUintegerChecker<uint32_t> ());
 
         ;
         return tid;
@@ -112,10 +141,17 @@ namespace ns3 {
     : m_N(100) // needed here to make sure when SetQ/SetS are called, there is a valid value of N
     , m_q(0.7)
     , m_s(0.7)
-    , m_seqRng(CreateObject<UniformRandomVariable>()) {
+    , m_seqRng(CreateObject<UniformRandomVariable>())
+    , m_cocoa(false)
+    , m_nstart(1)
+    , m_maxRetransmit(4)
+    , m_maxBacklog(100)
+    , m_timeoutRng(CreateObject<UniformRandomVariable>()) {
         NS_LOG_FUNCTION(this);
         m_sent = 0;
         m_received = 0;
+        m_retransmitted = 0;
+        m_dropped = 0;
         m_socket = 0;
         m_sendEvent = EventId();
         m_data = 0;
@@ -168,12 +204,38 @@ namespace ns3 {
 
     }
 
+    int64_t
+    CoapClient::AssignStreams(int64_t stream) {
+        NS_LOG_FUNCTION(this << stream);
+        m_seqRng->SetStream(stream);
+        m_timeoutRng->SetStream(stream + 1);
+        return 2;
+    }
+
+    Time
+    CoapClient::GetRto(Ipv6Address server) const {
+        std::map<Ipv6Address, Server>::const_iterator it = m_servers.find(server);
+        return it == m_servers.end() ? Seconds(0) : Seconds(it->second.rto);
+    }
+
+    uint32_t
+    CoapClient::GetRetransmitted(void) const {
+        return m_retransmitted;
+    }
+
     void
     CoapClient::SetIPv6Bucket(std::vector<Ipv6Address> bucket) {
-        m_IPv6Bucket = std::vector<Ipv6Address> (bucket.size() + 1);
-        m_IPv6Bucket = bucket;
-        // SetNumberOfContents((uint32_t)bucket.size());
+        // content i is served at bucket[i]
+        Ptr<CoapContentDirectory> directory = Create<CoapContentDirectory> ();
+        for (std::vector<Ipv6Address>::const_iterator it = bucket.begin(); it != bucket.end(); ++it) {
+            directory->Add(*it, m_peerPort);
+        }
+        SetContentDirectory(directory);
+    }
 
+    void
+    CoapClient::SetContentDirectory(Ptr<CoapContentDirectory> directory) {
+        m_directory = directory;
     }
 
     uint32_t
@@ -205,24 +267,15 @@ namespace ns3 {
 
     uint32_t
     CoapClient::GetNextSeq() {
-        uint32_t content_index = 1; //[1, m_N]
-        double p_sum = 0;
-
         double p_random = m_seqRng->GetValue();
         while (p_random == 0) {
             p_random = m_seqRng->GetValue();
         }
-        // if (p_random == 0)
         NS_LOG_LOGIC("p_random=" << p_random);
-        for (uint32_t i = 1; i <= m_N; i++) {
-            p_sum = m_Pcum[i]; // m_Pcum[i] = m_Pcum[i-1] + p[i], p[0] = 0;   e.g.: p_cum[1] = p[1],
-            // p_cum[2] = p[1] + p[2]
-            if (p_random <= p_sum) {
-                content_index = i;
-                break;
-            } // if
-        } // for
-        // content_index = 1;
+        // the first content whose cumulative probability reaches p_random, in [1, m_N]
+        // (m_Pcum[i] = m_Pcum[i-1] + p[i], p[0] = 0)
+        uint32_t content_index = std::lower_bound(m_Pcum.begin() + 1, m_Pcum.end(), p_random) - m_Pcum.begin();
+        content_index = std::min(content_index, m_N);
         NS_LOG_DEBUG("RandomNumber=" << content_index);
         return content_index;
     }
@@ -235,6 +288,11 @@ namespace ns3 {
         Ipv6InterfaceAddress ownaddr = ipv6->GetAddress(1, 1);
         m_ownip = ownaddr.GetAddress();
 
+        NS_ABORT_MSG_IF(!m_directory || m_directory->GetN() < m_N,
+                "CoapClient: the content directory does not resolve the " << m_N << " contents");
+        NS_ABORT_MSG_IF(!iamgtw && m_proxy.IsAny() && m_directory->CountContents(m_ownip) >= m_N,
+                "CoapClient: every content is served by the client itself");
+
         if (m_socket == 0) {
             TypeId tid = TypeId::LookupByName("ns3::UdpSocketFactory");
             m_socket = Socket::CreateSocket(GetNode(), tid);
@@ -258,6 +316,15 @@ namespace ns3 {
         NS_LOG_INFO("Total transmitted packets: " << m_sent);
         NS_LOG_INFO("Total received packets: " << m_received);
         NS_LOG_INFO("Packet loss: " << pktloss);
+        if (m_cocoa) {
+            NS_LOG_INFO("Retransmitted packets: " << m_retransmitted << ", dropped requests: " << m_dropped);
+        }
+
+        for (std::map<uint32_t, Exchange>::iterator it = m_exchanges.begin(); it != m_exchanges.end(); ++it) {
+            Simulator::Cancel(it->second.timer);
+        }
+        m_exchanges.clear();
+        m_servers.clear();
 
         if (m_socket != 0) {
             m_socket->Close();
@@ -370,16 +437,46 @@ namespace ns3 {
     void
     CoapClient::Send(void) {
         NS_LOG_FUNCTION(this);
-        CoapPacketTag coaptag;
         uint32_t nxtsq;
         NS_ASSERT(m_sendEvent.IsExpired());
         do {
             nxtsq = GetNextSeq() - 1; //Next sequence spans from [1, N];
-            NS_LOG_DEBUG("IP from bucket:" << m_IPv6Bucket[nxtsq] << " My own ip: " << m_ownip);
-        } while (m_IPv6Bucket[nxtsq] == m_ownip);
-        coaptag.SetReq(nxtsq);
-        coaptag.SetSeq(m_sent);
-        SetFill("Sensordata/" + std::to_string(nxtsq));
+            NS_LOG_DEBUG("Server of " << nxtsq << ": " << GetServer(nxtsq) << " My own ip: " << m_ownip);
+        } while (GetServer(nxtsq) == m_ownip && !iamgtw);
+
+        if (m_cocoa) {
+            StartExchange(nxtsq, m_sent);
+        } else {
+            Transmit(nxtsq, m_sent);
+            m_PenSeqSet.insert(nxtsq);
+        }
+        ++m_sent;
+        //std::cout<<"s: "<< m_sent<<std::endl;
+        if (m_sent < m_count) {
+            ScheduleTransmit(m_interval);
+        }
+    }
+
+    Ipv6Address
+    CoapClient::GetServer(uint32_t req) const {
+        if (iamgtw) {
+            return m_ownip;
+        }
+        return m_proxy.IsAny() ? m_directory->Resolve(req).address : m_proxy;
+    }
+
+    uint16_t
+    CoapClient::GetServerPort(uint32_t req) const {
+        return iamgtw || !m_proxy.IsAny() ? m_peerPort : m_directory->Resolve(req).port;
+    }
+
+    void
+    CoapClient::Transmit(uint32_t req, uint32_t seq) {
+        NS_LOG_FUNCTION(this << req << seq);
+        CoapPacketTag coaptag;
+        coaptag.SetReq(req);
+        coaptag.SetSeq(seq);
+        SetFill(m_directory->Resolve(req).path);
         NS_LOG_INFO("Added REQ to label: " << coaptag.GetReq());
         Ptr<Packet> p;
         if (m_dataSize) {
@@ -407,30 +504,129 @@ namespace ns3 {
         // so that tags added to the packet can be sent as well
         m_txTrace(p);
 
-        if (iamgtw) {
-            if (m_socket->SendTo(p, 0, Inet6SocketAddress(m_ownip, m_peerPort)) == -1) {
-                NS_LOG_INFO("SendTo ERROR! Trying to send to " << m_ownip);
-            }
+        Ipv6Address server = GetServer(req);
+        uint16_t port = GetServerPort(req);
+        if (m_socket->SendTo(p, 0, Inet6SocketAddress(server, port)) == -1) {
+            NS_LOG_INFO("SendTo ERROR! Trying to send to " << server);
+        }
+
+        NS_LOG_INFO("At time " << Simulator::Now().GetSeconds() << "s client sent " << m_size << " bytes to " <<
+                server << " port " << port);
+    }
+
+    void
+    CoapClient::StartExchange(uint32_t req, uint32_t seq) {
+        NS_LOG_FUNCTION(this << req << seq);
+        Ipv6Address server = GetServer(req);
+        std::map<Ipv6Address, Server>::iterator it = m_servers.find(server);
+        if (it == m_servers.end()) {
+            Server state = Server();
+            state.rto = 2.0; // initial RTO of CoCoA
+            state.rtoUpdated = Simulator::Now();
+            it = m_servers.insert(std::make_pair(server, state)).first;
+        }
+
+        if (it->second.outstanding < m_nstart) {
+            BeginExchange(server, req, seq);
+        } else if (it->second.backlog.size() < m_maxBacklog) {
+            it->second.backlog.push_back(std::make_pair(req, seq));
+            NS_LOG_INFO("Queued request " << seq << " for " << server << ", backlog " << it->second.backlog.size());
         } else {
-            if (m_socket->SendTo(p, 0, Inet6SocketAddress(m_IPv6Bucket[nxtsq], m_peerPort)) == -1) {
-                NS_LOG_INFO("SendTo ERROR! Trying to send to " << m_IPv6Bucket[nxtsq]);
-            };
+            NS_LOG_INFO("Dropped request " << seq << " for " << server << ", backlog full");
+            m_dropped++;
         }
+    }
 
+    void
+    CoapClient::BeginExchange(Ipv6Address server, uint32_t req, uint32_t seq) {
+        NS_LOG_FUNCTION(this << server << req << seq);
+        Server &state = m_servers[server];
+
+        // RTO aging: an estimate not updated for a while drifts back towards the 1-3 s range.
+        Time now = Simulator::Now();
+        if (state.rto < 1.0 && now - state.rtoUpdated > Seconds(16 * state.rto)) {
+            state.rto = 2 * state.rto;
+            state.rtoUpdated = now;
+        } else if (state.rto > 3.0 && now - state.rtoUpdated > Seconds(4 * state.rto)) {
+            state.rto = 1.0 + 0.5 * state.rto;
+            state.rtoUpdated = now;
+        }
 
+        Exchange &exchange = m_exchanges[seq];
+        exchange.server = server;
+        exchange.req = req;
+        exchange.retx = 0;
+        exchange.firstSent = now;
+        exchange.timeout = m_timeoutRng->GetValue(state.rto, 1.5 * state.rto);
+        // Variable backoff factor: short RTOs back off faster, long ones slower.
+        exchange.backoff = state.rto < 1.0 ? 3.0 : (state.rto > 3.0 ? 1.5 : 2.0);
+        state.outstanding++;
+
+        Transmit(req, seq);
+        exchange.timer = Simulator::Schedule(Seconds(exchange.timeout), &CoapClient::ExchangeTimeout, this, seq);
+    }
 
-        ++m_sent;
-        //std::cout<<"s: "<< m_sent<<std::endl;
-        m_PenSeqSet.insert(nxtsq);
-        if (Ipv6Address::IsMatchingType(m_IPv6Bucket[nxtsq])) {
-            NS_LOG_INFO("At time " << Simulator::Now().GetSeconds() << "s client sent " << m_size << " bytes to " <<
-                    m_IPv6Bucket[nxtsq] << " port " << m_peerPort);
+    void
+    CoapClient::ExchangeTimeout(uint32_t seq) {
+        NS_LOG_FUNCTION(this << seq);
+        std::map<uint32_t, Exchange>::iterator it = m_exchanges.find(seq);
+        NS_ASSERT(it != m_exchanges.end());
+        Exchange &exchange = it->second;
+
+        if (exchange.retx >= m_maxRetransmit) {
+            NS_LOG_INFO("Gave up request " << seq << " to " << exchange.server);
+            m_dropped++;
+            CompleteExchange(seq);
+            return;
         }
-        if (m_sent < m_count) {
-            ScheduleTransmit(m_interval);
+
+        exchange.retx++;
+        exchange.timeout *= exchange.backoff;
+        m_retransmitted++;
+        NS_LOG_INFO("Retransmission " << exchange.retx << " of request " << seq << ", next timeout " << exchange.timeout << " s");
+        Transmit(exchange.req, seq);
+        exchange.timer = Simulator::Schedule(Seconds(exchange.timeout), &CoapClient::ExchangeTimeout, this, seq);
+    }
+
+    void
+    CoapClient::CompleteExchange(uint32_t seq) {
+        NS_LOG_FUNCTION(this << seq);
+        std::map<uint32_t, Exchange>::iterator it = m_exchanges.find(seq);
+        Ipv6Address server = it->second.server;
+        Simulator::Cancel(it->second.timer);
+        m_exchanges.erase(it);
+
+        Server &state = m_servers[server];
+        state.outstanding--;
+        if (!state.backlog.empty()) {
+            std::pair<uint32_t, uint32_t> next = state.backlog.front();
+            state.backlog.pop_front();
+            BeginExchange(server, next.first, next.second);
         }
     }
 
+    void
+    CoapClient::UpdateRto(Server &server, Time rtt, bool strong) {
+        double r = rtt.GetSeconds();
+        RttEstimate &estimate = strong ? server.strong : server.weak;
+        if (!estimate.valid) {
+            estimate.srtt = r;
+            estimate.rttvar = r / 2;
+            estimate.valid = true;
+        } else {
+            estimate.rttvar = 0.75 * estimate.rttvar + 0.25 * std::fabs(estimate.srtt - r);
+            estimate.srtt = 0.875 * estimate.srtt + 0.125 * r;
+        }
+
+        if (strong) {
+            server.rto = 0.5 * (estimate.srtt + 4 * estimate.rttvar) + 0.5 * server.rto;
+        } else {
+            server.rto = 0.25 * (estimate.srtt + estimate.rttvar) + 0.75 * server.rto;
+        }
+        server.rtoUpdated = Simulator::Now();
+        NS_LOG_DEBUG("RTT " << r << " s (" << (strong ? "strong" : "weak") << "), RTO " << server.rto << " s");
+    }
+
     void
     CoapClient::HandleRead(Ptr<Socket> socket) {
         NS_LOG_FUNCTION(this << socket);
@@ -454,7 +650,23 @@ namespace ns3 {
                 NS_LOG_INFO("Seq Tag: " << coaptag.GetSeq());
                 // NS_LOG_INFO("IT: " << m_PenSeqSet[m_PenSeqSet.find(coaptag.GetReq())]);
 
-                if (m_PenSeqSet.find(coaptag.GetReq()) != m_PenSeqSet.end()) { //Check whether this packet was requested by this client application.
+                if (m_cocoa) {
+                    std::map<uint32_t, Exchange>::iterator it = m_exchanges.find(coaptag.GetSeq());
+                    if (it != m_exchanges.end()) { //Responses to retransmissions of a completed exchange are ignored.
+                        Exchange &exchange = it->second;
+                        Time rtt = Simulator::Now() - exchange.firstSent;
+                        // Which transmission a late response answers is unknown, CoCoA only
+                        // measures exchanges with up to two retransmissions, from the first one.
+                        if (exchange.retx <= 2) {
+                            UpdateRto(m_servers[exchange.server], rtt, exchange.retx == 0);
+                        }
+                        int64_t delay = rtt.GetMilliSeconds();
+                        int hops = iamgtw ? 0 : (int) (64 - hoplimitTag.GetHopLimit());
+                        PrintToFile(hops, delay);
+                        m_received++;
+                        CompleteExchange(coaptag.GetSeq());
+                    }
+                } else if (m_PenSeqSet.find(coaptag.GetReq()) != m_PenSeqSet.end()) { //Check whether this packet was requested by this client application.
                     Time e2edelay = Simulator::Now() - coaptag.GetTs();
                     int64_t delay = e2edelay.GetMilliSeconds();
                     int hops;
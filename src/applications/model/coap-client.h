@@ -33,7 +33,9 @@
 #include "ns3/callback.h"
 #include "ns3/uinteger.h"
 #include "ns3/double.h"
-#include "ns3/random-variable-stream.h"
+#include "ns3/coap-content-directory.h"
+#include <deque>
+#include <map>
 
 namespace ns3 {
 
@@ -45,6 +47,13 @@ namespace ns3 {
      * \brief A Udp Echo client
      *
      * Every packet sent should be returned by the server and received here.
+     *
+     * With CongestionControl, requests are confirmable and follow CoCoA
+     * (draft-ietf-core-cocoa): at most NStart exchanges are outstanding per
+     * server, further requests wait in a backlog, and requests are
+     * retransmitted up to MaxRetransmit times on a timeout drawn from the
+     * per-server RTO, which blends strong (no retransmission) and weak (one or
+     * two retransmissions) RTT estimates and ages towards 1-3 s when unused.
      */
     class CoapClient : public Application {
     public:
@@ -150,10 +159,36 @@ namespace ns3 {
         uint32_t GetRngStream() const;
         void SetIPv6Bucket(std::vector<Ipv6Address> bucket);
 
+        /**
+         * \brief Set the directory resolving the requested contents
+         * \param directory the directory, shared with the other clients of the domain
+         */
+        void SetContentDirectory(Ptr<CoapContentDirectory> directory);
 
         uint32_t
         GetNextSeq();
 
+        /**
+         * \brief Assign a fixed random variable stream number to the random variables
+         * used by this model: the content selection (also set by the RngStream
+         * attribute) and the CoCoA timeout dithering.
+         *
+         * \param stream first stream index to use
+         * \return the number of stream indices assigned by this model
+         */
+        int64_t AssignStreams(int64_t stream);
+
+        /**
+         * \param server the address of a server
+         * \return the CoCoA RTO of the server, zero before the first exchange with it
+         */
+        Time GetRto(Ipv6Address server) const;
+
+        /**
+         * \return the number of requests retransmitted with CongestionControl
+         */
+        uint32_t GetRetransmitted(void) const;
+
     protected:
         virtual void DoDispose(void);
 
@@ -172,6 +207,53 @@ namespace ns3 {
          */
         void Send(void);
 
+        /**
+         * \brief Build a request and send it to its server
+         * \param req the requested content
+         * \param seq the sequence number, message ID of the exchange with CoCoA
+         */
+        void Transmit(uint32_t req, uint32_t seq);
+
+        /**
+         * \param req the requested content
+         * \return the address requests for the content are sent to
+         */
+        Ipv6Address GetServer(uint32_t req) const;
+
+        /**
+         * \param req the requested content
+         * \return the port requests for the content are sent to
+         */
+        uint16_t GetServerPort(uint32_t req) const;
+
+        /**
+         * \brief Start a CoCoA exchange, or queue it while its server has NStart
+         * exchanges outstanding
+         * \param req the requested content
+         * \param seq the message ID
+         */
+        void StartExchange(uint32_t req, uint32_t seq);
+
+        /**
+         * \brief Send the first request of a CoCoA exchange
+         * \param server the server
+         * \param req the requested content
+         * \param seq the message ID
+         */
+        void BeginExchange(Ipv6Address server, uint32_t req, uint32_t seq);
+
+        /**
+         * \brief Retransmit the request of an exchange, or give it up
+         * \param seq the message ID
+         */
+        void ExchangeTimeout(uint32_t seq);
+
+        /**
+         * \brief End an exchange and begin the next one queued for its server
+         * \param seq the message ID
+         */
+        void CompleteExchange(uint32_t seq);
+
         /**
          * \brief Handle a packet reception.
          *
@@ -220,11 +302,64 @@ namespace ns3 {
         double m_q; // q in (k+q)^s
         double m_s; // s in (k+q)^s
         std::vector<double> m_Pcum; // cumulative probability
-        std::vector<Ipv6Address> m_IPv6Bucket;
+        Ptr<CoapContentDirectory> m_directory; //!< Producer of every content
+        Ipv6Address m_proxy; //!< Server of all the requests, any to resolve them in the directory
         Ptr<UniformRandomVariable> m_seqRng; // RNG
         std::set<uint32_t> m_PenSeqSet; //Pending sequences 
         Ipv6Address m_ownip;
         bool iamgtw = false;
+
+        /**
+         * \brief RTT estimator of CoCoA (RFC 6298 with its own K)
+         */
+        struct RttEstimate {
+            bool valid; //!< An RTT has been measured
+            double srtt; //!< Smoothed RTT, in seconds
+            double rttvar; //!< RTT variation, in seconds
+        };
+
+        /**
+         * \brief CoCoA state of a server
+         */
+        struct Server {
+            uint32_t outstanding; //!< Exchanges outstanding
+            std::deque<std::pair<uint32_t, uint32_t> > backlog; //!< Queued content and message ID
+            RttEstimate strong; //!< Estimator fed by exchanges without retransmission
+            RttEstimate weak; //!< Estimator fed by exchanges with one or two retransmissions
+            double rto; //!< Overall RTO, in seconds
+            Time rtoUpdated; //!< Time of the last RTO update
+        };
+
+        /**
+         * \brief An outstanding CoCoA exchange
+         */
+        struct Exchange {
+            Ipv6Address server; //!< Server of the exchange
+            uint32_t req; //!< Requested content
+            uint32_t retx; //!< Retransmissions
+            Time firstSent; //!< Time of the first request
+            double timeout; //!< Current timeout, in seconds
+            double backoff; //!< Variable backoff factor
+            EventId timer; //!< Retransmission timer
+        };
+
+        /**
+         * \brief Feed an RTT measurement to the estimators of a server
+         * \param server the server
+         * \param rtt the RTT, from the first request of the exchange
+         * \param strong whether the exchange had no retransmission
+         */
+        void UpdateRto(Server &server, Time rtt, bool strong);
+
+        bool m_cocoa; //!< CoCoA congestion control
+        uint32_t m_nstart; //!< Exchanges outstanding per server
+        uint32_t m_maxRetransmit; //!< Retransmissions before giving up an exchange
+        uint32_t m_maxBacklog; //!< Requests queued per server
+        std::map<Ipv6Address, Server> m_servers; //!< CoCoA state, by server
+        std::map<uint32_t, Exchange> m_exchanges; //!< Outstanding exchanges, by message ID
+        Ptr<UniformRandomVariable> m_timeoutRng; //!< Initial timeout dithering
+        uint32_t m_retransmitted; //!< Counter for retransmitted requests
+        uint32_t m_dropped; //!< Counter for requests given up or dropped from a full backlog
     };
 
 } // namespace ns3
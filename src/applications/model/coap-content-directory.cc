@@ -0,0 +1,84 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "coap-content-directory.h"
+
+#include <algorithm>
+
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+    NS_LOG_COMPONENT_DEFINE("CoapContentDirectory");
+
+    CoapContentDirectory::CoapContentDirectory() {
+        NS_LOG_FUNCTION(this);
+    }
+
+    uint32_t
+    CoapContentDirectory::Add(Ipv6Address address, uint16_t port) {
+        NS_LOG_FUNCTION(this << address << port);
+        uint32_t id = m_entries.size();
+        Entry entry;
+        entry.address = address;
+        entry.port = port;
+        entry.path = GetPath(id);
+        m_entries.push_back(entry);
+        return id;
+    }
+
+    void
+    CoapContentDirectory::Assign(const std::vector<Ipv6Address> &producers, uint32_t nContents, uint16_t port,
+            Ptr<UniformRandomVariable> rng) {
+        NS_LOG_FUNCTION(this << producers.size() << nContents << port);
+        NS_ASSERT_MSG(!producers.empty() || nContents == 0, "Contents without producers");
+
+        m_entries.clear();
+        m_entries.reserve(nContents);
+        for (uint32_t id = 0; id < nContents; id++) {
+            Add(producers[id % producers.size()], port);
+        }
+        // the paths stay with the ids, only the producers are permuted
+        for (uint32_t i = nContents; i > 1; i--) {
+            uint32_t j = rng->GetInteger(0, i - 1);
+            std::swap(m_entries[i - 1].address, m_entries[j].address);
+        }
+        NS_LOG_DEBUG("Assigned " << nContents << " contents to " << producers.size() << " producers");
+    }
+
+    uint32_t
+    CoapContentDirectory::GetN(void) const {
+        return m_entries.size();
+    }
+
+    uint32_t
+    CoapContentDirectory::CountContents(Ipv6Address address) const {
+        uint32_t n = 0;
+        for (std::vector<Entry>::const_iterator i = m_entries.begin(); i != m_entries.end(); ++i) {
+            if (i->address == address) {
+                n++;
+            }
+        }
+        return n;
+    }
+
+    std::string
+    CoapContentDirectory::GetPath(uint32_t id) {
+        return "Sensordata/" + std::to_string(id);
+    }
+
+} // namespace ns3
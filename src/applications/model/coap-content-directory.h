@@ -0,0 +1,113 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef COAP_CONTENT_DIRECTORY_H
+#define COAP_CONTENT_DIRECTORY_H
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "ns3/ipv6-address.h"
+#include "ns3/ptr.h"
+#include "ns3/random-variable-stream.h"
+#include "ns3/simple-ref-count.h"
+
+namespace ns3 {
+
+    /**
+     * \ingroup coap
+     * \brief The producer of every content of a domain.
+     *
+     * Content ids are 0 to GetN() - 1 and resolve in constant time to the
+     * address, port and path of their producer. A producer may serve any
+     * number of contents. One directory is shared by the servers, gateway
+     * caches and clients of a domain:
+     *
+     *     Ptr<CoapContentDirectory> directory = Create<CoapContentDirectory> ();
+     *     directory->Assign(producers, nContents, 9, rng);
+     *     serverHelper.SetContentDirectory(serverApp, directory);
+     *     clientHelper.SetContentDirectory(clientApp, directory);
+     */
+    class CoapContentDirectory : public SimpleRefCount<CoapContentDirectory> {
+    public:
+
+        /**
+         * \brief Where a content is served
+         */
+        struct Entry {
+            Ipv6Address address; //!< Address of the producer
+            uint16_t port; //!< Port of the CoAP server of the producer
+            std::string path; //!< URI path requested from the producer
+        };
+
+        CoapContentDirectory();
+
+        /**
+         * \brief Add a content at the end of the directory
+         * \param address the address of its producer
+         * \param port the port of the CoAP server of its producer
+         * \returns the id of the content
+         */
+        uint32_t Add(Ipv6Address address, uint16_t port);
+
+        /**
+         * \brief Replace the directory with \p nContents contents spread over
+         * the producers, at most one apart, in a random order
+         *
+         * The contents are dealt round-robin then permuted with a single
+         * Fisher-Yates pass, in O(nContents).
+         *
+         * \param producers the addresses of the producers
+         * \param nContents the number of contents
+         * \param port the port of the CoAP servers of the producers
+         * \param rng the random variable drawing the permutation
+         */
+        void Assign(const std::vector<Ipv6Address> &producers, uint32_t nContents, uint16_t port,
+                Ptr<UniformRandomVariable> rng);
+
+        /**
+         * \returns the number of contents
+         */
+        uint32_t GetN(void) const;
+
+        /**
+         * \param id the id of a content, lower than GetN()
+         * \returns where the content is served
+         */
+        const Entry &Resolve(uint32_t id) const {
+            return m_entries[id];
+        }
+
+        /**
+         * \param address the address of a producer
+         * \returns the number of contents served at \p address, in O(GetN())
+         */
+        uint32_t CountContents(Ipv6Address address) const;
+
+        /**
+         * \param id the id of a content
+         * \returns the path requesting the content, "Sensordata/<id>"
+         */
+        static std::string GetPath(uint32_t id);
+
+    private:
+        std::vector<Entry> m_entries; //!< The contents, by id
+    };
+
+} // namespace ns3
+
+#endif /* COAP_CONTENT_DIRECTORY_H */
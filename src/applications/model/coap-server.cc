@@ -85,9 +85,17 @@ namespace ns3 {
 
     void
     CoapServer::SetIPv6Bucket(std::vector<Ipv6Address> bucket) {
-        m_IPv6Bucket = std::vector<Ipv6Address> (bucket.size() + 1);
-        m_IPv6Bucket = bucket;
+        // content i is served at bucket[i]
+        Ptr<CoapContentDirectory> directory = Create<CoapContentDirectory> ();
+        for (std::vector<Ipv6Address>::const_iterator it = bucket.begin(); it != bucket.end(); ++it) {
+            directory->Add(*it, m_port);
+        }
+        SetContentDirectory(directory);
+    }
 
+    void
+    CoapServer::SetContentDirectory(Ptr<CoapContentDirectory> directory) {
+        m_directory = directory;
     }
 
     void
@@ -96,21 +104,6 @@ namespace ns3 {
         Application::DoDispose();
     }
 
-    void
-    CoapServer::AddSeq() {
-
-        //This function reads in the AddrResBucket and searches for its own producer IP. Corresponding sequences are copied into m_regSeqSet-set.
-
-        for (unsigned int idx = 0; idx < m_IPv6Bucket.size(); idx++) {
-            //NS_LOG_INFO("AddSeq: " << idx << " of " << m_ownip);
-            NS_LOG_INFO("m_IPv6Bucket[idx] == m_ownip? " << m_IPv6Bucket[idx] << " " << m_ownip << " --> " << (m_IPv6Bucket[idx] == m_ownip));
-            if (m_IPv6Bucket[idx] == m_ownip) {
-                m_regSeqSet.insert(idx);
-                NS_LOG_INFO("AddSeq: Adding seq " << idx << "To collection of " << m_ownip<< ". At node: "<< GetNode()->GetId());
-            }
-        }
-    }
-
     uint32_t
     CoapServer::FilterReqNum(uint32_t size) {
 
@@ -125,10 +118,7 @@ namespace ns3 {
 
     bool
     CoapServer::CheckReqAv(uint32_t reqnumber) {
-        if (m_regSeqSet.find(reqnumber) != m_regSeqSet.end()) {
-            return true;
-        }
-        return false;
+        return m_directory && reqnumber < m_directory->GetN() && m_directory->Resolve(reqnumber).address == m_ownip;
     }
 
     void
@@ -150,7 +140,6 @@ namespace ns3 {
         Ptr<Ipv6> ipv6 = PtrNode->GetObject<Ipv6> ();
         Ipv6InterfaceAddress ownaddr = ipv6->GetAddress(1, 1);
         m_ownip = ownaddr.GetAddress();
-        AddSeq();
 
         if (m_socket == 0) {
             TypeId tid = TypeId::LookupByName("ns3::UdpSocketFactory");
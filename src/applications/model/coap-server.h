@@ -27,6 +27,7 @@
 #include "ns3/callback.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/traced-callback.h"
+#include "ns3/coap-content-directory.h"
 
 namespace ns3 {
 
@@ -65,6 +66,11 @@ namespace ns3 {
 
         void SetIPv6Bucket(std::vector<Ipv6Address> bucket);
 
+        /**
+         * \brief Set the directory of the contents, the server serves those at its address
+         * \param directory the directory, shared with the other applications of the domain
+         */
+        void SetContentDirectory(Ptr<CoapContentDirectory> directory);
 
         CoapServer();
         virtual ~CoapServer();
@@ -76,7 +82,6 @@ namespace ns3 {
 
         virtual void StartApplication(void);
         virtual void StopApplication(void);
-        void AddSeq();
 
         /**
          * \brief Handle a packet reception.
@@ -111,10 +116,7 @@ namespace ns3 {
         TracedCallback<Ptr<const Packet> > m_txTrace;
         uint32_t m_RdataSize; //!< packet payload size (must be equal to m_size)
         uint8_t *m_Rdata; //!< packet payload data
-        //        uint32_t *m_regSeq; //!< Available sequence numbers.
-        //        uint32_t m_regNum; //!< Available sequence numbers.
-        std::set<uint32_t> m_regSeqSet;
-        std::vector<Ipv6Address> m_IPv6Bucket;
+        Ptr<CoapContentDirectory> m_directory; //!< Producer of every content
         Ipv6Address m_ownip;
     };
 
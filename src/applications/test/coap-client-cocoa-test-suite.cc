@@ -0,0 +1,271 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include "ns3/error-model.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/simple-channel.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv6-address-helper.h"
+#include "ns3/coap-helper.h"
+#include "ns3/coap-client.h"
+#include "ns3/coap-packet-tag.h"
+
+#include <cmath>
+#include <map>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \brief Drops the first transmissions of every CoAP request
+ */
+class CoapRequestErrorModel : public ErrorModel {
+public:
+    /**
+     * \param drops the number of transmissions dropped per request
+     */
+    CoapRequestErrorModel(uint32_t drops);
+
+private:
+    virtual bool DoCorrupt(Ptr<Packet> p);
+    virtual void DoReset(void);
+
+    uint32_t m_drops; //!< Transmissions dropped per request
+    std::map<uint32_t, uint32_t> m_received; //!< Transmissions received, by message ID
+};
+
+CoapRequestErrorModel::CoapRequestErrorModel(uint32_t drops)
+: m_drops(drops) {
+}
+
+bool
+CoapRequestErrorModel::DoCorrupt(Ptr<Packet> p) {
+    CoapPacketTag coaptag;
+    if (!p->PeekPacketTag(coaptag)) {
+        return false;
+    }
+    return ++m_received[coaptag.GetSeq()] <= m_drops;
+}
+
+void
+CoapRequestErrorModel::DoReset(void) {
+    m_received.clear();
+}
+
+/**
+ * \brief A CoCoA client and a CoAP server on a link dropping the first
+ * transmissions of every request
+ */
+class CoapClientCocoaTestCase : public TestCase {
+public:
+    /**
+     * \param name the name of the test case
+     * \param drops the number of transmissions dropped per request
+     */
+    CoapClientCocoaTestCase(std::string name, uint32_t drops);
+
+protected:
+    /**
+     * \brief Build the link, run the exchanges and record the transmissions
+     * \param nRequests the number of requests
+     * \param interval the time between requests
+     */
+    void Run(uint32_t nRequests, Time interval);
+
+    /**
+     * \brief Record a transmission of the client
+     * \param p the request
+     */
+    void Tx(Ptr<const Packet> p);
+
+    /**
+     * \brief Record the RTO of the server before the client stops
+     */
+    void SampleRto(void);
+
+    uint32_t m_drops; //!< Transmissions dropped per request
+    std::map<uint32_t, std::vector<Time> > m_txTimes; //!< Transmission times, by message ID
+    Ptr<CoapClient> m_client; //!< The client
+    Ipv6Address m_server; //!< Address of the server
+    Time m_rto; //!< RTO of the server after the last exchange
+    uint32_t m_retransmitted; //!< Retransmissions of the client
+};
+
+CoapClientCocoaTestCase::CoapClientCocoaTestCase(std::string name, uint32_t drops)
+: TestCase(name)
+, m_drops(drops)
+, m_retransmitted(0) {
+}
+
+void
+CoapClientCocoaTestCase::Tx(Ptr<const Packet> p) {
+    CoapPacketTag coaptag;
+    if (p->PeekPacketTag(coaptag)) {
+        m_txTimes[coaptag.GetSeq()].push_back(Simulator::Now());
+    }
+}
+
+void
+CoapClientCocoaTestCase::SampleRto(void) {
+    m_rto = m_client->GetRto(m_server);
+    m_retransmitted = m_client->GetRetransmitted();
+}
+
+void
+CoapClientCocoaTestCase::Run(uint32_t nRequests, Time interval) {
+    NodeContainer nodes;
+    nodes.Create(2);
+
+    Ptr<SimpleChannel> channel = CreateObject<SimpleChannel> ();
+    channel->SetAttribute("Delay", TimeValue(MilliSeconds(10)));
+    NetDeviceContainer devices;
+    for (uint32_t i = 0; i < 2; i++) {
+        Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice> ();
+        device->SetAddress(Mac48Address::Allocate());
+        device->SetChannel(channel);
+        nodes.Get(i)->AddDevice(device);
+        devices.Add(device);
+    }
+    DynamicCast<SimpleNetDevice> (devices.Get(1))->SetReceiveErrorModel(Create<CoapRequestErrorModel> (m_drops));
+
+    InternetStackHelper internet;
+    internet.Install(nodes);
+    Ipv6AddressHelper ipv6;
+    ipv6.SetBase(Ipv6Address("2001:1::"), Ipv6Prefix(64));
+    Ipv6InterfaceContainer interfaces = ipv6.Assign(devices);
+    m_server = interfaces.GetAddress(1, 1);
+
+    Ptr<CoapContentDirectory> directory = Create<CoapContentDirectory> ();
+    directory->Add(m_server, 5683);
+
+    CoapServerHelper server(5683);
+    ApplicationContainer serverApps = server.Install(nodes.Get(1));
+    server.SetContentDirectory(serverApps.Get(0), directory);
+
+    CoapClientHelper client(5683);
+    client.SetAttribute("MaxPackets", UintegerValue(nRequests));
+    client.SetAttribute("Interval", TimeValue(interval));
+    client.SetAttribute("NumberOfContents", UintegerValue(1));
+    client.SetAttribute("CongestionControl", BooleanValue(true));
+    ApplicationContainer clientApps = client.Install(nodes.Get(0));
+    client.SetContentDirectory(clientApps.Get(0), directory);
+    client.AssignStreams(nodes, 1);
+    clientApps.Start(Seconds(2));
+
+    m_client = DynamicCast<CoapClient> (clientApps.Get(0));
+    m_client->TraceConnectWithoutContext("Tx", MakeCallback(&CoapClientCocoaTestCase::Tx, this));
+    Time end = Seconds(2) + interval * nRequests;
+    Simulator::Schedule(end - MilliSeconds(1), &CoapClientCocoaTestCase::SampleRto, this);
+
+    Simulator::Stop(end);
+    Simulator::Run();
+    Simulator::Destroy();
+    m_client = 0;
+}
+
+/**
+ * \brief On a lossless link, strong RTT samples pull the RTO below its initial 2 s
+ */
+class CoapClientCocoaRtoTestCase : public CoapClientCocoaTestCase {
+public:
+    CoapClientCocoaRtoTestCase();
+    virtual void DoRun(void);
+};
+
+CoapClientCocoaRtoTestCase::CoapClientCocoaRtoTestCase()
+: CoapClientCocoaTestCase("CoCoA RTO follows the strong RTT estimate", 0) {
+}
+
+void
+CoapClientCocoaRtoTestCase::DoRun(void) {
+    // requests close enough for the RTO not to age between them
+    Run(10, MilliSeconds(200));
+
+    NS_TEST_ASSERT_MSG_EQ(m_txTimes.size(), 10, "requests");
+    NS_TEST_EXPECT_MSG_EQ(m_retransmitted, 0, "retransmissions on a lossless link");
+    for (std::map<uint32_t, std::vector<Time> >::const_iterator it = m_txTimes.begin(); it != m_txTimes.end(); ++it) {
+        NS_TEST_EXPECT_MSG_EQ(it->second.size(), 1, "transmissions of request " << it->first);
+    }
+    // the RTT is 20 ms, 40 ms for the first request which waits for neighbor
+    // discovery: 10 strong samples bring the RTO from 2 s down to 76 ms
+    NS_TEST_EXPECT_MSG_GT(m_rto, MilliSeconds(20), "RTO");
+    NS_TEST_EXPECT_MSG_LT(m_rto, MilliSeconds(100), "RTO");
+}
+
+/**
+ * \brief On a link losing the first two transmissions of every request, the
+ * timeouts back off and weak RTT samples raise the RTO
+ */
+class CoapClientCocoaBackoffTestCase : public CoapClientCocoaTestCase {
+public:
+    CoapClientCocoaBackoffTestCase();
+    virtual void DoRun(void);
+};
+
+CoapClientCocoaBackoffTestCase::CoapClientCocoaBackoffTestCase()
+: CoapClientCocoaTestCase("CoCoA backs off on a lossy link", 2) {
+}
+
+void
+CoapClientCocoaBackoffTestCase::DoRun(void) {
+    // each exchange takes two timeouts and their backoff, up to 25 s at the largest RTO
+    Run(3, Seconds(30));
+
+    NS_TEST_ASSERT_MSG_EQ(m_txTimes.size(), 3, "requests");
+    NS_TEST_EXPECT_MSG_EQ(m_retransmitted, 6, "retransmissions");
+
+    for (std::map<uint32_t, std::vector<Time> >::const_iterator it = m_txTimes.begin(); it != m_txTimes.end(); ++it) {
+        const std::vector<Time> &times = it->second;
+        NS_TEST_EXPECT_MSG_EQ(times.size(), 3, "transmissions of request " << it->first);
+        if (times.size() != 3) {
+            continue;
+        }
+        double first = (times[1] - times[0]).GetSeconds();
+        double second = (times[2] - times[1]).GetSeconds();
+        if (it == m_txTimes.begin()) {
+            // initial RTO of 2 s, dithered up to 1.5 times, then doubled
+            NS_TEST_EXPECT_MSG_GT_OR_EQ(first, 2.0, "first timeout");
+            NS_TEST_EXPECT_MSG_LT_OR_EQ(first, 3.0, "first timeout");
+            NS_TEST_EXPECT_MSG_EQ_TOL(second, 2.0 * first, 1e-9, "backoff of the first request");
+        } else {
+            // the factor follows the RTO of the server: 3, 2 or 1.5
+            double backoff = second / first;
+            bool variable = std::fabs(backoff - 3.0) < 1e-9 || std::fabs(backoff - 2.0) < 1e-9 || std::fabs(backoff - 1.5) < 1e-9;
+            NS_TEST_EXPECT_MSG_EQ(variable, true, "backoff of request " << it->first << ": " << backoff);
+        }
+    }
+    NS_TEST_EXPECT_MSG_GT(m_rto, Seconds(2), "weak RTT samples raise the RTO");
+}
+
+/**
+ * \brief CoapClient CoCoA test suite
+ */
+class CoapClientCocoaTestSuite : public TestSuite {
+public:
+    CoapClientCocoaTestSuite();
+};
+
+CoapClientCocoaTestSuite::CoapClientCocoaTestSuite()
+: TestSuite("coap-client-cocoa", UNIT) {
+    AddTestCase(new CoapClientCocoaRtoTestCase, TestCase::QUICK);
+    AddTestCase(new CoapClientCocoaBackoffTestCase, TestCase::QUICK);
+}
+
+static CoapClientCocoaTestSuite g_coapClientCocoaTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/coap-content-directory.h"
+
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \brief Contents added one by one resolve to their producer
+ */
+class CoapContentDirectoryAddTestCase : public TestCase {
+public:
+    CoapContentDirectoryAddTestCase();
+    virtual void DoRun(void);
+};
+
+CoapContentDirectoryAddTestCase::CoapContentDirectoryAddTestCase()
+: TestCase("Added contents resolve to their producer") {
+}
+
+void
+CoapContentDirectoryAddTestCase::DoRun(void) {
+    Ptr<CoapContentDirectory> directory = Create<CoapContentDirectory> ();
+    NS_TEST_ASSERT_MSG_EQ(directory->GetN(), 0, "new directory not empty");
+
+    Ipv6Address first("2001:1::1");
+    Ipv6Address second("2001:1::2");
+    NS_TEST_EXPECT_MSG_EQ(directory->Add(first, 9), 0, "id of the first content");
+    NS_TEST_EXPECT_MSG_EQ(directory->Add(second, 5683), 1, "id of the second content");
+    NS_TEST_EXPECT_MSG_EQ(directory->Add(first, 9), 2, "id of the third content");
+    NS_TEST_ASSERT_MSG_EQ(directory->GetN(), 3, "number of contents");
+
+    NS_TEST_EXPECT_MSG_EQ(directory->Resolve(1).address, second, "producer of content 1");
+    NS_TEST_EXPECT_MSG_EQ(directory->Resolve(1).port, 5683, "port of content 1");
+    NS_TEST_EXPECT_MSG_EQ(directory->Resolve(2).path, "Sensordata/2", "path of content 2");
+    NS_TEST_EXPECT_MSG_EQ(directory->CountContents(first), 2, "contents of the first producer");
+    NS_TEST_EXPECT_MSG_EQ(directory->CountContents(Ipv6Address("2001:1::3")), 0, "contents of an unknown address");
+}
+
+/**
+ * \brief Assign() spreads the contents evenly and in a random order
+ */
+class CoapContentDirectoryAssignTestCase : public TestCase {
+public:
+    CoapContentDirectoryAssignTestCase();
+    virtual void DoRun(void);
+};
+
+CoapContentDirectoryAssignTestCase::CoapContentDirectoryAssignTestCase()
+: TestCase("Assigned contents are spread over the producers") {
+}
+
+void
+CoapContentDirectoryAssignTestCase::DoRun(void) {
+    std::vector<Ipv6Address> producers;
+    for (uint32_t i = 1; i <= 7; i++) {
+        std::ostringstream address;
+        address << "2001:1::" << i;
+        producers.push_back(Ipv6Address(address.str().c_str()));
+    }
+    Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+    rng->SetStream(6);
+
+    Ptr<CoapContentDirectory> directory = Create<CoapContentDirectory> ();
+    directory->Add(producers[0], 9);
+    directory->Assign(producers, 1000, 5683, rng);
+    NS_TEST_ASSERT_MSG_EQ(directory->GetN(), 1000, "Assign() does not replace the directory");
+
+    // 1000 = 7 * 142 + 6
+    for (std::vector<Ipv6Address>::const_iterator producer = producers.begin(); producer != producers.end(); ++producer) {
+        uint32_t n = directory->CountContents(*producer);
+        NS_TEST_EXPECT_MSG_EQ((n == 142 || n == 143), true, "contents of " << *producer << ": " << n);
+    }
+
+    uint32_t roundRobin = 0;
+    for (uint32_t id = 0; id < directory->GetN(); id++) {
+        NS_TEST_EXPECT_MSG_EQ(directory->Resolve(id).port, 5683, "port of content " << id);
+        NS_TEST_EXPECT_MSG_EQ(directory->Resolve(id).path, CoapContentDirectory::GetPath(id), "path of content " << id);
+        if (directory->Resolve(id).address == producers[id % producers.size()]) {
+            roundRobin++;
+        }
+    }
+    NS_TEST_EXPECT_MSG_LT(roundRobin, 500, "the contents are not shuffled");
+}
+
+/**
+ * \brief CoapContentDirectory test suite
+ */
+class CoapContentDirectoryTestSuite : public TestSuite {
+public:
+    CoapContentDirectoryTestSuite();
+};
+
+CoapContentDirectoryTestSuite::CoapContentDirectoryTestSuite()
+: TestSuite("coap-content-directory", UNIT) {
+    AddTestCase(new CoapContentDirectoryAddTestCase, TestCase::QUICK);
+    AddTestCase(new CoapContentDirectoryAssignTestCase, TestCase::QUICK);
+}
+
+static CoapContentDirectoryTestSuite g_coapContentDirectoryTestSuite; //!< Static variable for test initialization
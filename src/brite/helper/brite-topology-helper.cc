@@ -24,11 +24,21 @@
 #include "ns3/random-variable-stream.h"
 #include "ns3/data-rate.h"
 #include "ns3/rng-seed-manager.h"
+#include "ns3/hash.h"
 
 #include "brite-topology-helper.h"
 
 #include <iostream>
 #include <fstream>
+#include <algorithm>
+#include <map>
+#include <limits>
+#include <sstream>
+#include <iomanip>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
 
 namespace ns3 {
 
@@ -43,7 +53,9 @@ namespace ns3 {
     m_numAs(0),
     m_topology(NULL),
     m_numNodes(0),
-    m_numEdges(0) {
+    m_numEdges(0),
+    m_numCutEdges(0),
+    m_lookahead(Time::Max()) {
         NS_LOG_FUNCTION(this);
 
         m_uv = CreateObject<UniformRandomVariable> ();
@@ -55,7 +67,9 @@ namespace ns3 {
     m_numAs(0),
     m_topology(NULL),
     m_numNodes(0),
-    m_numEdges(0) {
+    m_numEdges(0),
+    m_numCutEdges(0),
+    m_lookahead(Time::Max()) {
         NS_LOG_FUNCTION(this);
 
         m_uv = CreateObject<UniformRandomVariable> ();
@@ -326,12 +340,56 @@ namespace ns3 {
     void BriteTopologyHelper::GenerateBriteTopology(void) {
         NS_ASSERT_MSG(m_topology == NULL, "Brite Topology Already Created");
 
+        //the topology has been read by ReadAnnotatedTopology
+        if (!m_briteNodeInfoList.empty()) {
+            return;
+        }
+
         //check to see if need to generate seed file
         bool generateSeedFile = m_seedFile.empty();
 
+        std::ostringstream seeds;
         if (generateSeedFile) {
             NS_LOG_LOGIC("Generating BRITE Seed file");
 
+            //Generate seed file expected by BRITE
+            //need unsigned shorts 0-65535
+            seeds << "PLACES " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535) << std::endl;
+            seeds << "CONNECT " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535) << std::endl;
+            seeds << "EDGE_CONN " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535) << std::endl;
+            seeds << "GROUPING " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535) << std::endl;
+            seeds << "ASSIGNMENT " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535) << std::endl;
+            seeds << "BANDWIDTH " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535) << std::endl;
+        } else if (!m_cacheDirectory.empty()) {
+            std::ifstream seedFile(m_seedFile.c_str());
+            NS_ABORT_MSG_IF(!seedFile.good(), "Cannot read BRITE seed file " << m_seedFile);
+            seeds << seedFile.rdbuf();
+        }
+
+        //the topology only depends on the configuration and the seed values
+        std::string cacheFile;
+        if (!m_cacheDirectory.empty()) {
+            std::ifstream conf(m_confFile.c_str());
+            NS_ABORT_MSG_IF(!conf.good(), "Cannot read BRITE configuration file " << m_confFile);
+            std::ostringstream key;
+            key << conf.rdbuf() << seeds.str();
+            std::ostringstream name;
+            name << m_cacheDirectory << "/brite-" << std::hex << std::setw(16) << std::setfill('0')
+                    << Hash64(key.str()) << ".cache";
+            cacheFile = name.str();
+
+            std::string newSeeds;
+            if (ReadCache(cacheFile, newSeeds)) {
+                NS_LOG_INFO("BRITE topology read from " << cacheFile);
+                if (!generateSeedFile && !newSeeds.empty()) {
+                    std::ofstream newSeedFile(m_newSeedFile.c_str(), std::ios_base::out | std::ios_base::trunc);
+                    newSeedFile << newSeeds;
+                }
+                return;
+            }
+        }
+
+        if (generateSeedFile) {
             std::ofstream seedFile;
 
             //overwrite file if already there
@@ -340,14 +398,7 @@ namespace ns3 {
             //verify open
             NS_ASSERT(!seedFile.fail());
 
-            //Generate seed file expected by BRITE
-            //need unsigned shorts 0-65535
-            seedFile << "PLACES " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535) << std::endl;
-            seedFile << "CONNECT " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535) << std::endl;
-            seedFile << "EDGE_CONN " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535) << std::endl;
-            seedFile << "GROUPING " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535) << std::endl;
-            seedFile << "ASSIGNMENT " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535) << std::endl;
-            seedFile << "BANDWIDTH " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535) << " " << m_uv->GetInteger(0, 65535) << std::endl;
+            seedFile << seeds.str();
             seedFile.close();
 
             //if we're using NS3 generated seed files don't want brite to create a new seed file.
@@ -359,6 +410,16 @@ namespace ns3 {
         BuildBriteNodeInfoList();
         BuildBriteEdgeInfoList();
 
+        if (!cacheFile.empty()) {
+            std::ostringstream newSeeds;
+            if (!generateSeedFile) {
+                std::ifstream newSeedFile(m_newSeedFile.c_str());
+                newSeeds << newSeedFile.rdbuf();
+            }
+            WriteCache(cacheFile, newSeeds.str());
+            NS_LOG_INFO("BRITE topology cached in " << cacheFile);
+        }
+
         //brite automatically spits out the seed values used to a seperate file so no need to keep this anymore
         if (generateSeedFile) {
             remove("briteSeedFile.txt");
@@ -366,6 +427,303 @@ namespace ns3 {
 
     }
 
+    void
+    BriteTopologyHelper::SetCacheDirectory(std::string directory) {
+        NS_LOG_FUNCTION(this << directory);
+        m_cacheDirectory = directory;
+    }
+
+    /// First bytes of a cache file, to be changed along with its layout
+    static const char g_briteCacheMagic[8] = {'B', 'R', 'I', 'T', 'E', 'C', '1', '\n'};
+
+    template <typename T>
+    static void
+    WriteCacheValue(std::ostream& os, T value) {
+        os.write(reinterpret_cast<const char *> (&value), sizeof (value));
+    }
+
+    template <typename T>
+    static T
+    ReadCacheValue(std::istream& is) {
+        T value = T();
+        is.read(reinterpret_cast<char *> (&value), sizeof (value));
+        return value;
+    }
+
+    static void
+    WriteCacheString(std::ostream& os, const std::string& value) {
+        WriteCacheValue<uint32_t> (os, value.size());
+        os.write(value.data(), value.size());
+    }
+
+    static std::string
+    ReadCacheString(std::istream& is) {
+        uint32_t size = ReadCacheValue<uint32_t> (is);
+        if (!is.good() || size > (1 << 20)) {
+            is.setstate(std::ios_base::failbit);
+            return std::string();
+        }
+        std::string value(size, '\0');
+        is.read(&value[0], size);
+        return value;
+    }
+
+    bool
+    BriteTopologyHelper::ReadCache(const std::string& file, std::string& newSeeds) {
+        NS_LOG_FUNCTION(this << file);
+        std::ifstream is(file.c_str(), std::ios_base::in | std::ios_base::binary);
+        char magic[sizeof (g_briteCacheMagic)];
+        if (!is.read(magic, sizeof (magic)) || !std::equal(magic, magic + sizeof (magic), g_briteCacheMagic)) {
+            return false;
+        }
+
+        uint32_t numNodes = ReadCacheValue<uint32_t> (is);
+        uint32_t numAs = ReadCacheValue<uint32_t> (is);
+        if (!is.good() || numNodes > (1 << 24)) {
+            return false;
+        }
+        BriteNodeInfoList nodes(numNodes);
+        for (BriteNodeInfoList::iterator it = nodes.begin(); is.good() && it != nodes.end(); ++it) {
+            (*it).nodeId = ReadCacheValue<int32_t> (is);
+            (*it).xCoordinate = ReadCacheValue<double> (is);
+            (*it).yCoordinate = ReadCacheValue<double> (is);
+            (*it).inDegree = ReadCacheValue<int32_t> (is);
+            (*it).outDegree = ReadCacheValue<int32_t> (is);
+            (*it).asId = ReadCacheValue<int32_t> (is);
+            (*it).type = ReadCacheString(is);
+        }
+
+        uint32_t numEdges = is.good() ? ReadCacheValue<uint32_t> (is) : 0;
+        if (!is.good() || numEdges > (1 << 24)) {
+            return false;
+        }
+        BriteEdgeInfoList edges(numEdges);
+        for (BriteEdgeInfoList::iterator it = edges.begin(); is.good() && it != edges.end(); ++it) {
+            (*it).edgeId = ReadCacheValue<int32_t> (is);
+            (*it).srcId = ReadCacheValue<int32_t> (is);
+            (*it).destId = ReadCacheValue<int32_t> (is);
+            (*it).length = ReadCacheValue<double> (is);
+            (*it).delay = ReadCacheValue<double> (is);
+            (*it).bandwidth = ReadCacheValue<double> (is);
+            (*it).asFrom = ReadCacheValue<int32_t> (is);
+            (*it).asTo = ReadCacheValue<int32_t> (is);
+            (*it).type = ReadCacheString(is);
+        }
+        std::string seeds = ReadCacheString(is);
+        if (!is.good()) {
+            NS_LOG_WARN("Ignoring truncated BRITE cache file " << file);
+            return false;
+        }
+
+        m_briteNodeInfoList.swap(nodes);
+        m_briteEdgeInfoList.swap(edges);
+        m_numAs = numAs;
+        newSeeds = seeds;
+        return true;
+    }
+
+    void
+    BriteTopologyHelper::WriteCache(const std::string& file, const std::string& newSeeds) const {
+        NS_LOG_FUNCTION(this << file);
+        //runs of a sweep may share the cache: write aside, then rename over
+        std::ostringstream tmp;
+        tmp << file << "." << getpid() << ".tmp";
+        std::ofstream os(tmp.str().c_str(), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+        if (!os.good()) {
+            NS_LOG_WARN("Cannot write BRITE cache file " << tmp.str());
+            return;
+        }
+
+        os.write(g_briteCacheMagic, sizeof (g_briteCacheMagic));
+        WriteCacheValue<uint32_t> (os, m_briteNodeInfoList.size());
+        WriteCacheValue<uint32_t> (os, m_numAs);
+        for (BriteNodeInfoList::const_iterator it = m_briteNodeInfoList.begin(); it != m_briteNodeInfoList.end(); ++it) {
+            WriteCacheValue<int32_t> (os, (*it).nodeId);
+            WriteCacheValue<double> (os, (*it).xCoordinate);
+            WriteCacheValue<double> (os, (*it).yCoordinate);
+            WriteCacheValue<int32_t> (os, (*it).inDegree);
+            WriteCacheValue<int32_t> (os, (*it).outDegree);
+            WriteCacheValue<int32_t> (os, (*it).asId);
+            WriteCacheString(os, (*it).type);
+        }
+        WriteCacheValue<uint32_t> (os, m_briteEdgeInfoList.size());
+        for (BriteEdgeInfoList::const_iterator it = m_briteEdgeInfoList.begin(); it != m_briteEdgeInfoList.end(); ++it) {
+            WriteCacheValue<int32_t> (os, (*it).edgeId);
+            WriteCacheValue<int32_t> (os, (*it).srcId);
+            WriteCacheValue<int32_t> (os, (*it).destId);
+            WriteCacheValue<double> (os, (*it).length);
+            WriteCacheValue<double> (os, (*it).delay);
+            WriteCacheValue<double> (os, (*it).bandwidth);
+            WriteCacheValue<int32_t> (os, (*it).asFrom);
+            WriteCacheValue<int32_t> (os, (*it).asTo);
+            WriteCacheString(os, (*it).type);
+        }
+        WriteCacheString(os, newSeeds);
+        os.close();
+
+        if (os.fail() || std::rename(tmp.str().c_str(), file.c_str()) != 0) {
+            NS_LOG_WARN("Cannot write BRITE cache file " << file);
+            std::remove(tmp.str().c_str());
+        }
+    }
+
+    /// BRITE node types, as stored in BriteNodeInfo::type
+    static const char *g_briteNodeTypes[] = {
+        "RT_NONE ", "RT_LEAF ", "RT_BORDER", "RT_STUB ", "RT_BACKBONE ",
+        "AS_NONE ", "AS_LEAF ", "AS_STUB ", "AS_BORDER ", "AS_BACKBONE "
+    };
+
+    /**
+     * \param name a BRITE node type without the trailing blank
+     * \returns the type as stored in BriteNodeInfo::type, or an empty string if unknown
+     */
+    static std::string
+    GetBriteNodeType(const std::string& name) {
+        for (uint32_t i = 0; i < sizeof (g_briteNodeTypes) / sizeof (g_briteNodeTypes[0]); ++i) {
+            std::string type = g_briteNodeTypes[i];
+            if (type.substr(0, type.find_last_not_of(' ') + 1) == name) {
+                return type;
+            }
+        }
+        return std::string();
+    }
+
+    void
+    BriteTopologyHelper::ReadAnnotatedTopology(std::string file) {
+        NS_LOG_FUNCTION(this << file);
+        NS_ASSERT_MSG(m_topology == NULL && m_briteNodeInfoList.empty(), "Brite Topology Already Created");
+
+        std::ifstream is(file.c_str());
+        NS_ABORT_MSG_IF(!is.good(), "Cannot read topology file " << file);
+
+        std::map<std::string, int> idForName;
+        std::string line;
+        while (std::getline(is, line) && line != "router") {
+        }
+
+        m_numAs = 0;
+        while (std::getline(is, line) && line != "link") {
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            std::istringstream lineBuffer(line);
+            std::string name, comment;
+            double latitude = 0, longitude = 0;
+            lineBuffer >> name >> comment >> latitude >> longitude;
+            if (name.empty()) {
+                continue;
+            }
+            NS_ABORT_MSG_IF(idForName.count(name), "Router " << name << " listed twice in " << file);
+
+            //the comment holds AS<number>:<type>, as written by WriteAnnotatedTopology
+            BriteNodeInfo nodeInfo;
+            nodeInfo.nodeId = m_briteNodeInfoList.size();
+            nodeInfo.xCoordinate = longitude;
+            nodeInfo.yCoordinate = -latitude;
+            nodeInfo.inDegree = 0;
+            nodeInfo.outDegree = 0;
+            nodeInfo.asId = 0;
+            nodeInfo.type = "RT_NONE ";
+            std::string::size_type colon = comment.find(':');
+            if (comment.compare(0, 2, "AS") == 0 && colon != std::string::npos) {
+                nodeInfo.asId = atoi(comment.substr(2, colon - 2).c_str());
+                std::string type = GetBriteNodeType(comment.substr(colon + 1));
+                if (!type.empty()) {
+                    nodeInfo.type = type;
+                }
+            }
+            m_numAs = std::max(m_numAs, uint32_t(nodeInfo.asId + 1));
+            idForName[name] = nodeInfo.nodeId;
+            m_briteNodeInfoList.push_back(nodeInfo);
+        }
+        NS_ABORT_MSG_IF(m_briteNodeInfoList.empty(), "No router in topology file " << file);
+
+        while (std::getline(is, line)) {
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            std::istringstream lineBuffer(line);
+            std::string from, to, capacity, metric, delay;
+            lineBuffer >> from >> to >> capacity >> metric >> delay;
+            if (from.empty()) {
+                continue;
+            }
+            NS_ABORT_MSG_IF(!idForName.count(from) || !idForName.count(to),
+                    "Link " << from << " - " << to << " between unknown routers in " << file);
+            NS_ABORT_MSG_IF(capacity.empty(), "No bandwidth for link " << from << " - " << to << " in " << file);
+
+            BriteNodeInfo& src = m_briteNodeInfoList[idForName[from]];
+            BriteNodeInfo& dest = m_briteNodeInfoList[idForName[to]];
+            BriteEdgeInfo edgeInfo;
+            edgeInfo.edgeId = m_briteEdgeInfoList.size();
+            edgeInfo.srcId = src.nodeId;
+            edgeInfo.destId = dest.nodeId;
+            edgeInfo.length = std::sqrt(std::pow(src.xCoordinate - dest.xCoordinate, 2) +
+                    std::pow(src.yCoordinate - dest.yCoordinate, 2));
+            //brite delays are in milliseconds and bandwidths in Mbps
+            if (delay.empty()) {
+                edgeInfo.delay = -1;
+            } else if (delay.size() > 2 && delay.compare(delay.size() - 2, 2, "ms") == 0) {
+                edgeInfo.delay = atof(delay.c_str());
+            } else {
+                edgeInfo.delay = Time(delay).GetSeconds() * 1000.0;
+            }
+            if (capacity.size() > 4 && capacity.compare(capacity.size() - 4, 4, "Mbps") == 0) {
+                edgeInfo.bandwidth = atof(capacity.c_str());
+            } else {
+                edgeInfo.bandwidth = double (DataRate(capacity).GetBitRate()) / mbpsToBps;
+            }
+            edgeInfo.asFrom = src.asId;
+            edgeInfo.asTo = dest.asId;
+            edgeInfo.type = src.asId == dest.asId ? "E_RT_STUB " : "E_RT_BORDER ";
+            src.outDegree++;
+            dest.inDegree++;
+            m_briteEdgeInfoList.push_back(edgeInfo);
+        }
+
+        NS_LOG_INFO("Read " << m_briteNodeInfoList.size() << " nodes and " << m_briteEdgeInfoList.size()
+                << " edges in " << m_numAs << " AS from " << file);
+    }
+
+    void
+    BriteTopologyHelper::WriteAnnotatedTopology(std::string file) const {
+        NS_LOG_FUNCTION(this << file);
+        NS_ABORT_MSG_IF(m_briteNodeInfoList.empty(), "The BRITE topology has not been built yet");
+
+        std::ofstream os(file.c_str(), std::ios_base::out | std::ios_base::trunc);
+        NS_ABORT_MSG_IF(!os.good(), "Cannot write topology file " << file);
+        os << std::setprecision(std::numeric_limits<double>::digits10 + 2);
+
+        os << "# BRITE topology: " << m_briteNodeInfoList.size() << " routers, "
+                << m_briteEdgeInfoList.size() << " links, " << m_numAs << " AS\n"
+                << "\n"
+                << "router\n"
+                << "\n"
+                << "# node  AS:type  yPos  xPos  systemId\n";
+        for (BriteNodeInfoList::const_iterator it = m_briteNodeInfoList.begin(); it != m_briteNodeInfoList.end(); ++it) {
+            uint32_t systemId = uint32_t((*it).nodeId) < m_nodes.GetN() ? m_nodes.Get((*it).nodeId)->GetSystemId() : 0;
+            os << "n" << (*it).nodeId << "\t"
+                    << "AS" << (*it).asId << ":" << (*it).type.substr(0, (*it).type.find_last_not_of(' ') + 1) << "\t"
+                    << -(*it).yCoordinate << "\t" << (*it).xCoordinate << "\t" << systemId << "\n";
+        }
+
+        os << "\n"
+                << "link\n"
+                << "\n"
+                << "# srcNode  dstNode  bandwidth  metric  delay\n";
+        for (BriteEdgeInfoList::const_iterator it = m_briteEdgeInfoList.begin(); it != m_briteEdgeInfoList.end(); ++it) {
+            os << "n" << (*it).srcId << "\t" << "n" << (*it).destId << "\t"
+                    << (*it).bandwidth << "Mbps\t" << 1;
+            if ((*it).delay >= 0) {
+                //no exponent, which Time cannot parse
+                std::ostringstream delay;
+                delay << std::fixed << std::setprecision(15) << (*it).delay;
+                os << "\t" << delay.str() << "ms";
+            }
+            os << "\n";
+        }
+    }
+
     NodeContainer BriteTopologyHelper::BuildBriteTopologyNDN() {
         NS_LOG_FUNCTION(this);
 
@@ -460,6 +818,201 @@ namespace ns3 {
         return m_nodes;
     }
 
+    NodeContainer
+    BriteTopologyHelper::BuildBriteTopology2(const uint32_t systemCount, uint32_t attachedNodes) {
+        NS_LOG_FUNCTION(this << systemCount << attachedNodes);
+        NS_ASSERT_MSG(systemCount > 0, "At least one system is needed");
+
+        GenerateBriteTopology();
+
+        uint32_t numLeaves = 0;
+        for (BriteTopologyHelper::BriteNodeInfoList::iterator it = m_briteNodeInfoList.begin(); it != m_briteNodeInfoList.end(); ++it) {
+            if ((*it).type == "RT_LEAF ") {
+                numLeaves++;
+            }
+        }
+        double leafLoad = numLeaves > 0 ? double (attachedNodes) / numLeaves : 0;
+
+        std::vector<uint32_t> systemForNode = PartitionNodes(systemCount, leafLoad);
+        SetPartition(systemForNode, systemCount, leafLoad);
+
+        //create nodes
+        for (BriteTopologyHelper::BriteNodeInfoList::iterator it = m_briteNodeInfoList.begin(); it != m_briteNodeInfoList.end(); ++it) {
+            m_nodes.Add(CreateObject<Node> (systemForNode[(*it).nodeId]));
+            m_numNodes++;
+        }
+
+        NS_LOG_INFO(m_numNodes << " nodes created in BRITE topology on " << systemCount << " systems, "
+                << m_numCutEdges << " links cut, lookahead " << m_lookahead.GetMilliSeconds() << " ms");
+
+        ConstructTopology();
+
+        return m_nodes;
+    }
+
+    std::vector<uint32_t>
+    BriteTopologyHelper::PartitionNodes(uint32_t systemCount, double leafLoad) const {
+        NS_LOG_FUNCTION(this << systemCount << leafLoad);
+        //a link weighs the inverse of its delay: cutting short links shrinks the lookahead
+        static const double minDelay = 0.001;
+        static const uint32_t maxPasses = 16;
+        static const double imbalance = 0.05;
+        static const uint32_t unassigned = std::numeric_limits<uint32_t>::max();
+
+        uint32_t n = m_briteNodeInfoList.size();
+        std::vector<double> load(n, 1.0);
+        double totalLoad = 0;
+        for (BriteTopologyHelper::BriteNodeInfoList::const_iterator it = m_briteNodeInfoList.begin(); it != m_briteNodeInfoList.end(); ++it) {
+            if ((*it).type == "RT_LEAF ") {
+                load[(*it).nodeId] += leafLoad;
+            }
+            totalLoad += load[(*it).nodeId];
+        }
+
+        std::vector<std::vector<std::pair<uint32_t, double> > > links(n);
+        for (BriteTopologyHelper::BriteEdgeInfoList::const_iterator it = m_briteEdgeInfoList.begin(); it != m_briteEdgeInfoList.end(); ++it) {
+            double weight = 1.0 / std::max((*it).delay, minDelay);
+            links[(*it).srcId].push_back(std::make_pair((*it).destId, weight));
+            links[(*it).destId].push_back(std::make_pair((*it).srcId, weight));
+        }
+
+        std::vector<uint32_t> system(n, systemCount == 1 ? 0 : unassigned);
+        if (systemCount == 1) {
+            return system;
+        }
+
+        //grow each system from the first unassigned node, adding the node most strongly linked to it,
+        //up to its share of the load left
+        double target = totalLoad / systemCount;
+        double assignedLoad = 0;
+        std::vector<double> systemLoad(systemCount, 0);
+        uint32_t next = 0;
+        for (uint32_t sys = 0; sys < systemCount; ++sys) {
+            std::map<uint32_t, double> frontier;
+            bool last = sys == systemCount - 1;
+            double share = (totalLoad - assignedLoad) / (systemCount - sys);
+            while (last || systemLoad[sys] < share) {
+                uint32_t node = unassigned;
+                double best = -1;
+                for (std::map<uint32_t, double>::iterator it = frontier.begin(); it != frontier.end(); ++it) {
+                    if (it->second > best) {
+                        best = it->second;
+                        node = it->first;
+                    }
+                }
+                if (node == unassigned) {
+                    //disconnected from the nodes of this system so far, or a new system
+                    while (next < n && system[next] != unassigned) {
+                        ++next;
+                    }
+                    if (next == n) {
+                        break;
+                    }
+                    node = next;
+                }
+                if (!last && systemLoad[sys] > 0 && systemLoad[sys] + load[node] - share > share - systemLoad[sys]) {
+                    break; //closer to the share without it
+                }
+                frontier.erase(node);
+                system[node] = sys;
+                systemLoad[sys] += load[node];
+                assignedLoad += load[node];
+                for (uint32_t i = 0; i < links[node].size(); ++i) {
+                    if (system[links[node][i].first] == unassigned) {
+                        frontier[links[node][i].first] += links[node][i].second;
+                    }
+                }
+            }
+        }
+
+        //refine: move a node to the system it is most strongly linked to, if that lightens the cut
+        //and keeps every system within the imbalance
+        double slack = std::max(target * imbalance, *std::max_element(load.begin(), load.end()));
+        std::vector<double> linkTo(systemCount);
+        for (uint32_t pass = 0; pass < maxPasses; ++pass) {
+            uint32_t moves = 0;
+            for (uint32_t node = 0; node < n; ++node) {
+                std::fill(linkTo.begin(), linkTo.end(), 0);
+                for (uint32_t i = 0; i < links[node].size(); ++i) {
+                    linkTo[system[links[node][i].first]] += links[node][i].second;
+                }
+                uint32_t from = system[node];
+                uint32_t to = from;
+                for (uint32_t sys = 0; sys < systemCount; ++sys) {
+                    if (linkTo[sys] > linkTo[to] && systemLoad[sys] + load[node] <= target + slack) {
+                        to = sys;
+                    }
+                }
+                if (to != from && systemLoad[from] - load[node] >= target - slack) {
+                    system[node] = to;
+                    systemLoad[from] -= load[node];
+                    systemLoad[to] += load[node];
+                    ++moves;
+                }
+            }
+            NS_LOG_LOGIC("Partition refinement pass " << pass << ": " << moves << " nodes moved");
+            if (moves == 0) {
+                break;
+            }
+        }
+        return system;
+    }
+
+    void
+    BriteTopologyHelper::SetPartition(const std::vector<uint32_t>& systemForNode, uint32_t systemCount, double leafLoad) {
+        NS_LOG_FUNCTION(this << systemCount << leafLoad);
+        m_systemLoad.assign(systemCount, 0);
+        m_systemNodes.assign(systemCount, 0);
+        std::vector<std::vector<uint32_t> > asNodes(m_numAs, std::vector<uint32_t> (systemCount, 0));
+        for (BriteTopologyHelper::BriteNodeInfoList::iterator it = m_briteNodeInfoList.begin(); it != m_briteNodeInfoList.end(); ++it) {
+            uint32_t sys = systemForNode[(*it).nodeId];
+            m_systemLoad[sys] += 1.0 + ((*it).type == "RT_LEAF " ? leafLoad : 0);
+            m_systemNodes[sys]++;
+            asNodes[(*it).asId][sys]++;
+        }
+
+        //an AS spread over several systems is reported on the one holding most of its nodes
+        m_systemForAs.clear();
+        for (uint32_t i = 0; i < m_numAs; ++i) {
+            m_systemForAs.push_back(std::max_element(asNodes[i].begin(), asNodes[i].end()) - asNodes[i].begin());
+        }
+
+        m_numCutEdges = 0;
+        m_lookahead = Time::Max();
+        for (BriteTopologyHelper::BriteEdgeInfoList::iterator it = m_briteEdgeInfoList.begin(); it != m_briteEdgeInfoList.end(); ++it) {
+            if (systemForNode[(*it).srcId] != systemForNode[(*it).destId]) {
+                m_numCutEdges++;
+                m_lookahead = std::min(m_lookahead, Seconds((*it).delay / 1000.0));
+            }
+        }
+    }
+
+    Time
+    BriteTopologyHelper::GetLookahead(void) const {
+        return m_lookahead;
+    }
+
+    uint32_t
+    BriteTopologyHelper::GetNCutEdges(void) const {
+        return m_numCutEdges;
+    }
+
+    void
+    BriteTopologyHelper::PrintPartition(std::ostream &os) const {
+        for (uint32_t sys = 0; sys < m_systemLoad.size(); ++sys) {
+            os << "System " << sys << ": " << m_systemNodes[sys] << " nodes, load " << m_systemLoad[sys] << std::endl;
+        }
+        for (uint32_t i = 0; i < m_systemForAs.size(); ++i) {
+            os << "AS " << i << ": system " << m_systemForAs[i] << std::endl;
+        }
+        os << m_numCutEdges << " of " << m_briteEdgeInfoList.size() << " links cut, lookahead ";
+        if (m_numCutEdges > 0) {
+            os << m_lookahead.GetMicroSeconds() / 1000.0 << " ms" << std::endl;
+        } else {
+            os << "unbounded" << std::endl;
+        }
+    }
+
     void
     BriteTopologyHelper::AssignIpv4Addresses(Ipv4AddressHelper & address) {
         NS_LOG_FUNCTION(this);
@@ -21,14 +21,17 @@
 #include <string>
 #include <vector>
 #include <set>
+#include <ostream>
 
 #include "ns3/channel.h"
 #include "ns3/node-container.h"
 #include "ns3/node-list.h"
 #include "ns3/point-to-point-helper.h"
 #include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
 #include "ns3/ipv6-address-helper.h"
 #include "ns3/random-variable-stream.h"
+#include "ns3/nstime.h"
 
 //located in BRITE source directory
 #include "Brite.h"
@@ -112,6 +115,59 @@ namespace ns3 {
          */
         void BuildBriteTopology(InternetStackHelper& stack, const uint32_t systemCount);
 
+        /**
+         * Create NS3 topology using information generated from BRITE and configure topology for MPI use,
+         * leaving stack installation to the caller.
+         *
+         * Routers are spread over the MPI instances so as to balance their load while cutting as
+         * few low latency links as possible: a link weighs the inverse of its delay, and the
+         * lookahead is the smallest delay of a cut link.  Nodes attached to a leaf router later
+         * on, such as an IoT domain and its border router, should be created on the system of
+         * that leaf (Node::GetSystemId), as CSMA and wireless channels cannot span systems.
+         *
+         * \param systemCount The number of MPI instances to be used in the simulation.
+         * \param attachedNodes The number of nodes to be attached to leaf routers, spread evenly
+         *                      over the leaf routers when balancing the load.
+         * \returns NodeContainer
+         */
+        NodeContainer BuildBriteTopology2(const uint32_t systemCount, uint32_t attachedNodes = 0);
+
+        /**
+         * Cache the generated topologies in a directory.
+         *
+         * BRITE then runs once per configuration and seed values: the nodes and
+         * edges it generates are stored in a file named after a hash of the
+         * configuration file and of the seed values, and later runs with the same
+         * ones read that file instead.  With a seed file given to the
+         * constructor, the new seed file BRITE writes is cached as well.
+         *
+         * \param directory an existing directory
+         */
+        void SetCacheDirectory(std::string directory);
+
+        /**
+         * Read the nodes and edges of the topology from a file in the format of
+         * ndn::AnnotatedTopologyReader instead of running BRITE, for the next
+         * BuildBriteTopology call.
+         *
+         * The comment column of a router holds its AS number and BRITE type,
+         * as written by WriteAnnotatedTopology, and defaults to AS 0 and
+         * RT_NONE.  Edge lengths are recomputed from the positions.
+         *
+         * \param file the topology file
+         */
+        void ReadAnnotatedTopology(std::string file);
+
+        /**
+         * Write the nodes and edges of the topology in the format of
+         * ndn::AnnotatedTopologyReader, once it has been built: routers are
+         * named after their BRITE id, with their AS number and BRITE type as
+         * comment and their system number in the last column.
+         *
+         * \param file the topology file
+         */
+        void WriteAnnotatedTopology(std::string file) const;
+
         /**
          * Returns the number of router leaf nodes for a given AS
          *
@@ -206,6 +262,28 @@ namespace ns3 {
          */
         uint32_t GetSystemNumberForAs(uint32_t asNum) const;
 
+        /**
+         * Returns the lookahead of the MPI partition
+         *
+         * \returns The smallest delay of a link between two systems, Time::Max () if there is none
+         */
+        Time GetLookahead(void) const;
+
+        /**
+         * Returns the number of links between two systems
+         *
+         * \returns The number of links cut by the MPI partition
+         */
+        uint32_t GetNCutEdges(void) const;
+
+        /**
+         * Print the MPI partition: the load and the number of nodes of each system, the system
+         * of each AS, and the cut links with the resulting lookahead.
+         *
+         * \param os The output stream
+         */
+        void PrintPartition(std::ostream &os) const;
+
         /**
          * \param address an Ipv4AddressHelper which is used to install
          *                Ipv4 addresses on all the node interfaces in
@@ -301,6 +379,39 @@ namespace ns3 {
         void ConstructTopology(void);
         void GenerateBriteTopology(void);
 
+        /**
+         * Read the nodes and edges from the cache.
+         *
+         * \param file The cache file
+         * \param newSeeds Receives the new seed values cached with the topology
+         * \returns false if the file cannot be read
+         */
+        bool ReadCache(const std::string& file, std::string& newSeeds);
+
+        /**
+         * Write the nodes and edges to the cache.
+         *
+         * \param file The cache file
+         * \param newSeeds The new seed values written by BRITE, if any
+         */
+        void WriteCache(const std::string& file, const std::string& newSeeds) const;
+
+        /**
+         * Partition the BRITE nodes: grow each system from a seed along the heaviest links
+         * until it holds its share of the load, then move boundary nodes to the system they
+         * are most strongly linked to while the balance allows it.
+         *
+         * \param systemCount The number of systems.
+         * \param leafLoad The load added to each leaf router on top of its own.
+         * \returns The system number of each node, by BRITE node id.
+         */
+        std::vector<uint32_t> PartitionNodes(uint32_t systemCount, double leafLoad) const;
+
+        /**
+         * Record the load of each system and the cut links of a partition.
+         */
+        void SetPartition(const std::vector<uint32_t>& systemForNode, uint32_t systemCount, double leafLoad);
+
         /// brite configuration file to use
         std::string m_confFile;
 
@@ -310,6 +421,9 @@ namespace ns3 {
         /// brite seed file to generate for next run
         std::string m_newSeedFile;
 
+        /// directory of the topology cache, empty if not used
+        std::string m_cacheDirectory;
+
         /// stores the number of AS in the BRITE generated topology
         uint32_t m_numAs;
 
@@ -331,6 +445,18 @@ namespace ns3 {
         /// stores the MPI system number each AS assigned to.  All assigned to 0 if MPI not used.
         std::vector<int> m_systemForAs;
 
+        /// stores the load assigned to each MPI system
+        std::vector<double> m_systemLoad;
+
+        /// stores the number of BRITE nodes assigned to each MPI system
+        std::vector<uint32_t> m_systemNodes;
+
+        /// stores the number of links between two systems
+        uint32_t m_numCutEdges;
+
+        /// stores the smallest delay of a link between two systems
+        Time m_lookahead;
+
         /// the Brite topology
         brite::Topology* m_topology;
 
@@ -25,9 +25,12 @@
 #include "ns3/random-variable-stream.h"
 #include "ns3/on-off-helper.h"
 #include "ns3/brite-module.h"
+#include "ns3/system-path.h"
 #include "ns3/test.h"
 #include <iostream>
 #include <fstream>
+#include <cstdio>
+#include <list>
 
 using namespace ns3;
 
@@ -178,6 +181,190 @@ void BriteTopologyFunctionTestCase::DoRun(void) {
 
 }
 
+class BriteTopologyPartitionTestCase : public TestCase
+{
+    public :
+    BriteTopologyPartitionTestCase();
+    virtual ~BriteTopologyPartitionTestCase();
+
+private:
+    virtual void DoRun(void);
+};
+
+BriteTopologyPartitionTestCase::BriteTopologyPartitionTestCase()
+: TestCase("Test that a brite topology built for MPI is spread over all systems and reports its cut") {
+}
+
+BriteTopologyPartitionTestCase::~BriteTopologyPartitionTestCase() {
+}
+
+void BriteTopologyPartitionTestCase::DoRun(void) {
+
+    std::string confFile = "src/brite/test/test.conf";
+    const uint32_t systemCount = 2;
+
+    SeedManager::SetRun(1);
+    SeedManager::SetSeed(1);
+    BriteTopologyHelper bth(confFile);
+    bth.AssignStreams(1);
+
+    NodeContainer nodes = bth.BuildBriteTopology2(systemCount, 10);
+    NS_TEST_ASSERT_MSG_EQ(nodes.GetN(), bth.GetNNodesTopology(), "All nodes must be returned");
+
+    std::vector<uint32_t> nodesPerSystem(systemCount, 0);
+    for (uint32_t i = 0; i < nodes.GetN(); ++i) {
+        NS_TEST_ASSERT_MSG_LT(nodes.Get(i)->GetSystemId(), systemCount, "Node " << i << " on a system that does not exist");
+        nodesPerSystem[nodes.Get(i)->GetSystemId()]++;
+    }
+    for (uint32_t sys = 0; sys < systemCount; ++sys) {
+        NS_TEST_ASSERT_MSG_GT(nodesPerSystem[sys], 0, "No node on system " << sys);
+    }
+
+    //the cut and the lookahead must match the links of the topology
+    uint32_t cut = 0;
+    Time lookahead = Time::Max();
+    for (uint32_t i = 0; i < nodes.GetN(); ++i) {
+        Ptr<Node> node = nodes.Get(i);
+        for (uint32_t j = 0; j < node->GetNDevices(); ++j) {
+            Ptr<Channel> channel = node->GetDevice(j)->GetChannel();
+            if (channel == 0 || channel->GetNDevices() != 2) {
+                continue;
+            }
+            Ptr<Node> peer = channel->GetDevice(channel->GetDevice(0)->GetNode() == node ? 1 : 0)->GetNode();
+            if (peer->GetSystemId() != node->GetSystemId() && peer->GetId() > node->GetId()) {
+                cut++;
+                TimeValue delay;
+                channel->GetAttribute("Delay", delay);
+                lookahead = std::min(lookahead, delay.Get());
+            }
+        }
+    }
+    NS_TEST_ASSERT_MSG_GT(cut, 0, "Two systems must be linked");
+    NS_TEST_ASSERT_MSG_EQ(bth.GetNCutEdges(), cut, "Wrong number of cut links");
+    NS_TEST_ASSERT_MSG_EQ(bth.GetLookahead(), lookahead, "Wrong lookahead");
+
+    Simulator::Destroy();
+}
+
+class BriteTopologyCacheTestCase : public TestCase
+{
+    public :
+    BriteTopologyCacheTestCase();
+    virtual ~BriteTopologyCacheTestCase();
+
+private:
+    virtual void DoRun(void);
+
+    /**
+     * Check that two topologies have the same nodes and links
+     */
+    void CheckSameTopology(BriteTopologyHelper& bthA, NodeContainer nodesA,
+                           BriteTopologyHelper& bthB, NodeContainer nodesB, std::string what);
+
+    /**
+     * List the cache files of a directory
+     */
+    std::list<std::string> ListCacheFiles(std::string directory);
+};
+
+BriteTopologyCacheTestCase::BriteTopologyCacheTestCase()
+: TestCase("Test that a brite topology read from the cache or from an annotated topology file matches the generated one") {
+}
+
+BriteTopologyCacheTestCase::~BriteTopologyCacheTestCase() {
+}
+
+void BriteTopologyCacheTestCase::CheckSameTopology(BriteTopologyHelper& bthA, NodeContainer nodesA,
+                                                   BriteTopologyHelper& bthB, NodeContainer nodesB, std::string what) {
+    NS_TEST_ASSERT_MSG_EQ(bthB.GetNAs(), bthA.GetNAs(), "Number of AS differs " << what);
+    NS_TEST_ASSERT_MSG_EQ(bthB.GetNNodesTopology(), bthA.GetNNodesTopology(), "Number of nodes differs " << what);
+    NS_TEST_ASSERT_MSG_EQ(bthB.GetNEdgesTopology(), bthA.GetNEdgesTopology(), "Number of edges differs " << what);
+    for (uint32_t i = 0; i < bthA.GetNAs(); ++i) {
+        NS_TEST_ASSERT_MSG_EQ(bthB.GetNLeafNodesForAs(i), bthA.GetNLeafNodesForAs(i), "Number of leaf nodes differs for AS " << i << " " << what);
+    }
+    for (uint32_t i = 0; i < nodesA.GetN(); ++i) {
+        NS_TEST_ASSERT_MSG_EQ(nodesB.Get(i)->GetNDevices(), nodesA.Get(i)->GetNDevices(), "Degree of node " << i << " differs " << what);
+        for (uint32_t j = 0; j < nodesA.Get(i)->GetNDevices(); ++j) {
+            Ptr<Channel> channelA = nodesA.Get(i)->GetDevice(j)->GetChannel();
+            Ptr<Channel> channelB = nodesB.Get(i)->GetDevice(j)->GetChannel();
+            if (channelA == 0 || channelB == 0) {
+                continue;
+            }
+            TimeValue delayA, delayB;
+            channelA->GetAttribute("Delay", delayA);
+            channelB->GetAttribute("Delay", delayB);
+            NS_TEST_ASSERT_MSG_EQ(delayB.Get(), delayA.Get(), "Delay of link " << j << " of node " << i << " differs " << what);
+            DataRateValue rateA, rateB;
+            nodesA.Get(i)->GetDevice(j)->GetAttribute("DataRate", rateA);
+            nodesB.Get(i)->GetDevice(j)->GetAttribute("DataRate", rateB);
+            NS_TEST_ASSERT_MSG_EQ(rateB.Get(), rateA.Get(), "Rate of link " << j << " of node " << i << " differs " << what);
+        }
+    }
+}
+
+std::list<std::string> BriteTopologyCacheTestCase::ListCacheFiles(std::string directory) {
+    std::list<std::string> cacheFiles;
+    std::list<std::string> files = SystemPath::ReadFiles(directory);
+    for (std::list<std::string>::const_iterator it = files.begin(); it != files.end(); ++it) {
+        if (it->compare(0, 6, "brite-") == 0 && it->size() > 6 && it->compare(it->size() - 6, 6, ".cache") == 0) {
+            cacheFiles.push_back(SystemPath::Append(directory, *it));
+        }
+    }
+    return cacheFiles;
+}
+
+void BriteTopologyCacheTestCase::DoRun(void) {
+
+    std::string confFile = "src/brite/test/test.conf";
+    std::string cacheDirectory = CreateTempDirFilename("");
+
+    //the first helper runs BRITE and fills the cache
+    SeedManager::SetRun(1);
+    SeedManager::SetSeed(1);
+    BriteTopologyHelper bthA(confFile);
+    bthA.AssignStreams(1);
+    bthA.SetCacheDirectory(cacheDirectory);
+    NodeContainer nodesA = bthA.BuildBriteTopology2();
+
+    std::list<std::string> files = ListCacheFiles(cacheDirectory);
+    NS_TEST_ASSERT_MSG_EQ(files.size(), 1, "The first topology is not cached");
+    std::string cacheFileA = files.front();
+
+    //another run caches another topology
+    SeedManager::SetRun(2);
+    SeedManager::SetSeed(1);
+    BriteTopologyHelper bthD(confFile);
+    bthD.AssignStreams(1);
+    bthD.SetCacheDirectory(cacheDirectory);
+    NodeContainer nodesD = bthD.BuildBriteTopology2();
+
+    files = ListCacheFiles(cacheDirectory);
+    NS_TEST_ASSERT_MSG_EQ(files.size(), 2, "The second topology is not cached");
+    std::string cacheFileD = files.front() == cacheFileA ? files.back() : files.front();
+
+    //the second topology stands in for the first one: a helper with the seeds
+    //of the first run builds it only if it reads the cache
+    NS_TEST_ASSERT_MSG_EQ(std::rename(cacheFileD.c_str(), cacheFileA.c_str()), 0, "Cannot replace the cached topology");
+    SeedManager::SetRun(1);
+    SeedManager::SetSeed(1);
+    BriteTopologyHelper bthB(confFile);
+    bthB.AssignStreams(1);
+    bthB.SetCacheDirectory(cacheDirectory);
+    NodeContainer nodesB = bthB.BuildBriteTopology2();
+
+    CheckSameTopology(bthD, nodesD, bthB, nodesB, "with the cached topology");
+
+    std::string topologyFile = CreateTempDirFilename("brite-topology.txt");
+    bthA.WriteAnnotatedTopology(topologyFile);
+    BriteTopologyHelper bthC(confFile);
+    bthC.ReadAnnotatedTopology(topologyFile);
+    NodeContainer nodesC = bthC.BuildBriteTopology2();
+
+    CheckSameTopology(bthA, nodesA, bthC, nodesC, "with the annotated topology");
+
+    Simulator::Destroy();
+}
+
 class BriteTestSuite : public TestSuite
 {
     public :
@@ -185,4 +372,6 @@ class BriteTestSuite : public TestSuite
     {
         AddTestCase(new BriteTopologyStructureTestCase, TestCase::QUICK);
         AddTestCase(new BriteTopologyFunctionTestCase, TestCase::QUICK);
+        AddTestCase(new BriteTopologyPartitionTestCase, TestCase::QUICK);
+        AddTestCase(new BriteTopologyCacheTestCase, TestCase::QUICK);
     }} g_briteTestSuite;
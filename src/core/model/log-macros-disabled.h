@@ -44,6 +44,9 @@
     }                                       \
   while (false)
 
+#define NS_LOG_IS_ENABLED(level) \
+        false
+
 #define NS_LOG(level, msg) \
         NS_LOG_NOOP_INTERNAL (msg)
 
@@ -130,6 +130,20 @@
 #define NS_LOG_CONDITION
 #endif
 
+/**
+ * \ingroup logging
+ * Check whether \c level is compiled in and enabled for the log component
+ * of the translation unit.
+ *
+ * The first test is a constant, which removes the whole statement when
+ * \c level is not in NS_LOG_STATIC_LEVEL; the second is a relaxed load of
+ * the levels of the component.
+ *
+ * \param [in] level The LogLevel to check.
+ */
+#define NS_LOG_IS_ENABLED(level)                                \
+  ((((NS_LOG_STATIC_LEVEL) & (level)) != 0) && g_log.IsEnabled (level))
+
 /**
  * \ingroup logging
  *
@@ -153,7 +167,7 @@
   NS_LOG_CONDITION                                              \
   do                                                            \
     {                                                           \
-      if (g_log.IsEnabled (level))                              \
+      if (NS_LOG_IS_ENABLED (level))                            \
         {                                                       \
           NS_LOG_APPEND_TIME_PREFIX;                            \
           NS_LOG_APPEND_NODE_PREFIX;                            \
@@ -177,7 +191,7 @@
   NS_LOG_CONDITION                                              \
   do                                                            \
     {                                                           \
-      if (g_log.IsEnabled (ns3::LOG_FUNCTION))                  \
+      if (NS_LOG_IS_ENABLED (ns3::LOG_FUNCTION))                \
         {                                                       \
           NS_LOG_APPEND_TIME_PREFIX;                            \
           NS_LOG_APPEND_NODE_PREFIX;                            \
@@ -214,7 +228,7 @@
   NS_LOG_CONDITION                                              \
   do                                                            \
     {                                                           \
-      if (g_log.IsEnabled (ns3::LOG_FUNCTION))                  \
+      if (NS_LOG_IS_ENABLED (ns3::LOG_FUNCTION))                \
         {                                                       \
           NS_LOG_APPEND_TIME_PREFIX;                            \
           NS_LOG_APPEND_NODE_PREFIX;                            \
@@ -209,15 +209,9 @@ namespace ns3
 #endif
     }
 
-    bool
-    LogComponent::IsEnabled(const enum LogLevel level) const {
-        //  LogComponentEnableEnvVar ();
-        return (level & m_levels) ? 1 : 0;
-    }
-
     bool
     LogComponent::IsNoneEnabled(void) const {
-        return m_levels == 0;
+        return m_levels.load(std::memory_order_relaxed) == 0;
     }
 
     void
@@ -227,12 +221,12 @@ namespace ns3
 
     void
     LogComponent::Enable(const enum LogLevel level) {
-        m_levels |= (level & ~m_mask);
+        m_levels.fetch_or(level & ~m_mask, std::memory_order_relaxed);
     }
 
     void
     LogComponent::Disable(const enum LogLevel level) {
-        m_levels &= ~level;
+        m_levels.fetch_and(~level, std::memory_order_relaxed);
     }
 
     char const *
@@ -25,6 +25,7 @@
 #include <iostream>
 #include <stdint.h>
 #include <map>
+#include <atomic>
 
 #include "log-macros-enabled.h"
 #include "log-macros-disabled.h"
@@ -199,7 +200,7 @@ namespace ns3 {
  * \param [in] name The log component name.
  */
 #define NS_LOG_COMPONENT_DEFINE(name)                           \
-  static ns3::LogComponent g_log = ns3::LogComponent (name, __FILE__)
+  static ns3::LogComponent g_log (name, __FILE__)
 
 /**
  * Define a logging component with a mask.
@@ -210,7 +211,20 @@ namespace ns3 {
  * \param [in] mask The default mask.
  */
 #define NS_LOG_COMPONENT_DEFINE_MASK(name, mask)                \
-  static ns3::LogComponent g_log = ns3::LogComponent (name, __FILE__, mask)
+  static ns3::LogComponent g_log (name, __FILE__, mask)
+
+#ifndef NS_LOG_STATIC_LEVEL
+/**
+ * LogLevels compiled into the translation unit.
+ *
+ * Log statements of the other levels are removed at compile time: their
+ * message is never evaluated and no run-time check is left, whatever the
+ * NS_LOG environment variable says.  Defaults to all levels; the
+ * `--log-static-level` configure option sets it per module, for example
+ * `--log-static-level=ndnSIM=info,applications=warn`.
+ */
+#define NS_LOG_STATIC_LEVEL ns3::LOG_LEVEL_ALL
+#endif
 
 /**
  * Use \ref NS_LOG to output a message of level LOG_ERROR.
@@ -326,7 +340,9 @@ namespace ns3 {
          * \param [in] level The level to check for.
          * \return \c true if we are enabled at \c level.
          */
-        bool IsEnabled(const enum LogLevel level) const;
+        bool IsEnabled(const enum LogLevel level) const {
+            return (level & m_levels.load(std::memory_order_relaxed)) != 0;
+        }
         /**
          * Check if all levels are disabled.
          *
@@ -400,7 +416,7 @@ namespace ns3 {
          */
         void EnvVarCheck(void);
 
-        int32_t m_levels; //!< Enabled LogLevels.
+        std::atomic<int32_t> m_levels; //!< Enabled LogLevels, read without ordering on every log statement.
         int32_t m_mask; //!< Blocked LogLevels.
         std::string m_name; //!< LogComponent name.
         std::string m_file; //!< File defining this LogComponent.
@@ -29,6 +29,9 @@
 #include <sstream>
 #include <cstdlib>
 #include <cstring>
+#ifdef NS3_MTP
+#include <mutex>
+#endif
 
 /**
  * \file
@@ -41,6 +44,33 @@ namespace ns3
 
     NS_LOG_COMPONENT_DEFINE("Object");
 
+    /**
+     * \ingroup object
+     * The GetObject() calls counted for one TypeId.
+     */
+    struct GetObjectCounters {
+        /** The number of calls. */
+        uint64_t calls;
+        /** The number of calls not answered by the cache. */
+        uint64_t misses;
+    };
+
+    /**
+     * \ingroup object
+     * The GetObject() profile, indexed by TypeId uid.
+     */
+    static std::vector<GetObjectCounters> g_getObjectProfile;
+
+#ifdef NS3_MTP
+    /**
+     * \ingroup object
+     * Serializes the updates of the GetObject() profile.
+     */
+    static std::mutex g_getObjectProfileMutex;
+#endif
+
+    bool Object::m_getObjectProfiling = false;
+
     /*********************************************************************
      *         The Object implementation
      *********************************************************************/
@@ -92,10 +122,9 @@ namespace ns3
             : m_tid(Object::GetTypeId()),
             m_disposed(false),
             m_initialized(false),
-            m_aggregates((struct Aggregates *) std::malloc(sizeof (struct Aggregates))),
+            m_aggregates(CreateAggregates(1)),
             m_getObjectCount(0) {
         NS_LOG_FUNCTION(this);
-        m_aggregates->n = 1;
         m_aggregates->buffer[0] = this;
     }
 
@@ -112,6 +141,8 @@ namespace ns3
                 m_aggregates->n--;
             }
         }
+        // the remaining objects may have found this one through the cache
+        ClearCache(m_aggregates);
         // finally, if all objects have been removed from the list,
         // delete the aggregate list
         if (m_aggregates->n == 0) {
@@ -124,9 +155,8 @@ namespace ns3
             : m_tid(o.m_tid),
             m_disposed(false),
             m_initialized(false),
-            m_aggregates((struct Aggregates *) std::malloc(sizeof (struct Aggregates))),
+            m_aggregates(CreateAggregates(1)),
             m_getObjectCount(0) {
-        m_aggregates->n = 1;
         m_aggregates->buffer[0] = this;
     }
 
@@ -136,8 +166,28 @@ namespace ns3
         ConstructSelf(attributes);
     }
 
-    Ptr<Object>
-            Object::DoGetObject(TypeId tid) const {
+    Object::Aggregates *
+    Object::CreateAggregates(uint32_t n) {
+        struct Aggregates *aggregates =
+                (struct Aggregates *) std::malloc(sizeof (struct Aggregates)+(n - 1) * sizeof (Object*));
+        aggregates->n = n;
+        ClearCache(aggregates);
+        return aggregates;
+    }
+
+    void
+    Object::ClearCache(struct Aggregates *aggregates) {
+        for (uint32_t i = 0; i < 8; i++) {
+#ifdef NS3_MTP
+            aggregates->cache[i].store(0, std::memory_order_relaxed);
+#else
+            aggregates->cache[i] = 0;
+#endif
+        }
+    }
+
+    Object *
+    Object::DoGetObject(TypeId tid) const {
         NS_LOG_FUNCTION(this << tid);
         NS_ASSERT(CheckLoose());
 
@@ -154,14 +204,29 @@ namespace ns3
                 // the idea is that if we perform a lookup for a TypeId on this object,
                 // we are likely to perform the same lookup later so, we make sure
                 // that the aggregate array is sorted by the number of accesses
-                // to each object.
+                // to each object.  The multithreaded simulator (NS3_MTP) looks objects up
+                // from several threads, so it leaves the array alone.
 
+#ifndef NS3_MTP
                 // first, increment the access count
                 current->m_getObjectCount++;
                 // then, update the sort
                 UpdateSortedArray(m_aggregates, i);
+#endif
+                // The cache answers the next lookups of this TypeId until the
+                // aggregation changes. An object out of the 48 bits of an entry
+                // is not cached.
+                uint64_t address = static_cast<uint64_t> (reinterpret_cast<uintptr_t> (current));
+                if ((address >> 48) == 0) {
+                    uint64_t entry = (address << 16) | tid.GetUid();
+#ifdef NS3_MTP
+                    m_aggregates->cache[tid.GetUid() & 7].store(entry, std::memory_order_relaxed);
+#else
+                    m_aggregates->cache[tid.GetUid() & 7] = entry;
+#endif
+                }
                 // finally, return the match
-                return const_cast<Object *> (current);
+                return current;
             }
         }
         return 0;
@@ -240,11 +305,9 @@ restart:
         }
 
         Object *other = PeekPointer(o);
-        // first create the new aggregate buffer.
-        uint32_t total = m_aggregates->n + other->m_aggregates->n;
-        struct Aggregates *aggregates =
-                (struct Aggregates *) std::malloc(sizeof (struct Aggregates)+(total - 1) * sizeof (Object*));
-        aggregates->n = total;
+        // first create the new aggregate buffer, which starts with an empty
+        // cache since lookups may now find other objects.
+        struct Aggregates *aggregates = CreateAggregates(m_aggregates->n + other->m_aggregates->n);
 
         // copy our buffer to the new buffer
         std::memcpy(&aggregates->buffer[0],
@@ -288,6 +351,67 @@ restart:
         std::free(b);
     }
 
+    void
+    Object::SetGetObjectProfiling(bool enabled) {
+        NS_LOG_FUNCTION(enabled);
+        m_getObjectProfiling = enabled;
+    }
+
+    uint64_t
+    Object::GetObjectCalls(TypeId tid) {
+        NS_LOG_FUNCTION(tid);
+#ifdef NS3_MTP
+        std::lock_guard<std::mutex> lock(g_getObjectProfileMutex);
+#endif
+        if (tid.GetUid() < g_getObjectProfile.size()) {
+            return g_getObjectProfile[tid.GetUid()].calls;
+        }
+        return 0;
+    }
+
+    uint64_t
+    Object::GetObjectCacheMisses(TypeId tid) {
+        NS_LOG_FUNCTION(tid);
+#ifdef NS3_MTP
+        std::lock_guard<std::mutex> lock(g_getObjectProfileMutex);
+#endif
+        if (tid.GetUid() < g_getObjectProfile.size()) {
+            return g_getObjectProfile[tid.GetUid()].misses;
+        }
+        return 0;
+    }
+
+    void
+    Object::PrintGetObjectProfile(std::ostream &os) {
+        NS_LOG_FUNCTION(&os);
+#ifdef NS3_MTP
+        std::lock_guard<std::mutex> lock(g_getObjectProfileMutex);
+#endif
+        os << "TypeId\tCalls\tCacheMisses" << std::endl;
+        for (uint16_t uid = 1; uid < g_getObjectProfile.size(); uid++) {
+            if (g_getObjectProfile[uid].calls != 0) {
+                TypeId tid;
+                tid.SetUid(uid);
+                os << tid.GetName() << "\t" << g_getObjectProfile[uid].calls
+                        << "\t" << g_getObjectProfile[uid].misses << std::endl;
+            }
+        }
+    }
+
+    void
+    Object::CountGetObject(TypeId tid, bool cached) {
+#ifdef NS3_MTP
+        std::lock_guard<std::mutex> lock(g_getObjectProfileMutex);
+#endif
+        if (tid.GetUid() >= g_getObjectProfile.size()) {
+            g_getObjectProfile.resize(tid.GetUid() + 1, GetObjectCounters());
+        }
+        g_getObjectProfile[tid.GetUid()].calls++;
+        if (!cached) {
+            g_getObjectProfile[tid.GetUid()].misses++;
+        }
+    }
+
     /**
      * This function must be implemented in the stack that needs to notify
      * other stacks connected to the node of their presence in the node.
@@ -22,6 +22,7 @@
 #define OBJECT_H
 
 #include <stdint.h>
+#include <ostream>
 #include <string>
 #include <vector>
 #include "ptr.h"
@@ -29,6 +30,9 @@
 #include "object-base.h"
 #include "attribute-construction-list.h"
 #include "simple-ref-count.h"
+#ifdef NS3_MTP
+#include <atomic>
+#endif
 
 /**
  * \file
@@ -160,6 +164,39 @@ namespace ns3 {
          */
         template <typename T>
         Ptr<T> GetObject(TypeId tid) const;
+        /**
+         * Count the GetObject() calls of every TypeId from now on.
+         *
+         * \param [in] enabled Whether to count the calls.
+         *
+         * Counting is off by default.  When it is on, every GetObject()
+         * call records the requested TypeId and whether the lookup was
+         * answered by the cache of the aggregate, so that the hot lookups
+         * of a scenario can be found with PrintGetObjectProfile().
+         */
+        static void SetGetObjectProfiling(bool enabled);
+        /**
+         * Get the number of GetObject() calls counted for a TypeId.
+         *
+         * \param [in] tid The requested TypeId.
+         * \returns The number of calls since profiling was enabled.
+         */
+        static uint64_t GetObjectCalls(TypeId tid);
+        /**
+         * Get the number of counted GetObject() calls for a TypeId which
+         * were not answered by the cache and searched the aggregates.
+         *
+         * \param [in] tid The requested TypeId.
+         * \returns The number of cache misses since profiling was enabled.
+         */
+        static uint64_t GetObjectCacheMisses(TypeId tid);
+        /**
+         * Print the counted GetObject() calls, one TypeId per line with
+         * its name, its number of calls and its number of cache misses.
+         *
+         * \param [in,out] os The output stream.
+         */
+        static void PrintGetObjectProfile(std::ostream &os);
         /**
          * Dispose of this Object.
          *
@@ -328,17 +365,68 @@ namespace ns3 {
         struct Aggregates {
             /** The number of entries in \c buffer. */
             uint32_t n;
+            /**
+             * The results of recent lookups, see FindCachedObject().
+             *
+             * Each entry packs the Object pointer above the 16 bits of
+             * the TypeId uid, so that an entry is read and written as one
+             * word, also by the concurrent threads of the multithreaded
+             * simulator.  Zero is an empty entry.
+             */
+#ifdef NS3_MTP
+            std::atomic<uint64_t> cache[8];
+#else
+            uint64_t cache[8];
+#endif
             /** The array of Objects. */
             Object *buffer[1];
         };
 
         /**
-         * Find an Object of TypeId tid in the aggregates of this Object.
+         * Allocate the list of aggregates for \p n Objects with an
+         * empty cache.
+         *
+         * \param [in] n The number of aggregated Objects.
+         * \return The new list, to be released with std::free().
+         */
+        static struct Aggregates *CreateAggregates(uint32_t n);
+        /**
+         * Empty the lookup cache of a list of aggregates.
+         *
+         * \param [in,out] aggregates The list of aggregated Objects.
+         */
+        static void ClearCache(struct Aggregates *aggregates);
+        /**
+         * Look for an Object of TypeId tid in the lookup cache of the
+         * aggregates of this Object.
+         *
+         * \param [in] tid The TypeId we're looking for
+         * \return The matching Object, or zero if it is not cached
+         */
+        inline Object *FindCachedObject(TypeId tid) const;
+        /**
+         * Find an Object of TypeId tid in the cache, then in the aggregates
+         * of this Object.
+         *
+         * \param [in] tid The TypeId we're looking for
+         * \return The matching Object, if it is found
+         */
+        inline Object *LookupObject(TypeId tid) const;
+        /**
+         * Find an Object of TypeId tid in the aggregates of this Object,
+         * and cache the result.
          *
          * \param [in] tid The TypeId we're looking for
          * \return The matching Object, if it is found
          */
-        Ptr<Object> DoGetObject(TypeId tid) const;
+        Object *DoGetObject(TypeId tid) const;
+        /**
+         * Count a GetObject() call in the profile.
+         *
+         * \param [in] tid The requested TypeId.
+         * \param [in] cached Whether the cache answered the call.
+         */
+        static void CountGetObject(TypeId tid, bool cached);
         /**
          * Verify that this Object is still live, by checking it's reference count.
          * \return \c true if the reference count is non zero.
@@ -425,6 +513,8 @@ namespace ns3 {
          * the array of aggregates in most-frequently accessed order.
          */
         uint32_t m_getObjectCount;
+        /** Whether GetObject() calls are counted, see SetGetObjectProfiling(). */
+        static bool m_getObjectProfiling;
     };
 
     template <typename T>
@@ -445,31 +535,43 @@ namespace ns3 {
         object->DoDelete();
     }
 
+    Object *
+    Object::FindCachedObject(TypeId tid) const {
+#ifdef NS3_MTP
+        uint64_t entry = m_aggregates->cache[tid.GetUid() & 7].load(std::memory_order_relaxed);
+#else
+        uint64_t entry = m_aggregates->cache[tid.GetUid() & 7];
+#endif
+        if ((entry & 0xffff) == tid.GetUid()) {
+            return reinterpret_cast<Object *> (static_cast<uintptr_t> (entry >> 16));
+        }
+        return 0;
+    }
+
+    Object *
+    Object::LookupObject(TypeId tid) const {
+        // A repeated lookup of the same type, which is the common case, is
+        // answered by the cache without searching the aggregates.
+        Object *cached = FindCachedObject(tid);
+        if (m_getObjectProfiling) {
+            CountGetObject(tid, cached != 0);
+        }
+        if (cached != 0) {
+            return cached;
+        }
+        return DoGetObject(tid);
+    }
+
     template <typename T>
     Ptr<T>
     Object::GetObject() const {
-        // This is an optimization: if the cast works (which is likely),
-        // things will be pretty fast.
-        T *result = dynamic_cast<T *> (m_aggregates->buffer[0]);
-        if (result != 0) {
-            return Ptr<T> (result);
-        }
-        // if the cast does not work, we try to do a full type check.
-        Ptr<Object> found = DoGetObject(T::GetTypeId());
-        if (found != 0) {
-            return Ptr<T> (static_cast<T *> (PeekPointer(found)));
-        }
-        return 0;
+        return Ptr<T> (static_cast<T *> (LookupObject(T::GetTypeId())));
     }
 
     template <typename T>
     Ptr<T>
     Object::GetObject(TypeId tid) const {
-        Ptr<Object> found = DoGetObject(tid);
-        if (found != 0) {
-            return Ptr<T> (static_cast<T *> (PeekPointer(found)));
-        }
-        return 0;
+        return Ptr<T> (static_cast<T *> (LookupObject(tid)));
     }
 
     /*************************************************************************
@@ -24,6 +24,10 @@
 #include "config.h"
 #include "log.h"
 
+#ifdef NS3_MTP
+#include <atomic>
+#endif
+
 /**
  * \file
  * \ingroup randomvariable
@@ -40,7 +44,11 @@ namespace ns3
      * The next random number generator stream number to use
      * for automatic assignment.
      */
+#ifdef NS3_MTP
+    static std::atomic<uint64_t> g_nextStreamIndex(0);
+#else
     static uint64_t g_nextStreamIndex = 0;
+#endif
     /**
      * \relates RngSeedManager
      * The random number generator seed number global value.
@@ -90,9 +98,7 @@ namespace ns3
 
     uint64_t RngSeedManager::GetNextStreamIndex(void) {
         NS_LOG_FUNCTION_NOARGS();
-        uint64_t next = g_nextStreamIndex;
-        g_nextStreamIndex++;
-        return next;
+        return g_nextStreamIndex++;
     }
 
 } // namespace ns3
@@ -27,6 +27,9 @@
 #include "assert.h"
 #include <stdint.h>
 #include <limits>
+#ifdef NS3_MTP
+#include <atomic>
+#endif
 
 /**
  * \file
@@ -111,8 +114,7 @@ namespace ns3 {
          * unnecessary and dangerous.
          */
         inline void Unref(void) const {
-            m_count--;
-            if (m_count == 0) {
+            if (--m_count == 0) {
                 DELETER::Delete(static_cast<T*> (const_cast<SimpleRefCount *> (this)));
             }
         }
@@ -138,9 +140,14 @@ namespace ns3 {
          *
          * \internal
          * Note we make this mutable so that the const methods can still
-         * change it.
+         * change it.  With the multithreaded simulator (NS3_MTP) objects
+         * are shared between threads, so the count is atomic.
          */
+#ifdef NS3_MTP
+        mutable std::atomic<uint32_t> m_count;
+#else
         mutable uint32_t m_count;
+#endif
     };
 
 } // namespace ns3
@@ -1003,12 +1003,6 @@ namespace ns3{
         return 0;
     }
 
-    uint16_t
-    TypeId::GetUid(void) const
-    {
-        NS_LOG_FUNCTION(this);
-        return m_tid;
-    }
     void
     TypeId::SetUid(uint16_t tid)
     {
@@ -459,7 +459,7 @@ namespace ns3 {
          * This is really an internal method which users are not expected
          * to use.
          */
-        uint16_t GetUid(void) const;
+        inline uint16_t GetUid(void) const;
         /**
          * Set the internal id of this TypeId.
          *
@@ -569,6 +569,11 @@ namespace ns3 {
     TypeId::~TypeId() {
     }
 
+    uint16_t
+    TypeId::GetUid(void) const {
+        return m_tid;
+    }
+
     inline bool operator==(TypeId a, TypeId b) {
         return a.m_tid == b.m_tid;
     }
@@ -352,6 +352,69 @@ AggregateObjectTestCase::DoRun(void) {
     NS_TEST_ASSERT_MSG_NE(baseA, 0, "Unable to GetObject on released object");
 }
 
+// ===========================================================================
+// Test case to make sure that the GetObject cache follows the aggregation.
+// ===========================================================================
+class GetObjectCacheTestCase : public TestCase
+{
+    public :
+    GetObjectCacheTestCase();
+    virtual ~GetObjectCacheTestCase();
+
+private:
+    virtual void DoRun(void);};
+
+GetObjectCacheTestCase::GetObjectCacheTestCase()
+: TestCase("Check the GetObject cache and profile") {
+}
+
+GetObjectCacheTestCase::~GetObjectCacheTestCase() {
+}
+
+void
+GetObjectCacheTestCase::DoRun(void) {
+    Object::SetGetObjectProfiling(true);
+    uint64_t calls = Object::GetObjectCalls(BaseB::GetTypeId());
+    uint64_t misses = Object::GetObjectCacheMisses(BaseB::GetTypeId());
+
+    Ptr<BaseA> baseA = CreateObject<BaseA> ();
+    Ptr<DerivedB> derivedB = CreateObject<DerivedB> ();
+
+    //
+    // A failed lookup is not cached: once the DerivedB is aggregated, it is
+    // found through its parent type.
+    //
+    NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<BaseB> (), 0, "Unexpectedly found a BaseB before aggregation");
+    baseA->AggregateObject(derivedB);
+    NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<BaseB> (), derivedB, "Cannot GetObject for BaseB after aggregation");
+    NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<BaseB> (), derivedB, "Cached GetObject for BaseB returns a different Ptr");
+    NS_TEST_ASSERT_MSG_EQ(derivedB->GetObject<BaseB> (), derivedB, "GetObject through derivedB returns a different Ptr");
+
+    //
+    // Two lookups searched the aggregates, the last two were cached.
+    //
+    NS_TEST_ASSERT_MSG_EQ(Object::GetObjectCalls(BaseB::GetTypeId()) - calls, 4, "Unexpected number of GetObject calls");
+    NS_TEST_ASSERT_MSG_EQ(Object::GetObjectCacheMisses(BaseB::GetTypeId()) - misses, 2, "Unexpected number of cache misses");
+
+    //
+    // A new aggregation empties the cache, and the lookups still resolve.
+    //
+    NS_TEST_ASSERT_MSG_EQ(baseA->GetObject<BaseA> (), baseA, "Cannot GetObject for BaseA");
+    Ptr<DerivedA> derivedA = CreateObject<DerivedA> ();
+    NS_TEST_ASSERT_MSG_EQ(derivedA->GetObject<BaseA> (), derivedA, "Cannot GetObject for BaseA through derivedA");
+    derivedB->AggregateObject(derivedA);
+    NS_TEST_ASSERT_MSG_EQ(derivedB->GetObject<DerivedA> (), derivedA, "Cannot GetObject for DerivedA after aggregation");
+    NS_TEST_ASSERT_MSG_EQ(derivedA->GetObject<DerivedB> (), derivedB, "Cannot GetObject for DerivedB after aggregation");
+    misses = Object::GetObjectCacheMisses(BaseB::GetTypeId());
+    NS_TEST_ASSERT_MSG_EQ(derivedA->GetObject<BaseB> (), derivedB, "Cannot GetObject for BaseB after aggregation");
+    NS_TEST_ASSERT_MSG_EQ(Object::GetObjectCacheMisses(BaseB::GetTypeId()) - misses, 1, "The cache was not emptied by the aggregation");
+
+    Object::SetGetObjectProfiling(false);
+    calls = Object::GetObjectCalls(BaseB::GetTypeId());
+    derivedA->GetObject<BaseB> ();
+    NS_TEST_ASSERT_MSG_EQ(Object::GetObjectCalls(BaseB::GetTypeId()), calls, "GetObject calls counted with profiling disabled");
+}
+
 // ===========================================================================
 // Test case to make sure that an Object factory can create Objects
 // ===========================================================================
@@ -432,6 +495,7 @@ ObjectTestSuite::ObjectTestSuite()
 : TestSuite("object", UNIT) {
     AddTestCase(new CreateObjectTestCase, TestCase::QUICK);
     AddTestCase(new AggregateObjectTestCase, TestCase::QUICK);
+    AddTestCase(new GetObjectCacheTestCase, TestCase::QUICK);
     AddTestCase(new ObjectFactoryTestCase, TestCase::QUICK);
 }
 
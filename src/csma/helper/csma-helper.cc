@@ -86,12 +86,18 @@ namespace ns3
         std::string filename;
         if (explicitFilename) {
             filename = prefix;
+        } else if (GetPcapMergeChannels()) {
+            filename = pcapHelper.GetFilenameFromChannel(prefix, device->GetChannel());
         } else {
             filename = pcapHelper.GetFilenameFromDevice(prefix, device);
         }
 
-        Ptr<PcapFileWrapper> file = pcapHelper.CreateFile(filename, std::ios::out,
-                PcapHelper::DLT_EN10MB);
+        Ptr<PcapFileWrapper> file;
+        if (GetPcapMergeChannels()) {
+            file = pcapHelper.CreateInterface(filename, device, PcapHelper::DLT_EN10MB);
+        } else {
+            file = pcapHelper.CreateFile(filename, std::ios::out, PcapHelper::DLT_EN10MB);
+        }
         if (promiscuous) {
             pcapHelper.HookDefaultSink<CsmaNetDevice> (device, "PromiscSniffer", file);
         } else {
@@ -0,0 +1,43 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation;
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+// Convert a FlowMonitor streaming export (FlowMonitor::EnableStreamingExport)
+// to the XML report written by FlowMonitor::SerializeToXmlFile, e.g.
+//
+//   ./waf --run "flowmon-stream-to-xml --input=Flows.csv --output=Flows.xml"
+
+#include "ns3/core-module.h"
+#include "ns3/flow-monitor.h"
+
+using namespace ns3;
+
+int
+main(int argc, char *argv[]) {
+    std::string input = "Flows.csv";
+    std::string output = "Flows.xml";
+    bool histograms = true;
+    bool probes = true;
+
+    CommandLine cmd;
+    cmd.AddValue("input", "Streaming export file", input);
+    cmd.AddValue("output", "XML file to create", output);
+    cmd.AddValue("histograms", "Include the histograms", histograms);
+    cmd.AddValue("probes", "Include the per-probe statistics", probes);
+    cmd.Parse(argc, argv);
+
+    FlowMonitor::ConvertStreamToXmlFile(input, output, histograms, probes);
+    return 0;
+}
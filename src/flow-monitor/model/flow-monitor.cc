@@ -22,8 +22,12 @@
 #include "ns3/simulator.h"
 #include "ns3/log.h"
 #include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/abort.h"
 #include <fstream>
 #include <sstream>
+#include <iomanip>
+#include <cstdlib>
 
 #define INDENT(level) for (int __xpto = 0; __xpto < level; __xpto++) os << ' ';
 
@@ -71,6 +75,14 @@ namespace ns3
                 TimeValue(Seconds(0.5)),
                 MakeTimeAccessor(&FlowMonitor::m_flowInterruptionsMinTime),
                 MakeTimeChecker())
+                .AddAttribute("ReservedFlows", ("The number of flows to reserve room for in the flow index."),
+                UintegerValue(256),
+                MakeUintegerAccessor(&FlowMonitor::m_reservedFlows),
+                MakeUintegerChecker<uint32_t> ())
+                .AddAttribute("ReservedTrackedPackets", ("The number of in-flight packets to reserve room for."),
+                UintegerValue(4096),
+                MakeUintegerAccessor(&FlowMonitor::m_reservedTrackedPackets),
+                MakeUintegerChecker<uint32_t> ())
                 ;
         return tid;
     }
@@ -81,12 +93,15 @@ namespace ns3
     }
 
     FlowMonitor::FlowMonitor()
-            : m_enabled(false) {
+            : m_enabled(false),
+            m_streamHistograms(false),
+            m_streamDropProbeStats(false) {
         // m_histogramBinWidth=DEFAULT_BIN_WIDTH;
     }
 
     void
     FlowMonitor::DoDispose(void) {
+        StopStreamingExport();
         for (std::list<Ptr<FlowClassifier> >::iterator iter = m_classifiers.begin();
                 iter != m_classifiers.end();
                 iter++) {
@@ -99,12 +114,18 @@ namespace ns3
         Object::DoDispose();
     }
 
+    inline uint64_t
+    FlowMonitor::GetTrackedPacketKey(FlowId flowId, FlowPacketId packetId) {
+        return (static_cast<uint64_t> (flowId) << 32) | packetId;
+    }
+
     inline FlowMonitor::FlowStats &
             FlowMonitor::GetStatsForFlow(FlowId flowId) {
-        FlowStatsContainerI iter;
-        iter = m_flowStats.find(flowId);
-        if (iter == m_flowStats.end()) {
+        std::unordered_map<FlowId, FlowStats *>::iterator iter;
+        iter = m_flowStatsIndex.find(flowId);
+        if (iter == m_flowStatsIndex.end()) {
             FlowMonitor::FlowStats &ref = m_flowStats[flowId];
+            m_flowStatsIndex[flowId] = &ref;
             ref.delaySum = Seconds(0);
             ref.jitterSum = Seconds(0);
             ref.lastDelay = Seconds(0);
@@ -120,7 +141,7 @@ namespace ns3
             ref.flowInterruptionsHistogram.SetDefaultBinWidth(m_flowInterruptionsBinWidth);
             return ref;
         } else {
-            return iter->second;
+            return *iter->second;
         }
     }
 
@@ -130,16 +151,20 @@ namespace ns3
             return;
         }
         Time now = Simulator::Now();
-        TrackedPacket &tracked = m_trackedPackets[std::make_pair(flowId, packetId)];
+        FlowStats &stats = GetStatsForFlow(flowId);
+        uint64_t key = GetTrackedPacketKey(flowId, packetId);
+        TrackedPacket &tracked = m_trackedPackets[key];
         tracked.firstSeenTime = now;
         tracked.lastSeenTime = tracked.firstSeenTime;
         tracked.timesForwarded = 0;
+        tracked.stats = &stats;
+        TrackedPacketExpiry expiry = {now, key};
+        m_trackedPacketsExpiry.push_back(expiry);
         NS_LOG_DEBUG("ReportFirstTx: adding tracked packet (flowId=" << flowId << ", packetId=" << packetId
                 << ").");
 
         probe->AddPacketStats(flowId, packetSize, Seconds(0));
 
-        FlowStats &stats = GetStatsForFlow(flowId);
         stats.txBytes += packetSize;
         stats.txPackets++;
         if (stats.txPackets == 1) {
@@ -153,7 +178,7 @@ namespace ns3
         if (!m_enabled) {
             return;
         }
-        std::pair<FlowId, FlowPacketId> key(flowId, packetId);
+        uint64_t key = GetTrackedPacketKey(flowId, packetId);
         TrackedPacketMap::iterator tracked = m_trackedPackets.find(key);
         if (tracked == m_trackedPackets.end()) {
             NS_LOG_WARN("Received packet forward report (flowId=" << flowId << ", packetId=" << packetId
@@ -163,6 +188,8 @@ namespace ns3
 
         tracked->second.timesForwarded++;
         tracked->second.lastSeenTime = Simulator::Now();
+        TrackedPacketExpiry expiry = {tracked->second.lastSeenTime, key};
+        m_trackedPacketsExpiry.push_back(expiry);
 
         Time delay = (Simulator::Now() - tracked->second.firstSeenTime);
         probe->AddPacketStats(flowId, packetSize, delay);
@@ -173,7 +200,7 @@ namespace ns3
         if (!m_enabled) {
             return;
         }
-        TrackedPacketMap::iterator tracked = m_trackedPackets.find(std::make_pair(flowId, packetId));
+        TrackedPacketMap::iterator tracked = m_trackedPackets.find(GetTrackedPacketKey(flowId, packetId));
         if (tracked == m_trackedPackets.end()) {
             NS_LOG_WARN("Received packet last-tx report (flowId=" << flowId << ", packetId=" << packetId
                     << ") but not known to be transmitted.");
@@ -184,7 +211,7 @@ namespace ns3
         Time delay = (now - tracked->second.firstSeenTime);
         probe->AddPacketStats(flowId, packetSize, delay);
 
-        FlowStats &stats = GetStatsForFlow(flowId);
+        FlowStats &stats = *tracked->second.stats;
         stats.delaySum += delay;
         stats.delayHistogram.AddValue(delay.GetSeconds());
         if (stats.rxPackets > 0) {
@@ -239,7 +266,7 @@ namespace ns3
         stats.bytesDropped[reasonCode] += packetSize;
         NS_LOG_DEBUG("++stats.packetsDropped[" << reasonCode << "]; // becomes: " << stats.packetsDropped[reasonCode]);
 
-        TrackedPacketMap::iterator tracked = m_trackedPackets.find(std::make_pair(flowId, packetId));
+        TrackedPacketMap::iterator tracked = m_trackedPackets.find(GetTrackedPacketKey(flowId, packetId));
         if (tracked != m_trackedPackets.end()) {
             // we don't need to track this packet anymore
             // FIXME: this will not necessarily be true with broadcast/multicast
@@ -258,19 +285,20 @@ namespace ns3
     FlowMonitor::CheckForLostPackets(Time maxDelay) {
         Time now = Simulator::Now();
 
-        for (TrackedPacketMap::iterator iter = m_trackedPackets.begin();
-                iter != m_trackedPackets.end();) {
-            if (now - iter->second.lastSeenTime >= maxDelay) {
+        // Checks are queued in lastSeenTime order, so only the head of the
+        // queue can be due.
+        while (!m_trackedPacketsExpiry.empty()
+                && now - m_trackedPacketsExpiry.front().lastSeenTime >= maxDelay) {
+            const TrackedPacketExpiry &expiry = m_trackedPacketsExpiry.front();
+            TrackedPacketMap::iterator iter = m_trackedPackets.find(expiry.key);
+            if (iter != m_trackedPackets.end() && iter->second.lastSeenTime == expiry.lastSeenTime) {
                 // packet is considered lost, add it to the loss statistics
-                FlowStatsContainerI flow = m_flowStats.find(iter->first.first);
-                NS_ASSERT(flow != m_flowStats.end());
-                flow->second.lostPackets++;
+                iter->second.stats->lostPackets++;
 
                 // we won't track it anymore
-                m_trackedPackets.erase(iter++);
-            } else {
-                iter++;
+                m_trackedPackets.erase(iter);
             }
+            m_trackedPacketsExpiry.pop_front();
         }
     }
 
@@ -288,6 +316,8 @@ namespace ns3
     void
     FlowMonitor::NotifyConstructionCompleted() {
         Object::NotifyConstructionCompleted();
+        m_flowStatsIndex.reserve(m_reservedFlows);
+        m_trackedPackets.reserve(m_reservedTrackedPackets);
         Simulator::Schedule(PERIODIC_CHECK_INTERVAL, &FlowMonitor::PeriodicCheckForLostPackets, this);
     }
 
@@ -354,49 +384,7 @@ namespace ns3
         for (FlowStatsContainerCI flowI = m_flowStats.begin();
                 flowI != m_flowStats.end(); flowI++) {
 
-            INDENT(indent);
-#define ATTRIB(name) << " " # name "=\"" << flowI->second.name << "\""
-            os << "<Flow flowId=\"" << flowI->first << "\""
-                    ATTRIB(timeFirstTxPacket)
-                    ATTRIB(timeFirstRxPacket)
-                    ATTRIB(timeLastTxPacket)
-                    ATTRIB(timeLastRxPacket)
-                    ATTRIB(delaySum)
-                    ATTRIB(jitterSum)
-                    ATTRIB(lastDelay)
-                    ATTRIB(txBytes)
-                    ATTRIB(rxBytes)
-                    ATTRIB(txPackets)
-                    ATTRIB(rxPackets)
-                    ATTRIB(lostPackets)
-                    ATTRIB(timesForwarded)
-                    << ">\n";
-#undef ATTRIB
-
-
-            indent += 2;
-            for (uint32_t reasonCode = 0; reasonCode < flowI->second.packetsDropped.size(); reasonCode++) {
-                INDENT(indent);
-                os << "<packetsDropped reasonCode=\"" << reasonCode << "\""
-                        << " number=\"" << flowI->second.packetsDropped[reasonCode]
-                        << "\" />\n";
-            }
-            for (uint32_t reasonCode = 0; reasonCode < flowI->second.bytesDropped.size(); reasonCode++) {
-                INDENT(indent);
-                os << "<bytesDropped reasonCode=\"" << reasonCode << "\""
-                        << " bytes=\"" << flowI->second.bytesDropped[reasonCode]
-                        << "\" />\n";
-            }
-            if (enableHistograms) {
-                flowI->second.delayHistogram.SerializeToXmlStream(os, indent, "delayHistogram");
-                flowI->second.jitterHistogram.SerializeToXmlStream(os, indent, "jitterHistogram");
-                flowI->second.packetSizeHistogram.SerializeToXmlStream(os, indent, "packetSizeHistogram");
-                flowI->second.flowInterruptionsHistogram.SerializeToXmlStream(os, indent, "flowInterruptionsHistogram");
-            }
-            indent -= 2;
-
-            INDENT(indent);
-            os << "</Flow>\n";
+            SerializeFlowToXmlStream(os, indent, flowI->first, flowI->second, enableHistograms);
         }
         indent -= 2;
         INDENT(indent);
@@ -425,6 +413,54 @@ namespace ns3
         os << "</FlowMonitor>\n";
     }
 
+    void
+    FlowMonitor::SerializeFlowToXmlStream(std::ostream &os, int indent, FlowId flowId,
+            const FlowStats &stats, bool enableHistograms) {
+        INDENT(indent);
+#define ATTRIB(name) << " " # name "=\"" << stats.name << "\""
+        os << "<Flow flowId=\"" << flowId << "\""
+                ATTRIB(timeFirstTxPacket)
+                ATTRIB(timeFirstRxPacket)
+                ATTRIB(timeLastTxPacket)
+                ATTRIB(timeLastRxPacket)
+                ATTRIB(delaySum)
+                ATTRIB(jitterSum)
+                ATTRIB(lastDelay)
+                ATTRIB(txBytes)
+                ATTRIB(rxBytes)
+                ATTRIB(txPackets)
+                ATTRIB(rxPackets)
+                ATTRIB(lostPackets)
+                ATTRIB(timesForwarded)
+                << ">\n";
+#undef ATTRIB
+
+
+        indent += 2;
+        for (uint32_t reasonCode = 0; reasonCode < stats.packetsDropped.size(); reasonCode++) {
+            INDENT(indent);
+            os << "<packetsDropped reasonCode=\"" << reasonCode << "\""
+                    << " number=\"" << stats.packetsDropped[reasonCode]
+                    << "\" />\n";
+        }
+        for (uint32_t reasonCode = 0; reasonCode < stats.bytesDropped.size(); reasonCode++) {
+            INDENT(indent);
+            os << "<bytesDropped reasonCode=\"" << reasonCode << "\""
+                    << " bytes=\"" << stats.bytesDropped[reasonCode]
+                    << "\" />\n";
+        }
+        if (enableHistograms) {
+            stats.delayHistogram.SerializeToXmlStream(os, indent, "delayHistogram");
+            stats.jitterHistogram.SerializeToXmlStream(os, indent, "jitterHistogram");
+            stats.packetSizeHistogram.SerializeToXmlStream(os, indent, "packetSizeHistogram");
+            stats.flowInterruptionsHistogram.SerializeToXmlStream(os, indent, "flowInterruptionsHistogram");
+        }
+        indent -= 2;
+
+        INDENT(indent);
+        os << "</Flow>\n";
+    }
+
     std::string
     FlowMonitor::SerializeToXmlString(int indent, bool enableHistograms, bool enableProbes) {
         std::ostringstream os;
@@ -440,6 +476,300 @@ namespace ns3
         os.close();
     }
 
+    void
+    FlowMonitor::EnableStreamingExport(std::string fileName, Time interval, bool enableHistograms, bool dropProbeStats) {
+        NS_ASSERT_MSG(!m_streamFile.is_open(), "The streaming export is already enabled");
+        m_streamFile.open(fileName.c_str(), std::ios::out | std::ios::binary);
+        NS_ABORT_MSG_UNLESS(m_streamFile.is_open(), "Could not open " << fileName);
+        m_streamFile << "# ns-3 FlowMonitor stream v1\n";
+        m_streamInterval = interval;
+        m_streamHistograms = enableHistograms;
+        m_streamDropProbeStats = dropProbeStats;
+        m_streamEvent = Simulator::Schedule(m_streamInterval, &FlowMonitor::PeriodicStreamExport, this);
+    }
+
+    void
+    FlowMonitor::StopStreamingExport() {
+        if (!m_streamFile.is_open()) {
+            return;
+        }
+        Simulator::Cancel(m_streamEvent);
+        CheckForLostPackets();
+        ExportStream(true);
+
+        m_streamFile << "N," << Simulator::Now().GetTimeStep() << "," << m_flowProbes.size() << "\n";
+        for (std::list<Ptr<FlowClassifier> >::iterator iter = m_classifiers.begin();
+                iter != m_classifiers.end();
+                iter++) {
+            std::ostringstream os;
+            (*iter)->SerializeToXmlStream(os, 0);
+            std::istringstream xml(os.str());
+            std::string line;
+            while (std::getline(xml, line)) {
+                m_streamFile << "C," << line << "\n";
+            }
+        }
+        m_streamFile.close();
+        m_streamedFlowStats.clear();
+    }
+
+    void
+    FlowMonitor::PeriodicStreamExport() {
+        ExportStream(m_streamDropProbeStats);
+        m_streamEvent = Simulator::Schedule(m_streamInterval, &FlowMonitor::PeriodicStreamExport, this);
+    }
+
+    /// Write the bins of a histogram that changed since the previous streaming export
+    static void
+    ExportHistogram(std::ostream &os, int64_t now, FlowId flowId, const char *name,
+            Histogram &current, Histogram &last) {
+        for (uint32_t index = 0; index < current.GetNBins(); index++) {
+            uint32_t count = current.GetBinCount(index);
+            if (index < last.GetNBins()) {
+                count -= last.GetBinCount(index);
+            }
+            if (count > 0) {
+                os << "H," << now << "," << flowId << "," << name << ","
+                        << std::setprecision(17) << current.GetBinWidth(index) << std::setprecision(6)
+                        << "," << index << "," << count << "\n";
+            }
+        }
+    }
+
+    void
+    FlowMonitor::ExportStream(bool withProbes) {
+        int64_t now = Simulator::Now().GetTimeStep();
+
+        for (FlowStatsContainerI flowI = m_flowStats.begin(); flowI != m_flowStats.end(); flowI++) {
+            FlowStats &stats = flowI->second;
+            FlowStats &last = m_streamedFlowStats[flowI->first];
+            // every report changes one of these
+            if (stats.txPackets == last.txPackets && stats.rxPackets == last.rxPackets
+                    && stats.lostPackets == last.lostPackets) {
+                continue;
+            }
+
+            m_streamFile << "F," << now << "," << flowI->first
+                    << "," << stats.timeFirstTxPacket.GetTimeStep()
+                    << "," << stats.timeFirstRxPacket.GetTimeStep()
+                    << "," << stats.timeLastTxPacket.GetTimeStep()
+                    << "," << stats.timeLastRxPacket.GetTimeStep()
+                    << "," << (stats.delaySum - last.delaySum).GetTimeStep()
+                    << "," << (stats.jitterSum - last.jitterSum).GetTimeStep()
+                    << "," << stats.lastDelay.GetTimeStep()
+                    << "," << stats.txBytes - last.txBytes
+                    << "," << stats.rxBytes - last.rxBytes
+                    << "," << stats.txPackets - last.txPackets
+                    << "," << stats.rxPackets - last.rxPackets
+                    << "," << stats.lostPackets - last.lostPackets
+                    << "," << stats.timesForwarded - last.timesForwarded
+                    << "\n";
+
+            for (uint32_t reasonCode = 0; reasonCode < stats.packetsDropped.size(); reasonCode++) {
+                uint32_t packets = stats.packetsDropped[reasonCode];
+                uint64_t bytes = stats.bytesDropped[reasonCode];
+                if (reasonCode < last.packetsDropped.size()) {
+                    packets -= last.packetsDropped[reasonCode];
+                    bytes -= last.bytesDropped[reasonCode];
+                }
+                if (packets > 0) {
+                    m_streamFile << "D," << now << "," << flowI->first << "," << reasonCode
+                            << "," << packets << "," << bytes << "\n";
+                }
+            }
+
+            if (m_streamHistograms) {
+                ExportHistogram(m_streamFile, now, flowI->first, "delayHistogram",
+                        stats.delayHistogram, last.delayHistogram);
+                ExportHistogram(m_streamFile, now, flowI->first, "jitterHistogram",
+                        stats.jitterHistogram, last.jitterHistogram);
+                ExportHistogram(m_streamFile, now, flowI->first, "packetSizeHistogram",
+                        stats.packetSizeHistogram, last.packetSizeHistogram);
+                ExportHistogram(m_streamFile, now, flowI->first, "flowInterruptionsHistogram",
+                        stats.flowInterruptionsHistogram, last.flowInterruptionsHistogram);
+            }
+            last = stats;
+        }
+
+        if (!withProbes) {
+            return;
+        }
+        for (uint32_t i = 0; i < m_flowProbes.size(); i++) {
+            FlowProbe::Stats probeStats = m_flowProbes[i]->GetStats();
+            for (FlowProbe::Stats::const_iterator iter = probeStats.begin(); iter != probeStats.end(); iter++) {
+                m_streamFile << "P," << now << "," << i << "," << iter->first
+                        << "," << iter->second.packets
+                        << "," << iter->second.bytes
+                        << "," << iter->second.delayFromFirstProbeSum.GetTimeStep() << "\n";
+                for (uint32_t reasonCode = 0; reasonCode < iter->second.packetsDropped.size(); reasonCode++) {
+                    if (iter->second.packetsDropped[reasonCode] > 0) {
+                        m_streamFile << "Q," << now << "," << i << "," << iter->first << "," << reasonCode
+                                << "," << iter->second.packetsDropped[reasonCode]
+                                << "," << iter->second.bytesDropped[reasonCode] << "\n";
+                    }
+                }
+            }
+            if (m_streamDropProbeStats) {
+                m_flowProbes[i]->ClearStats();
+            }
+        }
+        m_streamFile.flush();
+    }
+
+    void
+    FlowMonitor::ConvertStreamToXmlStream(std::istream &is, std::ostream &os, int indent,
+            bool enableHistograms, bool enableProbes) {
+        FlowStatsContainer flowStats;
+        // flowId --> histogram name --> (bin width, bin index --> count)
+        std::map<FlowId, std::map<std::string, std::pair<double, std::map<uint32_t, uint32_t> > > > histograms;
+        std::vector<FlowProbe::Stats> probes;
+        std::vector<std::string> classifiers;
+
+        std::string line;
+        while (std::getline(is, line)) {
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+            if (line.compare(0, 2, "C,") == 0) {
+                classifiers.push_back(line.substr(2));
+                continue;
+            }
+
+            std::vector<std::string> fields;
+            std::istringstream record(line);
+            std::string field;
+            while (std::getline(record, field, ',')) {
+                fields.push_back(field);
+            }
+#define FIELD(i) std::strtoull(fields.at(i).c_str(), 0, 10)
+#define TIME_FIELD(i) TimeStep(std::strtoll(fields.at(i).c_str(), 0, 10))
+            if (fields[0] == "F") {
+                FlowStats &stats = flowStats[FIELD(2)];
+                stats.timeFirstTxPacket = TIME_FIELD(3);
+                stats.timeFirstRxPacket = TIME_FIELD(4);
+                stats.timeLastTxPacket = TIME_FIELD(5);
+                stats.timeLastRxPacket = TIME_FIELD(6);
+                stats.delaySum += TIME_FIELD(7);
+                stats.jitterSum += TIME_FIELD(8);
+                stats.lastDelay = TIME_FIELD(9);
+                stats.txBytes += FIELD(10);
+                stats.rxBytes += FIELD(11);
+                stats.txPackets += FIELD(12);
+                stats.rxPackets += FIELD(13);
+                stats.lostPackets += FIELD(14);
+                stats.timesForwarded += FIELD(15);
+            } else if (fields[0] == "D") {
+                FlowStats &stats = flowStats[FIELD(2)];
+                uint32_t reasonCode = FIELD(3);
+                if (stats.packetsDropped.size() < reasonCode + 1) {
+                    stats.packetsDropped.resize(reasonCode + 1, 0);
+                    stats.bytesDropped.resize(reasonCode + 1, 0);
+                }
+                stats.packetsDropped[reasonCode] += FIELD(4);
+                stats.bytesDropped[reasonCode] += FIELD(5);
+            } else if (fields[0] == "H") {
+                std::pair<double, std::map<uint32_t, uint32_t> > &histogram = histograms[FIELD(2)][fields.at(3)];
+                histogram.first = std::strtod(fields.at(4).c_str(), 0);
+                histogram.second[FIELD(5)] += FIELD(6);
+            } else if (fields[0] == "P" || fields[0] == "Q") {
+                uint32_t index = FIELD(2);
+                if (probes.size() < index + 1) {
+                    probes.resize(index + 1);
+                }
+                FlowProbe::FlowStats &stats = probes[index][FIELD(3)];
+                if (fields[0] == "P") {
+                    stats.packets += FIELD(4);
+                    stats.bytes += FIELD(5);
+                    stats.delayFromFirstProbeSum += TIME_FIELD(6);
+                } else {
+                    uint32_t reasonCode = FIELD(4);
+                    if (stats.packetsDropped.size() < reasonCode + 1) {
+                        stats.packetsDropped.resize(reasonCode + 1, 0);
+                        stats.bytesDropped.resize(reasonCode + 1, 0);
+                    }
+                    stats.packetsDropped[reasonCode] += FIELD(5);
+                    stats.bytesDropped[reasonCode] += FIELD(6);
+                }
+            } else if (fields[0] == "N") {
+                if (probes.size() < FIELD(2)) {
+                    probes.resize(FIELD(2));
+                }
+            } else {
+                NS_FATAL_ERROR("Unknown flow monitor stream record: " << line);
+            }
+#undef FIELD
+#undef TIME_FIELD
+        }
+
+        INDENT(indent);
+        os << "<FlowMonitor>\n";
+        indent += 2;
+        INDENT(indent);
+        os << "<FlowStats>\n";
+        indent += 2;
+        for (FlowStatsContainerI flowI = flowStats.begin(); flowI != flowStats.end(); flowI++) {
+            if (enableHistograms) {
+                std::map<std::string, std::pair<double, std::map<uint32_t, uint32_t> > > &flowHistograms = histograms[flowI->first];
+                Histogram *target[] = {&flowI->second.delayHistogram, &flowI->second.jitterHistogram,
+                    &flowI->second.packetSizeHistogram, &flowI->second.flowInterruptionsHistogram};
+                const char *names[] = {"delayHistogram", "jitterHistogram",
+                    "packetSizeHistogram", "flowInterruptionsHistogram"};
+                for (uint32_t i = 0; i < 4; i++) {
+                    std::pair<double, std::map<uint32_t, uint32_t> > &histogram = flowHistograms[names[i]];
+                    if (histogram.second.empty()) {
+                        continue;
+                    }
+                    // rebuild the bins by adding values at their middle
+                    target[i]->SetDefaultBinWidth(histogram.first);
+                    for (std::map<uint32_t, uint32_t>::const_iterator bin = histogram.second.begin();
+                            bin != histogram.second.end(); bin++) {
+                        for (uint32_t n = 0; n < bin->second; n++) {
+                            target[i]->AddValue((bin->first + 0.5) * histogram.first);
+                        }
+                    }
+                }
+            }
+            SerializeFlowToXmlStream(os, indent, flowI->first, flowI->second, enableHistograms);
+        }
+        indent -= 2;
+        INDENT(indent);
+        os << "</FlowStats>\n";
+
+        for (std::vector<std::string>::const_iterator iter = classifiers.begin();
+                iter != classifiers.end();
+                iter++) {
+            INDENT(indent);
+            os << *iter << "\n";
+        }
+
+        if (enableProbes) {
+            INDENT(indent);
+            os << "<FlowProbes>\n";
+            indent += 2;
+            for (uint32_t i = 0; i < probes.size(); i++) {
+                FlowProbe::SerializeStatsToXmlStream(os, indent, i, probes[i]);
+            }
+            indent -= 2;
+            INDENT(indent);
+            os << "</FlowProbes>\n";
+        }
+
+        indent -= 2;
+        INDENT(indent);
+        os << "</FlowMonitor>\n";
+    }
+
+    void
+    FlowMonitor::ConvertStreamToXmlFile(std::string streamFileName, std::string fileName,
+            bool enableHistograms, bool enableProbes) {
+        std::ifstream is(streamFileName.c_str(), std::ios::in | std::ios::binary);
+        NS_ABORT_MSG_UNLESS(is.is_open(), "Could not open " << streamFileName);
+        std::ofstream os(fileName.c_str(), std::ios::out | std::ios::binary);
+        os << "<?xml version=\"1.0\" ?>\n";
+        ConvertStreamToXmlStream(is, os, 0, enableHistograms, enableProbes);
+        os.close();
+    }
+
 
 } // namespace ns3
 
@@ -23,6 +23,9 @@
 
 #include <vector>
 #include <map>
+#include <deque>
+#include <unordered_map>
+#include <fstream>
 
 #include "ns3/ptr.h"
 #include "ns3/object.h"
@@ -255,6 +258,51 @@ namespace ns3 {
         /// \param enableProbes if true, include also the per-probe/flow pair statistics in the output
         void SerializeToXmlFile(std::string fileName, bool enableHistograms, bool enableProbes);
 
+        // --- streaming export ---
+
+        /// Start appending, every \p interval, the per-flow changes since the
+        /// previous export to a CSV file, so that long runs do not need to
+        /// build the whole XML report at the end.  One record per line,
+        /// the first field is the record type and the second one the time
+        /// step of the export; times are time steps, bin widths doubles and
+        /// every other field an unsigned integer.  "D" fields are deltas.
+        ///
+        /// - F,t,flowId,timeFirstTxPacket,timeFirstRxPacket,timeLastTxPacket,timeLastRxPacket,
+        ///   D(delaySum),D(jitterSum),lastDelay,D(txBytes),D(rxBytes),D(txPackets),D(rxPackets),
+        ///   D(lostPackets),D(timesForwarded)
+        /// - D,t,flowId,reasonCode,D(packetsDropped),D(bytesDropped)
+        /// - H,t,flowId,histogram,binWidth,index,D(count)
+        /// - P,t,probeIndex,flowId,D(packets),D(bytes),D(delayFromFirstProbeSum)
+        /// - Q,t,probeIndex,flowId,reasonCode,D(packetsDropped),D(bytesDropped)
+        /// - N,t,number of probes (written when the export is stopped)
+        /// - C,xml: one line of the FlowClassifier XML (written when the export is stopped)
+        ///
+        /// \param fileName name or path of the output file that will be created
+        /// \param interval export interval
+        /// \param enableHistograms if true, include also the histogram changes
+        /// \param dropProbeStats if true, export the per-probe statistics
+        ///        every interval and discard them from the probes; otherwise
+        ///        they are only exported when the export is stopped
+        void EnableStreamingExport(std::string fileName, Time interval, bool enableHistograms, bool dropProbeStats);
+        /// Export the remaining changes and close the streaming export file.
+        /// Called on dispose if the export is still running.
+        void StopStreamingExport();
+        /// Convert a streaming export file to the XML format of SerializeToXmlStream
+        /// \param is the streaming export input
+        /// \param os the output stream
+        /// \param indent number of spaces to use as base indentation level
+        /// \param enableHistograms if true, include also the histograms in the output
+        /// \param enableProbes if true, include also the per-probe/flow pair statistics in the output
+        static void ConvertStreamToXmlStream(std::istream &is, std::ostream &os, int indent,
+                bool enableHistograms, bool enableProbes);
+        /// Same as ConvertStreamToXmlStream, but reads and writes files, as SerializeToXmlFile
+        /// \param streamFileName name or path of the streaming export file
+        /// \param fileName name or path of the output file that will be created
+        /// \param enableHistograms if true, include also the histograms in the output
+        /// \param enableProbes if true, include also the per-probe/flow pair statistics in the output
+        static void ConvertStreamToXmlFile(std::string streamFileName, std::string fileName,
+                bool enableHistograms, bool enableProbes);
+
 
     protected:
 
@@ -264,19 +312,39 @@ namespace ns3 {
     private:
 
         /// Structure to represent a single tracked packet data
-
         struct TrackedPacket {
             Time firstSeenTime; //!< absolute time when the packet was first seen by a probe
             Time lastSeenTime; //!< absolute time when the packet was last seen by a probe
             uint32_t timesForwarded; //!< number of times the packet was reportedly forwarded
+            FlowStats *stats; //!< statistics of the flow the packet belongs to
         };
 
+        /// Structure to represent a pending lost-packet check
+        struct TrackedPacketExpiry {
+            Time lastSeenTime; //!< lastSeenTime of the packet when the check was queued
+            uint64_t key; //!< key of the packet in m_trackedPackets
+        };
+
+        /// Build the m_trackedPackets key of a packet
+        /// \param flowId flow identification
+        /// \param packetId Packet ID
+        /// \returns the key
+        static uint64_t GetTrackedPacketKey(FlowId flowId, FlowPacketId packetId);
+
         /// FlowId --> FlowStats
         FlowStatsContainer m_flowStats;
+        /// FlowId --> FlowStats, hashed index on m_flowStats (std::map entries are never moved)
+        std::unordered_map<FlowId, FlowStats *> m_flowStatsIndex;
 
         /// (FlowId,PacketId) --> TrackedPacket
-        typedef std::map< std::pair<FlowId, FlowPacketId>, TrackedPacket> TrackedPacketMap;
+        typedef std::unordered_map<uint64_t, TrackedPacket> TrackedPacketMap;
         TrackedPacketMap m_trackedPackets; //!< Tracked packets
+        /// Lost-packet checks, in lastSeenTime order.  A check is stale, and
+        /// is dropped, when the packet is no longer tracked or has been seen
+        /// again since (a newer check was queued then).
+        std::deque<TrackedPacketExpiry> m_trackedPacketsExpiry;
+        uint32_t m_reservedFlows; //!< Number of flows to reserve room for
+        uint32_t m_reservedTrackedPackets; //!< Number of tracked packets to reserve room for
         Time m_maxPerHopDelay; //!< Minimum per-hop delay
         FlowProbeContainer m_flowProbes; //!< all the FlowProbes
 
@@ -299,6 +367,29 @@ namespace ns3 {
 
         /// Periodic function to check for lost packets and prune statistics
         void PeriodicCheckForLostPackets();
+
+        /// Serializes a single flow in XML format
+        /// \param os the output stream
+        /// \param indent number of spaces to use as base indentation level
+        /// \param flowId the Flow identification
+        /// \param stats the stats of the flow
+        /// \param enableHistograms if true, include also the histograms in the output
+        static void SerializeFlowToXmlStream(std::ostream &os, int indent, FlowId flowId,
+                const FlowStats &stats, bool enableHistograms);
+
+        /// Write the changes since the previous streaming export
+        /// \param withProbes if true, write the per-probe statistics
+        void ExportStream(bool withProbes);
+        /// Periodic function of the streaming export
+        void PeriodicStreamExport();
+
+        std::ofstream m_streamFile; //!< Streaming export file
+        Time m_streamInterval; //!< Streaming export interval
+        bool m_streamHistograms; //!< Export histogram changes
+        bool m_streamDropProbeStats; //!< Export and discard the probe stats every interval
+        EventId m_streamEvent; //!< Next streaming export
+        /// Stats as of the previous streaming export
+        FlowStatsContainer m_streamedFlowStats;
     };
 
 
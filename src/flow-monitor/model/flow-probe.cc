@@ -74,8 +74,18 @@ namespace ns3
         return m_stats;
     }
 
+    void
+    FlowProbe::ClearStats() {
+        m_stats.clear();
+    }
+
     void
     FlowProbe::SerializeToXmlStream(std::ostream &os, int indent, uint32_t index) const {
+        SerializeStatsToXmlStream(os, indent, index, m_stats);
+    }
+
+    void
+    FlowProbe::SerializeStatsToXmlStream(std::ostream &os, int indent, uint32_t index, const Stats &stats) {
 #define INDENT(level) for (int __xpto = 0; __xpto < level; __xpto++) os << ' ';
 
         INDENT(indent);
@@ -83,7 +93,7 @@ namespace ns3
 
         indent += 2;
 
-        for (Stats::const_iterator iter = m_stats.begin(); iter != m_stats.end(); iter++) {
+        for (Stats::const_iterator iter = stats.begin(); iter != stats.end(); iter++) {
             INDENT(indent);
             os << "<FlowStats "
                     << " flowId=\"" << iter->first << "\""
@@ -111,6 +121,8 @@ namespace ns3
         indent -= 2;
         INDENT(indent);
         os << "</FlowProbe>\n";
+
+#undef INDENT
     }
 
 
@@ -98,12 +98,23 @@ namespace ns3 {
         /// \returns the partial flow statistics
         Stats GetStats() const;
 
+        /// Discard the partial flow statistics stored in this probe, e.g.
+        /// after they have been exported by the FlowMonitor
+        void ClearStats();
+
         /// Serializes the results to an std::ostream in XML format
         /// \param os the output stream
         /// \param indent number of spaces to use as base indentation level
         /// \param index FlowProbe index
         void SerializeToXmlStream(std::ostream &os, int indent, uint32_t index) const;
 
+        /// Serializes partial flow statistics to an std::ostream in XML format
+        /// \param os the output stream
+        /// \param indent number of spaces to use as base indentation level
+        /// \param index FlowProbe index
+        /// \param stats the partial flow statistics
+        static void SerializeStatsToXmlStream(std::ostream &os, int indent, uint32_t index, const Stats &stats);
+
     protected:
         Ptr<FlowMonitor> m_flowMonitor; //!< the FlowMonitor instance
         Stats m_stats; //!< The flow stats
@@ -81,6 +81,16 @@ namespace ns3
                 t1.destinationPort == t2.destinationPort);
     }
 
+    size_t
+    Ipv6FlowClassifier::FiveTupleHash::operator()(const FiveTuple &t) const {
+        Ipv6AddressHash addressHash;
+        size_t h = addressHash(t.sourceAddress);
+        h = h * 31 + addressHash(t.destinationAddress);
+        h = h * 31 + t.protocol;
+        h = h * 31 + ((static_cast<size_t> (t.sourcePort) << 16) | t.destinationPort);
+        return h;
+    }
+
     Ipv6FlowClassifier::Ipv6FlowClassifier() {
     }
 
@@ -128,20 +138,21 @@ namespace ns3
         tuple.destinationPort = dstPort;
 
         // try to insert the tuple, but check if it already exists
-        std::pair<std::map<FiveTuple, FlowId>::iterator, bool> insert
-                = m_flowMap.insert(std::pair<FiveTuple, FlowId> (tuple, 0));
+        FlowState state = {0, 0};
+        std::pair<std::unordered_map<FiveTuple, FlowState, FiveTupleHash>::iterator, bool> insert
+                = m_flowCache.insert(std::make_pair(tuple, state));
 
         // if the insertion succeeded, we need to assign this tuple a new flow identifier
         if (insert.second) {
             FlowId newFlowId = GetNewFlowId();
-            insert.first->second = newFlowId;
-            m_flowPktIdMap[newFlowId] = 0;
+            insert.first->second.flowId = newFlowId;
+            m_flowMap[tuple] = newFlowId;
         } else {
-            m_flowPktIdMap[insert.first->second]++;
+            insert.first->second.lastPacketId++;
         }
 
-        *out_flowId = insert.first->second;
-        *out_packetId = m_flowPktIdMap[*out_flowId];
+        *out_flowId = insert.first->second.flowId;
+        *out_packetId = insert.first->second.lastPacketId;
 
         return true;
     }
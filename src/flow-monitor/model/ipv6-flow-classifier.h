@@ -24,6 +24,7 @@
 
 #include <stdint.h>
 #include <map>
+#include <unordered_map>
 
 #include "ns3/ipv6-header.h"
 #include "ns3/flow-classifier.h"
@@ -74,10 +75,23 @@ namespace ns3 {
 
     private:
 
-        /// Map to Flows Identifiers to FlowIds
+        /// Hash function for FiveTuple
+        struct FiveTupleHash {
+            /// \param t the FiveTuple
+            /// \returns the hash of the tuple
+            size_t operator()(const FiveTuple &t) const;
+        };
+
+        /// Per-flow state kept in the flow cache
+        struct FlowState {
+            FlowId flowId; //!< FlowId of the tuple
+            FlowPacketId lastPacketId; //!< Last FlowPacketId given out for the flow
+        };
+
+        /// Map to Flows Identifiers to FlowIds, ordered for serialization
         std::map<FiveTuple, FlowId> m_flowMap;
-        /// Map to FlowIds to FlowPacketId
-        std::map<FlowId, FlowPacketId> m_flowPktIdMap;
+        /// Flow cache: hashed FiveTuple to FlowState, used to classify packets
+        std::unordered_map<FiveTuple, FlowState, FiveTupleHash> m_flowCache;
 
     };
 
@@ -0,0 +1,133 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation;
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "ns3/flow-monitor.h"
+#include "ns3/flow-probe.h"
+#include "ns3/ipv6-flow-classifier.h"
+#include "ns3/ipv6-header.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include <fstream>
+#include <sstream>
+
+using namespace ns3;
+
+/// FlowProbe that only forwards reports to the FlowMonitor
+class StreamTestFlowProbe : public FlowProbe {
+    public :
+    /// \param monitor the FlowMonitor
+    StreamTestFlowProbe(Ptr<FlowMonitor> monitor)
+    : FlowProbe(monitor) {
+    }
+};
+
+/// Check that a streaming export converts to the XML report of the FlowMonitor
+class FlowMonitorStreamTestCase : public ns3::TestCase{
+    private :
+    /// Run the scenario
+    /// \param dropProbeStats discard the probe stats after each export
+    /// \param streamXml the converted streaming export
+    /// \returns the XML report of the FlowMonitor
+    std::string Run(bool dropProbeStats, std::string &streamXml);
+
+    public :
+    FlowMonitorStreamTestCase();
+    virtual void DoRun(void);
+
+};
+
+FlowMonitorStreamTestCase::FlowMonitorStreamTestCase()
+: ns3::TestCase("Streaming export converts to the XML report") {
+}
+
+std::string
+FlowMonitorStreamTestCase::Run(bool dropProbeStats, std::string &streamXml) {
+    Ptr<FlowMonitor> monitor = CreateObject<FlowMonitor> ();
+    Ptr<FlowProbe> source = Create<StreamTestFlowProbe> (monitor);
+    Ptr<FlowProbe> router = Create<StreamTestFlowProbe> (monitor);
+    Create<StreamTestFlowProbe> (monitor); // a probe that sees nothing
+    Ptr<Ipv6FlowClassifier> classifier = Create<Ipv6FlowClassifier> ();
+    monitor->AddFlowClassifier(classifier);
+    monitor->StartRightNow();
+
+    std::string fileName = CreateTempDirFilename("flows.csv");
+    monitor->EnableStreamingExport(fileName, Seconds(2), true, dropProbeStats);
+
+    Ipv6Header header;
+    header.SetDestinationAddress(Ipv6Address("2001:2::1"));
+    header.SetNextHeader(17);
+    uint8_t ports[4] = {0x13, 0x88, 0x00, 0x09};
+    Ptr<Packet> payload = Create<Packet> (ports, 4);
+
+    for (uint32_t i = 0; i < 60; i++) {
+        header.SetSourceAddress(i % 3 ? Ipv6Address("2001:1::1") : Ipv6Address("2001:1::2"));
+        uint32_t flowId, packetId;
+        classifier->Classify(header, payload, &flowId, &packetId);
+        // irregular send times, so that flows are idle during some intervals
+        Time sent = MilliSeconds(i * i * 7);
+        uint32_t size = 100 + (i % 7) * 30;
+        Time hop = MilliSeconds(3 + (i * 13) % 40);
+        Simulator::Schedule(sent, &FlowMonitor::ReportFirstTx, monitor, source, flowId, packetId, size);
+        Simulator::Schedule(sent + hop, &FlowMonitor::ReportForwarding, monitor, router, flowId, packetId, size);
+        if (i % 11 == 5) {
+            Simulator::Schedule(sent + hop * 2, &FlowMonitor::ReportDrop, monitor, router, flowId, packetId, size, i % 2 ? 3 : 0);
+        } else if (i % 13 != 7) {
+            // i % 13 == 7 are never seen again and become lost
+            Simulator::Schedule(sent + hop * 2, &FlowMonitor::ReportLastRx, monitor, router, flowId, packetId, size);
+        }
+    }
+    Simulator::Stop(Seconds(40));
+    Simulator::Run();
+
+    monitor->StopStreamingExport();
+    std::string xml = monitor->SerializeToXmlString(0, true, true);
+    Simulator::Destroy();
+
+    std::ifstream is(fileName.c_str());
+    std::ostringstream os;
+    FlowMonitor::ConvertStreamToXmlStream(is, os, 0, true, true);
+    streamXml = os.str();
+    return xml;
+}
+
+void
+FlowMonitorStreamTestCase::DoRun(void) {
+    std::string streamXml;
+    std::string xml = Run(false, streamXml);
+    NS_TEST_EXPECT_MSG_NE(xml.find("reasonCode=\"3\""), std::string::npos, "The scenario drops packets");
+    NS_TEST_EXPECT_MSG_NE(xml.find("<bin"), std::string::npos, "The scenario fills histograms");
+    NS_TEST_EXPECT_MSG_NE(xml.find("<FlowProbe index=\"2\">"), std::string::npos, "All probes are reported");
+    NS_TEST_EXPECT_MSG_EQ(streamXml, xml, "Converted streaming export");
+
+    // the probe stats were discarded from the probes, but not from the export
+    std::string droppedStreamXml;
+    Run(true, droppedStreamXml);
+    NS_TEST_EXPECT_MSG_EQ(droppedStreamXml, xml, "Converted streaming export without probe stats");
+}
+
+/// FlowMonitor streaming export TestSuite
+class FlowMonitorStreamTestSuite : public TestSuite {
+    public :
+    FlowMonitorStreamTestSuite();
+};
+
+FlowMonitorStreamTestSuite::FlowMonitorStreamTestSuite()
+: TestSuite("flow-monitor-stream", UNIT) {
+    AddTestCase(new FlowMonitorStreamTestCase, TestCase::QUICK);
+}
+
+static FlowMonitorStreamTestSuite g_flowMonitorStreamTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,153 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation;
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "ns3/flow-monitor.h"
+#include "ns3/flow-probe.h"
+#include "ns3/ipv6-flow-classifier.h"
+#include "ns3/ipv6-header.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+
+using namespace ns3;
+
+/// FlowProbe that only forwards reports to the FlowMonitor
+class TrackingTestFlowProbe : public FlowProbe {
+    public :
+    /// \param monitor the FlowMonitor
+    TrackingTestFlowProbe(Ptr<FlowMonitor> monitor)
+    : FlowProbe(monitor) {
+    }
+};
+
+/// Check the lost-packet detection of the FlowMonitor
+class FlowMonitorLostPacketsTestCase : public ns3::TestCase{
+    private :
+    public :
+    FlowMonitorLostPacketsTestCase();
+    virtual void DoRun(void);
+
+};
+
+FlowMonitorLostPacketsTestCase::FlowMonitorLostPacketsTestCase()
+: ns3::TestCase("Lost packets are detected from the last time they were seen") {
+}
+
+void
+FlowMonitorLostPacketsTestCase::DoRun(void) {
+    Ptr<FlowMonitor> monitor = CreateObject<FlowMonitor> ();
+    Ptr<FlowProbe> probe = Create<TrackingTestFlowProbe> (monitor);
+    monitor->StartRightNow();
+
+    // flow 1: packet 0 is never seen again, packet 1 is forwarded at 5s,
+    // packet 2 is received at 1s; flow 2: packet 0 is dropped
+    monitor->ReportFirstTx(probe, 1, 0, 100);
+    monitor->ReportFirstTx(probe, 1, 1, 100);
+    monitor->ReportFirstTx(probe, 1, 2, 100);
+    monitor->ReportFirstTx(probe, 2, 0, 50);
+    Simulator::Schedule(Seconds(1), &FlowMonitor::ReportLastRx, monitor, probe, 1, 2, 100);
+    Simulator::Schedule(Seconds(1), &FlowMonitor::ReportDrop, monitor, probe, 2, 0, 50, 3);
+    Simulator::Schedule(Seconds(5), &FlowMonitor::ReportForwarding, monitor, probe, 1, 1, 100);
+    Simulator::Stop(Seconds(12));
+    Simulator::Run();
+
+    // at 12s, packet 0 was last seen 12s ago and packet 1 7s ago
+    const FlowMonitor::FlowStatsContainer &stats = monitor->GetFlowStats();
+    NS_TEST_EXPECT_MSG_EQ(stats.size(), 2, "Two flows");
+    NS_TEST_EXPECT_MSG_EQ(stats.find(1)->second.lostPackets, 1, "Only the packet not seen for 10s is lost");
+    NS_TEST_EXPECT_MSG_EQ(stats.find(1)->second.rxPackets, 1, "One packet received");
+    NS_TEST_EXPECT_MSG_EQ(stats.find(2)->second.lostPackets, 1, "The dropped packet is lost once");
+
+    monitor->CheckForLostPackets(Seconds(7));
+    NS_TEST_EXPECT_MSG_EQ(stats.find(1)->second.lostPackets, 2, "The forwarded packet is lost after 7s");
+    NS_TEST_EXPECT_MSG_EQ(stats.find(1)->second.timesForwarded, 0, "Lost packets do not count as forwarded");
+
+    // reports on packets no longer tracked are ignored
+    monitor->ReportLastRx(probe, 1, 0, 100);
+    NS_TEST_EXPECT_MSG_EQ(stats.find(1)->second.rxPackets, 1, "Unknown packet not received");
+
+    Simulator::Destroy();
+}
+
+/// Check the flow and packet identifiers given by the Ipv6FlowClassifier
+class Ipv6FlowClassifierTestCase : public ns3::TestCase{
+    private :
+    public :
+    Ipv6FlowClassifierTestCase();
+    virtual void DoRun(void);
+
+};
+
+Ipv6FlowClassifierTestCase::Ipv6FlowClassifierTestCase()
+: ns3::TestCase("Ipv6FlowClassifier flow and packet identifiers") {
+}
+
+void
+Ipv6FlowClassifierTestCase::DoRun(void) {
+    Ptr<Ipv6FlowClassifier> classifier = Create<Ipv6FlowClassifier> ();
+
+    Ipv6Header a;
+    a.SetSourceAddress(Ipv6Address("2001:1::1"));
+    a.SetDestinationAddress(Ipv6Address("2001:2::1"));
+    a.SetNextHeader(17);
+    Ipv6Header b = a;
+    b.SetSourceAddress(Ipv6Address("2001:1::2"));
+
+    uint8_t ports[4] = {0x13, 0x88, 0x00, 0x09};
+    Ptr<Packet> payload = Create<Packet> (ports, 4);
+
+    uint32_t flowId, packetId;
+    NS_TEST_ASSERT_MSG_EQ(classifier->Classify(b, payload, &flowId, &packetId), true, "UDP is classified");
+    NS_TEST_EXPECT_MSG_EQ(flowId, 1, "First flow");
+    NS_TEST_EXPECT_MSG_EQ(packetId, 0, "First packet");
+    classifier->Classify(a, payload, &flowId, &packetId);
+    NS_TEST_EXPECT_MSG_EQ(flowId, 2, "Second flow");
+    NS_TEST_EXPECT_MSG_EQ(packetId, 0, "First packet");
+    classifier->Classify(b, payload, &flowId, &packetId);
+    NS_TEST_EXPECT_MSG_EQ(flowId, 1, "First flow again");
+    NS_TEST_EXPECT_MSG_EQ(packetId, 1, "Second packet");
+    classifier->Classify(b, payload, &flowId, &packetId);
+    NS_TEST_EXPECT_MSG_EQ(packetId, 2, "Third packet");
+
+    Ipv6Header icmp = a;
+    icmp.SetNextHeader(58);
+    NS_TEST_EXPECT_MSG_EQ(classifier->Classify(icmp, payload, &flowId, &packetId), false, "ICMPv6 is not classified");
+
+    NS_TEST_EXPECT_MSG_EQ(classifier->FindFlow(1).sourceAddress, Ipv6Address("2001:1::2"), "FindFlow");
+
+    // flows are serialized in tuple order, not in FlowId order
+    std::ostringstream os;
+    classifier->SerializeToXmlStream(os, 0);
+    NS_TEST_EXPECT_MSG_EQ(os.str(),
+            "<Ipv6FlowClassifier>\n"
+            "  <Flow flowId=\"2\" sourceAddress=\"2001:1::1\" destinationAddress=\"2001:2::1\" protocol=\"17\" sourcePort=\"5000\" destinationPort=\"9\" />\n"
+            "  <Flow flowId=\"1\" sourceAddress=\"2001:1::2\" destinationAddress=\"2001:2::1\" protocol=\"17\" sourcePort=\"5000\" destinationPort=\"9\" />\n"
+            "</Ipv6FlowClassifier>\n", "XML output");
+}
+
+/// FlowMonitor tracking TestSuite
+class FlowMonitorTrackingTestSuite : public TestSuite {
+    public :
+    FlowMonitorTrackingTestSuite();
+};
+
+FlowMonitorTrackingTestSuite::FlowMonitorTrackingTestSuite()
+: TestSuite("flow-monitor-tracking", UNIT) {
+    AddTestCase(new FlowMonitorLostPacketsTestCase, TestCase::QUICK);
+    AddTestCase(new Ipv6FlowClassifierTestCase, TestCase::QUICK);
+}
+
+static FlowMonitorTrackingTestSuite g_flowMonitorTrackingTestSuite; //!< Static variable for test initialization
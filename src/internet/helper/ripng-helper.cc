@@ -22,8 +22,14 @@
 #include "ns3/node-list.h"
 #include "ns3/ipv6-list-routing.h"
 #include "ns3/ripng.h"
+#include "ns3/ipv6-static-routing-helper.h"
+#include "ns3/simulator.h"
+#include "ns3/abort.h"
+#include "ns3/channel.h"
 #include "ripng-helper.h"
 
+#include <queue>
+
 namespace ns3
 {
 
@@ -153,5 +159,166 @@ namespace ns3
         m_interfaceMetrics[node][interface] = metric;
     }
 
-}
+    void RipNgHelper::PopulateConvergedRoutes(NodeContainer c) const {
+        /// A node interface attached to a channel
+        struct Attachment {
+            uint32_t node; //!< index of the node in c
+            uint32_t interface; //!< interface index
+            Ipv6Address linkLocal; //!< link-local address of the interface
+        };
+        typedef std::pair<Ipv6Address, uint8_t> NetworkKey;
+
+        // RIPng neighbors are the nodes sharing a channel; destinations are the global prefixes
+        std::map<Ptr<Channel>, std::vector<Attachment> > channels;
+        std::map<NetworkKey, std::set<uint32_t> > networks;
+        for (uint32_t n = 0; n < c.GetN(); n++) {
+            Ptr<Ipv6> ipv6 = c.Get(n)->GetObject<Ipv6> ();
+            NS_ASSERT_MSG(ipv6, "Ipv6 not installed on node");
+
+            for (uint32_t i = 0; i < ipv6->GetNInterfaces(); i++) {
+                if (!ipv6->IsUp(i)) {
+                    continue;
+                }
+
+                for (uint32_t j = 0; j < ipv6->GetNAddresses(i); j++) {
+                    Ipv6InterfaceAddress address = ipv6->GetAddress(i, j);
+                    if (address.GetScope() == Ipv6InterfaceAddress::GLOBAL) {
+                        NetworkKey key(address.GetAddress().CombinePrefix(address.GetPrefix()), address.GetPrefix().GetPrefixLength());
+                        networks[key].insert(n);
+                    } else if (address.GetScope() == Ipv6InterfaceAddress::LINKLOCAL) {
+                        Ptr<Channel> channel = ipv6->GetNetDevice(i)->GetChannel();
+                        if (channel) {
+                            Attachment attachment = {n, i, address.GetAddress()};
+                            channels[channel].push_back(attachment);
+                        }
+                    }
+                }
+            }
+        }
+
+        // the channels each node is attached to
+        std::vector<std::vector<const std::vector<Attachment> *> > links(c.GetN());
+        for (std::map<Ptr<Channel>, std::vector<Attachment> >::const_iterator it = channels.begin(); it != channels.end(); it++) {
+            for (uint32_t a = 0; a < it->second.size(); a++) {
+                if (links[it->second[a].node].empty() || links[it->second[a].node].back() != &it->second) {
+                    links[it->second[a].node].push_back(&it->second);
+                }
+            }
+        }
+
+        Ipv6StaticRoutingHelper staticRoutingHelper;
+        std::vector<Ptr<Ipv6StaticRouting> > staticRouting(c.GetN());
+        std::vector<std::map<uint32_t, uint8_t> > interfaceMetrics(c.GetN());
+        std::vector<std::set<uint32_t> > interfaceExclusions(c.GetN());
+        for (uint32_t n = 0; n < c.GetN(); n++) {
+            staticRouting[n] = staticRoutingHelper.GetStaticRouting(c.Get(n)->GetObject<Ipv6> ());
+            NS_ABORT_MSG_IF(!staticRouting[n], "RipNgHelper::PopulateConvergedRoutes - Ipv6StaticRouting not installed on node " << c.Get(n)->GetId());
 
+            std::map< Ptr<Node>, std::map<uint32_t, uint8_t> >::const_iterator metrics = m_interfaceMetrics.find(c.Get(n));
+            if (metrics != m_interfaceMetrics.end()) {
+                interfaceMetrics[n] = metrics->second;
+            }
+            std::map< Ptr<Node>, std::set<uint32_t> >::const_iterator exclusions = m_interfaceExclusions.find(c.Get(n));
+            if (exclusions != m_interfaceExclusions.end()) {
+                interfaceExclusions[n] = exclusions->second;
+            }
+        }
+
+        const uint32_t infinity = 20;
+        for (std::map<NetworkKey, std::set<uint32_t> >::const_iterator it = networks.begin(); it != networks.end(); it++) {
+            // shortest paths towards the network, as distance-vector routing converges to
+            std::vector<uint32_t> metric(c.GetN(), infinity);
+            std::vector<uint32_t> outInterface(c.GetN());
+            std::vector<Ipv6Address> nextHop(c.GetN());
+            std::priority_queue<std::pair<uint32_t, uint32_t>, std::vector<std::pair<uint32_t, uint32_t> >,
+                    std::greater<std::pair<uint32_t, uint32_t> > > queue;
+
+            for (std::set<uint32_t>::const_iterator n = it->second.begin(); n != it->second.end(); n++) {
+                metric[*n] = 1;
+                queue.push(std::make_pair(1, *n));
+            }
+
+            while (!queue.empty()) {
+                uint32_t current = queue.top().first;
+                uint32_t v = queue.top().second;
+                queue.pop();
+                if (current != metric[v]) {
+                    continue;
+                }
+
+                for (uint32_t l = 0; l < links[v].size(); l++) {
+                    const std::vector<Attachment> &link = *links[v][l];
+                    Ipv6Address sender;
+                    for (uint32_t a = 0; a < link.size(); a++) {
+                        // v does not announce on excluded interfaces
+                        if (link[a].node == v && !interfaceExclusions[v].count(link[a].interface)) {
+                            sender = link[a].linkLocal;
+                            break;
+                        }
+                    }
+                    if (sender.IsAny()) {
+                        continue;
+                    }
+
+                    for (uint32_t a = 0; a < link.size(); a++) {
+                        uint32_t u = link[a].node;
+                        uint32_t interface = link[a].interface;
+                        if (u == v || interfaceExclusions[u].count(interface)) {
+                            continue;
+                        }
+
+                        uint32_t interfaceMetric = 1;
+                        if (interfaceMetrics[u].find(interface) != interfaceMetrics[u].end()) {
+                            interfaceMetric = interfaceMetrics[u][interface];
+                        }
+                        uint32_t candidate = std::min(current + interfaceMetric, infinity);
+                        if (candidate < metric[u]) {
+                            metric[u] = candidate;
+                            outInterface[u] = interface;
+                            nextHop[u] = sender;
+                            queue.push(std::make_pair(candidate, u));
+                        }
+                    }
+                }
+            }
+
+            for (uint32_t n = 0; n < c.GetN(); n++) {
+                if (!it->second.count(n) && metric[n] < infinity) {
+                    staticRouting[n]->AddNetworkRouteTo(it->first.first, Ipv6Prefix(it->first.second), nextHop[n], outInterface[n], metric[n]);
+                }
+            }
+        }
+    }
+
+    void RipNgHelper::Freeze(NodeContainer c, Time delay) const {
+        for (NodeContainer::Iterator i = c.Begin(); i != c.End(); ++i) {
+            Ptr<RipNg> ripng = GetRipNg(*i);
+            if (ripng) {
+                Simulator::Schedule(delay, &RipNg::Freeze, ripng);
+            }
+        }
+    }
+
+    Ptr<RipNg> RipNgHelper::GetRipNg(Ptr<Node> node) {
+        Ptr<Ipv6> ipv6 = node->GetObject<Ipv6> ();
+        NS_ASSERT_MSG(ipv6, "Ipv6 not installed on node");
+        Ptr<Ipv6RoutingProtocol> proto = ipv6->GetRoutingProtocol();
+        Ptr<RipNg> ripng = DynamicCast<RipNg> (proto);
+        if (ripng) {
+            return ripng;
+        }
+        // RIPng may also be in a list
+        Ptr<Ipv6ListRouting> list = DynamicCast<Ipv6ListRouting> (proto);
+        if (list) {
+            int16_t priority;
+            for (uint32_t i = 0; i < list->GetNRoutingProtocols(); i++) {
+                ripng = DynamicCast<RipNg> (list->GetRoutingProtocol(i, priority));
+                if (ripng) {
+                    return ripng;
+                }
+            }
+        }
+        return 0;
+    }
+
+}
@@ -25,9 +25,12 @@
 #include "ns3/ipv6-routing-helper.h"
 #include "ns3/node-container.h"
 #include "ns3/node.h"
+#include "ns3/nstime.h"
 
 namespace ns3 {
 
+    class RipNg;
+
     /**
      * \brief Helper class that adds RIPng routing to nodes.
      *
@@ -127,7 +130,42 @@ namespace ns3 {
          */
         void SetInterfaceMetric(Ptr<Node> node, uint32_t interface, uint8_t metric);
 
+        /**
+         * \brief Install in Ipv6StaticRouting the routes RIPng would converge to.
+         *
+         * The routes are computed offline from the addresses currently assigned
+         * to the nodes: two nodes are neighbors when up interfaces with a
+         * link-local address are attached to the same channel, and the
+         * destinations are the prefixes of the global addresses. Every node
+         * learns the networks of the other nodes through the neighbor with the
+         * lowest RIPng metric, taking into account interface metrics and
+         * exclusions set in this helper. The next hop is the link-local address
+         * of the neighbor on the shared channel, as with RIPng.
+         *
+         * The nodes must have an Ipv6StaticRouting (possibly in an Ipv6ListRouting),
+         * and need not run RIPng at all. Call this function after the addresses
+         * have been assigned.
+         *
+         * \param c the routers, i.e., the nodes that would run RIPng
+         */
+        void PopulateConvergedRoutes(NodeContainer c) const;
+
+        /**
+         * \brief Freeze the RIPng routing tables after a warm-up period.
+         *
+         * \param c the nodes
+         * \param delay time after which RIPng stops (see RipNg::Freeze)
+         */
+        void Freeze(NodeContainer c, Time delay) const;
+
     private:
+        /**
+         * \brief Get the RIPng instance of a node.
+         * \param node the node
+         * \return the RIPng routing protocol, or 0 if the node does not run RIPng
+         */
+        static Ptr<RipNg> GetRipNg(Ptr<Node> node);
+
         /**
          * \brief Assignment operator declared private and not implemented to disallow
          * assignment and prevent the compiler from happily inserting its own.
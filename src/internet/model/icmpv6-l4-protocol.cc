@@ -30,6 +30,7 @@
 #include "ns3/ipv6-route.h"
 #include "ns3/pointer.h"
 #include "ns3/string.h"
+#include "ns3/socket.h"
 
 #include "ipv6-raw-socket-factory-impl.h"
 #include "ipv6-l3-protocol.h"
@@ -775,6 +776,10 @@ namespace ns3
 
         tag.SetTtl(ttl);
         packet->AddPacketTag(tag);
+        // neighbor discovery and errors go ahead of the data on prioritizing MACs
+        SocketPriorityTag priorityTag;
+        priorityTag.SetPriority(Socket::NS3_PRIO_CONTROL);
+        packet->ReplacePacketTag(priorityTag);
         m_downTarget(packet, src, dst, PROT_NUMBER, 0);
     }
 
@@ -800,6 +805,9 @@ namespace ns3
             NS_LOG_LOGIC("Route exists");
             tag.SetTtl(ttl);
             packet->AddPacketTag(tag);
+            SocketPriorityTag priorityTag;
+            priorityTag.SetPriority(Socket::NS3_PRIO_CONTROL);
+            packet->ReplacePacketTag(priorityTag);
             Ipv6Address src = route->GetSource();
 
             icmpv6Hdr.CalculatePseudoHeaderChecksum(src, dst, packet->GetSize() + icmpv6Hdr.GetSerializedSize(), PROT_NUMBER);
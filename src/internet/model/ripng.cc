@@ -44,7 +44,8 @@ namespace ns3
     NS_OBJECT_ENSURE_REGISTERED(RipNg);
 
     RipNg::RipNg()
-            : m_ipv6(0), m_splitHorizonStrategy(RipNg::POISON_REVERSE), m_initialized(false) {
+            : m_routeFrontOrder(0), m_routeBackOrder(-1), m_nLookups(0),
+            m_ipv6(0), m_splitHorizonStrategy(RipNg::POISON_REVERSE), m_initialized(false), m_frozen(false) {
         m_rng = CreateObject<UniformRandomVariable> ();
     }
 
@@ -468,6 +469,7 @@ namespace ns3
             delete j->first;
         }
         m_routes.clear();
+        m_routeIndex.Clear();
 
         m_nextTriggeredUpdate.Cancel();
         m_nextUnsolicitedUpdate.Cancel();
@@ -491,7 +493,6 @@ namespace ns3
         NS_LOG_FUNCTION(this << dst << interface);
 
         Ptr<Ipv6Route> rtentry = 0;
-        uint16_t longestMask = 0;
 
         /* when sending on link-local multicast, there have to be interface specified */
         if (dst.IsLinkLocalMulticast()) {
@@ -504,46 +505,34 @@ namespace ns3
             return rtentry;
         }
 
-        for (RoutesI it = m_routes.begin(); it != m_routes.end(); it++) {
-            RipNgRoutingTableEntry* j = it->first;
-
-            if (j->GetRouteStatus() == RipNgRoutingTableEntry::RIPNG_VALID) {
-                Ipv6Prefix mask = j->GetDestNetworkPrefix();
-                uint16_t maskLen = mask.GetPrefixLength();
-                Ipv6Address entry = j->GetDestNetwork();
-
-                NS_LOG_LOGIC("Searching for route to " << dst << ", mask length " << maskLen);
+        m_nLookups++;
 
-                if (mask.IsMatch(dst, entry)) {
-                    NS_LOG_LOGIC("Found global network route " << j << ", mask length " << maskLen);
-
-                    /* if interface is given, check the route will output on this interface */
-                    if (!interface || interface == m_ipv6->GetNetDevice(j->GetInterface())) {
-                        if (maskLen < longestMask) {
-                            NS_LOG_LOGIC("Previous match longer, skipping");
-                            continue;
-                        }
-
-                        longestMask = maskLen;
+        int32_t interfaceIdx = -1;
+        if (interface) {
+            interfaceIdx = m_ipv6->GetInterfaceForDevice(interface);
+            if (interfaceIdx < 0) {
+                return rtentry;
+            }
+        }
 
-                        Ipv6RoutingTableEntry* route = j;
-                        uint32_t interfaceIdx = route->GetInterface();
-                        rtentry = Create<Ipv6Route> ();
+        RipNgRoutingTableEntry* route = m_routeIndex.Lookup(dst, interfaceIdx);
+        if (route) {
+            NS_LOG_LOGIC("Found global network route " << route << ", mask length " << int(route->GetDestNetworkPrefix().GetPrefixLength()));
 
-                        if (route->GetGateway().IsAny()) {
-                            rtentry->SetSource(m_ipv6->SourceAddressSelection(interfaceIdx, route->GetDest()));
-                        } else if (route->GetDest().IsAny()) /* default route */ {
-                            rtentry->SetSource(m_ipv6->SourceAddressSelection(interfaceIdx, route->GetPrefixToUse().IsAny() ? dst : route->GetPrefixToUse()));
-                        } else {
-                            rtentry->SetSource(m_ipv6->SourceAddressSelection(interfaceIdx, route->GetDest()));
-                        }
+            uint32_t routeInterface = route->GetInterface();
+            rtentry = Create<Ipv6Route> ();
 
-                        rtentry->SetDestination(route->GetDest());
-                        rtentry->SetGateway(route->GetGateway());
-                        rtentry->SetOutputDevice(m_ipv6->GetNetDevice(interfaceIdx));
-                    }
-                }
+            if (route->GetGateway().IsAny()) {
+                rtentry->SetSource(m_ipv6->SourceAddressSelection(routeInterface, route->GetDest()));
+            } else if (route->GetDest().IsAny()) /* default route */ {
+                rtentry->SetSource(m_ipv6->SourceAddressSelection(routeInterface, route->GetPrefixToUse().IsAny() ? dst : route->GetPrefixToUse()));
+            } else {
+                rtentry->SetSource(m_ipv6->SourceAddressSelection(routeInterface, route->GetDest()));
             }
+
+            rtentry->SetDestination(route->GetDest());
+            rtentry->SetGateway(route->GetGateway());
+            rtentry->SetOutputDevice(m_ipv6->GetNetDevice(routeInterface));
         }
 
         if (rtentry) {
@@ -564,7 +553,7 @@ namespace ns3
         route->SetRouteStatus(RipNgRoutingTableEntry::RIPNG_VALID);
         route->SetRouteChanged(true);
 
-        m_routes.push_back(std::make_pair(route, EventId()));
+        PushBackRoute(route);
     }
 
     void RipNg::AddNetworkRouteTo(Ipv6Address network, Ipv6Prefix networkPrefix, uint32_t interface) {
@@ -575,7 +564,7 @@ namespace ns3
         route->SetRouteStatus(RipNgRoutingTableEntry::RIPNG_VALID);
         route->SetRouteChanged(true);
 
-        m_routes.push_back(std::make_pair(route, EventId()));
+        PushBackRoute(route);
     }
 
     void RipNg::InvalidateRoute(RipNgRoutingTableEntry * route) {
@@ -601,6 +590,7 @@ namespace ns3
 
         for (RoutesI it = m_routes.begin(); it != m_routes.end(); it++) {
             if (it->first == route) {
+                m_routeIndex.Remove(route);
                 delete route;
                 m_routes.erase(it);
                 return;
@@ -615,6 +605,11 @@ namespace ns3
         Ptr<Packet> packet = socket->Recv();
         NS_LOG_INFO("Received " << *packet);
 
+        if (m_frozen) {
+            NS_LOG_LOGIC("Ignoring a packet, the routing table is frozen.");
+            return;
+        }
+
         Ipv6PacketInfoTag interfaceInfo;
         if (!packet->RemovePacketTag(interfaceInfo)) {
             NS_ABORT_MSG("No incoming interface on RIPng message, aborting.");
@@ -690,6 +685,9 @@ namespace ns3
                     p->RemovePacketTag(tag);
                     tag.SetHopLimit(255);
                     p->AddPacketTag(tag);
+                    SocketPriorityTag priorityTag;
+                    priorityTag.SetPriority(Socket::NS3_PRIO_CONTROL);
+                    p->AddPacketTag(priorityTag);
 
                     RipNgHeader hdr;
                     hdr.SetCommand(RipNgHeader::RESPONSE);
@@ -756,6 +754,9 @@ namespace ns3
             p->RemovePacketTag(tag);
             tag.SetHopLimit(255);
             p->AddPacketTag(tag);
+            SocketPriorityTag priorityTag;
+            priorityTag.SetPriority(Socket::NS3_PRIO_CONTROL);
+            p->AddPacketTag(priorityTag);
 
             RipNgHeader hdr;
             hdr.SetCommand(RipNgHeader::RESPONSE);
@@ -856,6 +857,7 @@ namespace ns3
                     if (rteMetric < it->first->GetRouteMetric()) {
                         if (senderAddress != it->first->GetGateway()) {
                             RipNgRoutingTableEntry* route = new RipNgRoutingTableEntry(rteAddr, rtePrefix, senderAddress, incomingInterface, Ipv6Address::GetAny());
+                            m_routeIndex.Replace(it->first, route);
                             delete it->first;
                             it->first = route;
                         }
@@ -877,6 +879,7 @@ namespace ns3
                                 route->SetRouteStatus(RipNgRoutingTableEntry::RIPNG_VALID);
                                 route->SetRouteTag(iter->GetRouteTag());
                                 route->SetRouteChanged(true);
+                                m_routeIndex.Replace(it->first, route);
                                 delete it->first;
                                 it->first = route;
                                 it->second.Cancel();
@@ -907,9 +910,7 @@ namespace ns3
                 route->SetRouteMetric(rteMetric);
                 route->SetRouteStatus(RipNgRoutingTableEntry::RIPNG_VALID);
                 route->SetRouteChanged(true);
-                m_routes.push_front(std::make_pair(route, EventId()));
-                EventId invalidateEvent = Simulator::Schedule(m_timeoutDelay, &RipNg::InvalidateRoute, this, route);
-                (m_routes.begin())->second = invalidateEvent;
+                PushFrontRoute(route) = Simulator::Schedule(m_timeoutDelay, &RipNg::InvalidateRoute, this, route);
                 changed = true;
             }
         }
@@ -922,6 +923,10 @@ namespace ns3
     void RipNg::DoSendRouteUpdate(bool periodic) {
         NS_LOG_FUNCTION(this << (periodic ? " periodic" : " triggered"));
 
+        if (m_frozen) {
+            return;
+        }
+
         for (SocketListI iter = m_sendSocketList.begin(); iter != m_sendSocketList.end(); iter++) {
             uint32_t interface = iter->second;
 
@@ -933,6 +938,9 @@ namespace ns3
                 SocketIpv6HopLimitTag tag;
                 tag.SetHopLimit(255);
                 p->AddPacketTag(tag);
+                SocketPriorityTag priorityTag;
+                priorityTag.SetPriority(Socket::NS3_PRIO_CONTROL);
+                p->AddPacketTag(priorityTag);
 
                 RipNgHeader hdr;
                 hdr.SetCommand(RipNgHeader::RESPONSE);
@@ -988,6 +996,10 @@ namespace ns3
     void RipNg::SendTriggeredRouteUpdate() {
         NS_LOG_FUNCTION(this);
 
+        if (m_frozen) {
+            return;
+        }
+
         if (m_nextTriggeredUpdate.IsRunning()) {
             NS_LOG_LOGIC("Skipping Triggered Update due to cooldown");
             return;
@@ -1057,11 +1069,18 @@ namespace ns3
     void RipNg::SendRouteRequest() {
         NS_LOG_FUNCTION(this);
 
+        if (m_frozen) {
+            return;
+        }
+
         Ptr<Packet> p = Create<Packet> ();
         SocketIpv6HopLimitTag tag;
         p->RemovePacketTag(tag);
         tag.SetHopLimit(255);
         p->AddPacketTag(tag);
+        SocketPriorityTag priorityTag;
+        priorityTag.SetPriority(Socket::NS3_PRIO_CONTROL);
+        p->AddPacketTag(priorityTag);
 
         RipNgHeader hdr;
         hdr.SetCommand(RipNgHeader::REQUEST);
@@ -1090,6 +1109,45 @@ namespace ns3
         AddNetworkRouteTo(Ipv6Address("::"), Ipv6Prefix::GetZero(), nextHop, interface, Ipv6Address("::"));
     }
 
+    uint64_t RipNg::GetNLookups(void) const {
+        return m_nLookups;
+    }
+
+    void RipNg::Freeze(void) {
+        NS_LOG_FUNCTION(this);
+
+        m_frozen = true;
+        m_nextUnsolicitedUpdate.Cancel();
+        m_nextTriggeredUpdate.Cancel();
+
+        for (RoutesI it = m_routes.begin(); it != m_routes.end();) {
+            it->second.Cancel();
+            if (it->first->GetRouteStatus() == RipNgRoutingTableEntry::RIPNG_VALID) {
+                it++;
+            } else {
+                m_routeIndex.Remove(it->first);
+                delete it->first;
+                it = m_routes.erase(it);
+            }
+        }
+    }
+
+    bool RipNg::IsFrozen(void) const {
+        return m_frozen;
+    }
+
+    EventId& RipNg::PushBackRoute(RipNgRoutingTableEntry *route) {
+        m_routes.push_back(std::make_pair(route, EventId()));
+        m_routeIndex.Add(route, ++m_routeBackOrder);
+        return m_routes.back().second;
+    }
+
+    EventId& RipNg::PushFrontRoute(RipNgRoutingTableEntry *route) {
+        m_routes.push_front(std::make_pair(route, EventId()));
+        m_routeIndex.Add(route, --m_routeFrontOrder);
+        return m_routes.front().second;
+    }
+
     /*
      * RipNgRoutingTableEntry
      */
@@ -1159,6 +1217,241 @@ namespace ns3
         return os;
     }
 
+    /*
+     * RipNgRouteIndex
+     */
+
+    namespace {
 
-}
+        bool GetBit(const uint8_t key[16], uint8_t bit) {
+            return (key[bit / 8] >> (7 - bit % 8)) & 1;
+        }
+
+        /// Length of the common prefix of two keys, up to maxLen bits
+        uint8_t CommonPrefixLength(const uint8_t a[16], const uint8_t b[16], uint8_t maxLen) {
+            uint8_t len = 0;
+            for (uint8_t i = 0; i < 16 && len < maxLen; i++) {
+                uint8_t diff = a[i] ^ b[i];
+                if (diff == 0) {
+                    len += 8;
+                    continue;
+                }
+                while ((diff & 0x80) == 0) {
+                    diff <<= 1;
+                    len++;
+                }
+                break;
+            }
+            return std::min(len, maxLen);
+        }
+
+        void GetNetworkKey(const RipNgRoutingTableEntry *route, uint8_t key[16], uint8_t &len) {
+            Ipv6Prefix prefix = route->GetDestNetworkPrefix();
+            route->GetDestNetwork().CombinePrefix(prefix).GetBytes(key);
+            len = prefix.GetPrefixLength();
+        }
+
+    } // anonymous namespace
+
+    RipNgRouteIndex::RipNgRouteIndex()
+            : m_nRoutes(0) {
+        uint8_t zero[16] = {0};
+        m_root = NewNode(zero, 0);
+    }
+
+    RipNgRouteIndex::~RipNgRouteIndex() {
+        DeleteNode(m_root);
+    }
+
+    RipNgRouteIndex::Node* RipNgRouteIndex::NewNode(const uint8_t key[16], uint8_t len) {
+        Node *node = new Node;
+        // keep only the first len bits
+        for (uint8_t i = 0; i < 16; i++) {
+            if (i * 8 + 8 <= len) {
+                node->key[i] = key[i];
+            } else if (i * 8 < len) {
+                node->key[i] = key[i] & static_cast<uint8_t> (0xff << (8 - (len - i * 8)));
+            } else {
+                node->key[i] = 0;
+            }
+        }
+        node->len = len;
+        node->child[0] = 0;
+        node->child[1] = 0;
+        return node;
+    }
+
+    void RipNgRouteIndex::DeleteNode(Node *node) {
+        if (node) {
+            DeleteNode(node->child[0]);
+            DeleteNode(node->child[1]);
+            delete node;
+        }
+    }
+
+    RipNgRouteIndex::Node* RipNgRouteIndex::Insert(const uint8_t key[16], uint8_t len) {
+        Node *node = m_root;
+        while (node->len != len) {
+            bool bit = GetBit(key, node->len);
+            Node *child = node->child[bit];
+            if (!child) {
+                node->child[bit] = NewNode(key, len);
+                return node->child[bit];
+            }
+
+            uint8_t common = CommonPrefixLength(key, child->key, std::min(len, child->len));
+            if (common == child->len) {
+                node = child;
+                continue;
+            }
+
+            // the new prefix diverges from child (or is shorter): split the edge
+            Node *split = NewNode(key, common);
+            split->child[GetBit(child->key, common)] = child;
+            node->child[bit] = split;
+            if (common == len) {
+                return split;
+            }
+            split->child[GetBit(key, common)] = NewNode(key, len);
+            return split->child[GetBit(key, common)];
+        }
+        return node;
+    }
 
+    RipNgRouteIndex::Node* RipNgRouteIndex::Find(const uint8_t key[16], uint8_t len, std::vector<Node *> &path) const {
+        Node *node = m_root;
+        while (node) {
+            if (node->len > len || CommonPrefixLength(key, node->key, node->len) < node->len) {
+                return 0;
+            }
+            path.push_back(node);
+            if (node->len == len) {
+                return node;
+            }
+            node = node->child[GetBit(key, node->len)];
+        }
+        return 0;
+    }
+
+    void RipNgRouteIndex::Prune(std::vector<Node *> &path) {
+        while (path.size() > 1) {
+            Node *node = path.back();
+            if (!node->routes.empty() || (node->child[0] && node->child[1])) {
+                return;
+            }
+            path.pop_back();
+            Node *parent = path.back();
+            Node *child = node->child[0] ? node->child[0] : node->child[1];
+            parent->child[parent->child[0] == node ? 0 : 1] = child;
+            delete node;
+            if (child) {
+                return;
+            }
+        }
+    }
+
+    void RipNgRouteIndex::Add(RipNgRoutingTableEntry *route, int64_t order) {
+        uint8_t key[16];
+        uint8_t len;
+        GetNetworkKey(route, key, len);
+
+        Insert(key, len)->routes.push_back(std::make_pair(order, route));
+        m_nRoutes++;
+    }
+
+    void RipNgRouteIndex::Replace(RipNgRoutingTableEntry *oldRoute, RipNgRoutingTableEntry *newRoute) {
+        uint8_t key[16];
+        uint8_t len;
+        GetNetworkKey(oldRoute, key, len);
+
+        std::vector<Node *> path;
+        Node *node = Find(key, len, path);
+        NS_ASSERT_MSG(node, "RipNgRouteIndex::Replace - cannot find the route to replace");
+        for (NodeRoutes::iterator it = node->routes.begin(); it != node->routes.end(); it++) {
+            if (it->second == oldRoute) {
+                int64_t order = it->first;
+                node->routes.erase(it);
+                Prune(path);
+                m_nRoutes--;
+                Add(newRoute, order);
+                return;
+            }
+        }
+        NS_ABORT_MSG("RipNgRouteIndex::Replace - cannot find the route to replace");
+    }
+
+    void RipNgRouteIndex::Remove(RipNgRoutingTableEntry *route) {
+        uint8_t key[16];
+        uint8_t len;
+        GetNetworkKey(route, key, len);
+
+        std::vector<Node *> path;
+        Node *node = Find(key, len, path);
+        if (!node) {
+            return;
+        }
+        for (NodeRoutes::iterator it = node->routes.begin(); it != node->routes.end(); it++) {
+            if (it->second == route) {
+                node->routes.erase(it);
+                m_nRoutes--;
+                Prune(path);
+                return;
+            }
+        }
+    }
+
+    void RipNgRouteIndex::Clear(void) {
+        DeleteNode(m_root->child[0]);
+        DeleteNode(m_root->child[1]);
+        m_root->child[0] = 0;
+        m_root->child[1] = 0;
+        m_root->routes.clear();
+        m_nRoutes = 0;
+    }
+
+    RipNgRoutingTableEntry* RipNgRouteIndex::Lookup(Ipv6Address dst, int32_t interface) const {
+        uint8_t key[16];
+        dst.GetBytes(key);
+
+        // nodes whose prefix matches dst, from the shortest to the longest
+        const Node * matching[129];
+        uint32_t nMatching = 0;
+        for (const Node *node = m_root; node; node = node->child[GetBit(key, node->len)]) {
+            if (CommonPrefixLength(key, node->key, node->len) < node->len) {
+                break;
+            }
+            matching[nMatching++] = node;
+            if (node->len == 128) {
+                break;
+            }
+        }
+
+        while (nMatching > 0) {
+            const Node *node = matching[--nMatching];
+            RipNgRoutingTableEntry *best = 0;
+            int64_t bestOrder = 0;
+            for (NodeRoutes::const_iterator it = node->routes.begin(); it != node->routes.end(); it++) {
+                RipNgRoutingTableEntry *route = it->second;
+                if (route->GetRouteStatus() != RipNgRoutingTableEntry::RIPNG_VALID) {
+                    continue;
+                }
+                if (interface >= 0 && route->GetInterface() != static_cast<uint32_t> (interface)) {
+                    continue;
+                }
+                if (!best || it->first > bestOrder) {
+                    best = route;
+                    bestOrder = it->first;
+                }
+            }
+            if (best) {
+                return best;
+            }
+        }
+        return 0;
+    }
+
+    uint32_t RipNgRouteIndex::GetNRoutes(void) const {
+        return m_nRoutes;
+    }
+
+}
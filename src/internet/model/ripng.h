@@ -22,6 +22,7 @@
 #define RIPNG_H
 
 #include <list>
+#include <vector>
 
 #include "ns3/ipv6-routing-protocol.h"
 #include "ns3/ipv6-interface.h"
@@ -162,6 +163,117 @@ namespace ns3 {
      */
     std::ostream& operator<<(std::ostream& os, RipNgRoutingTableEntry const& route);
 
+    /**
+     * \ingroup ripng
+     * \brief Longest-prefix-match index over RIPng routes
+     *
+     * The index is a path-compressed binary (Patricia) trie keyed by the route
+     * destination network and prefix length. Each trie node holds the routes for
+     * one prefix, tagged with their position in the RIPng route list so that ties
+     * between routes for the same prefix resolve as in a linear scan of that list
+     * (the last matching route wins).
+     *
+     * Invalid routes stay in the index until they are deleted; Lookup skips them.
+     * A lookup visits at most one node per prefix bit, i.e., it costs O(128)
+     * regardless of the number of routes.
+     */
+    class RipNgRouteIndex {
+    public:
+        RipNgRouteIndex();
+        ~RipNgRouteIndex();
+
+        /**
+         * \brief Add a route.
+         * \param route the route
+         * \param order position of the route in the route list (higher is later)
+         */
+        void Add(RipNgRoutingTableEntry *route, int64_t order);
+
+        /**
+         * \brief Replace a route with another one for the same network, keeping its position.
+         * \param oldRoute the route to be replaced
+         * \param newRoute the replacement
+         */
+        void Replace(RipNgRoutingTableEntry *oldRoute, RipNgRoutingTableEntry *newRoute);
+
+        /**
+         * \brief Remove a route.
+         * \param route the route
+         */
+        void Remove(RipNgRoutingTableEntry *route);
+
+        /**
+         * \brief Remove all routes.
+         */
+        void Clear(void);
+
+        /**
+         * \brief Find the longest prefix valid route to a destination.
+         * \param dst destination address
+         * \param interface if non-negative, only routes through this interface are considered
+         * \return the route or 0 if none matches
+         */
+        RipNgRoutingTableEntry* Lookup(Ipv6Address dst, int32_t interface = -1) const;
+
+        /**
+         * \brief Get the number of routes in the index.
+         * \return the number of routes
+         */
+        uint32_t GetNRoutes(void) const;
+
+    private:
+        /// Routes for one prefix - pair order, route
+        typedef std::vector<std::pair<int64_t, RipNgRoutingTableEntry *> > NodeRoutes;
+
+        /// Trie node
+        struct Node {
+            uint8_t key[16]; //!< prefix, bits beyond len are zero
+            uint8_t len; //!< prefix length
+            Node *child[2]; //!< children, by the bit following the prefix
+            NodeRoutes routes; //!< routes for exactly this prefix
+        };
+
+        /**
+         * \brief Create a node.
+         * \param key prefix
+         * \param len prefix length
+         * \return the node
+         */
+        static Node* NewNode(const uint8_t key[16], uint8_t len);
+
+        /**
+         * \brief Delete a node and its descendants.
+         * \param node the node
+         */
+        static void DeleteNode(Node *node);
+
+        /**
+         * \brief Find or create the node for a prefix.
+         * \param key prefix
+         * \param len prefix length
+         * \return the node
+         */
+        Node* Insert(const uint8_t key[16], uint8_t len);
+
+        /**
+         * \brief Find the node for a prefix and record the path leading to it.
+         * \param key prefix
+         * \param len prefix length
+         * \param path nodes from the root to the found node, both included
+         * \return the node or 0
+         */
+        Node* Find(const uint8_t key[16], uint8_t len, std::vector<Node *> &path) const;
+
+        /**
+         * \brief Remove nodes left without routes and with less than two children.
+         * \param path nodes from the root to the last modified node
+         */
+        void Prune(std::vector<Node *> &path);
+
+        Node *m_root; //!< root node (zero-length prefix)
+        uint32_t m_nRoutes; //!< number of routes
+    };
+
     /**
      * \ingroup ripng
      *
@@ -252,6 +364,27 @@ namespace ns3 {
          */
         void AddDefaultRouteTo(Ipv6Address nextHop, uint32_t interface);
 
+        /**
+         * \brief Get the number of forwarding table lookups performed so far.
+         * \return the number of lookups
+         */
+        uint64_t GetNLookups(void) const;
+
+        /**
+         * \brief Stop the protocol operation, keeping the current routes.
+         *
+         * After this call no RIPng messages are sent or processed and the
+         * valid routes never expire, i.e., the routing table is a static
+         * snapshot of the state reached so far. Invalid routes are deleted.
+         */
+        void Freeze(void);
+
+        /**
+         * \brief Check if the protocol operation has been stopped by Freeze.
+         * \return true if the routing table is frozen
+         */
+        bool IsFrozen(void) const;
+
     protected:
         /**
          * \brief Dispose this object.
@@ -371,7 +504,25 @@ namespace ns3 {
          */
         void DeleteRoute(RipNgRoutingTableEntry *route);
 
+        /**
+         * \brief Append a route to the route list and the LPM index.
+         * \param route the route
+         * \return the event slot of the route
+         */
+        EventId& PushBackRoute(RipNgRoutingTableEntry *route);
+
+        /**
+         * \brief Prepend a route to the route list and the LPM index.
+         * \param route the route
+         * \return the event slot of the route
+         */
+        EventId& PushFrontRoute(RipNgRoutingTableEntry *route);
+
         Routes m_routes; //!<  the forwarding table for network.
+        RipNgRouteIndex m_routeIndex; //!< LPM index over m_routes
+        int64_t m_routeFrontOrder; //!< order of the first route in m_routes
+        int64_t m_routeBackOrder; //!< order of the last route in m_routes
+        uint64_t m_nLookups; //!< number of forwarding table lookups
         Ptr<Ipv6> m_ipv6; //!< IPv6 reference
         Time m_startupDelay; //!< Random delay before protocol startup.
         Time m_minTriggeredUpdateDelay; //!< Min cooldown delay after a Triggered Update.
@@ -403,6 +554,7 @@ namespace ns3 {
         SplitHorizonType_e m_splitHorizonStrategy; //!< Split Horizon strategy
 
         bool m_initialized; //!< flag to allow socket's late-creation.
+        bool m_frozen; //!< flag to stop the protocol operation.
     };
 
 } // namespace ns3
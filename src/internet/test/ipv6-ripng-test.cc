@@ -39,6 +39,7 @@
 #include "ns3/icmpv6-l4-protocol.h"
 #include "ns3/udp-l4-protocol.h"
 #include "ns3/ipv6-static-routing.h"
+#include "ns3/ipv6-static-routing-helper.h"
 #include "ns3/ipv6-list-routing.h"
 #include "ns3/ipv6-list-routing-helper.h"
 #include "ns3/ripng.h"
@@ -614,6 +615,218 @@ Ipv6RipngSplitHorizonStrategyTest::DoRun(void) {
     Simulator::Destroy();
 }
 
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+// Ipv6RipngRouteIndexTest
+
+class Ipv6RipngRouteIndexTest : public TestCase
+{
+public:
+    virtual void DoRun(void);
+    Ipv6RipngRouteIndexTest();
+
+private:
+    RipNgRoutingTableEntry* NewRoute(std::string network, uint8_t prefixLength, uint32_t interface);
+};
+
+Ipv6RipngRouteIndexTest::Ipv6RipngRouteIndexTest()
+: TestCase("RIPng longest prefix match index") {
+}
+
+RipNgRoutingTableEntry*
+Ipv6RipngRouteIndexTest::NewRoute(std::string network, uint8_t prefixLength, uint32_t interface) {
+    RipNgRoutingTableEntry* route = new RipNgRoutingTableEntry(Ipv6Address(network.c_str()), Ipv6Prefix(prefixLength),
+            Ipv6Address("fe80::1"), interface, Ipv6Address::GetAny());
+    route->SetRouteStatus(RipNgRoutingTableEntry::RIPNG_VALID);
+    return route;
+}
+
+void
+Ipv6RipngRouteIndexTest::DoRun(void) {
+    RipNgRouteIndex index;
+
+    RipNgRoutingTableEntry* defaultRoute = NewRoute("::", 0, 1);
+    RipNgRoutingTableEntry* domain = NewRoute("2001:1::", 32, 1);
+    RipNgRoutingTableEntry* subnet = NewRoute("2001:1:0:5::", 64, 2);
+    RipNgRoutingTableEntry* sibling = NewRoute("2001:1:0:4::", 64, 3);
+    RipNgRoutingTableEntry* host = NewRoute("2001:1:0:5::7", 128, 1);
+    RipNgRoutingTableEntry* subnetLater = NewRoute("2001:1:0:5::", 64, 1);
+
+    index.Add(defaultRoute, 0);
+    index.Add(domain, 1);
+    index.Add(subnet, 2);
+    index.Add(sibling, 3);
+    index.Add(host, 4);
+    NS_TEST_EXPECT_MSG_EQ(index.GetNRoutes(), 5, "Wrong number of routes");
+
+    NS_TEST_EXPECT_MSG_EQ(index.Lookup(Ipv6Address("2001:1:0:5::7")), host, "Host route should win");
+    NS_TEST_EXPECT_MSG_EQ(index.Lookup(Ipv6Address("2001:1:0:5::8")), subnet, "Subnet route should win");
+    NS_TEST_EXPECT_MSG_EQ(index.Lookup(Ipv6Address("2001:1:0:4::8")), sibling, "Sibling subnet route should win");
+    NS_TEST_EXPECT_MSG_EQ(index.Lookup(Ipv6Address("2001:1:0:6::8")), domain, "Domain route should win");
+    NS_TEST_EXPECT_MSG_EQ(index.Lookup(Ipv6Address("2001:2::1")), defaultRoute, "Default route should win");
+
+    // interface filter skips longer matches through other interfaces
+    NS_TEST_EXPECT_MSG_EQ(index.Lookup(Ipv6Address("2001:1:0:5::8"), 1), domain, "Interface filter not applied");
+    NS_TEST_EXPECT_MSG_EQ(index.Lookup(Ipv6Address("2001:1:0:5::8"), 3), 0, "Interface filter not applied");
+
+    // among routes for the same prefix, the later one wins
+    index.Add(subnetLater, 5);
+    NS_TEST_EXPECT_MSG_EQ(index.Lookup(Ipv6Address("2001:1:0:5::8")), subnetLater, "Later route should win");
+
+    // invalid routes are skipped
+    subnetLater->SetRouteStatus(RipNgRoutingTableEntry::RIPNG_INVALID);
+    NS_TEST_EXPECT_MSG_EQ(index.Lookup(Ipv6Address("2001:1:0:5::8")), subnet, "Invalid route used");
+
+    // replacement keeps the position of the replaced route
+    RipNgRoutingTableEntry* replacement = NewRoute("2001:1:0:5::", 64, 3);
+    index.Replace(subnet, replacement);
+    delete subnet;
+    NS_TEST_EXPECT_MSG_EQ(index.Lookup(Ipv6Address("2001:1:0:5::8")), replacement, "Replacement not found");
+    subnetLater->SetRouteStatus(RipNgRoutingTableEntry::RIPNG_VALID);
+    NS_TEST_EXPECT_MSG_EQ(index.Lookup(Ipv6Address("2001:1:0:5::8")), subnetLater, "Replacement changed the order");
+
+    index.Remove(host);
+    index.Remove(subnetLater);
+    index.Remove(replacement);
+    NS_TEST_EXPECT_MSG_EQ(index.GetNRoutes(), 3, "Wrong number of routes");
+    NS_TEST_EXPECT_MSG_EQ(index.Lookup(Ipv6Address("2001:1:0:5::7")), domain, "Removed route still found");
+
+    index.Clear();
+    NS_TEST_EXPECT_MSG_EQ(index.Lookup(Ipv6Address("2001:2::1")), 0, "Index not cleared");
+
+    delete defaultRoute;
+    delete domain;
+    delete sibling;
+    delete host;
+    delete subnetLater;
+    delete replacement;
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+// Ipv6RipngConvergedRoutesTest
+
+class Ipv6RipngConvergedRoutesTest : public TestCase
+{
+    Ptr<Packet> m_receivedPacket;
+    void DoSendData(Ptr<Socket> socket, std::string to);
+    void SendData(Ptr<Socket> socket, std::string to);
+
+public:
+    virtual void DoRun(void);
+    Ipv6RipngConvergedRoutesTest();
+
+    void ReceivePkt(Ptr<Socket> socket);
+};
+
+Ipv6RipngConvergedRoutesTest::Ipv6RipngConvergedRoutesTest()
+: TestCase("RIPng converged routes installed in static routing") {
+}
+
+void Ipv6RipngConvergedRoutesTest::ReceivePkt(Ptr<Socket> socket) {
+    m_receivedPacket = socket->Recv(std::numeric_limits<uint32_t>::max(), 0);
+}
+
+void
+Ipv6RipngConvergedRoutesTest::DoSendData(Ptr<Socket> socket, std::string to) {
+    Address realTo = Inet6SocketAddress(Ipv6Address(to.c_str()), 1234);
+    NS_TEST_EXPECT_MSG_EQ(socket->SendTo(Create<Packet> (123), 0, realTo),
+            123, "100");
+}
+
+void
+Ipv6RipngConvergedRoutesTest::SendData(Ptr<Socket> socket, std::string to) {
+    m_receivedPacket = Create<Packet> ();
+    // no warm-up: the routes are there from the start
+    Simulator::ScheduleWithContext(socket->GetNode()->GetId(), Seconds(1),
+            &Ipv6RipngConvergedRoutesTest::DoSendData, this, socket, to);
+    Simulator::Stop(Seconds(2));
+    Simulator::Run();
+}
+
+void
+Ipv6RipngConvergedRoutesTest::DoRun(void) {
+    // txNode - routerA - routerB - routerC - rxNode, transit links with link-local addresses only
+    NodeContainer nodes;
+    nodes.Create(2);
+    NodeContainer routers;
+    routers.Create(3);
+
+    Ipv6StaticRoutingHelper staticRouting;
+    Ipv6ListRoutingHelper listRH;
+    listRH.Add(staticRouting, 0);
+    InternetStackHelper internetv6routers;
+    internetv6routers.SetRoutingHelper(listRH);
+    internetv6routers.Install(routers);
+
+    InternetStackHelper internetv6nodes;
+    internetv6nodes.Install(nodes);
+
+    Ptr<Node> chain[] = {nodes.Get(0), routers.Get(0), routers.Get(1), routers.Get(2), nodes.Get(1)};
+    NetDeviceContainer net[4];
+    uint8_t mac = 1;
+    for (uint32_t i = 0; i < 4; i++) {
+        Ptr<SimpleChannel> channel = CreateObject<SimpleChannel> ();
+        for (uint32_t j = i; j <= i + 1; j++) {
+            Ptr<SimpleNetDevice> dev = CreateObject<SimpleNetDevice> ();
+            uint8_t buffer[6] = {0, 0, 0, 0, 0, mac++};
+            Mac48Address address;
+            address.CopyFrom(buffer);
+            dev->SetAddress(address);
+            dev->SetChannel(channel);
+            chain[j]->AddDevice(dev);
+            net[i].Add(dev);
+        }
+    }
+
+    Ipv6AddressHelper ipv6;
+
+    ipv6.SetBase(Ipv6Address("2001:1::"), Ipv6Prefix(64));
+    Ipv6InterfaceContainer iic1 = ipv6.Assign(net[0]);
+    iic1.SetForwarding(1, true);
+    iic1.SetDefaultRouteInAllNodes(1);
+
+    for (uint32_t i = 1; i < 3; i++) {
+        Ipv6InterfaceContainer iic = ipv6.AssignWithoutAddress(net[i]);
+        iic.SetForwarding(0, true);
+        iic.SetForwarding(1, true);
+    }
+
+    ipv6.SetBase(Ipv6Address("2001:2::"), Ipv6Prefix(64));
+    Ipv6InterfaceContainer iic4 = ipv6.Assign(net[3]);
+    iic4.SetForwarding(0, true);
+    iic4.SetDefaultRouteInAllNodes(0);
+
+    RipNgHelper ripNgRouting;
+    ripNgRouting.PopulateConvergedRoutes(routers);
+
+    // routerA reaches 2001:2::/64 through routerB, as RIPng would with metric 3
+    Ptr<Ipv6StaticRouting> routingA = staticRouting.GetStaticRouting(routers.Get(0)->GetObject<Ipv6> ());
+    bool found = false;
+    for (uint32_t i = 0; i < routingA->GetNRoutes(); i++) {
+        Ipv6RoutingTableEntry route = routingA->GetRoute(i);
+        if (route.GetDestNetwork() == Ipv6Address("2001:2::")) {
+            found = true;
+            NS_TEST_EXPECT_MSG_EQ(routingA->GetMetric(i), 3, "Wrong RIPng metric");
+            NS_TEST_EXPECT_MSG_EQ(route.GetGateway().IsLinkLocal(), true, "Next hop should be link-local");
+        }
+    }
+    NS_TEST_EXPECT_MSG_EQ(found, true, "Converged route not installed");
+
+    Ptr<Socket> rxSocket = nodes.Get(1)->GetObject<UdpSocketFactory> ()->CreateSocket();
+    NS_TEST_EXPECT_MSG_EQ(rxSocket->Bind(Inet6SocketAddress(iic4.GetAddress(1, 1), 1234)), 0, "trivial");
+    rxSocket->SetRecvCallback(MakeCallback(&Ipv6RipngConvergedRoutesTest::ReceivePkt, this));
+
+    Ptr<Socket> txSocket = nodes.Get(0)->GetObject<UdpSocketFactory> ()->CreateSocket();
+
+    std::ostringstream to;
+    to << iic4.GetAddress(1, 1);
+    SendData(txSocket, to.str());
+    NS_TEST_EXPECT_MSG_EQ(m_receivedPacket->GetSize(), 123, "Converged routes should work without warm-up.");
+
+    Simulator::Destroy();
+}
+
 //-----------------------------------------------------------------------------
 //-----------------------------------------------------------------------------
 class Ipv6RipngTestSuite : public TestSuite
@@ -626,4 +839,6 @@ class Ipv6RipngTestSuite : public TestSuite
         AddTestCase(new Ipv6RipngSplitHorizonStrategyTest(RipNg::POISON_REVERSE), TestCase::QUICK);
         AddTestCase(new Ipv6RipngSplitHorizonStrategyTest(RipNg::SPLIT_HORIZON), TestCase::QUICK);
         AddTestCase(new Ipv6RipngSplitHorizonStrategyTest(RipNg::NO_SPLIT_HORIZON), TestCase::QUICK);
+        AddTestCase(new Ipv6RipngRouteIndexTest, TestCase::QUICK);
+        AddTestCase(new Ipv6RipngConvergedRoutesTest, TestCase::QUICK);
     }} g_ipv6ripngTestSuite;
@@ -0,0 +1,79 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+// Run an IoT scenario described by a configuration file:
+//
+//   ./waf --run "iot-scenario --config=src/iot-scenario/examples/smart-home.conf"
+//
+// NDN scenarios write app-delays-trace.txt and drop-trace.txt, IP
+// scenarios write Flows.xml.
+
+#include "ns3/core-module.h"
+#include "ns3/flow-monitor-module.h"
+#include "ns3/iot-scenario-module.h"
+#include "ns3/ndnSIM-module.h"
+
+namespace ns3 {
+
+    NS_LOG_COMPONENT_DEFINE("IotScenarioExample");
+
+    int
+    main(int argc, char *argv[]) {
+        std::string config = "src/iot-scenario/examples/smart-home.conf";
+        bool pcap = false;
+        double dropTraceInterval = 1.0;
+
+        CommandLine cmd;
+        cmd.AddValue("config", "The scenario configuration file", config);
+        cmd.AddValue("pcap", "Write pcap traces of the domains", pcap);
+        cmd.AddValue("dropTraceInterval", "Interval of the NDN drop trace, in seconds", dropTraceInterval);
+        cmd.Parse(argc, argv);
+
+        IotScenarioHelper scenario(IotScenarioConfig::Read(config));
+        scenario.Build();
+        const IotScenarioConfig &scenarioConfig = scenario.GetConfig();
+
+        if (pcap) {
+            scenario.EnablePcap("iot-scenario");
+        }
+
+        FlowMonitorHelper flowHelper;
+        Ptr<FlowMonitor> flowMonitor;
+        if (scenarioConfig.stack == "ndn") {
+            ndn::AppDelayTracer::InstallAll("app-delays-trace.txt");
+            L2RateTracer::InstallAll("drop-trace.txt", Seconds(dropTraceInterval));
+        } else {
+            flowMonitor = flowHelper.InstallAll();
+        }
+
+        NS_LOG_INFO("Run Simulation.");
+        Simulator::Stop(scenarioConfig.simTime);
+        Simulator::Run();
+        if (flowMonitor) {
+            flowMonitor->SerializeToXmlFile("Flows.xml", true, true);
+        }
+        Simulator::Destroy();
+        NS_LOG_INFO("Done.");
+        return 0;
+    }
+
+} // namespace ns3
+
+int
+main(int argc, char *argv[]) {
+    return ns3::main(argc, argv);
+}
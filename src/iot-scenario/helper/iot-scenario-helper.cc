@@ -0,0 +1,506 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "iot-scenario-helper.h"
+
+#include <cmath>
+#include <sstream>
+
+#include "ns3/abort.h"
+#include "ns3/boolean.h"
+#include "ns3/coap-helper.h"
+#include "ns3/double.h"
+#include "ns3/integer.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv6-address-helper.h"
+#include "ns3/ipv6-list-routing-helper.h"
+#include "ns3/log.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/propagation-delay-model.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/ripng-helper.h"
+#include "ns3/ripng.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/simulator.h"
+#include "ns3/single-model-spectrum-channel.h"
+#include "ns3/sixlowpan-helper.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/ndnSIM-module.h"
+
+namespace ns3 {
+
+    NS_LOG_COMPONENT_DEFINE("IotScenarioHelper");
+
+    IotScenarioHelper::IotScenarioHelper(const IotScenarioConfig &config)
+    : m_config(config),
+    m_brite(config.briteConf),
+    m_built(false) {
+        NS_LOG_FUNCTION(this);
+    }
+
+    void
+    IotScenarioHelper::Build(void) {
+        NS_LOG_FUNCTION(this);
+        NS_ABORT_MSG_IF(m_built, "The scenario is already built");
+        m_built = true;
+
+        // a stream takes the run when it is set: the run goes first
+        RngSeedManager::SetRun(m_config.run);
+        // the streams of the wsn-iot scenarios
+        m_leafRng = CreateObject<UniformRandomVariable> ();
+        m_leafRng->SetStream(1);
+        m_frequencyRng = CreateObject<UniformRandomVariable> ();
+        m_frequencyRng->SetStream(2);
+        m_consumerLeafRng = CreateObject<UniformRandomVariable> ();
+        m_consumerLeafRng->SetStream(3);
+        m_insideRng = CreateObject<UniformRandomVariable> ();
+        m_insideRng->SetStream(4);
+        m_startRng = CreateObject<UniformRandomVariable> ();
+        m_startRng->SetStream(5);
+        m_contentRng = CreateObject<UniformRandomVariable> ();
+        m_contentRng->SetStream(6);
+
+        BuildBackhaul();
+        BuildDomains();
+        if (m_config.stack == "ndn") {
+            InstallNdn();
+        } else {
+            InstallIp();
+        }
+        NS_LOG_INFO("Built " << m_domains.size() << " domains of " << m_motes.GetN() << " motes on "
+                << m_backhaul.GetN() << " backhaul routers, " << m_producers.GetN() << " producers and "
+                << m_consumers.GetN() << " consumers");
+    }
+
+    const IotScenarioConfig &
+    IotScenarioHelper::GetConfig(void) const {
+        return m_config;
+    }
+
+    uint32_t
+    IotScenarioHelper::GetNDomains(void) const {
+        return m_domains.size();
+    }
+
+    NodeContainer
+    IotScenarioHelper::GetDomain(uint32_t i) const {
+        NS_ASSERT(i < m_domains.size());
+        return m_domains[i].nodes;
+    }
+
+    NetDeviceContainer
+    IotScenarioHelper::GetLrWpanDevices(uint32_t i) const {
+        NS_ASSERT(i < m_domains.size());
+        return m_domains[i].lrWpanDevices;
+    }
+
+    NetDeviceContainer
+    IotScenarioHelper::GetCsmaDevices(uint32_t i) const {
+        NS_ASSERT(i < m_domains.size());
+        return m_domains[i].csmaDevices;
+    }
+
+    Ptr<CoapContentDirectory>
+    IotScenarioHelper::GetContentDirectory(uint32_t i) const {
+        NS_ASSERT(i < m_domains.size());
+        return m_domains[i].directory;
+    }
+
+    NodeContainer
+    IotScenarioHelper::GetMotes(void) const {
+        return m_motes;
+    }
+
+    NodeContainer
+    IotScenarioHelper::GetGateways(void) const {
+        return m_gateways;
+    }
+
+    NodeContainer
+    IotScenarioHelper::GetBackhaul(void) const {
+        return m_backhaul;
+    }
+
+    ApplicationContainer
+    IotScenarioHelper::GetProducers(void) const {
+        return m_producers;
+    }
+
+    ApplicationContainer
+    IotScenarioHelper::GetConsumers(void) const {
+        return m_consumers;
+    }
+
+    void
+    IotScenarioHelper::EnablePcap(std::string prefix) {
+        NS_LOG_FUNCTION(this << prefix);
+        NS_ASSERT_MSG(m_built, "Build the scenario first");
+        for (std::vector<Domain>::const_iterator domain = m_domains.begin(); domain != m_domains.end(); ++domain) {
+            m_csma.EnablePcap(prefix + "-csma", domain->csmaDevices, true);
+            m_lrWpan.EnablePcap(prefix + "-lrwpan", domain->lrWpanDevices, true);
+        }
+    }
+
+    void
+    IotScenarioHelper::BuildBackhaul(void) {
+        NS_LOG_FUNCTION(this);
+        m_brite.AssignStreams(3);
+        if (!m_config.briteCacheDirectory.empty()) {
+            m_brite.SetCacheDirectory(m_config.briteCacheDirectory);
+        }
+        if (!m_config.topologyFile.empty()) {
+            m_brite.ReadAnnotatedTopology(m_config.topologyFile);
+        }
+        m_backhaul = m_brite.BuildBriteTopology2();
+    }
+
+    void
+    IotScenarioHelper::BuildDomains(void) {
+        NS_LOG_FUNCTION(this);
+        NodeContainer leaves = m_brite.GetLeafNodeContainer();
+        NS_ABORT_MSG_IF(leaves.GetN() == 0, "The backhaul has no leaf router");
+
+        m_domains.reserve(m_config.GetNDomains());
+        for (std::vector<IotDomainConfig>::const_iterator family = m_config.domains.begin();
+                family != m_config.domains.end(); ++family) {
+            for (uint32_t i = 0; i < family->count; i++) {
+                Domain domain;
+                domain.config = &*family;
+                domain.index = m_domains.size();
+                domain.leaf = leaves.Get(m_leafRng->GetInteger(0, leaves.GetN() - 1));
+                m_brite.SetConnectedLeaf(domain.leaf);
+                m_domains.push_back(domain);
+            }
+        }
+
+        // the leaf routers left to the consumers, found once instead of by retrying
+        m_freeLeaves.reserve(leaves.GetN());
+        for (NodeContainer::Iterator leaf = leaves.Begin(); leaf != leaves.End(); ++leaf) {
+            if (!m_brite.IsConnectedLeaf(*leaf)) {
+                m_freeLeaves.push_back(*leaf);
+            }
+        }
+
+        m_csma.SetChannelAttribute("DataRate", DataRateValue(m_config.gatewayLinkRate));
+        m_csma.SetChannelAttribute("Delay", TimeValue(m_config.gatewayLinkDelay));
+
+        MobilityHelper mobility;
+        mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+        for (std::vector<Domain>::iterator domain = m_domains.begin(); domain != m_domains.end(); ++domain) {
+            uint32_t systemId = domain->leaf->GetSystemId();
+            Ptr<Node> gateway = CreateObject<Node> (systemId);
+            domain->nodes.Create(domain->config->motes, systemId);
+            m_motes.Add(domain->nodes);
+            domain->nodes.Add(gateway);
+            m_gateways.Add(gateway);
+
+            // a grid of motes per domain, the gateway at its corner
+            double x = -100 + domain->index * m_config.spacing;
+            mobility.SetPositionAllocator("ns3::GridPositionAllocator",
+                    "MinX", DoubleValue(x),
+                    "MinY", DoubleValue(400),
+                    "DeltaX", DoubleValue(5),
+                    "DeltaY", DoubleValue(5),
+                    "GridWidth", UintegerValue(5),
+                    "LayoutType", StringValue("RowFirst"));
+            for (uint32_t i = 0; i < domain->config->motes; i++) {
+                mobility.Install(domain->nodes.Get(i));
+            }
+            Ptr<ListPositionAllocator> gatewayPosition = CreateObject<ListPositionAllocator> ();
+            gatewayPosition->Add(Vector(x + 5, 395, 0));
+            mobility.SetPositionAllocator(gatewayPosition);
+            mobility.Install(gateway);
+
+            domain->csmaDevices = m_csma.Install(NodeContainer(gateway, domain->leaf));
+
+            // every domain is a PAN on a channel of its own
+            if (domain != m_domains.begin()) {
+                Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel> ();
+                channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel> ());
+                channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel> ());
+                m_lrWpan.SetChannel(channel);
+            }
+            int motes = domain->config->motes;
+            int nDomains = m_domains.size();
+            bool contikiMac = domain->config->mac == "contikimac";
+            domain->lrWpanDevices = m_lrWpan.InstallIoT(domain->nodes, motes, nDomains, contikiMac, motes);
+            m_lrWpan.AssociateToPan(domain->lrWpanDevices, 10);
+        }
+    }
+
+    void
+    IotScenarioHelper::InstallNdn(void) {
+        NS_LOG_FUNCTION(this);
+        const std::string dataName = "/SensorData";
+
+        ndn::StackHelper ndnHelper;
+        ndnHelper.SetDefaultRoutes(true);
+        if (m_config.cacheSize == 0) {
+            ndnHelper.SetOldContentStore("ns3::ndn::cs::Nocache");
+        } else if (m_config.freshness.IsStrictlyPositive()) {
+            ndnHelper.SetOldContentStore("ns3::ndn::cs::Freshness::Lru",
+                    "MaxSize", std::to_string(m_config.cacheSize),
+                    "ReportTime", std::to_string(m_config.reportTime));
+        } else {
+            ndnHelper.setCsSize(m_config.cacheSize);
+        }
+        if (m_config.ndnCompression) {
+            ndnHelper.setLowPanCompression(true, {dataName});
+        }
+        for (std::vector<Domain>::const_iterator domain = m_domains.begin(); domain != m_domains.end(); ++domain) {
+            ndnHelper.Install(domain->nodes);
+        }
+        if (m_config.ipBackhaul) {
+            // an IP backhaul does not cache
+            ndnHelper.SetOldContentStore("ns3::ndn::cs::Nocache");
+        }
+        ndnHelper.Install(m_backhaul);
+
+        if (m_config.ipBackhaul) {
+            for (NodeContainer::Iterator router = m_backhaul.Begin(); router != m_backhaul.End(); ++router) {
+                (*router)->GetObject<ndn::L3Protocol> ()->setRole(1);
+            }
+            for (NodeContainer::Iterator gateway = m_gateways.Begin(); gateway != m_gateways.End(); ++gateway) {
+                (*gateway)->GetObject<ndn::L3Protocol> ()->setRole(2);
+            }
+        }
+
+        ndn::StrategyChoiceHelper::InstallAll("/", "/localhost/nfd/strategy/bestroute2");
+        ndn::GlobalRoutingHelper routingHelper;
+        routingHelper.InstallAll();
+
+        ndn::AppHelper producerHelper("ns3::ndn::Producer");
+        producerHelper.SetAttribute("PayloadSize", UintegerValue(m_config.payloadSize));
+        producerHelper.SetAttribute("Freshness", TimeValue(m_config.freshness));
+
+        ndn::AppHelper consumerHelper(m_config.congestionControl ? "ns3::ndn::ConsumerZipfAimd" : "ns3::ndn::ConsumerZipfMandelbrotV2");
+        consumerHelper.SetAttribute("q", DoubleValue(m_config.zipfQ));
+        consumerHelper.SetAttribute("s", DoubleValue(m_config.zipfS));
+
+        Time stop = m_config.simTime - Seconds(5);
+        for (std::vector<Domain>::const_iterator domain = m_domains.begin(); domain != m_domains.end(); ++domain) {
+            std::ostringstream prefix;
+            prefix << "/" << domain->config->name << "_" << domain->index << dataName;
+
+            // the contents are dealt to the producers in a random order
+            std::vector<uint32_t> contents = ShuffleContents(domain->config->contents);
+            for (uint32_t i = 0; i < domain->config->contents; i++) {
+                Ptr<Node> producer = domain->nodes.Get(i % domain->config->producers);
+                std::string name = prefix.str() + "/" + std::to_string(contents[i]);
+                producerHelper.SetPrefix(name);
+                m_producers.Add(producerHelper.Install(producer));
+                routingHelper.AddOrigin(name, producer);
+            }
+
+            consumerHelper.SetPrefix(prefix.str());
+            consumerHelper.SetAttribute("NumberOfContents", StringValue(std::to_string(domain->config->contents)));
+            uint32_t nConsumers = domain->config->leafConsumers + domain->config->insideConsumers + domain->config->gatewayConsumers;
+            for (uint32_t i = 0; i < nConsumers; i++) {
+                Ptr<Node> node;
+                uint32_t stream;
+                if (i < domain->config->leafConsumers) {
+                    node = SelectConsumerLeaf();
+                    if (m_config.ipBackhaul) {
+                        node->GetObject<ndn::L3Protocol> ()->setRole(2);
+                    }
+                    stream = node->GetId();
+                } else if (i < domain->config->leafConsumers + domain->config->insideConsumers) {
+                    node = domain->nodes.Get(m_insideRng->GetInteger(0, domain->nodes.GetN() - 1));
+                    stream = node->GetId();
+                } else {
+                    node = domain->nodes.Get(domain->config->motes);
+                    stream = node->GetId() + 100 + i;
+                }
+                consumerHelper.SetAttribute("Frequency", DoubleValue(m_frequencyRng->GetValue(m_config.minFrequency, m_config.maxFrequency)));
+                consumerHelper.SetAttribute("RngStream", StringValue(std::to_string(stream)));
+                ApplicationContainer apps = consumerHelper.Install(node);
+                apps.Start(m_config.trafficStart + Seconds(m_startRng->GetValue(0.1, 1 / m_config.maxFrequency)));
+                apps.Stop(stop);
+                m_consumers.Add(apps);
+            }
+        }
+
+        ndn::GlobalRoutingHelper::CalculateRoutes();
+    }
+
+    void
+    IotScenarioHelper::InstallIp(void) {
+        NS_LOG_FUNCTION(this);
+        // Routing modes:
+        // - ripng:         RIPng keeps running, its updates are reduced at the end of the warm-up.
+        // - ripng-freeze:  RIPng runs during the warm-up, then the routing tables are frozen.
+        // - static:        The routes RIPng would converge to are installed at t=0.
+        RipNgHelper ripNgRouting;
+        ripNgRouting.Set("UnsolicitedRoutingUpdate", TimeValue(Seconds(15)));
+        Ipv6ListRoutingHelper listRouting;
+        listRouting.Add(ripNgRouting, 0);
+
+        InternetStackHelper internetv6;
+        internetv6.SetIpv4StackInstall(false);
+        internetv6.Install(m_motes);
+        if (m_config.routing != "static") {
+            internetv6.SetRoutingHelper(listRouting);
+        }
+        internetv6.Install(m_gateways);
+        internetv6.Install(m_backhaul);
+
+        Ipv6AddressHelper ipv6;
+        ipv6.SetBase(Ipv6Address("2001:0:1337::"), Ipv6Prefix(64));
+        m_brite.AssignIpv6Addresses(ipv6);
+
+        // two subnets per domain, 2001:<2i + 1>:: for 6LoWPAN and 2001:<2i + 2>:: for CSMA
+        NS_ABORT_MSG_IF(2 * m_domains.size() > 0xffff, "Too many domains for the IPv6 addressing plan");
+        SixLowPanHelper sixlowpan;
+        for (std::vector<Domain>::iterator domain = m_domains.begin(); domain != m_domains.end(); ++domain) {
+            uint32_t gateway = domain->config->motes;
+            std::ostringstream lowPanSubnet, csmaSubnet;
+            lowPanSubnet << "2001:" << std::hex << 2 * domain->index + 1 << "::";
+            csmaSubnet << "2001:" << std::hex << 2 * domain->index + 2 << "::";
+
+            ipv6.SetBase(Ipv6Address(lowPanSubnet.str().c_str()), Ipv6Prefix(64));
+            domain->lowPanInterfaces = ipv6.Assign(sixlowpan.Install(domain->lrWpanDevices));
+            ipv6.SetBase(Ipv6Address(csmaSubnet.str().c_str()), Ipv6Prefix(64));
+            Ipv6InterfaceContainer csmaInterfaces = ipv6.Assign(domain->csmaDevices);
+
+            domain->lowPanInterfaces.SetDefaultRouteInAllNodes(gateway);
+            domain->lowPanInterfaces.SetForwarding(gateway, true);
+            csmaInterfaces.SetForwarding(0, true);
+            csmaInterfaces.SetForwarding(1, true);
+        }
+
+        NodeContainer routers(m_gateways, m_backhaul);
+        Time warmup = m_config.trafficStart;
+        if (m_config.routing == "static") {
+            ripNgRouting.PopulateConvergedRoutes(routers);
+            warmup = Seconds(1);
+        } else if (m_config.routing == "ripng-freeze") {
+            ripNgRouting.Freeze(routers, warmup);
+        } else {
+            Simulator::Schedule(warmup, &IotScenarioHelper::SlowDownRipNg, routers);
+        }
+
+        uint16_t port = 9;
+        CoapServerHelper server(port);
+        server.SetAttribute("Payload", UintegerValue(m_config.payloadSize));
+        CoapCacheGtwHelper gatewayCache(port);
+        gatewayCache.SetAttribute("Payload", UintegerValue(m_config.payloadSize));
+        // the gateway counts freshness in whole seconds: round up, so a short freshness is not 0
+        gatewayCache.SetAttribute("Freshness", UintegerValue(std::ceil(m_config.freshness.GetSeconds())));
+        gatewayCache.SetAttribute("CacheSize", UintegerValue(m_config.cacheSize));
+        gatewayCache.SetAttribute("ReportTime", IntegerValue(m_config.reportTime));
+        CoapClientHelper client(port);
+        client.SetAttribute("MaxPackets", UintegerValue(99999999));
+        client.SetAttribute("q", DoubleValue(m_config.zipfQ));
+        client.SetAttribute("s", DoubleValue(m_config.zipfS));
+        client.SetAttribute("CongestionControl", BooleanValue(m_config.congestionControl));
+
+        Time stop = m_config.simTime - Seconds(5);
+        for (std::vector<Domain>::iterator domain = m_domains.begin(); domain != m_domains.end(); ++domain) {
+            uint32_t producers = domain->config->producers;
+            Ptr<Node> gateway = domain->nodes.Get(domain->config->motes);
+
+            // the producer of every content, in a random order
+            std::vector<Ipv6Address> addresses(producers);
+            for (uint32_t i = 0; i < producers; i++) {
+                addresses[i] = domain->lowPanInterfaces.GetAddress(i, 1);
+            }
+            domain->directory = Create<CoapContentDirectory> ();
+            domain->directory->Assign(addresses, domain->config->contents, port, m_contentRng);
+
+            if (m_config.gatewayCache) {
+                ApplicationContainer apps = gatewayCache.Install(gateway);
+                gatewayCache.SetContentDirectory(apps.Get(0), domain->directory);
+                apps.Start(Seconds(1));
+                apps.Stop(m_config.simTime);
+            }
+            for (uint32_t i = 0; i < producers; i++) {
+                ApplicationContainer apps = server.Install(domain->nodes.Get(i));
+                server.SetContentDirectory(apps.Get(0), domain->directory);
+                apps.Start(Seconds(1));
+                apps.Stop(m_config.simTime);
+                m_producers.Add(apps);
+            }
+
+            client.SetAttribute("NumberOfContents", UintegerValue(domain->config->contents));
+            uint32_t nConsumers = domain->config->leafConsumers + domain->config->insideConsumers + domain->config->gatewayConsumers;
+            for (uint32_t i = 0; i < nConsumers; i++) {
+                Ptr<Node> node;
+                uint32_t stream;
+                client.SetAttribute("GTW", StringValue("0"));
+                client.SetAttribute("Proxy", Ipv6AddressValue(Ipv6Address::GetAny()));
+                if (i < domain->config->leafConsumers) {
+                    node = SelectConsumerLeaf();
+                    stream = node->GetId();
+                    // the leaf consumers ask the gateway cache for every content
+                    if (m_config.gatewayCache) {
+                        client.SetAttribute("Proxy", Ipv6AddressValue(domain->lowPanInterfaces.GetAddress(domain->config->motes, 1)));
+                    }
+                } else if (i < domain->config->leafConsumers + domain->config->insideConsumers) {
+                    node = domain->nodes.Get(m_insideRng->GetInteger(0, domain->nodes.GetN() - 1));
+                    stream = node->GetId();
+                } else {
+                    node = gateway;
+                    stream = node->GetId() + 100 + i;
+                    if (m_config.gatewayCache) {
+                        client.SetAttribute("GTW", StringValue("1"));
+                    }
+                }
+                double frequency = m_frequencyRng->GetValue(m_config.minFrequency, m_config.maxFrequency);
+                client.SetAttribute("Interval", TimeValue(Seconds(1 / frequency)));
+                client.SetAttribute("RngStream", StringValue(std::to_string(stream)));
+                ApplicationContainer apps = client.Install(node);
+                client.SetContentDirectory(apps.Get(0), domain->directory);
+                apps.Start(warmup + Seconds(m_startRng->GetValue(0.1, 1 / m_config.maxFrequency)));
+                apps.Stop(stop);
+                m_consumers.Add(apps);
+            }
+        }
+    }
+
+    Ptr<Node>
+    IotScenarioHelper::SelectConsumerLeaf(void) {
+        NS_ABORT_MSG_IF(m_freeLeaves.empty(), "Every backhaul leaf router carries a domain, none is left for the leaf consumers");
+        return m_freeLeaves[m_consumerLeafRng->GetInteger(0, m_freeLeaves.size() - 1)];
+    }
+
+    std::vector<uint32_t>
+    IotScenarioHelper::ShuffleContents(uint32_t n) const {
+        std::vector<uint32_t> contents(n);
+        for (uint32_t i = 0; i < n; i++) {
+            contents[i] = i;
+        }
+        for (uint32_t i = n; i > 1; i--) {
+            std::swap(contents[i - 1], contents[m_contentRng->GetInteger(0, i - 1)]);
+        }
+        return contents;
+    }
+
+    void
+    IotScenarioHelper::SlowDownRipNg(NodeContainer routers) {
+        NS_LOG_FUNCTION(routers.GetN());
+        for (NodeContainer::Iterator router = routers.Begin(); router != routers.End(); ++router) {
+            Ptr<RipNg> ripNg = (*router)->GetObject<RipNg> ();
+            if (ripNg) {
+                ripNg->SetAttribute("UnsolicitedRoutingUpdate", TimeValue(Seconds(50000)));
+                ripNg->SetAttribute("TimeoutDelay", TimeValue(Seconds(50600)));
+                ripNg->SetAttribute("GarbageCollectionDelay", TimeValue(Seconds(50700)));
+            }
+        }
+    }
+
+} // namespace ns3
@@ -0,0 +1,211 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef IOT_SCENARIO_HELPER_H
+#define IOT_SCENARIO_HELPER_H
+
+#include <string>
+#include <vector>
+
+#include "ns3/iot-scenario-config.h"
+#include "ns3/application-container.h"
+#include "ns3/brite-topology-helper.h"
+#include "ns3/coap-content-directory.h"
+#include "ns3/csma-helper.h"
+#include "ns3/ipv6-interface-container.h"
+#include "ns3/lr-wpan-helper.h"
+#include "ns3/net-device-container.h"
+#include "ns3/node-container.h"
+#include "ns3/random-variable-stream.h"
+
+namespace ns3 {
+
+    /**
+     * \ingroup iot-scenario
+     * \brief Build an IoT scenario from its configuration.
+     *
+     * Build() creates, in one pass over the configuration:
+     *  - the BRITE backhaul;
+     *  - for every domain, its motes and its gateway, on a 802.15.4 channel
+     *    of their own, and the CSMA link between the gateway and a random
+     *    leaf router of the backhaul;
+     *  - the NDN stack, with the contents spread over the producing motes and
+     *    Zipf-Mandelbrot consumers, or the 6LoWPAN and IPv6 stack with RIPng,
+     *    with a CoAP server per producing mote, a content directory per domain
+     *    and CoAP clients.
+     *
+     * The NDN and IP scenarios of a configuration share their topology,
+     * positions, request frequencies and start times.
+     *
+     *     IotScenarioHelper scenario(IotScenarioConfig::Read("smart-home.conf"));
+     *     scenario.Build();
+     *     Simulator::Stop(scenario.GetConfig().simTime);
+     *     Simulator::Run();
+     *
+     * The helper owns the 802.15.4 channels: it must outlive the simulation.
+     */
+    class IotScenarioHelper {
+    public:
+        /**
+         * \param config The scenario to build.
+         */
+        IotScenarioHelper(const IotScenarioConfig &config);
+
+        /**
+         * Create the nodes, devices, stacks and applications of the scenario.
+         */
+        void Build(void);
+
+        /**
+         * \returns The configuration of the scenario.
+         */
+        const IotScenarioConfig &GetConfig(void) const;
+
+        /**
+         * \returns The number of domains.
+         */
+        uint32_t GetNDomains(void) const;
+
+        /**
+         * \param i The index of a domain, in the order of the configuration.
+         * \returns The motes of the domain followed by its gateway.
+         */
+        NodeContainer GetDomain(uint32_t i) const;
+
+        /**
+         * \param i The index of a domain.
+         * \returns The 802.15.4 devices of the domain, the gateway one last.
+         */
+        NetDeviceContainer GetLrWpanDevices(uint32_t i) const;
+
+        /**
+         * \param i The index of a domain.
+         * \returns The CSMA devices of the gateway and of the backhaul leaf of the domain.
+         */
+        NetDeviceContainer GetCsmaDevices(uint32_t i) const;
+
+        /**
+         * \param i The index of a domain.
+         * \returns The producer of every content of the domain (IP), 0 for NDN.
+         */
+        Ptr<CoapContentDirectory> GetContentDirectory(uint32_t i) const;
+
+        /**
+         * \returns The motes of all the domains.
+         */
+        NodeContainer GetMotes(void) const;
+
+        /**
+         * \returns The gateways of all the domains.
+         */
+        NodeContainer GetGateways(void) const;
+
+        /**
+         * \returns The backhaul routers.
+         */
+        NodeContainer GetBackhaul(void) const;
+
+        /**
+         * \returns The producers (NDN) or servers (IP) of all the domains.
+         */
+        ApplicationContainer GetProducers(void) const;
+
+        /**
+         * \returns The consumers (NDN) or clients (IP) of all the domains.
+         */
+        ApplicationContainer GetConsumers(void) const;
+
+        /**
+         * Enable pcap output on the CSMA and 802.15.4 devices of the domains.
+         *
+         * \param prefix The prefix of the file names.
+         */
+        void EnablePcap(std::string prefix);
+
+    private:
+        /**
+         * A domain of the scenario.
+         */
+        struct Domain {
+            /** The configuration of the domain family. */
+            const IotDomainConfig *config;
+            /** The global index of the domain. */
+            uint32_t index;
+            /** The motes followed by the gateway. */
+            NodeContainer nodes;
+            /** The backhaul leaf router the gateway is connected to. */
+            Ptr<Node> leaf;
+            /** The 802.15.4 devices. */
+            NetDeviceContainer lrWpanDevices;
+            /** The CSMA devices of the gateway and of the leaf. */
+            NetDeviceContainer csmaDevices;
+            /** IP only: the interfaces of the 6LoWPAN devices. */
+            Ipv6InterfaceContainer lowPanInterfaces;
+            /** IP only: the producer of every content of the domain. */
+            Ptr<CoapContentDirectory> directory;
+        };
+
+        /** Create the backhaul. */
+        void BuildBackhaul(void);
+        /** Create the domains, their devices and their positions. */
+        void BuildDomains(void);
+        /** Install the NDN stack and applications. */
+        void InstallNdn(void);
+        /** Install the 6LoWPAN and IPv6 stack, RIPng and the CoAP applications. */
+        void InstallIp(void);
+
+        /**
+         * \returns A random backhaul leaf router without domain, for a consumer.
+         */
+        Ptr<Node> SelectConsumerLeaf(void);
+
+        /**
+         * \param n The number of contents.
+         * \returns A random permutation of 0 to n - 1, the order contents are dealt to the producers.
+         */
+        std::vector<uint32_t> ShuffleContents(uint32_t n) const;
+
+        /**
+         * Reduce the RIPng updates once the routes have converged.
+         *
+         * \param routers The routers running RIPng.
+         */
+        static void SlowDownRipNg(NodeContainer routers);
+
+        IotScenarioConfig m_config; //!< The scenario.
+        BriteTopologyHelper m_brite; //!< The backhaul.
+        CsmaHelper m_csma; //!< The gateway links.
+        LrWpanHelper m_lrWpan; //!< The 802.15.4 devices, a channel per domain.
+        std::vector<Domain> m_domains; //!< The domains.
+        NodeContainer m_backhaul; //!< The backhaul routers.
+        NodeContainer m_gateways; //!< The gateways.
+        NodeContainer m_motes; //!< The motes.
+        std::vector<Ptr<Node> > m_freeLeaves; //!< The backhaul leaf routers without domain.
+        ApplicationContainer m_producers; //!< The producers or servers.
+        ApplicationContainer m_consumers; //!< The consumers or clients.
+        Ptr<UniformRandomVariable> m_leafRng; //!< Selects the leaf routers of the domains.
+        Ptr<UniformRandomVariable> m_consumerLeafRng; //!< Selects the leaf routers of the consumers.
+        Ptr<UniformRandomVariable> m_insideRng; //!< Selects the motes of the consumers.
+        Ptr<UniformRandomVariable> m_frequencyRng; //!< Draws the request frequencies.
+        Ptr<UniformRandomVariable> m_startRng; //!< Draws the start delays.
+        Ptr<UniformRandomVariable> m_contentRng; //!< Assigns the contents to the producers.
+        bool m_built; //!< Whether Build() was called.
+    };
+
+} // namespace ns3
+
+#endif /* IOT_SCENARIO_HELPER_H */
@@ -0,0 +1,289 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#include "iot-scenario-config.h"
+
+#include <fstream>
+#include <set>
+#include <sstream>
+
+#include <boost/property_tree/info_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include "ns3/abort.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+    NS_LOG_COMPONENT_DEFINE("IotScenarioConfig");
+
+    namespace {
+
+        typedef boost::property_tree::ptree Section;
+
+        /**
+         * Abort on the keys of a section which are not in \p known.
+         */
+        void
+        CheckKeys(const Section &section, const std::string &source, const std::string &name,
+                const std::set<std::string> &known) {
+            for (Section::const_iterator i = section.begin(); i != section.end(); ++i) {
+                NS_ABORT_MSG_IF(known.count(i->first) == 0,
+                        source << ": unknown key \"" << i->first << "\" in section " << name);
+            }
+        }
+
+        /**
+         * The value of \p key in \p section, \p value if it is missing.
+         */
+        template<typename T>
+        T
+        GetValue(const Section &section, const std::string &source, const std::string &name,
+                const std::string &key, T value) {
+            boost::optional<const Section&> child = section.get_child_optional(key);
+            if (!child) {
+                return value;
+            }
+            std::istringstream is(child->data());
+            is >> value;
+            NS_ABORT_MSG_IF(is.fail() || !is.eof(),
+                    source << ": invalid value \"" << child->data() << "\" of " << name << "." << key);
+            return value;
+        }
+
+        template<>
+        std::string
+        GetValue<std::string>(const Section &section, const std::string &source, const std::string &name,
+                const std::string &key, std::string value) {
+            return section.get<std::string>(key, value);
+        }
+
+        template<>
+        bool
+        GetValue<bool>(const Section &section, const std::string &source, const std::string &name,
+                const std::string &key, bool value) {
+            boost::optional<const Section&> child = section.get_child_optional(key);
+            if (!child) {
+                return value;
+            }
+            const std::string &data = child->data();
+            if (data == "yes" || data == "true" || data == "on" || data == "1") {
+                return true;
+            }
+            NS_ABORT_MSG_UNLESS(data == "no" || data == "false" || data == "off" || data == "0",
+                    source << ": invalid value \"" << data << "\" of " << name << "." << key);
+            return false;
+        }
+
+        /**
+         * Read a duration in seconds, or with a unit as in "2ms".
+         */
+        Time
+        GetTime(const Section &section, const std::string &source, const std::string &name,
+                const std::string &key, Time value) {
+            std::string data = GetValue<std::string>(section, source, name, key, "");
+            if (data.empty()) {
+                return value;
+            }
+            if (data.find_first_not_of("0123456789.") == std::string::npos) {
+                data += "s";
+            }
+            return Time(data);
+        }
+
+        /**
+         * An empty section when \p section has no child \p key.
+         */
+        const Section &
+        GetSection(const Section &section, const std::string &key) {
+            static const Section empty;
+            boost::optional<const Section&> child = section.get_child_optional(key);
+            return child ? *child : empty;
+        }
+
+        IotDomainConfig
+        ParseDomain(const Section &section, const std::string &source, uint32_t index) {
+            std::ostringstream name;
+            name << "domain " << index;
+
+            CheckKeys(section, source, name.str(), {"name", "count", "motes", "producers", "contents", "mac", "consumers"});
+            IotDomainConfig domain;
+            domain.name = GetValue<std::string>(section, source, name.str(), "name", domain.name);
+            domain.count = GetValue<uint32_t>(section, source, name.str(), "count", domain.count);
+            domain.motes = GetValue<uint32_t>(section, source, name.str(), "motes", domain.motes);
+            domain.producers = GetValue<uint32_t>(section, source, name.str(), "producers", domain.motes);
+            domain.contents = GetValue<uint32_t>(section, source, name.str(), "contents", domain.producers);
+            domain.mac = GetValue<std::string>(section, source, name.str(), "mac", domain.mac);
+
+            const Section &consumers = GetSection(section, "consumers");
+            std::string consumersName = name.str() + ".consumers";
+            CheckKeys(consumers, source, consumersName, {"leaf", "inside", "gateway"});
+            domain.leafConsumers = GetValue<uint32_t>(consumers, source, consumersName, "leaf", domain.leafConsumers);
+            domain.insideConsumers = GetValue<uint32_t>(consumers, source, consumersName, "inside", domain.insideConsumers);
+            domain.gatewayConsumers = GetValue<uint32_t>(consumers, source, consumersName, "gateway", domain.gatewayConsumers);
+
+            NS_ABORT_MSG_IF(domain.name.empty() || domain.name.find('/') != std::string::npos,
+                    source << ": invalid name \"" << domain.name << "\" of " << name.str());
+            NS_ABORT_MSG_IF(domain.count == 0, source << ": " << name.str() << " has no domains");
+            NS_ABORT_MSG_IF(domain.motes == 0, source << ": " << name.str() << " has no motes");
+            NS_ABORT_MSG_IF(domain.producers == 0 || domain.producers > domain.motes,
+                    source << ": " << name.str() << " needs between 1 and " << domain.motes << " producers");
+            NS_ABORT_MSG_IF(domain.contents < domain.producers,
+                    source << ": " << name.str() << " needs at least one content per producer");
+            NS_ABORT_MSG_UNLESS(domain.mac == "lrwpan" || domain.mac == "contikimac",
+                    source << ": unknown mac \"" << domain.mac << "\" of " << name.str());
+            return domain;
+        }
+
+    } // namespace
+
+    IotDomainConfig::IotDomainConfig()
+    : name("Home"),
+    count(1),
+    motes(9),
+    producers(9),
+    contents(9),
+    mac("lrwpan"),
+    leafConsumers(0),
+    insideConsumers(0),
+    gatewayConsumers(0) {
+    }
+
+    IotScenarioConfig::IotScenarioConfig()
+    : stack("ndn"),
+    simTime(Seconds(300)),
+    run(43221),
+    spacing(100),
+    briteConf("./TD_ASBarabasi_RTWaxman.conf"),
+    gatewayLinkRate(5000000),
+    gatewayLinkDelay(MilliSeconds(2)),
+    payloadSize(10),
+    minFrequency(0.0166),
+    maxFrequency(5),
+    trafficStart(Seconds(120)),
+    zipfQ(0.7),
+    zipfS(0.7),
+    congestionControl(false),
+    cacheSize(100),
+    freshness(Seconds(0)),
+    reportTime(1000),
+    gatewayCache(false),
+    ndnCompression(false),
+    ipBackhaul(false),
+    routing("ripng") {
+    }
+
+    IotScenarioConfig
+    IotScenarioConfig::Read(std::string filename) {
+        NS_LOG_FUNCTION(filename);
+        std::ifstream is(filename.c_str());
+        NS_ABORT_MSG_IF(!is.good(), "Cannot read scenario file " << filename);
+        return Parse(is, filename);
+    }
+
+    IotScenarioConfig
+    IotScenarioConfig::Parse(std::istream &is, std::string source) {
+        NS_LOG_FUNCTION(&is << source);
+        Section root;
+        try {
+            boost::property_tree::read_info(is, root);
+        } catch (const boost::property_tree::info_parser_error &error) {
+            NS_FATAL_ERROR(source << ":" << error.line() << ": " << error.message());
+        }
+
+        CheckKeys(root, source, "root", {"scenario", "backhaul", "traffic", "caching", "ndn", "ip", "domain"});
+        IotScenarioConfig config;
+
+        const Section &scenario = GetSection(root, "scenario");
+        CheckKeys(scenario, source, "scenario", {"stack", "simtime", "run", "spacing"});
+        config.stack = GetValue<std::string>(scenario, source, "scenario", "stack", config.stack);
+        config.simTime = GetTime(scenario, source, "scenario", "simtime", config.simTime);
+        config.run = GetValue<uint32_t>(scenario, source, "scenario", "run", config.run);
+        config.spacing = GetValue<double>(scenario, source, "scenario", "spacing", config.spacing);
+
+        const Section &backhaul = GetSection(root, "backhaul");
+        CheckKeys(backhaul, source, "backhaul", {"brite", "topology", "cache", "rate", "delay"});
+        config.briteConf = GetValue<std::string>(backhaul, source, "backhaul", "brite", config.briteConf);
+        config.topologyFile = GetValue<std::string>(backhaul, source, "backhaul", "topology", config.topologyFile);
+        config.briteCacheDirectory = GetValue<std::string>(backhaul, source, "backhaul", "cache", config.briteCacheDirectory);
+        std::string rate = GetValue<std::string>(backhaul, source, "backhaul", "rate", "");
+        if (!rate.empty()) {
+            config.gatewayLinkRate = DataRate(rate);
+        }
+        config.gatewayLinkDelay = GetTime(backhaul, source, "backhaul", "delay", config.gatewayLinkDelay);
+
+        const Section &traffic = GetSection(root, "traffic");
+        CheckKeys(traffic, source, "traffic", {"payload", "min_frequency", "max_frequency", "start", "zipf_q", "zipf_s", "congestion_control"});
+        config.payloadSize = GetValue<uint32_t>(traffic, source, "traffic", "payload", config.payloadSize);
+        config.minFrequency = GetValue<double>(traffic, source, "traffic", "min_frequency", config.minFrequency);
+        config.maxFrequency = GetValue<double>(traffic, source, "traffic", "max_frequency", config.maxFrequency);
+        config.trafficStart = GetTime(traffic, source, "traffic", "start", config.trafficStart);
+        config.zipfQ = GetValue<double>(traffic, source, "traffic", "zipf_q", config.zipfQ);
+        config.zipfS = GetValue<double>(traffic, source, "traffic", "zipf_s", config.zipfS);
+        config.congestionControl = GetValue<bool>(traffic, source, "traffic", "congestion_control", config.congestionControl);
+
+        const Section &caching = GetSection(root, "caching");
+        CheckKeys(caching, source, "caching", {"size", "freshness", "report_time", "gateway"});
+        config.cacheSize = GetValue<uint32_t>(caching, source, "caching", "size", config.cacheSize);
+        config.freshness = GetTime(caching, source, "caching", "freshness", config.freshness);
+        config.reportTime = GetValue<uint32_t>(caching, source, "caching", "report_time", config.reportTime);
+        config.gatewayCache = GetValue<bool>(caching, source, "caching", "gateway", config.gatewayCache);
+
+        const Section &ndn = GetSection(root, "ndn");
+        CheckKeys(ndn, source, "ndn", {"compression", "ip_backhaul"});
+        config.ndnCompression = GetValue<bool>(ndn, source, "ndn", "compression", config.ndnCompression);
+        config.ipBackhaul = GetValue<bool>(ndn, source, "ndn", "ip_backhaul", config.ipBackhaul);
+
+        const Section &ip = GetSection(root, "ip");
+        CheckKeys(ip, source, "ip", {"routing"});
+        config.routing = GetValue<std::string>(ip, source, "ip", "routing", config.routing);
+
+        for (Section::const_iterator i = root.begin(); i != root.end(); ++i) {
+            if (i->first == "domain") {
+                config.domains.push_back(ParseDomain(i->second, source, config.domains.size()));
+            }
+        }
+
+        NS_ABORT_MSG_UNLESS(config.stack == "ndn" || config.stack == "ip",
+                source << ": unknown stack \"" << config.stack << "\"");
+        NS_ABORT_MSG_UNLESS(config.routing == "ripng" || config.routing == "ripng-freeze" || config.routing == "static",
+                source << ": unknown routing \"" << config.routing << "\"");
+        NS_ABORT_MSG_IF(config.minFrequency <= 0 || config.maxFrequency < config.minFrequency,
+                source << ": invalid request frequencies " << config.minFrequency << " to " << config.maxFrequency);
+        NS_ABORT_MSG_IF(config.domains.empty(), source << ": no domain section");
+        return config;
+    }
+
+    uint32_t
+    IotScenarioConfig::GetNDomains(void) const {
+        uint32_t n = 0;
+        for (std::vector<IotDomainConfig>::const_iterator i = domains.begin(); i != domains.end(); ++i) {
+            n += i->count;
+        }
+        return n;
+    }
+
+    uint32_t
+    IotScenarioConfig::GetNMotes(void) const {
+        uint32_t n = 0;
+        for (std::vector<IotDomainConfig>::const_iterator i = domains.begin(); i != domains.end(); ++i) {
+            n += i->count * i->motes;
+        }
+        return n;
+    }
+
+} // namespace ns3
@@ -0,0 +1,222 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ */
+
+#ifndef IOT_SCENARIO_CONFIG_H
+#define IOT_SCENARIO_CONFIG_H
+
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "ns3/data-rate.h"
+#include "ns3/nstime.h"
+
+namespace ns3 {
+
+    /**
+     * \defgroup iot-scenario IoT scenarios
+     *
+     * Build smart home and smart factory scenarios, sensor domains behind
+     * border gateways on a BRITE backhaul, from a declarative configuration.
+     */
+
+    /**
+     * \ingroup iot-scenario
+     * \brief One family of sensor domains of an IoT scenario.
+     *
+     * A domain is a 802.15.4 PAN of motes and its border gateway, which is
+     * connected by a CSMA link to a leaf router of the backhaul.
+     */
+    struct IotDomainConfig {
+        IotDomainConfig();
+
+        /** Name of the domains, the NDN prefixes are /<name>_<index>/SensorData. */
+        std::string name;
+        /** Number of identical domains. */
+        uint32_t count;
+        /** Number of motes in each domain. */
+        uint32_t motes;
+        /** Number of motes producing contents, the first ones of the domain. */
+        uint32_t producers;
+        /** Number of contents of each domain, spread over the producers. */
+        uint32_t contents;
+        /** MAC of the motes: "lrwpan" or "contikimac". */
+        std::string mac;
+        /** Number of consumers of the domain contents on unconnected backhaul leaf routers. */
+        uint32_t leafConsumers;
+        /** Number of consumers of the domain contents on motes of the domain. */
+        uint32_t insideConsumers;
+        /** Number of consumers of the domain contents on the gateway of the domain. */
+        uint32_t gatewayConsumers;
+    };
+
+    /**
+     * \ingroup iot-scenario
+     * \brief The declarative description of an IoT scenario.
+     *
+     * The configuration file uses the INFO format of the NFD configuration:
+     * sections of "key value" lines between braces, ';' starting a comment.
+     * Every key has a default, only the domain sections are required, and
+     * an unknown key is an error.
+     *
+     *     scenario
+     *     {
+     *       stack ndn                 ; ndn or ip
+     *       simtime 300               ; seconds
+     *       run 43221                 ; RngRun
+     *       spacing 100               ; meters between domains
+     *     }
+     *     backhaul
+     *     {
+     *       brite ./TD_ASBarabasi_RTWaxman.conf
+     *       topology backhaul.txt     ; annotated topology read instead of running BRITE
+     *       cache ./brite-cache       ; directory caching the BRITE topologies
+     *       rate 5Mbps                ; gateway links
+     *       delay 2ms
+     *     }
+     *     traffic
+     *     {
+     *       payload 10                ; bytes
+     *       min_frequency 0.0166      ; requests per second, drawn per consumer
+     *       max_frequency 5
+     *       start 120                 ; consumers start, also the RIPng warm-up
+     *       zipf_q 0.7
+     *       zipf_s 0.7
+     *       congestion_control no     ; AIMD for NDN consumers, CoCoA for CoAP clients
+     *     }
+     *     caching
+     *     {
+     *       size 100                  ; 0 disables caching
+     *       freshness 0               ; seconds, 0 disables freshness
+     *       report_time 1000
+     *       gateway no                ; IP only: CoAP cache on the gateways
+     *     }
+     *     ndn
+     *     {
+     *       compression no            ; compress NDN on the 802.15.4 links
+     *       ip_backhaul no            ; model an IP backhaul, without caches
+     *     }
+     *     ip
+     *     {
+     *       routing ripng             ; ripng, ripng-freeze or static
+     *     }
+     *     domain
+     *     {
+     *       name Home
+     *       count 3
+     *       motes 9
+     *       producers 9
+     *       contents 9                ; spread over the producers, defaults to producers
+     *       mac lrwpan                ; lrwpan or contikimac
+     *       consumers
+     *       {
+     *         leaf 0
+     *         inside 0
+     *         gateway 1
+     *       }
+     *     }
+     */
+    struct IotScenarioConfig {
+        IotScenarioConfig();
+
+        /**
+         * Read a scenario from a configuration file.
+         *
+         * \param filename The configuration file.
+         * \returns The scenario, the program is aborted on an invalid file.
+         */
+        static IotScenarioConfig Read(std::string filename);
+
+        /**
+         * Read a scenario from a configuration.
+         *
+         * \param is The configuration.
+         * \param source The name of the configuration in the error messages.
+         * \returns The scenario, the program is aborted on an invalid configuration.
+         */
+        static IotScenarioConfig Parse(std::istream &is, std::string source);
+
+        /**
+         * \returns The number of domains, each domain section counting for
+         *          its number of identical domains.
+         */
+        uint32_t GetNDomains(void) const;
+
+        /**
+         * \returns The number of motes of all the domains.
+         */
+        uint32_t GetNMotes(void) const;
+
+        /** Network stack: "ndn" or "ip". */
+        std::string stack;
+        /** Duration of the simulation. */
+        Time simTime;
+        /** Run number of the random number generator. */
+        uint32_t run;
+        /** Distance between the domains, in meters. */
+        double spacing;
+
+        /** BRITE configuration of the backhaul. */
+        std::string briteConf;
+        /** Annotated topology file read instead of running BRITE, empty for none. */
+        std::string topologyFile;
+        /** Directory caching the BRITE topologies, empty for none. */
+        std::string briteCacheDirectory;
+        /** Data rate of the links between the gateways and the backhaul. */
+        DataRate gatewayLinkRate;
+        /** Delay of the links between the gateways and the backhaul. */
+        Time gatewayLinkDelay;
+
+        /** Payload of a content, in bytes. */
+        uint32_t payloadSize;
+        /** Lower bound of the request frequency of a consumer, in requests per second. */
+        double minFrequency;
+        /** Upper bound of the request frequency of a consumer, in requests per second. */
+        double maxFrequency;
+        /** Start of the consumers, also the RIPng warm-up. */
+        Time trafficStart;
+        /** Zipf-Mandelbrot q of the content popularity. */
+        double zipfQ;
+        /** Zipf-Mandelbrot s of the content popularity. */
+        double zipfS;
+        /** AIMD window for NDN consumers, CoCoA for CoAP clients. */
+        bool congestionControl;
+
+        /** Number of contents in each cache, 0 to disable caching. */
+        uint32_t cacheSize;
+        /** Freshness of the contents, 0 to disable freshness. */
+        Time freshness;
+        /** Report time of the cache utilization metric. */
+        uint32_t reportTime;
+        /** IP only: CoAP cache on the gateways. */
+        bool gatewayCache;
+
+        /** Compress NDN on the 802.15.4 links. */
+        bool ndnCompression;
+        /** Model an IP backhaul for NDN: no caches and overhead names on the backhaul. */
+        bool ipBackhaul;
+
+        /** IP routing: "ripng", "ripng-freeze" or "static". */
+        std::string routing;
+
+        /** The domain families, in the order of the configuration. */
+        std::vector<IotDomainConfig> domains;
+    };
+
+} // namespace ns3
+
+#endif /* IOT_SCENARIO_CONFIG_H */
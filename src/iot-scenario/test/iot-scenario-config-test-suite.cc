@@ -0,0 +1,134 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/iot-scenario-config.h"
+
+#include <sstream>
+
+using namespace ns3;
+
+/**
+ * \brief A configuration with only a domain section gets the defaults
+ */
+class IotScenarioConfigDefaultsTestCase : public TestCase {
+public:
+    IotScenarioConfigDefaultsTestCase();
+    virtual void DoRun(void);
+};
+
+IotScenarioConfigDefaultsTestCase::IotScenarioConfigDefaultsTestCase()
+: TestCase("A minimal configuration gets the defaults") {
+}
+
+void
+IotScenarioConfigDefaultsTestCase::DoRun(void) {
+    std::istringstream is("domain\n{\n}\n");
+    IotScenarioConfig config = IotScenarioConfig::Parse(is, "defaults");
+    IotScenarioConfig defaults;
+
+    NS_TEST_ASSERT_MSG_EQ(config.stack, "ndn", "stack");
+    NS_TEST_EXPECT_MSG_EQ(config.simTime, defaults.simTime, "simtime");
+    NS_TEST_EXPECT_MSG_EQ(config.run, defaults.run, "run");
+    NS_TEST_EXPECT_MSG_EQ(config.gatewayLinkDelay, MilliSeconds(2), "delay");
+    NS_TEST_EXPECT_MSG_EQ(config.cacheSize, defaults.cacheSize, "cache size");
+    NS_TEST_EXPECT_MSG_EQ(config.routing, "ripng", "routing");
+    NS_TEST_ASSERT_MSG_EQ(config.domains.size(), 1, "domain sections");
+    NS_TEST_EXPECT_MSG_EQ(config.domains[0].name, "Home", "domain name");
+    NS_TEST_EXPECT_MSG_EQ(config.domains[0].motes, 9, "motes");
+    NS_TEST_EXPECT_MSG_EQ(config.domains[0].producers, 9, "producers");
+    NS_TEST_EXPECT_MSG_EQ(config.domains[0].contents, 9, "contents");
+    NS_TEST_EXPECT_MSG_EQ(config.domains[0].mac, "lrwpan", "mac");
+    NS_TEST_EXPECT_MSG_EQ(config.GetNDomains(), 1, "domains");
+    NS_TEST_EXPECT_MSG_EQ(config.GetNMotes(), 9, "motes of all the domains");
+}
+
+/**
+ * \brief Every section of a configuration is read
+ */
+class IotScenarioConfigParseTestCase : public TestCase {
+public:
+    IotScenarioConfigParseTestCase();
+    virtual void DoRun(void);
+};
+
+IotScenarioConfigParseTestCase::IotScenarioConfigParseTestCase()
+: TestCase("A full configuration is read") {
+}
+
+void
+IotScenarioConfigParseTestCase::DoRun(void) {
+    std::istringstream is(
+            "; a small factory\n"
+            "scenario\n{\n  stack ip\n  simtime 600\n  run 7\n}\n"
+            "backhaul\n{\n  rate 10Mbps\n  delay 1ms\n}\n"
+            "traffic\n{\n  payload 32\n  start 60\n  zipf_s 0.9\n  congestion_control yes\n}\n"
+            "caching\n{\n  size 50\n  freshness 10\n  gateway on\n}\n"
+            "ip\n{\n  routing static\n}\n"
+            "domain\n{\n  name Hall\n  count 4\n  motes 25\n  producers 20\n  contents 200\n  mac contikimac\n"
+            "  consumers\n  {\n    leaf 2\n    gateway 1\n  }\n}\n"
+            "domain\n{\n  name Office\n  count 2\n  producers 4\n  consumers\n  {\n    inside 3\n  }\n}\n");
+    IotScenarioConfig config = IotScenarioConfig::Parse(is, "factory");
+
+    NS_TEST_EXPECT_MSG_EQ(config.stack, "ip", "stack");
+    NS_TEST_EXPECT_MSG_EQ(config.simTime, Seconds(600), "simtime");
+    NS_TEST_EXPECT_MSG_EQ(config.run, 7, "run");
+    NS_TEST_EXPECT_MSG_EQ(config.gatewayLinkRate, DataRate("10Mbps"), "rate");
+    NS_TEST_EXPECT_MSG_EQ(config.gatewayLinkDelay, MilliSeconds(1), "delay");
+    NS_TEST_EXPECT_MSG_EQ(config.payloadSize, 32, "payload");
+    NS_TEST_EXPECT_MSG_EQ(config.trafficStart, Seconds(60), "start");
+    NS_TEST_EXPECT_MSG_EQ_TOL(config.zipfS, 0.9, 1e-9, "zipf_s");
+    NS_TEST_EXPECT_MSG_EQ(config.congestionControl, true, "congestion_control");
+    NS_TEST_EXPECT_MSG_EQ(config.cacheSize, 50, "cache size");
+    NS_TEST_EXPECT_MSG_EQ(config.freshness, Seconds(10), "freshness");
+    NS_TEST_EXPECT_MSG_EQ(config.gatewayCache, true, "gateway cache");
+    NS_TEST_EXPECT_MSG_EQ(config.routing, "static", "routing");
+
+    NS_TEST_ASSERT_MSG_EQ(config.domains.size(), 2, "domain sections");
+    const IotDomainConfig &hall = config.domains[0];
+    NS_TEST_EXPECT_MSG_EQ(hall.name, "Hall", "first domain name");
+    NS_TEST_EXPECT_MSG_EQ(hall.count, 4, "first domain count");
+    NS_TEST_EXPECT_MSG_EQ(hall.producers, 20, "first domain producers");
+    NS_TEST_EXPECT_MSG_EQ(hall.contents, 200, "first domain contents");
+    NS_TEST_EXPECT_MSG_EQ(hall.mac, "contikimac", "first domain mac");
+    NS_TEST_EXPECT_MSG_EQ(hall.leafConsumers, 2, "first domain leaf consumers");
+    NS_TEST_EXPECT_MSG_EQ(hall.insideConsumers, 0, "first domain inside consumers");
+    NS_TEST_EXPECT_MSG_EQ(hall.gatewayConsumers, 1, "first domain gateway consumers");
+    const IotDomainConfig &office = config.domains[1];
+    NS_TEST_EXPECT_MSG_EQ(office.name, "Office", "second domain name");
+    NS_TEST_EXPECT_MSG_EQ(office.motes, 9, "second domain motes");
+    NS_TEST_EXPECT_MSG_EQ(office.contents, 4, "second domain contents, one per producer");
+    NS_TEST_EXPECT_MSG_EQ(office.insideConsumers, 3, "second domain inside consumers");
+
+    NS_TEST_EXPECT_MSG_EQ(config.GetNDomains(), 6, "domains");
+    NS_TEST_EXPECT_MSG_EQ(config.GetNMotes(), 4 * 25 + 2 * 9, "motes of all the domains");
+}
+
+/**
+ * \brief IotScenarioConfig test suite
+ */
+class IotScenarioConfigTestSuite : public TestSuite {
+public:
+    IotScenarioConfigTestSuite();
+};
+
+IotScenarioConfigTestSuite::IotScenarioConfigTestSuite()
+: TestSuite("iot-scenario-config", UNIT) {
+    AddTestCase(new IotScenarioConfigDefaultsTestCase, TestCase::QUICK);
+    AddTestCase(new IotScenarioConfigParseTestCase, TestCase::QUICK);
+}
+
+static IotScenarioConfigTestSuite g_iotScenarioConfigTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,206 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/node.h"
+#include "ns3/net-device.h"
+#include "ns3/application.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/coap-content-directory.h"
+#include "ns3/iot-scenario-helper.h"
+
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \brief Write a backhaul of a border router and five leaf routers, read
+ * instead of running BRITE
+ * \param file the topology file
+ */
+static void
+WriteBackhaul(std::string file) {
+    std::ofstream os(file.c_str());
+    os << "router\n"
+            << "n0\tAS0:RT_BORDER\t0\t0\n";
+    for (uint32_t i = 1; i <= 5; i++) {
+        os << "n" << i << "\tAS0:RT_LEAF\t" << 10 * i << "\t10\n";
+    }
+    os << "link\n";
+    for (uint32_t i = 1; i <= 5; i++) {
+        os << "n0\tn" << i << "\t100Mbps\t1\t1ms\n";
+    }
+}
+
+/**
+ * \brief A small scenario is built with its domains, devices and applications
+ */
+class IotScenarioHelperBuildTestCase : public TestCase {
+public:
+    /**
+     * \param stack ndn or ip
+     */
+    IotScenarioHelperBuildTestCase(std::string stack);
+    virtual void DoRun(void);
+
+private:
+    std::string m_stack; //!< The stack of the scenario
+};
+
+IotScenarioHelperBuildTestCase::IotScenarioHelperBuildTestCase(std::string stack)
+: TestCase("A small " + stack + " scenario is built"),
+m_stack(stack) {
+}
+
+void
+IotScenarioHelperBuildTestCase::DoRun(void) {
+    uint32_t run = RngSeedManager::GetRun();
+    std::string topology = CreateTempDirFilename("backhaul.txt");
+    WriteBackhaul(topology);
+    std::istringstream is(
+            "scenario\n{\n  stack " + m_stack + "\n}\n"
+            "backhaul\n{\n  topology " + topology + "\n}\n"
+            "domain\n{\n  count 2\n  motes 4\n  producers 2\n  contents 6\n"
+            "  consumers\n  {\n    leaf 1\n    inside 1\n    gateway 1\n  }\n}\n");
+    IotScenarioHelper scenario(IotScenarioConfig::Parse(is, m_stack));
+    scenario.Build();
+
+    NS_TEST_ASSERT_MSG_EQ(scenario.GetNDomains(), 2, "domains");
+    NS_TEST_EXPECT_MSG_EQ(scenario.GetBackhaul().GetN(), 6, "backhaul routers");
+    NS_TEST_EXPECT_MSG_EQ(scenario.GetMotes().GetN(), 8, "motes");
+    NS_TEST_EXPECT_MSG_EQ(scenario.GetGateways().GetN(), 2, "gateways");
+    for (uint32_t i = 0; i < scenario.GetNDomains(); i++) {
+        NS_TEST_EXPECT_MSG_EQ(scenario.GetDomain(i).GetN(), 5, "nodes of domain " << i);
+        NS_TEST_EXPECT_MSG_EQ(scenario.GetDomain(i).Get(4), scenario.GetGateways().Get(i), "gateway of domain " << i);
+        NS_TEST_EXPECT_MSG_EQ(scenario.GetLrWpanDevices(i).GetN(), 5, "802.15.4 devices of domain " << i);
+        NS_TEST_EXPECT_MSG_EQ(scenario.GetCsmaDevices(i).GetN(), 2, "CSMA devices of domain " << i);
+    }
+    NS_TEST_EXPECT_MSG_EQ(scenario.GetConsumers().GetN(), 6, "consumers");
+
+    if (m_stack == "ndn") {
+        // a producer application per content
+        NS_TEST_EXPECT_MSG_EQ(scenario.GetProducers().GetN(), 12, "producers");
+        std::map<Ptr<Node>, uint32_t> contents;
+        for (ApplicationContainer::Iterator app = scenario.GetProducers().Begin(); app != scenario.GetProducers().End(); ++app) {
+            contents[(*app)->GetNode()]++;
+        }
+        NS_TEST_EXPECT_MSG_EQ(contents.size(), 4, "producing motes");
+        for (std::map<Ptr<Node>, uint32_t>::const_iterator it = contents.begin(); it != contents.end(); ++it) {
+            NS_TEST_EXPECT_MSG_EQ(it->second, 3, "contents of node " << it->first->GetId());
+        }
+    } else {
+        // a server per producer, the contents in the directory of the domain
+        NS_TEST_EXPECT_MSG_EQ(scenario.GetProducers().GetN(), 4, "servers");
+        for (uint32_t i = 0; i < scenario.GetNDomains(); i++) {
+            Ptr<CoapContentDirectory> directory = scenario.GetContentDirectory(i);
+            NS_TEST_ASSERT_MSG_NE(directory, 0, "directory of domain " << i);
+            NS_TEST_EXPECT_MSG_EQ(directory->GetN(), 6, "contents of domain " << i);
+            std::map<Ipv6Address, uint32_t> contents;
+            for (uint32_t id = 0; id < directory->GetN(); id++) {
+                contents[directory->Resolve(id).address]++;
+            }
+            NS_TEST_EXPECT_MSG_EQ(contents.size(), 2, "producers of domain " << i);
+            for (std::map<Ipv6Address, uint32_t>::const_iterator it = contents.begin(); it != contents.end(); ++it) {
+                NS_TEST_EXPECT_MSG_EQ(it->second, 3, "contents of " << it->first);
+            }
+        }
+    }
+
+    Simulator::Destroy();
+    RngSeedManager::SetRun(run);
+}
+
+/**
+ * \brief The run of the configuration changes the draws of the scenario
+ */
+class IotScenarioHelperRunTestCase : public TestCase {
+public:
+    IotScenarioHelperRunTestCase();
+    virtual void DoRun(void);
+
+private:
+    /**
+     * \brief Build a scenario and return the leaf routers of its domains
+     * \param run the run of the configuration
+     * \returns the index in the backhaul of the leaf router of every domain
+     */
+    std::vector<uint32_t> DrawLeaves(uint32_t run);
+};
+
+IotScenarioHelperRunTestCase::IotScenarioHelperRunTestCase()
+: TestCase("The run of the configuration changes the leaf routers of the domains") {
+}
+
+std::vector<uint32_t>
+IotScenarioHelperRunTestCase::DrawLeaves(uint32_t run) {
+    std::string topology = CreateTempDirFilename("backhaul.txt");
+    WriteBackhaul(topology);
+    std::ostringstream is;
+    is << "scenario\n{\n  stack ip\n  run " << run << "\n}\n"
+            << "backhaul\n{\n  topology " << topology << "\n}\n"
+            << "domain\n{\n  count 8\n  motes 1\n  producers 1\n  contents 1\n}\n";
+    std::istringstream config(is.str());
+    IotScenarioHelper scenario(IotScenarioConfig::Parse(config, "run"));
+    scenario.Build();
+
+    std::vector<uint32_t> leaves;
+    NodeContainer backhaul = scenario.GetBackhaul();
+    for (uint32_t i = 0; i < scenario.GetNDomains(); i++) {
+        Ptr<Node> leaf = scenario.GetCsmaDevices(i).Get(1)->GetNode();
+        for (uint32_t j = 0; j < backhaul.GetN(); j++) {
+            if (backhaul.Get(j) == leaf) {
+                leaves.push_back(j);
+            }
+        }
+    }
+    Simulator::Destroy();
+    return leaves;
+}
+
+void
+IotScenarioHelperRunTestCase::DoRun(void) {
+    uint32_t run = RngSeedManager::GetRun();
+    std::vector<uint32_t> first = DrawLeaves(1);
+    std::vector<uint32_t> again = DrawLeaves(1);
+    std::vector<uint32_t> second = DrawLeaves(2);
+    RngSeedManager::SetRun(run);
+
+    NS_TEST_ASSERT_MSG_EQ(first.size(), 8, "leaf routers of the first run");
+    NS_TEST_ASSERT_MSG_EQ(second.size(), 8, "leaf routers of the second run");
+    NS_TEST_EXPECT_MSG_EQ((first == again), true, "the same run draws the same leaf routers");
+    NS_TEST_EXPECT_MSG_EQ((first != second), true, "another run draws other leaf routers");
+}
+
+/**
+ * \brief IotScenarioHelper test suite
+ */
+class IotScenarioHelperTestSuite : public TestSuite {
+public:
+    IotScenarioHelperTestSuite();
+};
+
+IotScenarioHelperTestSuite::IotScenarioHelperTestSuite()
+: TestSuite("iot-scenario-helper", UNIT) {
+    AddTestCase(new IotScenarioHelperBuildTestCase("ndn"), TestCase::QUICK);
+    AddTestCase(new IotScenarioHelperBuildTestCase("ip"), TestCase::QUICK);
+    AddTestCase(new IotScenarioHelperRunTestCase, TestCase::QUICK);
+}
+
+static IotScenarioHelperTestSuite g_iotScenarioHelperTestSuite; //!< Static variable for test initialization
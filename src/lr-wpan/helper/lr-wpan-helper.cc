@@ -301,12 +301,18 @@ namespace ns3
         std::string filename;
         if (explicitFilename) {
             filename = prefix;
+        } else if (GetPcapMergeChannels()) {
+            filename = pcapHelper.GetFilenameFromChannel(prefix, device->GetChannel());
         } else {
             filename = pcapHelper.GetFilenameFromDevice(prefix, device);
         }
 
-        Ptr<PcapFileWrapper> file = pcapHelper.CreateFile(filename, std::ios::out,
-                PcapHelper::DLT_IEEE802_15_4);
+        Ptr<PcapFileWrapper> file;
+        if (GetPcapMergeChannels()) {
+            file = pcapHelper.CreateInterface(filename, device, PcapHelper::DLT_IEEE802_15_4);
+        } else {
+            file = pcapHelper.CreateFile(filename, std::ios::out, PcapHelper::DLT_IEEE802_15_4);
+        }
 
         if (promiscuous == true) {
             device->GetMac()->TraceConnectWithoutContext("PromiscSniffer", MakeBoundCallback(&PcapSniffLrWpan, file));
@@ -185,9 +185,10 @@ namespace ns3
         NS_LOG_FUNCTION(this);
 
         // Pull a packet from the queue and start sending, if we are not already sending.
-        if (m_lrWpanMacState == MAC_IDLE && !m_txQueue.empty() && m_txPkt == 0 && !m_setMacState.IsRunning()) {
+        if (m_lrWpanMacState == MAC_IDLE && m_txPkt == 0 && !m_setMacState.IsRunning() && PrepareTxQueueHead()) {
             TxQueueElement *txQElement = m_txQueue.front();
             m_txPkt = txQElement->txQPkt;
+            m_txInService = true;
             Ptr<Packet> pkt = m_txPkt->Copy();
             LrWpanMacHeader hdr;
             pkt->RemoveHeader(hdr);
@@ -24,6 +24,7 @@
 #include <ns3/random-variable-stream.h>
 #include <ns3/simulator.h>
 #include <ns3/log.h>
+#include <ns3/boolean.h>
 #include <algorithm>
 
 namespace ns3
@@ -39,6 +40,13 @@ namespace ns3
                 .SetParent<Object> ()
                 .SetGroupName("LrWpan")
                 .AddConstructor<LrWpanCsmaCa> ()
+                .AddAttribute("Abstracted",
+                "Collapse the first backoff and CCA of the unslotted CSMA-CA into a single "
+                "event which senses the channel once. If the channel is busy, the remaining "
+                "backoffs are simulated exactly",
+                BooleanValue(false),
+                MakeBooleanAccessor(&LrWpanCsmaCa::m_abstracted),
+                MakeBooleanChecker())
                 ;
         return tid;
     }
@@ -57,6 +65,7 @@ namespace ns3
         m_random = CreateObject<UniformRandomVariable> ();
         m_BE = m_macMinBE;
         m_ccaRequestRunning = false;
+        m_abstracted = false;
     }
 
     LrWpanCsmaCa::~LrWpanCsmaCa() {
@@ -177,6 +186,10 @@ namespace ns3
             //TODO: for slotted, locate backoff period boundary. i.e. delay to the next slot boundary
             Time backoffBoundary = GetTimeToNextSlot();
             m_randomBackoffEvent = Simulator::Schedule(backoffBoundary, &LrWpanCsmaCa::RandomBackoffDelay, this);
+        } else if (m_abstracted) {
+            m_BE = m_macMinBE;
+            Time ccaTime = Seconds(8.0 / m_mac->GetPhy()->GetDataOrSymbolRate(false));
+            m_requestCcaEvent = Simulator::Schedule(GetRandomBackoff() + ccaTime, &LrWpanCsmaCa::AbstractedCCA, this);
         } else {
             m_BE = m_macMinBE;
             m_randomBackoffEvent = Simulator::ScheduleNow(&LrWpanCsmaCa::RandomBackoffDelay, this);
@@ -202,20 +215,24 @@ namespace ns3
      * Delay for backoff period in the range 0 to 2^BE -1 units
      * TODO: If using Backoff.cc (Backoff::GetBackoffTime) will need to be slightly modified
      */
-    void
-    LrWpanCsmaCa::RandomBackoffDelay() {
-        NS_LOG_FUNCTION(this);
-
+    Time
+    LrWpanCsmaCa::GetRandomBackoff() {
         uint64_t upperBound = (uint64_t) pow(2, m_BE) - 1;
         uint64_t backoffPeriod;
-        Time randomBackoff;
         uint64_t symbolRate;
         bool isData = false;
 
 
         symbolRate = (uint64_t) m_mac->GetPhy()->GetDataOrSymbolRate(isData); //symbols per second
         backoffPeriod = (uint64_t) m_random->GetValue(0, upperBound + 1); // num backoff periods
-        randomBackoff = MicroSeconds(backoffPeriod * GetUnitBackoffPeriod() * 1000 * 1000 / symbolRate);
+        return MicroSeconds(backoffPeriod * GetUnitBackoffPeriod() * 1000 * 1000 / symbolRate);
+    }
+
+    void
+    LrWpanCsmaCa::RandomBackoffDelay() {
+        NS_LOG_FUNCTION(this);
+
+        Time randomBackoff = GetRandomBackoff();
 
         if (IsUnSlottedCsmaCa()) {
             NS_LOG_LOGIC("Unslotted:  requesting CCA after backoff of " << randomBackoff.GetMicroSeconds() << " us");
@@ -256,6 +273,15 @@ namespace ns3
         m_mac->GetPhy()->PlmeCcaRequest();
     }
 
+    void
+    LrWpanCsmaCa::AbstractedCCA() {
+        NS_LOG_FUNCTION(this);
+        LrWpanPhyEnumeration status = m_mac->GetPhy()->SenseChannel();
+        NS_LOG_LOGIC("Abstracted CCA, channel sensed state: " << status);
+        m_ccaRequestRunning = true;
+        PlmeCcaConfirm(status);
+    }
+
     /*
      * This function is called when the phy calls back after completing a PlmeCcaRequest
      */
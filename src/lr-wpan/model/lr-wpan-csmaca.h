@@ -200,6 +200,14 @@ namespace ns3 {
          */
         void RequestCCA(void);
 
+        /**
+         * Abstracted replacement for steps 2 and 3 of the unslotted CSMA-CA: sense
+         * the channel once at the end of the random backoff and the CCA period,
+         * which were drawn and scheduled as a single event. A busy channel is
+         * handled as a regular CCA failure, so the remaining backoffs run exactly.
+         */
+        void AbstractedCCA(void);
+
         /**
          *  IEEE 802.15.4-2006 section 6.2.2.2
          *  PLME-CCA.confirm status
@@ -239,6 +247,13 @@ namespace ns3 {
         uint8_t GetNB(void);
 
     private:
+        /**
+         * Draw the random backoff of step 2 in the range of 0 to 2^BE -1 backoff periods.
+         *
+         * \return the backoff delay
+         */
+        Time GetRandomBackoff(void);
+
         // Disable implicit copy constructors
         /**
          * \brief Copy constructor - defined and not implemented.
@@ -333,6 +348,12 @@ namespace ns3 {
          * reporting the channel status to the MAC while canceling the CSMA algorithm.
          */
         bool m_ccaRequestRunning;
+
+        /**
+         * Whether the first backoff and CCA of the unslotted CSMA-CA are abstracted
+         * into a single event (see AbstractedCCA).
+         */
+        bool m_abstracted;
     };
 
 }
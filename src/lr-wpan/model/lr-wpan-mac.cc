@@ -31,8 +31,13 @@
 #include <ns3/uinteger.h>
 #include <ns3/node.h>
 #include <ns3/packet.h>
+#include <ns3/socket.h>
 #include <ns3/random-variable-stream.h>
 #include <ns3/double.h>
+#include <ns3/boolean.h>
+#include <ns3/enum.h>
+#include <ns3/string.h>
+#include <cmath>
 
 #undef NS_LOG_APPEND_CONTEXT
 #define NS_LOG_APPEND_CONTEXT                                   \
@@ -56,10 +61,41 @@ namespace ns3 {
                 MakeUintegerAccessor(&LrWpanMac::m_macPanId),
                 MakeUintegerChecker<uint16_t> ())
                 .AddAttribute("MaxQueueSize",
-                "If a packet arrives when queue at capacity, packet is dropped",
+                "If a packet arrives when queue at capacity, packets are dropped "
+                "according to the queue policy. 0 means no limit",
                 UintegerValue(4),
                 MakeUintegerAccessor(&LrWpanMac::m_qMaxSize),
                 MakeUintegerChecker<uint32_t> ())
+                .AddAttribute("MaxQueueBytes",
+                "If a packet arrives when the queue holds this many bytes (MPDU size), "
+                "packets are dropped according to the queue policy. 0 means no limit",
+                UintegerValue(0),
+                MakeUintegerAccessor(&LrWpanMac::m_qMaxBytes),
+                MakeUintegerChecker<uint32_t> ())
+                .AddAttribute("TxQueuePolicy",
+                "Drop the arriving packet (DropTail) or the oldest queued one (HeadDrop) "
+                "when the queue is full, or use drop-tail plus CoDel on the queue head (CoDel)",
+                EnumValue(TX_QUEUE_DROP_TAIL),
+                MakeEnumAccessor(&LrWpanMac::m_qPolicy),
+                MakeEnumChecker(TX_QUEUE_DROP_TAIL, "DropTail",
+                TX_QUEUE_HEAD_DROP, "HeadDrop",
+                TX_QUEUE_CODEL, "CoDel"))
+                .AddAttribute("PrioritizeControl",
+                "Queue control traffic (see LrWpanMac::IsControlMsdu) ahead of other "
+                "traffic and let it push out other traffic when the queue is full",
+                BooleanValue(false),
+                MakeBooleanAccessor(&LrWpanMac::m_qPrioritizeControl),
+                MakeBooleanChecker())
+                .AddAttribute("CoDelTarget",
+                "The CoDel target queue delay",
+                StringValue("50ms"),
+                MakeTimeAccessor(&LrWpanMac::m_codelTarget),
+                MakeTimeChecker())
+                .AddAttribute("CoDelInterval",
+                "The CoDel interval",
+                StringValue("500ms"),
+                MakeTimeAccessor(&LrWpanMac::m_codelInterval),
+                MakeTimeChecker())
                 .AddTraceSource("MacTxEnqueue",
                 "Trace source indicating a packet has been "
                 "enqueued in the transaction queue",
@@ -85,6 +121,24 @@ namespace ns3 {
                 "dropped during transmission",
                 MakeTraceSourceAccessor(&LrWpanMac::m_macTxDropTrace),
                 "ns3::Packet::TracedCallback")
+                .AddTraceSource("MacTxQueueDrop",
+                "Trace source indicating a packet has been "
+                "dropped by the transaction queue",
+                MakeTraceSourceAccessor(&LrWpanMac::m_macTxQueueDropTrace),
+                "ns3::Packet::TracedCallback")
+                .AddTraceSource("MacTxQueueLength",
+                "Number of packets in the transaction queue",
+                MakeTraceSourceAccessor(&LrWpanMac::m_qSize),
+                "ns3::TracedValue::Uint32Callback")
+                .AddTraceSource("MacTxQueueBytes",
+                "Number of bytes in the transaction queue",
+                MakeTraceSourceAccessor(&LrWpanMac::m_qBytes),
+                "ns3::TracedValue::Uint32Callback")
+                .AddTraceSource("MacTxQueueSojourn",
+                "Time spent in the transaction queue by the packet "
+                "last pulled from it for transmission",
+                MakeTraceSourceAccessor(&LrWpanMac::m_qSojourn),
+                "ns3::Time::TracedValueCallback")
                 .AddTraceSource("MacPromiscRx",
                 "A packet has been received by this device, "
                 "has been passed up from the physical layer "
@@ -134,6 +188,9 @@ namespace ns3 {
         ChangeMacState(MAC_IDLE);
 
         m_qSize = 0;
+        m_qBytes = 0;
+        m_codelDropping = false;
+        m_codelCount = 0;
         m_macPanId = 0;
         m_associationStatus = ASSOCIATED;
         m_selfExt = Mac64Address::Allocate();
@@ -142,6 +199,7 @@ namespace ns3 {
         m_retransmission = 0;
         m_numCsmacaRetry = 0;
         m_txPkt = 0;
+        m_txInService = false;
 
         Ptr<UniformRandomVariable> uniformVar = CreateObject<UniformRandomVariable> ();
         uniformVar->SetAttribute("Min", DoubleValue(0.0));
@@ -165,11 +223,15 @@ namespace ns3 {
             m_csmaCa = 0;
         }
         m_txPkt = 0;
+        m_txInService = false;
         for (uint32_t i = 0; i < m_txQueue.size(); i++) {
             m_txQueue[i]->txQPkt = 0;
             delete m_txQueue[i];
         }
         m_txQueue.clear();
+        m_qSize = 0;
+        m_qBytes = 0;
+        m_txPriorityCallback = MakeNullCallback<bool, Ptr<const Packet> > ();
         m_phy = 0;
         m_mcpsDataIndicationCallback = MakeNullCallback< void, McpsDataIndicationParams, Ptr<Packet> > ();
         m_mcpsDataConfirmCallback = MakeNullCallback< void, McpsDataConfirmParams > ();
@@ -205,11 +267,6 @@ namespace ns3 {
     LrWpanMac::McpsDataRequest(McpsDataRequestParams params, Ptr<Packet> p) {
         NS_LOG_FUNCTION(this << p);
 
-        if (m_qSize == m_qMaxSize) {
-            NS_LOG_DEBUG("The transmit queue is FULL. Packet dropped.");
-            return;
-        }
-
         McpsDataConfirmParams confirmParams;
         confirmParams.m_msduHandle = params.m_msduHandle;
 
@@ -328,6 +385,11 @@ namespace ns3 {
             return;
         }
 
+        bool control = false;
+        if (m_qPrioritizeControl) {
+            control = m_txPriorityCallback.IsNull() ? IsControlMsdu(p) : m_txPriorityCallback(p);
+        }
+
         p->AddHeader(macHdr);
 
         LrWpanMacTrailer macTrailer;
@@ -338,13 +400,34 @@ namespace ns3 {
         }
         p->AddTrailer(macTrailer);
 
+        if (!MakeRoom(p->GetSize(), control)) {
+            NS_LOG_DEBUG("The transmit queue is FULL. Packet dropped.");
+            m_macTxQueueDropTrace(p);
+            confirmParams.m_status = IEEE_802_15_4_TRANSACTION_OVERFLOW;
+            if (!m_mcpsDataConfirmCallback.IsNull()) {
+                m_mcpsDataConfirmCallback(confirmParams);
+            }
+            return;
+        }
+
         m_macTxEnqueueTrace(p);
 
         TxQueueElement *txQElement = new TxQueueElement;
         txQElement->txQMsduHandle = params.m_msduHandle;
         txQElement->txQPkt = p;
-        m_txQueue.push_back(txQElement);
+        txQElement->txQEnqueueTime = Simulator::Now();
+        txQElement->txQControl = control;
+        std::deque<TxQueueElement*>::iterator it = m_txQueue.end();
+        if (control) {
+            // Behind the packet being sent and the control packets already queued.
+            it = m_txQueue.begin();
+            while (it != m_txQueue.end() && (IsInService(it) || (*it)->txQControl)) {
+                ++it;
+            }
+        }
+        m_txQueue.insert(it, txQElement);
         m_qSize++;
+        m_qBytes += p->GetSize();
 
         CheckQueue();
     }
@@ -354,15 +437,162 @@ namespace ns3 {
         NS_LOG_FUNCTION(this);
 
         // Pull a packet from the queue and start sending, if we are not already sending.
-        if (m_lrWpanMacState == MAC_IDLE && !m_txQueue.empty() && m_txPkt == 0 && !m_setMacState.IsRunning()) {
+        if (m_lrWpanMacState == MAC_IDLE && m_txPkt == 0 && !m_setMacState.IsRunning() && PrepareTxQueueHead()) {
             TxQueueElement *txQElement = m_txQueue.front();
             m_txPkt = txQElement->txQPkt;
+            m_txInService = true;
             m_setMacState = Simulator::ScheduleNow(&LrWpanMac::SetLrWpanMacState, this, MAC_CSMA);
             return false;
         }
         return true;
     }
 
+    bool
+    LrWpanMac::PrepareTxQueueHead() {
+        NS_LOG_FUNCTION(this);
+        NS_ASSERT(m_txPkt == 0);
+
+        if (m_qPolicy == TX_QUEUE_CODEL) {
+            // CoDel dequeue, see RFC 8289. Control packets are never dropped.
+            Time now = Simulator::Now();
+            bool okToDrop = CoDelOkToDrop(now);
+            if (m_codelDropping) {
+                if (!okToDrop) {
+                    m_codelDropping = false;
+                }
+                while (m_codelDropping && now >= m_codelDropNext) {
+                    DropTxQElement(m_txQueue.begin());
+                    ++m_codelCount;
+                    if (!CoDelOkToDrop(now)) {
+                        m_codelDropping = false;
+                    } else {
+                        m_codelDropNext = CoDelControlLaw(m_codelDropNext);
+                    }
+                }
+            } else if (okToDrop && (now - m_codelDropNext < m_codelInterval || now - m_codelFirstAbove >= m_codelInterval)) {
+                DropTxQElement(m_txQueue.begin());
+                m_codelDropping = true;
+                // Start close to the previous drop rate if the last dropping state was recent.
+                if (m_codelCount > 2 && now - m_codelDropNext < m_codelInterval * 8) {
+                    m_codelCount -= 2;
+                } else {
+                    m_codelCount = 1;
+                }
+                m_codelDropNext = CoDelControlLaw(now);
+            }
+        }
+
+        if (m_txQueue.empty()) {
+            return false;
+        }
+        m_qSojourn = Simulator::Now() - m_txQueue.front()->txQEnqueueTime;
+        return true;
+    }
+
+    bool
+    LrWpanMac::CoDelOkToDrop(Time now) {
+        if (m_txQueue.empty()) {
+            m_codelFirstAbove = Time(0);
+            return false;
+        }
+        TxQueueElement *head = m_txQueue.front();
+        // A single full-sized frame is not a standing queue.
+        if (head->txQControl || now - head->txQEnqueueTime < m_codelTarget || m_qBytes <= LrWpanPhy::aMaxPhyPacketSize) {
+            m_codelFirstAbove = Time(0);
+            return false;
+        }
+        if (m_codelFirstAbove == Time(0)) {
+            m_codelFirstAbove = now + m_codelInterval;
+            return false;
+        }
+        return now >= m_codelFirstAbove;
+    }
+
+    Time
+    LrWpanMac::CoDelControlLaw(Time t) const {
+        return t + Time::FromDouble(m_codelInterval.GetDouble() / std::sqrt(static_cast<double> (m_codelCount)), Time::GetResolution());
+    }
+
+    bool
+    LrWpanMac::IsInService(std::deque<TxQueueElement*>::const_iterator it) const {
+        return m_txInService && it == m_txQueue.begin();
+    }
+
+    void
+    LrWpanMac::DropTxQElement(std::deque<TxQueueElement*>::iterator it) {
+        NS_ASSERT(!IsInService(it));
+        TxQueueElement *txQElement = *it;
+        Ptr<Packet> p = txQElement->txQPkt;
+        m_txQueue.erase(it);
+        m_qSize--;
+        m_qBytes -= p->GetSize();
+        NS_LOG_DEBUG("Dropping queued packet " << p);
+
+        McpsDataConfirmParams confirmParams;
+        confirmParams.m_msduHandle = txQElement->txQMsduHandle;
+        confirmParams.m_status = IEEE_802_15_4_TRANSACTION_OVERFLOW;
+        txQElement->txQPkt = 0;
+        delete txQElement;
+
+        m_macTxQueueDropTrace(p);
+        if (!m_mcpsDataConfirmCallback.IsNull()) {
+            m_mcpsDataConfirmCallback(confirmParams);
+        }
+    }
+
+    bool
+    LrWpanMac::MakeRoom(uint32_t size, bool control) {
+        NS_LOG_FUNCTION(this << size << control);
+
+        while ((m_qMaxSize != 0 && m_qSize >= m_qMaxSize) || (m_qMaxBytes != 0 && m_qBytes + size > m_qMaxBytes)) {
+            // Pick the victim: for control packets the newest queued non-control
+            // packet, otherwise the oldest packet for head-drop.
+            std::deque<TxQueueElement*>::iterator victim = m_txQueue.end();
+            if (control) {
+                for (std::deque<TxQueueElement*>::iterator it = m_txQueue.begin(); it != m_txQueue.end(); ++it) {
+                    if (!IsInService(it) && !(*it)->txQControl) {
+                        victim = it;
+                    }
+                }
+            }
+            if (victim == m_txQueue.end() && m_qPolicy == TX_QUEUE_HEAD_DROP) {
+                for (std::deque<TxQueueElement*>::iterator it = m_txQueue.begin(); it != m_txQueue.end(); ++it) {
+                    // Head-drop does not let other traffic push out control packets.
+                    if (!IsInService(it) && (control || !(*it)->txQControl)) {
+                        victim = it;
+                        break;
+                    }
+                }
+            }
+            if (victim == m_txQueue.end()) {
+                return false;
+            }
+            DropTxQElement(victim);
+        }
+        return true;
+    }
+
+    void
+    LrWpanMac::SetTxPriorityCallback(LrWpanTxPriorityCallback c) {
+        m_txPriorityCallback = c;
+    }
+
+    uint32_t
+    LrWpanMac::GetTxQueueSize(void) const {
+        return m_qSize;
+    }
+
+    uint32_t
+    LrWpanMac::GetTxQueueBytes(void) const {
+        return m_qBytes;
+    }
+
+    bool
+    LrWpanMac::IsControlMsdu(Ptr<const Packet> msdu) {
+        SocketPriorityTag priorityTag;
+        return msdu->PeekPacketTag(priorityTag) && priorityTag.GetPriority() == Socket::NS3_PRIO_CONTROL;
+    }
+
     void
     LrWpanMac::SetCsmaCa(Ptr<LrWpanCsmaCa> csmaCa) {
         m_csmaCa = csmaCa;
@@ -616,7 +846,9 @@ namespace ns3 {
         delete txQElement;
         m_txQueue.pop_front();
         m_qSize--;
+        m_qBytes -= p->GetSize();
         m_txPkt = 0;
+        m_txInService = false;
         m_retransmission = 0;
         m_numCsmacaRetry = 0;
         m_macTxDequeueTrace(p);
@@ -32,6 +32,7 @@
 #include <ns3/sequence-number.h>
 #include <ns3/lr-wpan-phy.h>
 #include <ns3/event-id.h>
+#include <ns3/nstime.h>
 #include <deque>
 
 
@@ -131,6 +132,18 @@ namespace ns3 {
         IEEE_802_15_4_INVALID_PARAMETER = 11
     } LrWpanMcpsDataConfirmStatus;
 
+    /**
+     * \ingroup lr-wpan
+     *
+     * Policy applied by the MAC transmit queue when it is full or, for CoDel,
+     * when packets wait too long at its head.
+     */
+    typedef enum {
+        TX_QUEUE_DROP_TAIL = 0,
+        TX_QUEUE_HEAD_DROP = 1,
+        TX_QUEUE_CODEL = 2
+    } LrWpanTxQueuePolicy;
+
     /**
      * \ingroup lr-wpan
      *
@@ -200,6 +213,15 @@ namespace ns3 {
      */
     typedef Callback<void, McpsDataIndicationParams, Ptr<Packet> > McpsDataIndicationCallback;
 
+    /**
+     * \ingroup lr-wpan
+     *
+     * This callback is called for every MSDU handed to McpsDataRequest while
+     * control traffic prioritization is enabled. It returns true if the MSDU
+     * belongs to the strict priority (control) class of the transmit queue.
+     */
+    typedef Callback<bool, Ptr<const Packet> > LrWpanTxPriorityCallback;
+
     /**
      * \ingroup lr-wpan
      *
@@ -332,6 +354,36 @@ namespace ns3 {
          */
         virtual void SetMcpsDataConfirmCallback(McpsDataConfirmCallback c);
 
+        /**
+         * Set the classifier deciding which MSDUs are put in the control class
+         * of the transmit queue. Without a classifier, IsControlMsdu is used.
+         * Only used if the PrioritizeControl attribute is set.
+         *
+         * \param c the callback
+         */
+        void SetTxPriorityCallback(LrWpanTxPriorityCallback c);
+
+        /**
+         * Default transmit queue classifier. The upper layers mark their control
+         * traffic with a SocketPriorityTag of Socket::NS3_PRIO_CONTROL: ICMPv6
+         * and RIPng in the internet module, NDN Interests and Nacks in the ndnSIM
+         * NetDeviceTransport.
+         *
+         * \param msdu the MSDU, without MAC header and trailer
+         * \return true if the MSDU is control traffic
+         */
+        static bool IsControlMsdu(Ptr<const Packet> msdu);
+
+        /**
+         * \return the number of packets in the transmit queue
+         */
+        uint32_t GetTxQueueSize(void) const;
+
+        /**
+         * \return the number of bytes (MPDU size) in the transmit queue
+         */
+        uint32_t GetTxQueueBytes(void) const;
+
         // interfaces between MAC and PHY
         /**
          *  IEEE 802.15.4-2006 section 6.2.1.3
@@ -504,8 +556,20 @@ namespace ns3 {
         struct TxQueueElement {
             uint8_t txQMsduHandle; //!< MSDU Handle
             Ptr<Packet> txQPkt; //!< Queued packet
+            Time txQEnqueueTime; //!< Time the packet entered the queue
+            bool txQControl; //!< Whether the packet belongs to the control class
         };
 
+        /**
+         * Prepare the head of the transmission queue for transmission. Applies
+         * CoDel, if enabled, to the packets waiting at the head and updates the
+         * sojourn time trace with the packet that is about to be sent.
+         * Must only be called if no packet is being sent.
+         *
+         * \return true, if there is a packet to send, false otherwise.
+         */
+        bool PrepareTxQueueHead(void);
+
         /**
          * Send an acknowledgment packet for the given sequence number.
          *
@@ -552,7 +616,42 @@ namespace ns3 {
         /**
          * The transmit queue current size.
          */
-        uint32_t m_qSize;
+        TracedValue<uint32_t> m_qSize;
+
+        /**
+         * The transmit queue current size in bytes.
+         */
+        TracedValue<uint32_t> m_qBytes;
+
+        /**
+         * The transmit queue capacity in bytes, 0 for no limit.
+         */
+        uint32_t m_qMaxBytes;
+
+        /**
+         * The policy applied by the transmit queue.
+         */
+        LrWpanTxQueuePolicy m_qPolicy;
+
+        /**
+         * Whether control traffic is queued ahead of other traffic.
+         */
+        bool m_qPrioritizeControl;
+
+        /**
+         * The classifier used when control traffic is prioritized.
+         */
+        LrWpanTxPriorityCallback m_txPriorityCallback;
+
+        /**
+         * CoDel target queue delay.
+         */
+        Time m_codelTarget;
+
+        /**
+         * CoDel interval.
+         */
+        Time m_codelInterval;
 
         /**
          * The PHY associated with this MAC.
@@ -629,6 +728,20 @@ namespace ns3 {
          */
         TracedCallback<Ptr<const Packet> > m_macTxDropTrace;
 
+        /**
+         * The trace source fired when packets are dropped by the transmit queue,
+         * either because it is full or by CoDel.
+         *
+         * \see class CallBackTraceSource
+         */
+        TracedCallback<Ptr<const Packet> > m_macTxQueueDropTrace;
+
+        /**
+         * The time spent in the transmit queue by the packet that was last
+         * pulled from it for transmission.
+         */
+        TracedValue<Time> m_qSojourn;
+
         /**
          * The trace source fired for packets successfully received by the device
          * immediately before being forwarded up to higher layers (at the L2/L3
@@ -721,6 +834,13 @@ namespace ns3 {
          */
         Ptr<Packet> m_txPkt; // XXX need packet buffer instead of single packet
 
+        /**
+         * Whether the head of the transmit queue has been pulled for sending.
+         * Set when CheckQueue starts sending it, cleared when it leaves the queue
+         * on confirm. m_txPkt cannot tell, as it also holds the ACK frames we send.
+         */
+        bool m_txInService;
+
         /**
          * The short address used by this MAC. Currently we do not have complete
          * extended address support in the MAC, nor do we have the association
@@ -760,6 +880,68 @@ namespace ns3 {
          * Scheduler event for a deferred MAC state change.
          */
         EventId m_setMacState;
+
+        /**
+         * Whether CoDel is in its dropping state.
+         */
+        bool m_codelDropping;
+
+        /**
+         * Number of packets dropped since CoDel entered its dropping state.
+         */
+        uint32_t m_codelCount;
+
+        /**
+         * Time at which the head sojourn time will have been above target for a
+         * full interval, zero if it is below target.
+         */
+        Time m_codelFirstAbove;
+
+        /**
+         * Time of the next CoDel drop while in the dropping state.
+         */
+        Time m_codelDropNext;
+
+        /**
+         * Check whether a queued packet is being sent, i.e. it is the head of the
+         * queue and has been pulled from it (see m_txInService).
+         *
+         * \param it the position of the packet in the transmit queue
+         * \return true, if the packet must not be removed from the queue
+         */
+        bool IsInService(std::deque<TxQueueElement*>::const_iterator it) const;
+
+        /**
+         * Remove a packet which is not being sent from the transmit queue, fire
+         * the queue drop trace and report the overflow to the higher layer.
+         *
+         * \param it the position of the packet in the transmit queue
+         */
+        void DropTxQElement(std::deque<TxQueueElement*>::iterator it);
+
+        /**
+         * Make room for an incoming packet according to the queue policy.
+         *
+         * \param size the size of the incoming packet
+         * \param control whether the incoming packet belongs to the control class
+         * \return true, if the incoming packet can be enqueued
+         */
+        bool MakeRoom(uint32_t size, bool control);
+
+        /**
+         * CoDel dequeue-time test on the head of the transmit queue.
+         *
+         * \param now the current time
+         * \return true, if the sojourn time of the head has been above target for
+         * at least an interval
+         */
+        bool CoDelOkToDrop(Time now);
+
+        /**
+         * \param t the time of the last drop
+         * \return the time of the next drop according to the CoDel control law
+         */
+        Time CoDelControlLaw(Time t) const;
     };
 
 
@@ -997,7 +997,6 @@ namespace ns3 {
     void
     LrWpanPhy::EndCca(void) {
         NS_LOG_FUNCTION(this);
-        LrWpanPhyEnumeration sensedChannelState = IEEE_802_15_4_PHY_UNSPECIFIED;
 
         // Update peak power.
         double power = LrWpanSpectrumValueHelper::TotalAvgPower(m_signal->GetSignalPsd(), m_phyPIBAttributes.phyCurrentChannel);
@@ -1005,11 +1004,37 @@ namespace ns3 {
             m_ccaPeakPower = power;
         }
 
+        LrWpanPhyEnumeration sensedChannelState = GetCcaResult(m_ccaPeakPower);
+
+        NS_LOG_LOGIC(this << "channel sensed state: " << sensedChannelState);
+
+        if (!m_plmeCcaConfirmCallback.IsNull()) {
+            m_plmeCcaConfirmCallback(sensedChannelState);
+        }
+    }
+
+    LrWpanPhyEnumeration
+    LrWpanPhy::SenseChannel(void) const {
+        NS_LOG_FUNCTION(this);
+
+        if (m_trxState == IEEE_802_15_4_PHY_RX_ON || m_trxState == IEEE_802_15_4_PHY_BUSY_RX) {
+            double power = LrWpanSpectrumValueHelper::TotalAvgPower(m_signal->GetSignalPsd(), m_phyPIBAttributes.phyCurrentChannel);
+            return GetCcaResult(power);
+        } else if (m_trxState == IEEE_802_15_4_PHY_TRX_OFF) {
+            return IEEE_802_15_4_PHY_TRX_OFF;
+        }
+        return IEEE_802_15_4_PHY_BUSY;
+    }
+
+    LrWpanPhyEnumeration
+    LrWpanPhy::GetCcaResult(double peakPower) const {
+        LrWpanPhyEnumeration sensedChannelState = IEEE_802_15_4_PHY_UNSPECIFIED;
+
         if (PhyIsBusy()) {
             sensedChannelState = IEEE_802_15_4_PHY_BUSY;
         } else if (m_phyPIBAttributes.phyCCAMode == 1) { //sec 6.9.9 ED detection
             // -- ED threshold at most 10 dB above receiver sensitivity.
-            if (10 * log10(m_ccaPeakPower / m_rxSensitivity) >= 10.0) {
+            if (10 * log10(peakPower / m_rxSensitivity) >= 10.0) {
                 sensedChannelState = IEEE_802_15_4_PHY_BUSY;
                 NS_LOG_INFO("BUSY 1");
             } else {
@@ -1029,7 +1054,7 @@ namespace ns3 {
                 sensedChannelState = IEEE_802_15_4_PHY_IDLE;
             }
         } else if (m_phyPIBAttributes.phyCCAMode == 3) { //sect 6.9.9 both
-            if ((10 * log10(m_ccaPeakPower / m_rxSensitivity) >= 10.0)
+            if ((10 * log10(peakPower / m_rxSensitivity) >= 10.0)
                     && m_trxState == IEEE_802_15_4_PHY_BUSY_RX) {
                 // Again, this code will never be reached, if we are already receiving
                 // a packet, as PhyIsBusy() would already lead to a channel busy condition.
@@ -1043,11 +1068,7 @@ namespace ns3 {
             NS_ASSERT_MSG(false, "Invalid CCA mode");
         }
 
-        NS_LOG_LOGIC(this << "channel sensed state: " << sensedChannelState);
-
-        if (!m_plmeCcaConfirmCallback.IsNull()) {
-            m_plmeCcaConfirmCallback(sensedChannelState);
-        }
+        return sensedChannelState;
     }
 
     void
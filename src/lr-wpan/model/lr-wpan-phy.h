@@ -376,6 +376,17 @@ namespace ns3 {
          */
         void PlmeCcaRequest(void);
 
+        /**
+         * Sense the channel at once, applying the CCA mode to the current signal
+         * power instead of the peak power over the 8 symbol CCA period. No event
+         * is scheduled and the CCA confirm callback is not fired. Used by the
+         * abstracted CSMA/CA.
+         *
+         * \return IEEE_802_15_4_PHY_IDLE or IEEE_802_15_4_PHY_BUSY, or
+         * IEEE_802_15_4_PHY_TRX_OFF if the transceiver is disabled
+         */
+        LrWpanPhyEnumeration SenseChannel(void) const;
+
         /**
          *  IEEE 802.15.4-2006 section 6.2.2.3
          *  PLME-ED.request
@@ -664,6 +675,14 @@ namespace ns3 {
          */
         void EndCca(void);
 
+        /**
+         * Apply the CCA mode to the sensed channel.
+         *
+         * \param peakPower the peak signal power during the CCA
+         * \return the channel condition, IEEE_802_15_4_PHY_IDLE or IEEE_802_15_4_PHY_BUSY
+         */
+        LrWpanPhyEnumeration GetCcaResult(double peakPower) const;
+
         /**
          * Called after applying a deferred transceiver state switch. The result of
          * the state switch is reported to the MAC.
@@ -0,0 +1,264 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/test.h>
+#include <ns3/packet.h>
+#include <ns3/lr-wpan-module.h>
+#include <ns3/mobility-module.h>
+#include <ns3/propagation-module.h>
+#include <ns3/spectrum-module.h>
+#include <ns3/mac16-address.h>
+#include <ns3/log.h>
+#include <ns3/boolean.h>
+#include <ns3/rng-seed-manager.h>
+#include <cmath>
+#include <map>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("lr-wpan-abstracted-csmaca-test");
+
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief Compare the abstracted CSMA-CA with the exact one on an unsaturated
+ * star: several senders around a sink, with Poisson traffic and ACKs.
+ */
+class LrWpanAbstractedCsmaCaTestCase : public TestCase
+{
+    public :
+    LrWpanAbstractedCsmaCaTestCase();
+
+private:
+    virtual void DoRun(void);
+
+    /**
+     * \brief Statistics of one run.
+     */
+    struct Result {
+        uint32_t requests; //!< Data requests.
+        uint32_t delivered; //!< Frames received by the sink.
+        uint32_t accessFailures; //!< Channel access failures.
+        uint32_t collisions; //!< Frames dropped by the sink PHY.
+        uint32_t accesses; //!< Channel accesses.
+        Time totalAccessDelay; //!< Sum of the channel access delays.
+        uint64_t events; //!< Simulator events.
+    };
+
+    /**
+     * \brief Run the scenario.
+     * \param abstracted Whether the CSMA-CA is abstracted.
+     * \return The statistics.
+     */
+    Result Run(bool abstracted);
+
+    /**
+     * \brief Send a frame and schedule the next one.
+     * \param dev The sending device.
+     * \param interval The inter-arrival time.
+     * \param stop The time of the last request.
+     */
+    void Send(Ptr<LrWpanNetDevice> dev, Ptr<ExponentialRandomVariable> interval, Time stop);
+
+    /**
+     * \brief Function called on MAC state changes of the senders.
+     * \param context The sender address.
+     * \param oldState The old state.
+     * \param newState The new state.
+     */
+    void MacState(std::string context, LrWpanMacState oldState, LrWpanMacState newState);
+
+    /**
+     * \brief Function called when a sender gives up on the channel.
+     * \param params The MCPS params.
+     */
+    void DataConfirm(McpsDataConfirmParams params);
+
+    /**
+     * \brief Function called when the sink receives a frame.
+     * \param params The MCPS params.
+     * \param p The packet.
+     */
+    void DataIndication(McpsDataIndicationParams params, Ptr<Packet> p);
+
+    /**
+     * \brief Function called when the sink PHY drops a frame.
+     * \param p The packet.
+     */
+    void PhyRxDrop(Ptr<const Packet> p);
+
+    Result m_result; //!< Statistics of the current run.
+    std::map<std::string, Time> m_csmaStart; //!< Start of the current channel access, per sender.
+};
+
+LrWpanAbstractedCsmaCaTestCase::LrWpanAbstractedCsmaCaTestCase()
+: TestCase("Test the abstracted CSMA-CA against the exact one") {
+}
+
+void
+LrWpanAbstractedCsmaCaTestCase::Send(Ptr<LrWpanNetDevice> dev, Ptr<ExponentialRandomVariable> interval, Time stop) {
+    McpsDataRequestParams params;
+    params.m_srcAddrMode = SHORT_ADDR;
+    params.m_dstAddrMode = SHORT_ADDR;
+    params.m_dstPanId = 0;
+    params.m_dstAddr = Mac16Address("00:01");
+    params.m_msduHandle = 0;
+    params.m_txOptions = TX_OPTION_ACK;
+    dev->GetMac()->McpsDataRequest(params, Create<Packet> (40));
+    m_result.requests++;
+
+    Time next = Seconds(interval->GetValue());
+    if (Simulator::Now() + next < stop) {
+        Simulator::Schedule(next, &LrWpanAbstractedCsmaCaTestCase::Send, this, dev, interval, stop);
+    }
+}
+
+void
+LrWpanAbstractedCsmaCaTestCase::MacState(std::string context, LrWpanMacState oldState, LrWpanMacState newState) {
+    if (newState == MAC_CSMA) {
+        m_csmaStart[context] = Simulator::Now();
+    } else if (oldState == MAC_CSMA && newState == MAC_SENDING) {
+        m_result.accesses++;
+        m_result.totalAccessDelay += Simulator::Now() - m_csmaStart[context];
+    }
+}
+
+void
+LrWpanAbstractedCsmaCaTestCase::DataConfirm(McpsDataConfirmParams params) {
+    if (params.m_status == IEEE_802_15_4_CHANNEL_ACCESS_FAILURE) {
+        m_result.accessFailures++;
+    }
+}
+
+void
+LrWpanAbstractedCsmaCaTestCase::DataIndication(McpsDataIndicationParams params, Ptr<Packet> p) {
+    m_result.delivered++;
+}
+
+void
+LrWpanAbstractedCsmaCaTestCase::PhyRxDrop(Ptr<const Packet> p) {
+    m_result.collisions++;
+}
+
+LrWpanAbstractedCsmaCaTestCase::Result
+LrWpanAbstractedCsmaCaTestCase::Run(bool abstracted) {
+    static const uint32_t nSenders = 8;
+
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    m_result = Result();
+    m_csmaStart.clear();
+    m_result.requests = 0;
+    m_result.delivered = 0;
+    m_result.accessFailures = 0;
+    m_result.collisions = 0;
+    m_result.accesses = 0;
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel> ();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel> ());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel> ());
+
+    Ptr<LrWpanNetDevice> sink;
+    Time stop = Seconds(10);
+    for (uint32_t i = 0; i <= nSenders; i++) {
+        Ptr<Node> node = CreateObject<Node> ();
+        Ptr<LrWpanNetDevice> dev = CreateObject<LrWpanNetDevice> ();
+        dev->AssignStreams(10 * i);
+        dev->GetCsmaCa()->SetAttribute("Abstracted", BooleanValue(abstracted));
+        char address[6];
+        snprintf(address, sizeof (address), "00:%02x", i + 1);
+        dev->SetAddress(Mac16Address(address));
+        dev->SetChannel(channel);
+        node->AddDevice(dev);
+
+        Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+        double angle = 2 * M_PI * i / nSenders;
+        mobility->SetPosition(i == 0 ? Vector(0, 0, 0) : Vector(10 * std::cos(angle), 10 * std::sin(angle), 0));
+        dev->GetPhy()->SetMobility(mobility);
+
+        if (i == 0) {
+            sink = dev;
+            dev->GetMac()->SetMcpsDataIndicationCallback(MakeCallback(&LrWpanAbstractedCsmaCaTestCase::DataIndication, this));
+            dev->GetPhy()->TraceConnectWithoutContext("PhyRxDrop", MakeCallback(&LrWpanAbstractedCsmaCaTestCase::PhyRxDrop, this));
+        } else {
+            dev->GetMac()->SetMcpsDataConfirmCallback(MakeCallback(&LrWpanAbstractedCsmaCaTestCase::DataConfirm, this));
+            dev->GetMac()->TraceConnect("MacState", address, MakeCallback(&LrWpanAbstractedCsmaCaTestCase::MacState, this));
+            Ptr<ExponentialRandomVariable> interval = CreateObject<ExponentialRandomVariable> ();
+            interval->SetAttribute("Mean", DoubleValue(0.05));
+            interval->SetStream(1000 + i);
+            Simulator::Schedule(Seconds(interval->GetValue()), &LrWpanAbstractedCsmaCaTestCase::Send, this, dev, interval, stop);
+        }
+    }
+
+    Simulator::Stop(stop + Seconds(1));
+    Simulator::Run();
+    // Event uids are allocated sequentially, so the uid of a new event counts
+    // all events scheduled before it.
+    m_result.events = Simulator::Schedule(Seconds(0), &Simulator::Stop).GetUid();
+    Simulator::Destroy();
+
+    NS_LOG_INFO((abstracted ? "abstracted" : "exact") << ": requests " << m_result.requests
+            << " delivered " << m_result.delivered
+            << " access failures " << m_result.accessFailures
+            << " collisions " << m_result.collisions
+            << " mean access delay " << (m_result.totalAccessDelay / m_result.accesses).GetMicroSeconds() << " us"
+            << " events " << m_result.events);
+    return m_result;
+}
+
+void
+LrWpanAbstractedCsmaCaTestCase::DoRun(void) {
+    Result exact = Run(false);
+    Result abstracted = Run(true);
+
+    double exactDelay = (exact.totalAccessDelay / exact.accesses).GetSeconds();
+    double abstractedDelay = (abstracted.totalAccessDelay / abstracted.accesses).GetSeconds();
+    NS_TEST_EXPECT_MSG_EQ_TOL(abstractedDelay, exactDelay, exactDelay * 0.05, "Mean access delay differs by more than 5%");
+
+    double exactDelivery = double (exact.delivered) / exact.requests;
+    double abstractedDelivery = double (abstracted.delivered) / abstracted.requests;
+    NS_TEST_EXPECT_MSG_EQ_TOL(abstractedDelivery, exactDelivery, 0.01, "Delivery ratio differs by more than 1%");
+
+    double exactCollisions = double (exact.collisions) / exact.requests;
+    double abstractedCollisions = double (abstracted.collisions) / abstracted.requests;
+    NS_TEST_EXPECT_MSG_EQ_TOL(abstractedCollisions, exactCollisions, 0.01, "Collision ratio differs by more than 1%");
+
+    // The exact first backoff and CCA take three events (backoff start, CCA
+    // request, CCA end), the abstracted one takes one; PHY and channel events
+    // are the same in both modes.
+    double savedEventsPerRequest = double (exact.events - abstracted.events) / exact.requests;
+    NS_TEST_EXPECT_MSG_GT(savedEventsPerRequest, 1.5, "The abstracted CSMA-CA saves events");
+}
+
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief LrWpan abstracted CSMA-CA TestSuite
+ */
+class LrWpanAbstractedCsmaCaTestSuite : public TestSuite
+{
+    public :
+    LrWpanAbstractedCsmaCaTestSuite();};
+
+LrWpanAbstractedCsmaCaTestSuite::LrWpanAbstractedCsmaCaTestSuite()
+: TestSuite("lr-wpan-abstracted-csmaca", UNIT) {
+    AddTestCase(new LrWpanAbstractedCsmaCaTestCase, TestCase::QUICK);
+}
+
+static LrWpanAbstractedCsmaCaTestSuite g_lrWpanAbstractedCsmaCaTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,379 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/log.h>
+#include <ns3/core-module.h>
+#include <ns3/lr-wpan-module.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/propagation-delay-model.h>
+#include <ns3/simulator.h>
+#include <ns3/single-model-spectrum-channel.h>
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/packet.h>
+#include <ns3/socket.h>
+#include "ns3/rng-seed-manager.h"
+
+#include <vector>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("lr-wpan-tx-queue-test");
+
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief LrWpan transmit queue test base, sends bursts of packets from a
+ * single device and records the MCPS-DATA.confirm primitives.
+ */
+class LrWpanTxQueueTestCase : public TestCase
+{
+    public :
+    /**
+     * Constructor.
+     * \param name The test case name.
+     */
+    LrWpanTxQueueTestCase(std::string name);
+
+protected:
+    /**
+     * \brief Create the device and connect the traces.
+     */
+    void Setup(void);
+
+    /**
+     * \brief Request the transmission of a packet.
+     * \param handle The MSDU handle.
+     * \param control Whether the packet is marked as control traffic.
+     * \param size The packet size.
+     */
+    void Send(uint8_t handle, bool control, uint32_t size);
+
+    /**
+     * \brief Function called when DataConfirm is hit.
+     * \param params The MCPS params.
+     */
+    void DataConfirm(McpsDataConfirmParams params);
+
+    /**
+     * \brief Function called when a packet is dropped by the queue.
+     * \param p The packet.
+     */
+    void QueueDrop(Ptr<const Packet> p);
+
+    /**
+     * \brief Function called when the queue length changes.
+     * \param oldValue The old queue length.
+     * \param newValue The new queue length.
+     */
+    void QueueLength(uint32_t oldValue, uint32_t newValue);
+
+    /**
+     * \brief Function called when the sojourn time trace changes.
+     * \param oldValue The old sojourn time.
+     * \param newValue The new sojourn time.
+     */
+    void QueueSojourn(Time oldValue, Time newValue);
+
+    Ptr<LrWpanNetDevice> m_dev; //!< The sending device.
+    std::vector<McpsDataConfirmParams> m_confirms; //!< Confirmations, in order.
+    uint32_t m_drops; //!< Queue drop trace hits.
+    uint32_t m_maxLength; //!< Maximum queue length.
+    Time m_maxSojourn; //!< Maximum sojourn time.
+};
+
+LrWpanTxQueueTestCase::LrWpanTxQueueTestCase(std::string name)
+: TestCase(name),
+m_drops(0),
+m_maxLength(0) {
+}
+
+void
+LrWpanTxQueueTestCase::Setup(void) {
+    RngSeedManager::SetSeed(1);
+    RngSeedManager::SetRun(1);
+
+    m_confirms.clear();
+    m_drops = 0;
+    m_maxLength = 0;
+    m_maxSojourn = Seconds(0);
+
+    Ptr<Node> n0 = CreateObject <Node> ();
+    m_dev = CreateObject<LrWpanNetDevice> ();
+    m_dev->AssignStreams(0);
+    m_dev->SetAddress(Mac16Address("00:01"));
+
+    Ptr<SingleModelSpectrumChannel> channel = CreateObject<SingleModelSpectrumChannel> ();
+    channel->AddPropagationLossModel(CreateObject<LogDistancePropagationLossModel> ());
+    channel->SetPropagationDelayModel(CreateObject<ConstantSpeedPropagationDelayModel> ());
+    m_dev->SetChannel(channel);
+    n0->AddDevice(m_dev);
+
+    Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+    m_dev->GetPhy()->SetMobility(mobility);
+
+    m_dev->GetMac()->SetMcpsDataConfirmCallback(MakeCallback(&LrWpanTxQueueTestCase::DataConfirm, this));
+    m_dev->GetMac()->TraceConnectWithoutContext("MacTxQueueDrop", MakeCallback(&LrWpanTxQueueTestCase::QueueDrop, this));
+    m_dev->GetMac()->TraceConnectWithoutContext("MacTxQueueLength", MakeCallback(&LrWpanTxQueueTestCase::QueueLength, this));
+    m_dev->GetMac()->TraceConnectWithoutContext("MacTxQueueSojourn", MakeCallback(&LrWpanTxQueueTestCase::QueueSojourn, this));
+}
+
+void
+LrWpanTxQueueTestCase::Send(uint8_t handle, bool control, uint32_t size) {
+    Ptr<Packet> p = Create<Packet> (size);
+    if (control) {
+        SocketPriorityTag priorityTag;
+        priorityTag.SetPriority(Socket::NS3_PRIO_CONTROL);
+        p->AddPacketTag(priorityTag);
+    }
+
+    McpsDataRequestParams params;
+    params.m_srcAddrMode = SHORT_ADDR;
+    params.m_dstAddrMode = SHORT_ADDR;
+    params.m_dstPanId = 0;
+    params.m_dstAddr = Mac16Address("00:02");
+    params.m_msduHandle = handle;
+    params.m_txOptions = TX_OPTION_NONE;
+    m_dev->GetMac()->McpsDataRequest(params, p);
+}
+
+void
+LrWpanTxQueueTestCase::DataConfirm(McpsDataConfirmParams params) {
+    m_confirms.push_back(params);
+}
+
+void
+LrWpanTxQueueTestCase::QueueDrop(Ptr<const Packet> p) {
+    m_drops++;
+}
+
+void
+LrWpanTxQueueTestCase::QueueLength(uint32_t oldValue, uint32_t newValue) {
+    m_maxLength = std::max(m_maxLength, newValue);
+}
+
+void
+LrWpanTxQueueTestCase::QueueSojourn(Time oldValue, Time newValue) {
+    m_maxSojourn = std::max(m_maxSojourn, newValue);
+}
+
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief Test the packet limit with the DropTail policy.
+ */
+class LrWpanTxQueueDropTailTestCase : public LrWpanTxQueueTestCase
+{
+    public :
+    LrWpanTxQueueDropTailTestCase();
+
+private:
+    virtual void DoRun(void);
+};
+
+LrWpanTxQueueDropTailTestCase::LrWpanTxQueueDropTailTestCase()
+: LrWpanTxQueueTestCase("Test the 802.15.4 transmit queue DropTail policy") {
+}
+
+void
+LrWpanTxQueueDropTailTestCase::DoRun(void) {
+    Setup();
+    m_dev->GetMac()->SetAttribute("MaxQueueSize", UintegerValue(3));
+
+    for (uint8_t i = 1; i <= 6; i++) {
+        Send(i, false, 20);
+    }
+    NS_TEST_EXPECT_MSG_EQ(m_dev->GetMac()->GetTxQueueSize(), 3, "The queue is limited to 3 packets");
+    NS_TEST_EXPECT_MSG_GT(m_dev->GetMac()->GetTxQueueBytes(), 3 * 20, "Bytes are counted with MAC header and trailer");
+
+    Simulator::Run();
+
+    NS_TEST_ASSERT_MSG_EQ(m_confirms.size(), 6, "Every request is confirmed");
+    for (uint32_t i = 0; i < 3; i++) {
+        NS_TEST_EXPECT_MSG_EQ(m_confirms[i].m_msduHandle, i + 4, "Arriving packets are dropped");
+        NS_TEST_EXPECT_MSG_EQ(m_confirms[i].m_status, IEEE_802_15_4_TRANSACTION_OVERFLOW, "Drops are reported as overflow");
+        NS_TEST_EXPECT_MSG_EQ(m_confirms[i + 3].m_msduHandle, i + 1, "Queued packets are sent in order");
+        NS_TEST_EXPECT_MSG_EQ(m_confirms[i + 3].m_status, IEEE_802_15_4_SUCCESS, "Queued packets are sent");
+    }
+    NS_TEST_EXPECT_MSG_EQ(m_drops, 3, "Drops are traced");
+    NS_TEST_EXPECT_MSG_EQ(m_maxLength, 3, "The queue length is traced");
+    NS_TEST_EXPECT_MSG_EQ(m_dev->GetMac()->GetTxQueueSize(), 0, "The queue is empty");
+    NS_TEST_EXPECT_MSG_EQ(m_dev->GetMac()->GetTxQueueBytes(), 0, "The queue is empty");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief Test the control class with the HeadDrop policy.
+ */
+class LrWpanTxQueuePriorityTestCase : public LrWpanTxQueueTestCase
+{
+    public :
+    LrWpanTxQueuePriorityTestCase();
+
+private:
+    virtual void DoRun(void);
+};
+
+LrWpanTxQueuePriorityTestCase::LrWpanTxQueuePriorityTestCase()
+: LrWpanTxQueueTestCase("Test the 802.15.4 transmit queue control class and HeadDrop policy") {
+}
+
+void
+LrWpanTxQueuePriorityTestCase::DoRun(void) {
+    Setup();
+    m_dev->GetMac()->SetAttribute("MaxQueueSize", UintegerValue(4));
+    m_dev->GetMac()->SetAttribute("TxQueuePolicy", EnumValue(TX_QUEUE_HEAD_DROP));
+    m_dev->GetMac()->SetAttribute("PrioritizeControl", BooleanValue(true));
+
+    // Queue: 1 (being sent), 2, 3, 4.
+    for (uint8_t i = 1; i <= 4; i++) {
+        Send(i, false, 20);
+    }
+    // Control packet 5 pushes out the newest data packet: 1, 5, 2, 3.
+    Send(5, true, 20);
+    // Data packet 6 pushes out the oldest waiting data packet: 1, 5, 3, 6.
+    Send(6, false, 20);
+    // Control packet 7 pushes out data packet 6 and goes behind control packet 5: 1, 5, 7, 3.
+    Send(7, true, 20);
+
+    Simulator::Run();
+
+    static const uint8_t expected[7] = {4, 2, 6, 1, 5, 7, 3};
+    NS_TEST_ASSERT_MSG_EQ(m_confirms.size(), 7, "Every request is confirmed");
+    for (uint32_t i = 0; i < 7; i++) {
+        NS_TEST_EXPECT_MSG_EQ(m_confirms[i].m_msduHandle, expected[i], "Unexpected confirmation order");
+        NS_TEST_EXPECT_MSG_EQ(m_confirms[i].m_status, (i < 3 ? IEEE_802_15_4_TRANSACTION_OVERFLOW : IEEE_802_15_4_SUCCESS),
+                "Unexpected confirmation status");
+    }
+    NS_TEST_EXPECT_MSG_EQ(m_drops, 3, "Drops are traced");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief Test the CoDel policy on a standing queue.
+ */
+class LrWpanTxQueueCoDelTestCase : public LrWpanTxQueueTestCase
+{
+    public :
+    LrWpanTxQueueCoDelTestCase();
+
+private:
+    virtual void DoRun(void);
+};
+
+LrWpanTxQueueCoDelTestCase::LrWpanTxQueueCoDelTestCase()
+: LrWpanTxQueueTestCase("Test the 802.15.4 transmit queue CoDel policy") {
+}
+
+void
+LrWpanTxQueueCoDelTestCase::DoRun(void) {
+    Setup();
+    m_dev->GetMac()->SetAttribute("MaxQueueSize", UintegerValue(0));
+    m_dev->GetMac()->SetAttribute("TxQueuePolicy", EnumValue(TX_QUEUE_CODEL));
+    m_dev->GetMac()->SetAttribute("CoDelTarget", TimeValue(MilliSeconds(5)));
+    m_dev->GetMac()->SetAttribute("CoDelInterval", TimeValue(MilliSeconds(50)));
+
+    // About 4 ms per frame, so the burst builds a standing queue of well over
+    // 100 ms.
+    for (uint8_t i = 1; i <= 40; i++) {
+        Send(i, false, 100);
+    }
+    NS_TEST_EXPECT_MSG_EQ(m_drops, 0, "CoDel does not drop on enqueue");
+
+    Simulator::Run();
+
+    NS_TEST_EXPECT_MSG_EQ(m_confirms.size(), 40, "Every request is confirmed");
+    NS_TEST_EXPECT_MSG_GT(m_drops, 0, "CoDel drops packets from the standing queue");
+    NS_TEST_EXPECT_MSG_LT(m_drops, 40, "CoDel does not drop the whole queue");
+    NS_TEST_EXPECT_MSG_GT(m_maxSojourn, MilliSeconds(50), "The sojourn time is traced");
+
+    Simulator::Destroy();
+}
+
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief Test the default control traffic classifier.
+ */
+class LrWpanTxQueueClassifierTestCase : public TestCase
+{
+    public :
+    LrWpanTxQueueClassifierTestCase();
+
+private:
+    virtual void DoRun(void);
+
+    /**
+     * \brief Classify a packet.
+     * \param priority The priority it is tagged with, none if negative.
+     * \return The classification.
+     */
+    static bool Classify(int priority);
+};
+
+LrWpanTxQueueClassifierTestCase::LrWpanTxQueueClassifierTestCase()
+: TestCase("Test the 802.15.4 transmit queue control traffic classifier") {
+}
+
+bool
+LrWpanTxQueueClassifierTestCase::Classify(int priority) {
+    Ptr<Packet> p = Create<Packet> (10);
+    if (priority >= 0) {
+        SocketPriorityTag priorityTag;
+        priorityTag.SetPriority(priority);
+        p->AddPacketTag(priorityTag);
+    }
+    return LrWpanMac::IsControlMsdu(p);
+}
+
+void
+LrWpanTxQueueClassifierTestCase::DoRun(void) {
+    NS_TEST_EXPECT_MSG_EQ(Classify(-1), false, "Untagged packets are not control");
+    NS_TEST_EXPECT_MSG_EQ(Classify(Socket::NS3_PRIO_BESTEFFORT), false, "Best effort is not control");
+    NS_TEST_EXPECT_MSG_EQ(Classify(Socket::NS3_PRIO_INTERACTIVE), false, "Interactive is not control");
+    NS_TEST_EXPECT_MSG_EQ(Classify(Socket::NS3_PRIO_CONTROL), true, "Tagged control is control");
+}
+
+/**
+ * \ingroup lr-wpan-test
+ * \ingroup tests
+ *
+ * \brief LrWpan transmit queue TestSuite
+ */
+class LrWpanTxQueueTestSuite : public TestSuite
+{
+    public :
+    LrWpanTxQueueTestSuite();};
+
+LrWpanTxQueueTestSuite::LrWpanTxQueueTestSuite()
+: TestSuite("lr-wpan-tx-queue", UNIT) {
+    AddTestCase(new LrWpanTxQueueClassifierTestCase, TestCase::QUICK);
+    AddTestCase(new LrWpanTxQueueDropTailTestCase, TestCase::QUICK);
+    AddTestCase(new LrWpanTxQueuePriorityTestCase, TestCase::QUICK);
+    AddTestCase(new LrWpanTxQueueCoDelTestCase, TestCase::QUICK);
+}
+
+static LrWpanTxQueueTestSuite g_lrWpanTxQueueTestSuite; //!< Static variable for test initialization
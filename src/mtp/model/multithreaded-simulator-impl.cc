@@ -0,0 +1,548 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "multithreaded-simulator-impl.h"
+
+#include "ns3/simulator.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/channel.h"
+#include "ns3/channel-list.h"
+#include "ns3/net-device.h"
+#include "ns3/point-to-point-net-device.h"
+#include "ns3/point-to-point-channel.h"
+
+#include <set>
+#include <thread>
+
+namespace ns3 {
+
+    NS_LOG_COMPONENT_DEFINE("MultithreadedSimulatorImpl");
+
+    NS_OBJECT_ENSURE_REGISTERED(MultithreadedSimulatorImpl);
+
+    thread_local MultithreadedSimulatorImpl::Partition *MultithreadedSimulatorImpl::m_current = 0;
+
+    /// Time stamp of no event
+    static const uint64_t NO_TS = ~(uint64_t) 0;
+
+    TypeId
+    MultithreadedSimulatorImpl::GetTypeId(void) {
+        static TypeId tid = TypeId("ns3::MultithreadedSimulatorImpl")
+                .SetParent<SimulatorImpl> ()
+                .SetGroupName("Mtp")
+                .AddConstructor<MultithreadedSimulatorImpl> ()
+                ;
+        return tid;
+    }
+
+    MultithreadedSimulatorImpl::MultithreadedSimulatorImpl()
+    : m_lookahead(NO_TS),
+    m_partitioned(false),
+    m_stop(false),
+    m_running(false),
+    m_windowEnd(0),
+    m_round(0),
+    m_done(0),
+    m_nextWorker(1),
+    m_exit(false) {
+        NS_LOG_FUNCTION(this);
+        m_global.m_systemId = 0;
+        m_global.m_currentTs = 0;
+        m_global.m_currentUid = 0;
+        m_global.m_currentContext = 0xffffffff;
+        // uids are allocated from 4, as in DefaultSimulatorImpl
+        m_global.m_uid = 4;
+        m_global.m_sentTs = NO_TS;
+    }
+
+    MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl() {
+        NS_LOG_FUNCTION(this);
+    }
+
+    void
+    MultithreadedSimulatorImpl::DoDispose(void) {
+        NS_LOG_FUNCTION(this);
+        if (!m_threads.empty()) {
+            m_exit = true;
+            m_round.fetch_add(1, std::memory_order_release);
+            for (uint32_t i = 0; i < m_threads.size(); ++i) {
+                m_threads[i]->Join();
+            }
+            m_threads.clear();
+        }
+
+        for (uint32_t i = 0; i < m_queues.size(); ++i) {
+            if (m_queues[i] != 0) {
+                Message message;
+                while (m_queues[i]->Pop(message)) {
+                    message.m_event->Unref();
+                }
+                delete m_queues[i];
+            }
+        }
+        m_queues.clear();
+
+        for (uint32_t i = 0; i <= m_partitions.size(); ++i) {
+            Partition *partition = i < m_partitions.size() ? m_partitions[i] : &m_global;
+            while (partition->m_events != 0 && !partition->m_events->IsEmpty()) {
+                Scheduler::Event next = partition->m_events->RemoveNext();
+                next.impl->Unref();
+            }
+            partition->m_events = 0;
+            if (partition != &m_global) {
+                delete partition;
+            }
+        }
+        m_partitions.clear();
+        SimulatorImpl::DoDispose();
+    }
+
+    void
+    MultithreadedSimulatorImpl::Destroy() {
+        NS_LOG_FUNCTION(this);
+        while (!m_destroyEvents.empty()) {
+            Ptr<EventImpl> ev = m_destroyEvents.front().PeekEventImpl();
+            m_destroyEvents.pop_front();
+            NS_LOG_LOGIC("handle destroy " << ev);
+            if (!ev->IsCancelled()) {
+                ev->Invoke();
+            }
+        }
+    }
+
+    void
+    MultithreadedSimulatorImpl::SetScheduler(ObjectFactory schedulerFactory) {
+        NS_LOG_FUNCTION(this << schedulerFactory);
+        m_schedulerFactory = schedulerFactory;
+        for (uint32_t i = 0; i <= m_partitions.size(); ++i) {
+            Partition *partition = i < m_partitions.size() ? m_partitions[i] : &m_global;
+            Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler> ();
+            if (partition->m_events != 0) {
+                while (!partition->m_events->IsEmpty()) {
+                    scheduler->Insert(partition->m_events->RemoveNext());
+                }
+            }
+            partition->m_events = scheduler;
+        }
+    }
+
+    MultithreadedSimulatorImpl::Partition *
+    MultithreadedSimulatorImpl::GetCurrent(void) const {
+        return m_current != 0 ? m_current : const_cast<Partition *> (&m_global);
+    }
+
+    MultithreadedSimulatorImpl::Partition *
+    MultithreadedSimulatorImpl::GetPartition(uint32_t context) const {
+        // events of nodes created after the partitioning run with the global events
+        if (!m_partitioned || context >= m_partitionOfContext.size()) {
+            return const_cast<Partition *> (&m_global);
+        }
+        return m_partitions[m_partitionOfContext[context]];
+    }
+
+    Scheduler::EventKey
+    MultithreadedSimulatorImpl::Insert(Partition *partition, uint64_t ts, uint32_t context, EventImpl *event) {
+        Scheduler::Event ev;
+        ev.impl = event;
+        ev.key.m_ts = ts;
+        ev.key.m_context = context;
+        ev.key.m_uid = partition->m_uid;
+        partition->m_uid++;
+        partition->m_events->Insert(ev);
+        return ev.key;
+    }
+
+    uint64_t
+    MultithreadedSimulatorImpl::NextTs(Partition *partition) {
+        if (partition->m_events->IsEmpty()) {
+            return NO_TS;
+        }
+        return partition->m_events->PeekNext().key.m_ts;
+    }
+
+    void
+    MultithreadedSimulatorImpl::CreatePartitions(void) {
+        NS_LOG_FUNCTION(this);
+        uint32_t n = 1;
+        for (NodeList::Iterator it = NodeList::Begin(); it != NodeList::End(); ++it) {
+            uint32_t systemId = (*it)->GetSystemId();
+            m_partitionOfContext.push_back(systemId);
+            n = std::max(n, systemId + 1);
+        }
+
+        for (uint32_t i = 0; i < n; ++i) {
+            Partition *partition = new Partition();
+            partition->m_systemId = i;
+            partition->m_events = m_schedulerFactory.Create<Scheduler> ();
+            partition->m_currentTs = m_global.m_currentTs;
+            partition->m_currentUid = 0;
+            partition->m_currentContext = 0xffffffff;
+            // above the uids of the events moved from the global scheduler
+            partition->m_uid = m_global.m_uid;
+            partition->m_sentTs = NO_TS;
+            partition->m_inbox.resize(n, 0);
+            m_partitions.push_back(partition);
+        }
+        m_global.m_inbox.resize(n, 0);
+
+        // a queue from every partition to every other one and to the global events
+        m_queues.resize(n * (n + 1), 0);
+        for (uint32_t src = 0; src < n; ++src) {
+            for (uint32_t dst = 0; dst <= n; ++dst) {
+                if (src == dst) {
+                    continue;
+                }
+                MessageQueue *queue = new MessageQueue();
+                m_queues[src * (n + 1) + dst] = queue;
+                Partition *partition = dst < n ? m_partitions[dst] : &m_global;
+                partition->m_inbox[src] = queue;
+            }
+        }
+        m_partitioned = true;
+
+        // events scheduled so far for nodes go to their partition
+        Ptr<Scheduler> events = m_global.m_events;
+        m_global.m_events = m_schedulerFactory.Create<Scheduler> ();
+        while (!events->IsEmpty()) {
+            Scheduler::Event ev = events->RemoveNext();
+            GetPartition(ev.key.m_context)->m_events->Insert(ev);
+        }
+
+        for (ChannelList::Iterator it = ChannelList::Begin(); it != ChannelList::End(); ++it) {
+            Ptr<Channel> channel = *it;
+            std::set<uint32_t> systems;
+            for (uint32_t i = 0; i < channel->GetNDevices(); ++i) {
+                Ptr<NetDevice> device = channel->GetDevice(i);
+                if (device != 0 && device->GetNode() != 0) {
+                    systems.insert(device->GetNode()->GetSystemId());
+                }
+            }
+            if (systems.size() < 2) {
+                continue;
+            }
+            if (DynamicCast<PointToPointChannel> (channel) == 0) {
+                NS_FATAL_ERROR("Channel " << channel->GetId() << " (" << channel->GetInstanceTypeId().GetName()
+                        << ") links nodes of different systems, only point-to-point channels may");
+            }
+            TimeValue delay;
+            channel->GetAttribute("Delay", delay);
+            if (!delay.Get().IsStrictlyPositive()) {
+                NS_FATAL_ERROR("Channel " << channel->GetId() << " links nodes of different systems without delay");
+            }
+            m_lookahead = std::min(m_lookahead, (uint64_t) delay.Get().GetTimeStep());
+        }
+        NS_LOG_INFO(n << " partitions, lookahead " << GetLookahead());
+    }
+
+    void
+    MultithreadedSimulatorImpl::ReceiveMessages(Partition *partition) {
+        // in the order of the senders, so that the uids do not depend on the threads
+        for (uint32_t src = 0; src < partition->m_inbox.size(); ++src) {
+            if (partition->m_inbox[src] == 0) {
+                continue;
+            }
+            Message message;
+            while (partition->m_inbox[src]->Pop(message)) {
+                NS_ASSERT(message.m_ts >= partition->m_currentTs);
+                Insert(partition, message.m_ts, message.m_context, message.m_event);
+            }
+        }
+    }
+
+    void
+    MultithreadedSimulatorImpl::ProcessOneEvent(Partition *partition) {
+        Scheduler::Event next = partition->m_events->RemoveNext();
+
+        NS_ASSERT(next.key.m_ts >= partition->m_currentTs);
+        NS_LOG_LOGIC("handle " << next.key.m_ts);
+        partition->m_currentTs = next.key.m_ts;
+        partition->m_currentContext = next.key.m_context;
+        partition->m_currentUid = next.key.m_uid;
+        next.impl->Invoke();
+        next.impl->Unref();
+    }
+
+    void
+    MultithreadedSimulatorImpl::ProcessWindow(Partition *partition) {
+        m_current = partition;
+        ReceiveMessages(partition);
+        partition->m_sentTs = NO_TS;
+        while (!partition->m_events->IsEmpty() &&
+                partition->m_events->PeekNext().key.m_ts < m_windowEnd) {
+            ProcessOneEvent(partition);
+        }
+    }
+
+    void
+    MultithreadedSimulatorImpl::DoWork(void) {
+        Partition *partition = m_partitions[m_nextWorker.fetch_add(1)];
+        uint32_t round = 0;
+        while (true) {
+            while (m_round.load(std::memory_order_acquire) == round) {
+                std::this_thread::yield();
+            }
+            round++;
+            if (m_exit) {
+                break;
+            }
+            ProcessWindow(partition);
+            m_done.fetch_add(1, std::memory_order_release);
+        }
+        m_current = 0;
+    }
+
+    void
+    MultithreadedSimulatorImpl::WaitForWorkers(void) {
+        while (m_done.load(std::memory_order_acquire) < m_partitions.size() - 1) {
+            std::this_thread::yield();
+        }
+    }
+
+    void
+    MultithreadedSimulatorImpl::Run(void) {
+        NS_LOG_FUNCTION(this);
+        if (!m_partitioned) {
+            CreatePartitions();
+        }
+        m_stop = false;
+
+        // one thread per partition, the first one runs in this thread
+        for (uint32_t i = m_threads.size() + 1; i < m_partitions.size(); ++i) {
+            Ptr<SystemThread> thread = Create<SystemThread> (MakeCallback(&MultithreadedSimulatorImpl::DoWork, this));
+            thread->Start();
+            m_threads.push_back(thread);
+        }
+
+        while (true) {
+            // between windows: only this thread runs, with the global events
+            m_current = &m_global;
+            ReceiveMessages(&m_global);
+
+            uint64_t next = NO_TS;
+            for (uint32_t i = 0; i < m_partitions.size(); ++i) {
+                next = std::min(next, std::min(NextTs(m_partitions[i]), m_partitions[i]->m_sentTs));
+            }
+            uint64_t global = NextTs(&m_global);
+            if (m_stop || (next == NO_TS && global == NO_TS)) {
+                break;
+            }
+            if (global <= next) {
+                ProcessOneEvent(&m_global);
+                continue;
+            }
+
+            // no event sent in the window can fall within it, nor after the next global event
+            m_windowEnd = global - next > m_lookahead ? next + m_lookahead : global;
+            m_running = true;
+            m_done.store(0, std::memory_order_relaxed);
+            m_round.fetch_add(1, std::memory_order_release);
+            ProcessWindow(m_partitions[0]);
+            WaitForWorkers();
+            m_running = false;
+        }
+
+        m_current = 0;
+        for (uint32_t i = 0; i < m_partitions.size(); ++i) {
+            m_global.m_currentTs = std::max(m_global.m_currentTs, m_partitions[i]->m_currentTs);
+        }
+    }
+
+    void
+    MultithreadedSimulatorImpl::Stop(void) {
+        NS_LOG_FUNCTION(this);
+        m_stop = true;
+    }
+
+    void
+    MultithreadedSimulatorImpl::Stop(Time const &delay) {
+        NS_LOG_FUNCTION(this << delay.GetTimeStep());
+        Simulator::Schedule(delay, &Simulator::Stop);
+    }
+
+    EventId
+    MultithreadedSimulatorImpl::Schedule(Time const &delay, EventImpl * event) {
+        NS_LOG_FUNCTION(this << delay.GetTimeStep() << event);
+        NS_ASSERT(delay.IsPositive());
+        Partition *partition = GetCurrent();
+        Scheduler::EventKey key = Insert(partition, partition->m_currentTs + delay.GetTimeStep(),
+                partition->m_currentContext, event);
+        return EventId(event, key.m_ts, key.m_context, key.m_uid);
+    }
+
+    void
+    MultithreadedSimulatorImpl::ScheduleWithContext(uint32_t context, Time const &delay, EventImpl * event) {
+        NS_LOG_FUNCTION(this << context << delay.GetTimeStep() << event);
+        NS_ASSERT(delay.IsPositive());
+        Partition *partition = GetCurrent();
+        Partition *target = GetPartition(context);
+        uint64_t ts = partition->m_currentTs + delay.GetTimeStep();
+
+        // between windows the other partitions wait, their schedulers are safe to use
+        if (target == partition || !m_running) {
+            Insert(target, ts, context, event);
+            return;
+        }
+        if (ts < m_windowEnd) {
+            NS_FATAL_ERROR("Event for context " << context << " at " << TimeStep(ts)
+                    << " within the window ending at " << TimeStep(m_windowEnd)
+                    << ", partitions must only be linked by channels with a delay of at least " << GetLookahead());
+        }
+        uint32_t n = m_partitions.size();
+        uint32_t dst = target == &m_global ? n : target->m_systemId;
+        Message message;
+        message.m_ts = ts;
+        message.m_context = context;
+        message.m_event = event;
+        m_queues[partition->m_systemId * (n + 1) + dst]->Push(message);
+        partition->m_sentTs = std::min(partition->m_sentTs, ts);
+    }
+
+    EventId
+    MultithreadedSimulatorImpl::ScheduleNow(EventImpl * event) {
+        Partition *partition = GetCurrent();
+        Scheduler::EventKey key = Insert(partition, partition->m_currentTs, partition->m_currentContext, event);
+        return EventId(event, key.m_ts, key.m_context, key.m_uid);
+    }
+
+    EventId
+    MultithreadedSimulatorImpl::ScheduleDestroy(EventImpl * event) {
+        NS_ASSERT_MSG(m_current == 0 || m_current == &m_global, "Simulator::ScheduleDestroy from a partition");
+
+        EventId id(Ptr<EventImpl> (event, false), m_global.m_currentTs, 0xffffffff, 2);
+        m_destroyEvents.push_back(id);
+        return id;
+    }
+
+    Time
+    MultithreadedSimulatorImpl::Now(void) const {
+        // Do not add function logging here, to avoid stack overflow
+        return TimeStep(GetCurrent()->m_currentTs);
+    }
+
+    Time
+    MultithreadedSimulatorImpl::GetDelayLeft(const EventId & id) const {
+        if (IsExpired(id)) {
+            return TimeStep(0);
+        } else {
+            return TimeStep(id.GetTs() - GetPartition(id.GetContext())->m_currentTs);
+        }
+    }
+
+    void
+    MultithreadedSimulatorImpl::Remove(const EventId & id) {
+        if (id.GetUid() == 2) {
+            // destroy events.
+            for (DestroyEvents::iterator i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++) {
+                if (*i == id) {
+                    m_destroyEvents.erase(i);
+                    break;
+                }
+            }
+            return;
+        }
+        if (IsExpired(id)) {
+            return;
+        }
+        Partition *partition = GetPartition(id.GetContext());
+        NS_ASSERT_MSG(partition == GetCurrent() || !m_running, "Simulator::Remove of an event of another partition");
+        Scheduler::Event event;
+        event.impl = id.PeekEventImpl();
+        event.key.m_ts = id.GetTs();
+        event.key.m_context = id.GetContext();
+        event.key.m_uid = id.GetUid();
+        partition->m_events->Remove(event);
+        event.impl->Cancel();
+        // whenever we remove an event from the event list, we have to unref it.
+        event.impl->Unref();
+    }
+
+    void
+    MultithreadedSimulatorImpl::Cancel(const EventId & id) {
+        if (!IsExpired(id)) {
+            id.PeekEventImpl()->Cancel();
+        }
+    }
+
+    bool
+    MultithreadedSimulatorImpl::IsExpired(const EventId & id) const {
+        if (id.GetUid() == 2) {
+            if (id.PeekEventImpl() == 0 ||
+                    id.PeekEventImpl()->IsCancelled()) {
+                return true;
+            }
+            // destroy events.
+            for (DestroyEvents::const_iterator i = m_destroyEvents.begin(); i != m_destroyEvents.end(); i++) {
+                if (*i == id) {
+                    return false;
+                }
+            }
+            return true;
+        }
+        Partition *partition = GetPartition(id.GetContext());
+        if (id.PeekEventImpl() == 0 ||
+                id.GetTs() < partition->m_currentTs ||
+                (id.GetTs() == partition->m_currentTs &&
+                id.GetUid() <= partition->m_currentUid) ||
+                id.PeekEventImpl()->IsCancelled()) {
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    bool
+    MultithreadedSimulatorImpl::IsFinished(void) const {
+        if (m_stop) {
+            return true;
+        }
+        for (uint32_t i = 0; i <= m_partitions.size(); ++i) {
+            Partition *partition = i < m_partitions.size() ? m_partitions[i] : const_cast<Partition *> (&m_global);
+            if (NextTs(partition) != NO_TS || partition->m_sentTs != NO_TS) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    Time
+    MultithreadedSimulatorImpl::GetMaximumSimulationTime(void) const {
+        return TimeStep(0x7fffffffffffffffLL);
+    }
+
+    uint32_t
+    MultithreadedSimulatorImpl::GetSystemId(void) const {
+        return GetCurrent()->m_systemId;
+    }
+
+    uint32_t
+    MultithreadedSimulatorImpl::GetContext(void) const {
+        return GetCurrent()->m_currentContext;
+    }
+
+    uint32_t
+    MultithreadedSimulatorImpl::GetNPartitions(void) const {
+        return m_partitions.size();
+    }
+
+    Time
+    MultithreadedSimulatorImpl::GetLookahead(void) const {
+        return m_lookahead == NO_TS ? Time::Max() : TimeStep(m_lookahead);
+    }
+
+} // namespace ns3
@@ -0,0 +1,209 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MULTITHREADED_SIMULATOR_IMPL_H
+#define MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "ns3/simulator-impl.h"
+#include "ns3/scheduler.h"
+#include "ns3/event-impl.h"
+#include "ns3/system-thread.h"
+#include "ns3/ptr.h"
+
+#include "spsc-queue.h"
+
+#include <atomic>
+#include <list>
+#include <vector>
+
+namespace ns3 {
+
+    /**
+     * \ingroup mtp
+     *
+     * \brief Simulator implementation running one partition of the nodes per
+     * thread, in shared memory.
+     *
+     * Nodes are partitioned by their system id (Node::GetSystemId), as for the
+     * distributed simulators, and each partition runs its events in a thread of
+     * its own.  Partitions may only be linked by point-to-point channels: the
+     * lookahead is the smallest delay of such a channel between two partitions,
+     * and the partitions run the events of a window of that length without
+     * waiting for each other.  An event scheduled for a node of another
+     * partition goes through a lock-free queue to that partition, to run in a
+     * later window.  CSMA and wireless channels must stay within a partition.
+     *
+     * Events without a node context, such as those scheduled before Run or
+     * Simulator::Stop, run between windows while all partitions wait, so they
+     * may access every node.  Results do not depend on the scheduling of the
+     * threads, though the order of simultaneous events of different nodes may
+     * differ from DefaultSimulatorImpl.  Simulator::Stop called from a node
+     * event takes effect at the end of the window.
+     *
+     * Objects are shared between threads, so ns-3 has to be built with
+     * NS3_MTP (./waf configure --enable-mtp), which makes reference counts
+     * atomic.  Trace sinks connected to nodes of different partitions are
+     * called from different threads.
+     */
+    class MultithreadedSimulatorImpl : public SimulatorImpl {
+    public:
+        static TypeId GetTypeId(void);
+
+        MultithreadedSimulatorImpl();
+        ~MultithreadedSimulatorImpl();
+
+        // virtual from SimulatorImpl
+        virtual void Destroy();
+        virtual bool IsFinished(void) const;
+        virtual void Stop(void);
+        virtual void Stop(Time const &delay);
+        virtual EventId Schedule(Time const &delay, EventImpl *event);
+        virtual void ScheduleWithContext(uint32_t context, Time const &delay, EventImpl *event);
+        virtual EventId ScheduleNow(EventImpl *event);
+        virtual EventId ScheduleDestroy(EventImpl *event);
+        virtual void Remove(const EventId &id);
+        virtual void Cancel(const EventId &id);
+        virtual bool IsExpired(const EventId &id) const;
+        virtual void Run(void);
+        virtual Time Now(void) const;
+        virtual Time GetDelayLeft(const EventId &id) const;
+        virtual Time GetMaximumSimulationTime(void) const;
+        virtual void SetScheduler(ObjectFactory schedulerFactory);
+        virtual uint32_t GetSystemId(void) const;
+        virtual uint32_t GetContext(void) const;
+
+        /**
+         * \returns the number of partitions, known once Run has been called
+         */
+        uint32_t GetNPartitions(void) const;
+
+        /**
+         * \returns the smallest delay of a channel between two partitions,
+         * known once Run has been called
+         */
+        Time GetLookahead(void) const;
+
+    private:
+        virtual void DoDispose(void);
+
+        /// An event sent to another partition
+        struct Message {
+            uint64_t m_ts; //!< absolute time stamp
+            uint32_t m_context; //!< node context
+            EventImpl *m_event; //!< the event
+        };
+
+        /// Queue of the events sent from a partition to another
+        typedef SpscQueue<Message> MessageQueue;
+
+        /// The events of the nodes of a system, run by one thread
+        struct Partition {
+            uint32_t m_systemId; //!< system id of the nodes
+            Ptr<Scheduler> m_events; //!< the events
+            uint64_t m_currentTs; //!< time stamp of the current event
+            uint32_t m_currentUid; //!< uid of the current event
+            uint32_t m_currentContext; //!< context of the current event
+            uint32_t m_uid; //!< next event uid
+            uint64_t m_sentTs; //!< smallest time stamp sent to other partitions in this window
+            std::vector<MessageQueue *> m_inbox; //!< queues from the other partitions, by index
+        };
+
+        /**
+         * \returns the partition of the calling thread
+         */
+        Partition *GetCurrent(void) const;
+
+        /**
+         * \param context a node context
+         * \returns the partition whose thread runs the events of the context
+         */
+        Partition *GetPartition(uint32_t context) const;
+
+        /**
+         * \brief Insert an event into the scheduler of a partition
+         * \param partition the partition
+         * \param ts absolute time stamp
+         * \param context node context
+         * \param event the event
+         * \returns the scheduler key
+         */
+        Scheduler::EventKey Insert(Partition *partition, uint64_t ts, uint32_t context, EventImpl *event);
+
+        /**
+         * \brief Create a partition per system id and compute the lookahead
+         */
+        void CreatePartitions(void);
+
+        /**
+         * \brief Move the events sent to a partition into its scheduler
+         * \param partition the partition
+         */
+        void ReceiveMessages(Partition *partition);
+
+        /**
+         * \brief Run the events of a partition up to the end of the window
+         * \param partition the partition
+         */
+        void ProcessWindow(Partition *partition);
+
+        /**
+         * \brief Run the next event of a partition
+         * \param partition the partition
+         */
+        void ProcessOneEvent(Partition *partition);
+
+        /**
+         * \brief Worker thread: take a partition and run its windows until told to exit
+         */
+        void DoWork(void);
+
+        /**
+         * \brief Wait until the workers have run the current window
+         */
+        void WaitForWorkers(void);
+
+        /**
+         * \param partition a partition
+         * \returns the time stamp of its next event, ~0 if there is none
+         */
+        static uint64_t NextTs(Partition *partition);
+
+        static thread_local Partition *m_current; //!< partition run by the calling thread
+
+        typedef std::list<EventId> DestroyEvents;
+        DestroyEvents m_destroyEvents; //!< events run by Destroy
+
+        ObjectFactory m_schedulerFactory; //!< creates the schedulers of the partitions
+        Partition m_global; //!< events without a node context
+        std::vector<Partition *> m_partitions; //!< partitions, by system id
+        std::vector<MessageQueue *> m_queues; //!< queues between partitions, by source * (n + 1) + destination
+        std::vector<uint32_t> m_partitionOfContext; //!< system id of each node
+        uint64_t m_lookahead; //!< smallest delay between two partitions
+        bool m_partitioned; //!< whether the partitions have been created
+
+        std::atomic<bool> m_stop; //!< stop at the end of the window
+        bool m_running; //!< whether partitions are running a window
+        uint64_t m_windowEnd; //!< the window runs the events before this time stamp
+        std::atomic<uint32_t> m_round; //!< number of windows started
+        std::atomic<uint32_t> m_done; //!< number of workers done with the window
+        std::atomic<uint32_t> m_nextWorker; //!< partition taken by the next worker
+        bool m_exit; //!< tells the workers to exit
+        std::vector<Ptr<SystemThread> > m_threads; //!< worker threads, one per partition but the first
+    };
+
+} // namespace ns3
+
+#endif /* MULTITHREADED_SIMULATOR_IMPL_H */
@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <stdint.h>
+#include <atomic>
+
+namespace ns3 {
+
+    /**
+     * \ingroup mtp
+     *
+     * \brief Unbounded lock-free queue between one producer thread and one
+     * consumer thread.
+     *
+     * Items are stored in chunks of N: the producer fills the tail chunk and
+     * links a new one once it is full, the consumer empties the head chunk and
+     * frees it once it has moved on to the next.  The number of items written
+     * to a chunk, and the link to the next chunk, are published with release
+     * semantics, so the consumer sees the items they cover.
+     */
+    template <typename T, uint32_t N = 256>
+    class SpscQueue {
+    public:
+        SpscQueue();
+        ~SpscQueue();
+
+        /**
+         * \brief Append an item, from the producer thread
+         * \param item the item
+         */
+        void Push(const T &item);
+
+        /**
+         * \brief Take the oldest item, from the consumer thread
+         * \param item the item taken
+         * \returns false if the queue is empty
+         */
+        bool Pop(T &item);
+
+    private:
+        SpscQueue(const SpscQueue &);
+        SpscQueue &operator=(const SpscQueue &);
+
+        /// A chunk of items
+        struct Chunk {
+            Chunk() : m_written(0), m_next(0) {
+            }
+            T m_items[N]; //!< the items
+            std::atomic<uint32_t> m_written; //!< number of items written
+            std::atomic<Chunk *> m_next; //!< the next chunk, once this one is full
+        };
+
+        Chunk *m_head; //!< chunk read by the consumer
+        uint32_t m_read; //!< number of items read from m_head
+        char m_pad[64]; //!< keeps the consumer and producer fields on different cache lines
+        Chunk *m_tail; //!< chunk written by the producer
+        uint32_t m_write; //!< number of items written to m_tail
+    };
+
+    template <typename T, uint32_t N>
+    SpscQueue<T, N>::SpscQueue()
+    : m_head(new Chunk()),
+    m_read(0),
+    m_tail(m_head),
+    m_write(0) {
+    }
+
+    template <typename T, uint32_t N>
+    SpscQueue<T, N>::~SpscQueue() {
+        while (m_head != 0) {
+            Chunk *next = m_head->m_next.load(std::memory_order_relaxed);
+            delete m_head;
+            m_head = next;
+        }
+    }
+
+    template <typename T, uint32_t N>
+    void
+    SpscQueue<T, N>::Push(const T &item) {
+        if (m_write == N) {
+            Chunk *chunk = new Chunk();
+            m_tail->m_next.store(chunk, std::memory_order_release);
+            m_tail = chunk;
+            m_write = 0;
+        }
+        m_tail->m_items[m_write] = item;
+        m_tail->m_written.store(++m_write, std::memory_order_release);
+    }
+
+    template <typename T, uint32_t N>
+    bool
+    SpscQueue<T, N>::Pop(T &item) {
+        if (m_read == N) {
+            Chunk *next = m_head->m_next.load(std::memory_order_acquire);
+            if (next == 0) {
+                return false;
+            }
+            // the producer is done with the chunk once it has linked the next
+            delete m_head;
+            m_head = next;
+            m_read = 0;
+        }
+        if (m_read == m_head->m_written.load(std::memory_order_acquire)) {
+            return false;
+        }
+        item = m_head->m_items[m_read++];
+        return true;
+    }
+
+} // namespace ns3
+
+#endif /* SPSC_QUEUE_H */
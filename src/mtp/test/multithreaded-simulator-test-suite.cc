@@ -0,0 +1,213 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/net-device-container.h"
+#include "ns3/point-to-point-helper.h"
+#include "ns3/string.h"
+#include "ns3/global-value.h"
+#include "ns3/multithreaded-simulator-impl.h"
+#include "ns3/spsc-queue.h"
+
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \brief Test the lock-free queue between two threads
+ */
+class SpscQueueTestCase : public TestCase {
+public:
+    SpscQueueTestCase();
+    virtual void DoRun(void);
+
+private:
+    /// Push the items, from the producer thread
+    void Produce(void);
+
+    SpscQueue<uint32_t, 16> m_queue; //!< the queue
+    uint32_t m_n; //!< number of items
+};
+
+SpscQueueTestCase::SpscQueueTestCase()
+: TestCase("Items cross the queue in order"),
+m_n(100000) {
+}
+
+void
+SpscQueueTestCase::Produce(void) {
+    for (uint32_t i = 0; i < m_n; ++i) {
+        m_queue.Push(i);
+    }
+}
+
+void
+SpscQueueTestCase::DoRun(void) {
+    uint32_t item;
+    NS_TEST_ASSERT_MSG_EQ(m_queue.Pop(item), false, "queue not empty");
+
+    Ptr<SystemThread> producer = Create<SystemThread> (MakeCallback(&SpscQueueTestCase::Produce, this));
+    producer->Start();
+    uint32_t expected = 0;
+    while (expected < m_n) {
+        if (m_queue.Pop(item)) {
+            NS_TEST_ASSERT_MSG_EQ(item, expected, "item out of order");
+            expected++;
+        }
+    }
+    producer->Join();
+    NS_TEST_ASSERT_MSG_EQ(m_queue.Pop(item), false, "queue not empty");
+}
+
+/**
+ * \brief Run the same exchanges with DefaultSimulatorImpl and
+ * MultithreadedSimulatorImpl
+ *
+ * Four nodes on two systems, A(0) - B(1) - C(0) - D(1), ping-pong packets
+ * over each link, and a global event takes a snapshot of the counters
+ * midway.  Both simulators must deliver the same packets at the same
+ * times.
+ */
+class MultithreadedSimulatorTestCase : public TestCase {
+public:
+    MultithreadedSimulatorTestCase();
+    virtual void DoRun(void);
+
+private:
+    /// What a run delivered
+    struct Result {
+        std::vector<uint32_t> m_received; //!< packets received, by node
+        std::vector<Time> m_last; //!< time of the last packet received, by node
+        std::vector<uint32_t> m_snapshot; //!< m_received at the snapshot
+        Time m_end; //!< time at the end of the run
+    };
+
+    /**
+     * \brief Build the nodes and run the simulation
+     * \param impl simulator implementation type
+     * \returns what the run delivered
+     */
+    Result RunScenario(std::string impl);
+
+    /// Send the packet back
+    void Receive(Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol,
+                 const Address &from, const Address &to, NetDevice::PacketType type);
+
+    /// Copy the counters, from a global event
+    void Snapshot(void);
+
+    Result m_result; //!< result of the current run
+};
+
+MultithreadedSimulatorTestCase::MultithreadedSimulatorTestCase()
+: TestCase("Multithreaded runs match sequential runs") {
+}
+
+void
+MultithreadedSimulatorTestCase::Receive(Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol,
+                                        const Address &from, const Address &to, NetDevice::PacketType type) {
+    // each node only touches its own counters
+    uint32_t id = device->GetNode()->GetId();
+    m_result.m_received[id]++;
+    m_result.m_last[id] = Simulator::Now();
+    device->Send(packet->Copy(), device->GetBroadcast(), protocol);
+}
+
+void
+MultithreadedSimulatorTestCase::Snapshot(void) {
+    m_result.m_snapshot = m_result.m_received;
+}
+
+MultithreadedSimulatorTestCase::Result
+MultithreadedSimulatorTestCase::RunScenario(std::string impl) {
+    GlobalValue::Bind("SimulatorImplementationType", StringValue(impl));
+
+    std::vector<Ptr<Node> > nodes;
+    for (uint32_t i = 0; i < 4; ++i) {
+        nodes.push_back(CreateObject<Node> (i % 2));
+    }
+    m_result = Result();
+    m_result.m_received.resize(nodes.size(), 0);
+    m_result.m_last.resize(nodes.size());
+
+    PointToPointHelper p2p;
+    p2p.SetDeviceAttribute("DataRate", StringValue("10Mbps"));
+    const char *delays[] = {"2ms", "3ms", "5ms"};
+    for (uint32_t i = 0; i + 1 < nodes.size(); ++i) {
+        p2p.SetChannelAttribute("Delay", StringValue(delays[i]));
+        NetDeviceContainer devices = p2p.Install(nodes[i], nodes[i + 1]);
+        for (uint32_t j = 0; j < 2; ++j) {
+            Ptr<NetDevice> device = devices.Get(j);
+            device->GetNode()->RegisterProtocolHandler(
+                    MakeCallback(&MultithreadedSimulatorTestCase::Receive, this), 0x0800, device);
+        }
+        // one packet each way, started by the nodes themselves
+        for (uint32_t j = 0; j < 2; ++j) {
+            Ptr<NetDevice> device = devices.Get(j);
+            Simulator::ScheduleWithContext(device->GetNode()->GetId(), MilliSeconds(j),
+                    MakeEvent(&NetDevice::Send, device, Create<Packet> (100 + i), device->GetBroadcast(), 0x0800));
+        }
+    }
+
+    Simulator::Schedule(MilliSeconds(500), &MultithreadedSimulatorTestCase::Snapshot, this);
+    Simulator::Stop(Seconds(1));
+    Simulator::Run();
+
+    if (impl == "ns3::MultithreadedSimulatorImpl") {
+        Ptr<MultithreadedSimulatorImpl> mt = DynamicCast<MultithreadedSimulatorImpl> (Simulator::GetImplementation());
+        NS_TEST_EXPECT_MSG_EQ(mt->GetNPartitions(), 2, "one partition per system");
+        NS_TEST_EXPECT_MSG_EQ(mt->GetLookahead(), MilliSeconds(2), "lookahead is the shortest delay");
+    }
+
+    Result result = m_result;
+    result.m_end = Simulator::Now();
+    Simulator::Destroy();
+    return result;
+}
+
+void
+MultithreadedSimulatorTestCase::DoRun(void) {
+    Result sequential = RunScenario("ns3::DefaultSimulatorImpl");
+    Result parallel = RunScenario("ns3::MultithreadedSimulatorImpl");
+    GlobalValue::Bind("SimulatorImplementationType", StringValue("ns3::DefaultSimulatorImpl"));
+
+    NS_TEST_ASSERT_MSG_GT(sequential.m_received[1], 100, "packets do not flow");
+    NS_TEST_EXPECT_MSG_EQ(parallel.m_end, sequential.m_end, "runs end at different times");
+    for (uint32_t i = 0; i < sequential.m_received.size(); ++i) {
+        NS_TEST_EXPECT_MSG_EQ(parallel.m_received[i], sequential.m_received[i], "packets received by node " << i);
+        NS_TEST_EXPECT_MSG_EQ(parallel.m_last[i], sequential.m_last[i], "last packet received by node " << i);
+        NS_TEST_EXPECT_MSG_EQ(parallel.m_snapshot[i], sequential.m_snapshot[i], "snapshot of node " << i);
+    }
+}
+
+/**
+ * \brief MultithreadedSimulatorImpl test suite
+ */
+class MultithreadedSimulatorTestSuite : public TestSuite {
+public:
+    MultithreadedSimulatorTestSuite();
+};
+
+MultithreadedSimulatorTestSuite::MultithreadedSimulatorTestSuite()
+: TestSuite("multithreaded-simulator", UNIT) {
+    AddTestCase(new SpscQueueTestCase, TestCase::QUICK);
+    AddTestCase(new MultithreadedSimulatorTestCase, TestCase::QUICK);
+}
+
+static MultithreadedSimulatorTestSuite g_multithreadedSimulatorTestSuite; //!< Static variable for test initialization
@@ -37,19 +37,19 @@ namespace nfd {
 static ns3::LogComponent g_log
 
 #define NFD_LOG_INCLASS_DEFINE(cls, name) \
-ns3::LogComponent cls::g_log = ns3::LogComponent ("nfd." name, __FILE__)
+ns3::LogComponent cls::g_log ("nfd." name, __FILE__)
 
 #define NFD_LOG_INCLASS_TEMPLATE_DEFINE(cls, name) \
 template<class T>                                  \
-ns3::LogComponent cls<T>::g_log = ns3::LogComponent ("nfd." name, __FILE__)
+ns3::LogComponent cls<T>::g_log ("nfd." name, __FILE__)
 
 #define NFD_LOG_INCLASS_TEMPLATE_SPECIALIZATION_DEFINE(cls, specialization, name) \
 template<>                                                                        \
-ns3::LogComponent cls<specialization>::g_log = ns3::LogComponent ("nfd." name, __FILE__)
+ns3::LogComponent cls<specialization>::g_log ("nfd." name, __FILE__)
 
 #define NFD_LOG_INCLASS_2TEMPLATE_SPECIALIZATION_DEFINE(cls, s1, s2, name) \
 template<>                                                                 \
-s3::LogComponent cls<s1, s2>::g_log = ns3::LogComponent ("nfd." name, __FILE__)
+ns3::LogComponent cls<s1, s2>::g_log ("nfd." name, __FILE__)
 
 #define NFD_LOG_TRACE(expression) NS_LOG_LOGIC(expression)
 #define NFD_LOG_DEBUG(expression) NS_LOG_DEBUG(expression)
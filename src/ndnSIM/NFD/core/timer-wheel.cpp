@@ -0,0 +1,234 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "timer-wheel.hpp"
+
+namespace nfd {
+    namespace scheduler {
+
+        const time::nanoseconds TimerWheel::DEFAULT_GRANULARITY = time::milliseconds(1);
+
+        TimerWheel::TimerWheel(const time::nanoseconds& granularity)
+        : m_granularity(granularity)
+        , m_nTimers(0)
+        , m_eventTick(0) {
+            if (m_granularity <= time::nanoseconds::zero()) {
+                BOOST_THROW_EXCEPTION(std::invalid_argument("granularity must be positive"));
+            }
+            m_levelSizes.fill(0);
+            m_currentTick = this->toTick(time::steady_clock::now(), false);
+        }
+
+        TimerWheel::~TimerWheel() {
+            this->cancelAll();
+        }
+
+        TimerWheel::TimerId
+        TimerWheel::schedule(const time::nanoseconds& after, const Callback& callback) {
+            time::steady_clock::TimePoint now = time::steady_clock::now();
+            if (m_nTimers == 0) {
+                // nothing is pending, so the wheel can jump to the present without processing ticks
+                m_currentTick = std::max(m_currentTick, this->toTick(now, false));
+            }
+
+            Tick expiry = std::max(this->toTick(now + after, true), m_currentTick + 1);
+            TimerId timer = make_shared<Timer>(expiry, callback);
+
+            Slot& slot = this->findSlot(expiry, timer->level);
+            timer->slot = &slot;
+            timer->pos = slot.insert(slot.end(), timer);
+            timer->isPending = true;
+            ++m_levelSizes[timer->level];
+            ++m_nTimers;
+
+            this->arm();
+            return timer;
+        }
+
+        void
+        TimerWheel::cancel(const TimerId& timerId) {
+            TimerId timer = timerId; // timerId may refer to the copy held by the slot
+            if (timer == nullptr || !timer->isPending) {
+                return;
+            }
+
+            timer->slot->erase(timer->pos);
+            timer->isPending = false;
+            timer->callback = nullptr; // break cycles through objects bound into the callback
+            --m_levelSizes[timer->level];
+            --m_nTimers;
+            // the global event is left armed: if it fires early, it is simply re-armed
+        }
+
+        void
+        TimerWheel::cancelAll() {
+            for (auto& level : m_wheel) {
+                for (Slot& slot : level) {
+                    for (const TimerId& timer : slot) {
+                        timer->isPending = false;
+                        timer->callback = nullptr;
+                    }
+                    slot.clear();
+                }
+            }
+            m_levelSizes.fill(0);
+            m_nTimers = 0;
+
+            scheduler::cancel(m_event);
+            m_event.reset();
+        }
+
+        TimerWheel::Tick
+        TimerWheel::toTick(const time::steady_clock::TimePoint& tp, bool roundUp) const {
+            Tick ns = static_cast<Tick> (time::duration_cast<time::nanoseconds>(tp.time_since_epoch()).count());
+            Tick granularity = static_cast<Tick> (m_granularity.count());
+            return roundUp ? (ns + granularity - 1) / granularity : ns / granularity;
+        }
+
+        TimerWheel::Slot&
+        TimerWheel::findSlot(Tick expiry, size_t& level) {
+            BOOST_ASSERT(expiry >= m_currentTick);
+            Tick delta = expiry - m_currentTick;
+
+            level = 0;
+            while (level < N_LEVELS - 1 && delta >= (static_cast<Tick> (1) << (SLOT_BITS * (level + 1)))) {
+                ++level;
+            }
+
+            Tick maxDelta = (static_cast<Tick> (1) << (SLOT_BITS * N_LEVELS)) - 1;
+            if (delta > maxDelta) {
+                // beyond the range of the wheel: park in the farthest slot, to be re-placed on cascade
+                expiry = m_currentTick + maxDelta;
+            }
+
+            return m_wheel[level][(expiry >> (SLOT_BITS * level)) & (N_SLOTS - 1)];
+        }
+
+        void
+        TimerWheel::cascade(size_t level, size_t slotIndex) {
+            Slot pending;
+            pending.splice(pending.end(), m_wheel[level][slotIndex]);
+            m_levelSizes[level] -= pending.size();
+
+            while (!pending.empty()) {
+                Slot::iterator it = pending.begin();
+                Timer& timer = **it;
+                Slot& slot = this->findSlot(timer.expiry, timer.level);
+                slot.splice(slot.end(), pending, it); // iterator stays valid, no reallocation
+                timer.slot = &slot;
+                ++m_levelSizes[timer.level];
+            }
+        }
+
+        TimerWheel::Tick
+        TimerWheel::findNextTick(Tick target) const {
+            Tick next = target;
+            if (m_nTimers == 0) {
+                return next;
+            }
+
+            if (m_levelSizes[0] > 0) {
+                for (Tick t = m_currentTick + 1; t <= m_currentTick + N_SLOTS && t < next; ++t) {
+                    if (!m_wheel[0][t & (N_SLOTS - 1)].empty()) {
+                        next = t;
+                        break;
+                    }
+                }
+            }
+
+            // a higher level slot needs attention at the tick where it is cascaded
+            for (size_t level = 1; level < N_LEVELS; ++level) {
+                if (m_levelSizes[level] == 0) {
+                    continue;
+                }
+                size_t shift = SLOT_BITS * level;
+                Tick first = (m_currentTick >> shift) + 1;
+                for (Tick k = first; k < first + N_SLOTS && (k << shift) < next; ++k) {
+                    if (!m_wheel[level][k & (N_SLOTS - 1)].empty()) {
+                        next = k << shift;
+                        break;
+                    }
+                }
+            }
+            return next;
+        }
+
+        void
+        TimerWheel::advance(Tick target) {
+            while (m_currentTick < target) {
+                m_currentTick = this->findNextTick(target);
+
+                // cascade every level whose period starts at this tick, highest first
+                for (size_t level = N_LEVELS - 1; level > 0; --level) {
+                    size_t shift = SLOT_BITS * level;
+                    if ((m_currentTick & ((static_cast<Tick> (1) << shift) - 1)) == 0) {
+                        this->cascade(level, (m_currentTick >> shift) & (N_SLOTS - 1));
+                    }
+                }
+
+                Slot& slot = m_wheel[0][m_currentTick & (N_SLOTS - 1)];
+                while (!slot.empty()) {
+                    TimerId timer = slot.front();
+                    slot.pop_front();
+                    timer->isPending = false;
+                    --m_levelSizes[0];
+                    --m_nTimers;
+
+                    Callback callback;
+                    callback.swap(timer->callback);
+                    callback(); // may schedule or cancel other timers
+                }
+            }
+        }
+
+        void
+        TimerWheel::arm() {
+            if (m_nTimers == 0) {
+                return;
+            }
+
+            Tick next = this->findNextTick(std::numeric_limits<Tick>::max());
+            if (m_event != nullptr && m_eventTick <= next) {
+                // already armed at or before the earliest slot
+                return;
+            }
+
+            scheduler::cancel(m_event);
+            time::nanoseconds after = time::nanoseconds(static_cast<time::nanoseconds::rep> (next) * m_granularity.count()) -
+                    time::steady_clock::now().time_since_epoch();
+            m_event = scheduler::schedule(std::max(after, time::nanoseconds::zero()),
+                    bind(&TimerWheel::onTick, this));
+            m_eventTick = next;
+        }
+
+        void
+        TimerWheel::onTick() {
+            m_event.reset();
+            this->advance(this->toTick(time::steady_clock::now(), false));
+            this->arm();
+        }
+
+    } // namespace scheduler
+} // namespace nfd
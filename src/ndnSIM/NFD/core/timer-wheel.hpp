@@ -0,0 +1,176 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_CORE_TIMER_WHEEL_HPP
+#define NFD_CORE_TIMER_WHEEL_HPP
+
+#include "scheduler.hpp"
+
+#include <array>
+
+namespace nfd {
+    namespace scheduler {
+
+        /** \brief a hierarchical timer wheel
+         *
+         *  The wheel keeps a large number of short-lived timers (e.g. PIT entry lifetimes) in
+         *  four levels of 256 slots each, and drives all of them through a single event in the
+         *  global scheduler that is armed for the earliest pending slot. Adding a timer only
+         *  touches the global scheduler when it becomes the new earliest deadline, and cancelling
+         *  a timer never does, which keeps Schedule/Cancel churn out of the simulator event queue.
+         *
+         *  Expiry times are rounded up to a multiple of the granularity, so a timer fires
+         *  at most one granularity later than requested and never earlier.
+         */
+        class TimerWheel : noncopyable {
+        public:
+            typedef function<void() > Callback;
+
+            class Timer;
+
+            /** \brief identifies a timer scheduled on the wheel
+             *
+             *  A default-constructed or expired TimerId is valid to cancel.
+             */
+            typedef shared_ptr<Timer> TimerId;
+
+            explicit
+            TimerWheel(const time::nanoseconds& granularity = DEFAULT_GRANULARITY);
+
+            /** \brief cancels all pending timers
+             */
+            ~TimerWheel();
+
+            /** \brief schedule callback to be invoked after the specified delay
+             */
+            TimerId
+            schedule(const time::nanoseconds& after, const Callback& callback);
+
+            /** \brief cancel a timer
+             *
+             *  Cancelling a timer that has fired or has been cancelled has no effect.
+             */
+            void
+            cancel(const TimerId& timerId);
+
+            /** \brief cancel all pending timers
+             */
+            void
+            cancelAll();
+
+            /** \return number of pending timers
+             */
+            size_t
+            size() const {
+                return m_nTimers;
+            }
+
+            const time::nanoseconds&
+            getGranularity() const {
+                return m_granularity;
+            }
+
+        public:
+            static const time::nanoseconds DEFAULT_GRANULARITY;
+
+        private:
+            typedef uint64_t Tick;
+            typedef std::list<TimerId> Slot;
+
+            Tick
+            toTick(const time::steady_clock::TimePoint& tp, bool roundUp) const;
+
+            /** \return the slot matching expiry, relative to m_currentTick
+             *  \param[out] level level of the returned slot
+             */
+            Slot&
+            findSlot(Tick expiry, size_t& level);
+
+            /** \brief move all timers of a higher level slot to lower levels
+             */
+            void
+            cascade(size_t level, size_t slot);
+
+            /** \brief process all ticks up to and including target
+             */
+            void
+            advance(Tick target);
+
+            /** \return the next tick after m_currentTick at which work may be due,
+             *          or target if there is none before target
+             */
+            Tick
+            findNextTick(Tick target) const;
+
+            /** \brief (re)arm the global scheduler event for the earliest pending slot
+             */
+            void
+            arm();
+
+            void
+            onTick();
+
+        PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+            static const size_t N_LEVELS = 4;
+            static const size_t SLOT_BITS = 8;
+            static const size_t N_SLOTS = 1 << SLOT_BITS;
+
+        private:
+            time::nanoseconds m_granularity;
+            std::array<std::array<Slot, N_SLOTS>, N_LEVELS> m_wheel;
+            std::array<size_t, N_LEVELS> m_levelSizes;
+            size_t m_nTimers;
+            Tick m_currentTick;
+
+            EventId m_event;
+            Tick m_eventTick;
+        };
+
+        /** \brief a timer on TimerWheel
+         *  \note This type is opaque to users of TimerWheel.
+         */
+        class TimerWheel::Timer : noncopyable {
+        public:
+            Timer(Tick expiry, const Callback& callback)
+            : expiry(expiry)
+            , callback(callback)
+            , isPending(false) {
+            }
+
+        private:
+            Tick expiry;
+            Callback callback;
+            bool isPending;
+            size_t level;
+            Slot* slot;
+            Slot::iterator pos;
+
+            friend class TimerWheel;
+        };
+
+    } // namespace scheduler
+} // namespace nfd
+
+#endif // NFD_CORE_TIMER_WHEEL_HPP
@@ -53,7 +53,7 @@ namespace nfd {
 
         void
         GenericLinkService::doSendInterest(const Interest& interest) {
-            lp::Packet lpPacket(interest.wireEncode());
+            lp::Packet lpPacket(this->compressNetPacket(interest.wireEncode()));
 
             encodeLpFields(interest, lpPacket);
 
@@ -62,7 +62,7 @@ namespace nfd {
 
         void
         GenericLinkService::doSendData(const Data& data) {
-            lp::Packet lpPacket(data.wireEncode());
+            lp::Packet lpPacket(this->compressNetPacket(data.wireEncode()));
 
             encodeLpFields(data, lpPacket);
 
@@ -71,7 +71,7 @@ namespace nfd {
 
         void
         GenericLinkService::doSendNack(const lp::Nack& nack) {
-            lp::Packet lpPacket(nack.getInterest().wireEncode());
+            lp::Packet lpPacket(this->compressNetPacket(nack.getInterest().wireEncode()));
             lpPacket.add<lp::NackField>(nack.getHeader());
 
             encodeLpFields(nack, lpPacket);
@@ -79,6 +79,16 @@ namespace nfd {
             this->sendNetPacket(std::move(lpPacket));
         }
 
+        Block
+        GenericLinkService::compressNetPacket(const Block& netPkt) {
+            return netPkt;
+        }
+
+        bool
+        GenericLinkService::decompressNetPacket(Block& netPkt) {
+            return true;
+        }
+
         void
         GenericLinkService::encodeLpFields(const ndn::TagHost& netPkt, lp::Packet& lpPacket) {
             if (m_options.allowLocalFields) {
@@ -180,7 +190,12 @@ namespace nfd {
         }
 
         void
-        GenericLinkService::decodeNetPacket(const Block& netPkt, const lp::Packet& firstPkt) {
+        GenericLinkService::decodeNetPacket(const Block& received, const lp::Packet& firstPkt) {
+            Block netPkt = received;
+            if (!this->decompressNetPacket(netPkt)) {
+                return;
+            }
+
             try {
                 switch (netPkt.type()) {
                     case tlv::Interest:
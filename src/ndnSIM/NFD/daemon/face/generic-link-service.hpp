@@ -127,6 +127,22 @@ namespace nfd {
             virtual const Counters&
             getCounters() const override;
 
+        protected: // link-specific encoding of network-layer packets
+            /** \brief compress an outgoing network-layer packet before it is put into an LpPacket
+             *  \param netPkt Interest or Data, as encoded by the network layer
+             *  \return the packet to send; the default implementation returns \p netPkt
+             */
+            virtual Block
+            compressNetPacket(const Block& netPkt);
+
+            /** \brief decompress a reassembled network-layer packet before it is decoded
+             *  \param[in,out] netPkt reassembled network-layer packet
+             *  \return false if the packet should be dropped;
+             *           the default implementation leaves \p netPkt unchanged and returns true
+             */
+            virtual bool
+            decompressNetPacket(Block& netPkt);
+
         private: // send path
             /** \brief send Interest
              */
@@ -173,14 +189,14 @@ namespace nfd {
             doReceivePacket(Transport::Packet&& packet) override;
 
             /** \brief decode incoming network-layer packet
-             *  \param netPkt reassembled network-layer packet
+             *  \param received reassembled network-layer packet, passed to decompressNetPacket
              *  \param firstPkt LpPacket of first fragment
              *
              *  If decoding is successful, a receive signal is emitted;
              *  otherwise, a warning is logged.
              */
             void
-            decodeNetPacket(const Block& netPkt, const lp::Packet& firstPkt);
+            decodeNetPacket(const Block& received, const lp::Packet& firstPkt);
 
             /** \brief decode incoming Interest
              *  \param netPkt reassembled network-layer packet; TLV-TYPE must be Interest
@@ -221,7 +237,13 @@ namespace nfd {
         private:
             Options m_options;
             LpFragmenter m_fragmenter;
+
+        protected:
+            /** \brief reassembler, which a subclass passes to the virtual base GenericLinkServiceCounters
+             */
             LpReassembler m_reassembler;
+
+        private:
             lp::Sequence m_lastSeqNo;
         };
 
@@ -53,6 +53,7 @@ namespace nfd {
     , m_pit(m_nameTree)
     , m_measurements(m_nameTree)
     , m_strategyChoice(m_nameTree, fw::makeDefaultStrategy(*this))
+    , m_deadNonceList(new DeadNonceList())
     , m_tx_data_bytes(0)
     , m_tx_interest_bytes(0)
     , m_csFace(face::makeNullFace(FaceUri("contentstore://"))) {
@@ -177,6 +178,11 @@ namespace nfd {
         interest.setTag(make_shared<lp::IncomingFaceIdTag>(inFace.getId()));
         ++m_counters.nInInterests;
 
+        // a neighbor on the shared medium has sent this Interest: ours is no longer needed
+        if (inFace.getLinkType() == ndn::nfd::LINK_TYPE_MULTI_ACCESS) {
+            m_multiAccessSuppression.overhearInterest(inFace, interest.getName());
+        }
+
         //**New part for IP backhaul functionality. 
 
         // Make copy of interest in order to be able to change it.
@@ -198,6 +204,8 @@ namespace nfd {
             //Place ovrhd label into m_trnsoverhead translation vector.
             m_trnsoverhead.push_back(std::make_pair(subname.toUri(), ovrhd));
             outInterest->setName(subname);
+            // subname is a prefix of the original name: reuse its prefix hashes if already computed
+            name_tree::inheritPrefixHashes(*outInterest, interest);
             NFD_LOG_DEBUG("Removed overhead component, name is now: " << outInterest->getName());
         }
 
@@ -215,7 +223,7 @@ namespace nfd {
 
 
         // detect duplicate Nonce with Dead Nonce List
-        bool hasDuplicateNonceInDnl = m_deadNonceList.has(outInterest->getName(), outInterest->getNonce());
+        bool hasDuplicateNonceInDnl = m_deadNonceList->has(outInterest->getName(), outInterest->getNonce());
         if (hasDuplicateNonceInDnl) {
             // goto Interest loop pipeline
             this->onInterestLoop(inFace, *outInterest);
@@ -363,13 +371,13 @@ namespace nfd {
 
         // If this node is either a gateway or a backhaul node, add overhead name. 
         // This should only be done if the incoming interest already had an overhead component.
-        // Also check that outface is not a broadcast domain.
-        if ((iamGTW() == 1 || (iamGTW() == 2)) && (m_conOvrhd_int == 0) && ((outFace.getRemoteUri().toString() == "netdev://[ff:ff:ff:ff:ff:ff]")
-                && (outFace.getRemoteUri().toString() == "netdev://[ff:ff:ff:ff:ff:ff]")) != 1) {
+        // Also check that outface is not a broadcast domain (CSMA, LR-WPAN, whatever its address size).
+        uint8_t role = iamGTW();
+        if ((role == 1 || (role == 2)) && (m_conOvrhd_int == 0) && (outFace.getLinkType() != ndn::nfd::LINK_TYPE_MULTI_ACCESS)) {
             if ((oerie.getScheme() != "AppFace") && (outFace.getScope() == ndn::nfd::FACE_SCOPE_NON_LOCAL)) {
-                if (iamGTW() == 1) {
+                if (role == 1) {
                     NFD_LOG_DEBUG("Node: " << m_node->GetId() << " is configured as a backhaulnode. " << "Adding overhead component.");
-                } else if (iamGTW() == 2) {
+                } else if (role == 2) {
                     NFD_LOG_DEBUG("Node: " << m_node->GetId() << " is configured as a gateway node." << "Adding overhead component.");
                 }
                 nameWithSequence = make_shared<Name>(outInterest->getName());
@@ -379,12 +387,34 @@ namespace nfd {
             }
         }
 
-        if ((oerie.getScheme() != "AppFace") && (outFace.getScope() == ndn::nfd::FACE_SCOPE_NON_LOCAL)) {
-            m_tx_interest_bytes += (uint64_t) (outInterest->wireEncode().size()) + 7;
+        //**End of part for backhaul modeling.
+
+        if (m_multiAccessSuppression.shouldDefer(outFace, false)) {
+            weak_ptr<pit::Entry> weakEntry = pitEntry;
+            weak_ptr<Face> weakFace = outFace.shared_from_this();
+            m_multiAccessSuppression.deferInterest(outFace, outInterest->getName(),
+                    [this, weakEntry, weakFace, outInterest] {
+                        shared_ptr<pit::Entry> entry = weakEntry.lock();
+                        shared_ptr<Face> face = weakFace.lock();
+                        // drop if the Interest has been satisfied, rejected or has expired meanwhile
+                        if (entry == nullptr || face == nullptr || !entry->hasInRecords()) {
+                            return;
+                        }
+                        this->transmitInterest(*face, *outInterest);
+                    });
+            return;
         }
 
-        //**End of part for backhaul modeling.
-        outFace.sendInterest(*outInterest);
+        this->transmitInterest(outFace, *outInterest);
+    }
+
+    void
+    Forwarder::transmitInterest(Face& outFace, const Interest& interest) {
+        if ((outFace.getLocalUri().getScheme() != "AppFace") && (outFace.getScope() == ndn::nfd::FACE_SCOPE_NON_LOCAL)) {
+            m_tx_interest_bytes += (uint64_t) (interest.wireSize()) + 7;
+        }
+
+        outFace.sendInterest(interest);
         ++m_counters.nOutInterests;
     }
 
@@ -448,6 +478,11 @@ namespace nfd {
         data.setTag(make_shared<lp::IncomingFaceIdTag>(inFace.getId()));
         ++m_counters.nInData;
 
+        // a neighbor on the shared medium has sent this Data: cancel our copy and Interests it satisfies
+        if (inFace.getLinkType() == ndn::nfd::LINK_TYPE_MULTI_ACCESS) {
+            m_multiAccessSuppression.overhearData(inFace, data.getName());
+        }
+
         //**New part for backhaul modeling.
 
         auto outData = make_shared<Data>(data);
@@ -477,6 +512,7 @@ namespace nfd {
             std::string ovrhd = data.getName().at(-1).toUri();
             Name subname = data.getName().getSubName(0, data.getName().size() - 1);
             outData->setName(subname);
+            name_tree::inheritPrefixHashes(*outData, data);
             NFD_LOG_DEBUG("Removed overhead component, name is now: " << outData->getName());
         }
 
@@ -553,6 +589,10 @@ namespace nfd {
                 m_cs.insert(data, true);
             else
                 m_csFromNdnSim->Add(data.shared_from_this());
+
+            if (inFace.getLinkType() == ndn::nfd::LINK_TYPE_MULTI_ACCESS) {
+                m_multiAccessSuppression.afterCacheOverheardData();
+            }
         }
 
         NFD_LOG_DEBUG("onDataUnsolicited face=" << inFace.getId() <<
@@ -603,11 +643,28 @@ namespace nfd {
         }
         //**End new part
 
-        if ((oerie.getScheme() != "AppFace") && (outFace.getScope() == ndn::nfd::FACE_SCOPE_NON_LOCAL)) {
-            m_tx_data_bytes += (uint64_t) (outData->wireEncode().size()) + 7;
+        if (m_multiAccessSuppression.shouldDefer(outFace, true)) {
+            weak_ptr<Face> weakFace = outFace.shared_from_this();
+            m_multiAccessSuppression.deferData(outFace, outData->getName(),
+                    [this, weakFace, outData] {
+                        shared_ptr<Face> face = weakFace.lock();
+                        if (face != nullptr) {
+                            this->transmitData(*face, *outData);
+                        }
+                    });
+            return;
+        }
+
+        this->transmitData(outFace, *outData);
+    }
+
+    void
+    Forwarder::transmitData(Face& outFace, const Data& data) {
+        if ((outFace.getLocalUri().getScheme() != "AppFace") && (outFace.getScope() == ndn::nfd::FACE_SCOPE_NON_LOCAL)) {
+            m_tx_data_bytes += (uint64_t) (data.wireSize()) + 7;
         }
         // send Data
-        outFace.sendData(*outData);
+        outFace.sendData(data);
         ++m_counters.nOutData;
     }
 
@@ -733,8 +790,8 @@ namespace nfd {
             // TODO all in-records are already expired; will this happen?
         }
 
-        scheduler::cancel(pitEntry->m_unsatisfyTimer);
-        pitEntry->m_unsatisfyTimer = scheduler::schedule(lastExpiryFromNow,
+        m_timerWheel.cancel(pitEntry->m_unsatisfyTimer);
+        pitEntry->m_unsatisfyTimer = m_timerWheel.schedule(lastExpiryFromNow,
                 bind(&Forwarder::onInterestUnsatisfied, this, pitEntry));
     }
 
@@ -744,20 +801,20 @@ namespace nfd {
 
         time::nanoseconds stragglerTime = time::milliseconds(100);
 
-        scheduler::cancel(pitEntry->m_stragglerTimer);
-        pitEntry->m_stragglerTimer = scheduler::schedule(stragglerTime,
+        m_timerWheel.cancel(pitEntry->m_stragglerTimer);
+        pitEntry->m_stragglerTimer = m_timerWheel.schedule(stragglerTime,
                 bind(&Forwarder::onInterestFinalize, this, pitEntry, isSatisfied, dataFreshnessPeriod));
     }
 
     void
     Forwarder::cancelUnsatisfyAndStragglerTimer(pit::Entry& pitEntry) {
 
-        scheduler::cancel(pitEntry.m_unsatisfyTimer);
-        scheduler::cancel(pitEntry.m_stragglerTimer);
+        m_timerWheel.cancel(pitEntry.m_unsatisfyTimer);
+        m_timerWheel.cancel(pitEntry.m_stragglerTimer);
     }
 
     static inline void
-    insertNonceToDnl(DeadNonceList& dnl, const pit::Entry& pitEntry,
+    insertNonceToDnl(DeadNonceListBase& dnl, const pit::Entry& pitEntry,
             const pit::OutRecord& outRecord) {
 
         dnl.add(pitEntry.getName(), outRecord.getLastNonce());
@@ -772,7 +829,7 @@ namespace nfd {
             bool hasFreshnessPeriod = dataFreshnessPeriod >= time::milliseconds::zero();
             // Data never becomes stale if it doesn't have FreshnessPeriod field
             needDnl = static_cast<bool> (pitEntry.getInterest().getMustBeFresh()) &&
-                    (hasFreshnessPeriod && dataFreshnessPeriod < m_deadNonceList.getLifetime());
+                    (hasFreshnessPeriod && dataFreshnessPeriod < m_deadNonceList->getLifetime());
         } else {
             needDnl = true;
         }
@@ -786,12 +843,12 @@ namespace nfd {
             // insert all outgoing Nonces
             const pit::OutRecordCollection& outRecords = pitEntry.getOutRecords();
             std::for_each(outRecords.begin(), outRecords.end(),
-                    bind(&insertNonceToDnl, ref(m_deadNonceList), cref(pitEntry), _1));
+                    bind(&insertNonceToDnl, ref(*m_deadNonceList), cref(pitEntry), _1));
         } else {
             // insert outgoing Nonce of a specific face
             pit::OutRecordCollection::iterator outRecord = pitEntry.getOutRecord(*upstream);
             if (outRecord != pitEntry.getOutRecords().end()) {
-                m_deadNonceList.add(pitEntry.getName(), outRecord->getLastNonce());
+                m_deadNonceList->add(pitEntry.getName(), outRecord->getLastNonce());
             }
         }
     }
@@ -28,9 +28,11 @@
 
 #include "core/common.hpp"
 #include "core/scheduler.hpp"
+#include "core/timer-wheel.hpp"
 #include "forwarder-counters.hpp"
 #include "face-table.hpp"
 #include "unsolicited-data-policy.hpp"
+#include "multi-access-suppression.hpp"
 #include "table/fib.hpp"
 #include "table/pit.hpp"
 #include "table/cs.hpp"
@@ -118,6 +120,13 @@ namespace nfd {
             m_unsolicitedDataPolicy = std::move(policy);
         }
 
+        /** \brief deferral and suppression of transmissions on multi-access faces
+         */
+        fw::MultiAccessSuppression &
+        getMultiAccessSuppression() {
+            return m_multiAccessSuppression;
+        }
+
     public: // forwarding entrypoints and tables
         /** \brief start incoming Interest processing
          *  \param face face on which Interest is received
@@ -170,9 +179,19 @@ namespace nfd {
             return m_strategyChoice;
         }
 
-        DeadNonceList &
+        DeadNonceListBase &
         getDeadNonceList() {
-            return m_deadNonceList;
+            return *m_deadNonceList;
+        }
+
+        /** \brief replace the Dead Nonce List implementation
+         *
+         *  Entries recorded in the previous Dead Nonce List are discarded.
+         */
+        void
+        setDeadNonceList(unique_ptr<DeadNonceListBase> dnl) {
+            BOOST_ASSERT(dnl != nullptr);
+            m_deadNonceList = std::move(dnl);
         }
 
         NetworkRegionTable &
@@ -180,6 +199,16 @@ namespace nfd {
             return m_networkRegionTable;
         }
 
+        /** \brief timer wheel driving PIT unsatisfy and straggler timers
+         *
+         *  Strategies may schedule their own short-lived per-entry timers on it
+         *  instead of using scheduler::schedule.
+         */
+        scheduler::TimerWheel &
+        getTimerWheel() {
+            return m_timerWheel;
+        }
+
     public: // allow enabling ndnSIM content store (will be removed in the future)
 
         void
@@ -287,6 +316,16 @@ PROTECTED_WITH_TESTS_ELSE_PRIVATE:
         insertDeadNonceList(pit::Entry& pitEntry, bool isSatisfied,
                 time::milliseconds dataFreshnessPeriod, Face * upstream);
 
+        /** \brief account for and send Interest on \p outFace
+         */
+        void
+        transmitInterest(Face& outFace, const Interest& interest);
+
+        /** \brief account for and send Data on \p outFace
+         */
+        void
+        transmitData(Face& outFace, const Data& data);
+
         /** \brief call trigger (method) on the effective strategy of pitEntry
          */
 #ifdef WITH_TESTS
@@ -307,16 +346,19 @@ PROTECTED_WITH_TESTS_ELSE_PRIVATE:
         ns3::Ptr <ns3::Node> m_node;
         FaceTable m_faceTable;
         unique_ptr<fw::UnsolicitedDataPolicy> m_unsolicitedDataPolicy;
+        fw::MultiAccessSuppression m_multiAccessSuppression;
         bool m_conOvrhd_int; //Flag to indicate if current interest contained overhead component.
         bool m_conOvrhd_data; //Flag to indicate if current interest contained overhead component.
         std::vector<std::pair<std::string, std::string>> m_trnsoverhead;
         NameTree m_nameTree;
         Fib m_fib;
         Pit m_pit;
+        // declared after the tables so it is destroyed first: its pending callbacks hold PIT entries
+        scheduler::TimerWheel m_timerWheel;
         Cs m_cs;
         Measurements m_measurements;
         StrategyChoice m_strategyChoice;
-        DeadNonceList m_deadNonceList;
+        unique_ptr<DeadNonceListBase> m_deadNonceList;
         NetworkRegionTable m_networkRegionTable;
         uint64_t m_tx_data_bytes;
         uint64_t m_tx_interest_bytes;
@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "multi-access-suppression.hpp"
+#include "core/logger.hpp"
+#include "core/random.hpp"
+
+namespace nfd {
+    namespace fw {
+
+        NFD_LOG_INIT("MultiAccessSuppression");
+
+        MultiAccessSuppression::~MultiAccessSuppression() {
+            for (const auto& item : m_interests) {
+                scheduler::cancel(item.second);
+            }
+            for (const auto& item : m_data) {
+                scheduler::cancel(item.second);
+            }
+        }
+
+        void
+        MultiAccessSuppression::setOptions(const Options& options) {
+            if (options.minBackoff < time::nanoseconds::zero() || options.maxBackoff < options.minBackoff) {
+                BOOST_THROW_EXCEPTION(std::invalid_argument("backoff interval is invalid"));
+            }
+            m_options = options;
+        }
+
+        bool
+        MultiAccessSuppression::shouldDefer(const Face& outFace, bool isData) const {
+            return m_options.isEnabled && (!isData || m_options.deferData) &&
+                    outFace.getLinkType() == ndn::nfd::LINK_TYPE_MULTI_ACCESS;
+        }
+
+        void
+        MultiAccessSuppression::deferInterest(const Face& outFace, const Name& name,
+                const std::function<void()>& send) {
+            ++m_counters.nDeferredInterests;
+            this->defer(m_interests, outFace, name, send);
+        }
+
+        void
+        MultiAccessSuppression::deferData(const Face& outFace, const Name& name,
+                const std::function<void()>& send) {
+            ++m_counters.nDeferredData;
+            this->defer(m_data, outFace, name, send);
+        }
+
+        void
+        MultiAccessSuppression::defer(Table& table, const Face& outFace, const Name& name,
+                const std::function<void()>& send) {
+            std::uniform_int_distribution<time::nanoseconds::rep> dist(m_options.minBackoff.count(),
+                    m_options.maxBackoff.count());
+            time::nanoseconds backoff(dist(getGlobalRng()));
+
+            auto key = std::make_pair(outFace.getId(), name);
+            scheduler::EventId& event = table[key];
+            scheduler::cancel(event);
+            event = scheduler::schedule(backoff, [&table, key, send] {
+                table.erase(key);
+                send();
+            });
+
+            NFD_LOG_DEBUG("defer face=" << outFace.getId() << " name=" << name << " backoff=" << backoff);
+        }
+
+        bool
+        MultiAccessSuppression::cancel(Table& table, FaceId faceId, const Name& name) {
+            auto it = table.find(std::make_pair(faceId, name));
+            if (it == table.end()) {
+                return false;
+            }
+            scheduler::cancel(it->second);
+            table.erase(it);
+            return true;
+        }
+
+        void
+        MultiAccessSuppression::overhearInterest(const Face& inFace, const Name& name) {
+            if (this->cancel(m_interests, inFace.getId(), name)) {
+                ++m_counters.nSuppressedInterests;
+                NFD_LOG_DEBUG("suppress-interest face=" << inFace.getId() << " name=" << name);
+            }
+        }
+
+        void
+        MultiAccessSuppression::overhearData(const Face& inFace, const Name& name) {
+            if (this->cancel(m_data, inFace.getId(), name)) {
+                ++m_counters.nSuppressedData;
+                NFD_LOG_DEBUG("suppress-data face=" << inFace.getId() << " name=" << name);
+            }
+
+            if (m_interests.empty()) {
+                return;
+            }
+            // a pending Interest is satisfied by this Data if its name is a prefix of the Data name
+            for (size_t prefixLen = 0; prefixLen <= name.size(); ++prefixLen) {
+                if (this->cancel(m_interests, inFace.getId(), name.getPrefix(prefixLen))) {
+                    ++m_counters.nSuppressedInterests;
+                    NFD_LOG_DEBUG("suppress-interest face=" << inFace.getId() <<
+                            " name=" << name.getPrefix(prefixLen) << " by-data");
+                }
+            }
+        }
+
+    } // namespace fw
+} // namespace nfd
@@ -0,0 +1,145 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_FW_MULTI_ACCESS_SUPPRESSION_HPP
+#define NFD_DAEMON_FW_MULTI_ACCESS_SUPPRESSION_HPP
+
+#include "core/counter.hpp"
+#include "core/scheduler.hpp"
+#include "face/face.hpp"
+
+namespace nfd {
+    namespace fw {
+
+        /** \brief defers transmissions on multi-access faces and suppresses them when overheard
+         *
+         *  On a broadcast medium every neighbor receives every Interest and Data. When enabled,
+         *  an Interest or Data to be sent on a LINK_TYPE_MULTI_ACCESS face is held for a random
+         *  backoff in [minBackoff, maxBackoff]. If during the backoff the same Interest, or a
+         *  Data satisfying it, is received on that face, another node has already transmitted it
+         *  and the pending transmission is cancelled.
+         */
+        class MultiAccessSuppression : noncopyable {
+        public:
+            struct Options {
+                /// whether transmissions on multi-access faces are deferred at all
+                bool isEnabled = false;
+
+                time::nanoseconds minBackoff = time::nanoseconds::zero();
+                time::nanoseconds maxBackoff = time::milliseconds(10);
+
+                /// whether Data is deferred in addition to Interests
+                bool deferData = true;
+            };
+
+            class Counters {
+            public:
+                PacketCounter nDeferredInterests;
+                PacketCounter nSuppressedInterests;
+                PacketCounter nDeferredData;
+                PacketCounter nSuppressedData;
+                /// unsolicited Data received on multi-access faces and admitted into the CS
+                PacketCounter nCachedOverheardData;
+            };
+
+            MultiAccessSuppression() = default;
+
+            ~MultiAccessSuppression();
+
+            const Options&
+            getOptions() const {
+                return m_options;
+            }
+
+            void
+            setOptions(const Options& options);
+
+            const Counters&
+            getCounters() const {
+                return m_counters;
+            }
+
+            /** \return whether a transmission on \p outFace should be deferred
+             */
+            bool
+            shouldDefer(const Face& outFace, bool isData) const;
+
+            /** \brief schedules \p send after a random backoff
+             *
+             *  A pending Interest for the same name on the same face is replaced.
+             */
+            void
+            deferInterest(const Face& outFace, const Name& name, const std::function<void()>& send);
+
+            /** \brief schedules \p send after a random backoff
+             *
+             *  A pending Data with the same name on the same face is replaced.
+             */
+            void
+            deferData(const Face& outFace, const Name& name, const std::function<void()>& send);
+
+            /** \brief cancels pending Interests with \p name on \p inFace
+             */
+            void
+            overhearInterest(const Face& inFace, const Name& name);
+
+            /** \brief cancels pending Data with \p name on \p inFace,
+             *         and pending Interests on \p inFace that it satisfies
+             */
+            void
+            overhearData(const Face& inFace, const Name& name);
+
+            void
+            afterCacheOverheardData() {
+                ++m_counters.nCachedOverheardData;
+            }
+
+            /** \return number of pending transmissions
+             */
+            size_t
+            size() const {
+                return m_interests.size() + m_data.size();
+            }
+
+        private:
+            typedef std::map<std::pair<FaceId, Name>, scheduler::EventId> Table;
+
+            void
+            defer(Table& table, const Face& outFace, const Name& name, const std::function<void()>& send);
+
+            bool
+            cancel(Table& table, FaceId faceId, const Name& name);
+
+        private:
+            Options m_options;
+            Counters m_counters;
+            Table m_interests;
+            Table m_data;
+        };
+
+    } // namespace fw
+} // namespace nfd
+
+#endif // NFD_DAEMON_FW_MULTI_ACCESS_SUPPRESSION_HPP
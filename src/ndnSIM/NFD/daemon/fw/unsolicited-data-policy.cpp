@@ -79,6 +79,16 @@ namespace nfd {
             return UnsolicitedDataDecision::DROP;
         }
 
+        NFD_REGISTER_UNSOLICITED_DATA_POLICY(AdmitMultiAccessUnsolicitedDataPolicy, "admit-multi-access");
+
+        UnsolicitedDataDecision
+        AdmitMultiAccessUnsolicitedDataPolicy::decide(const Face& inFace, const Data& data) const {
+            if (inFace.getLinkType() == ndn::nfd::LINK_TYPE_MULTI_ACCESS) {
+                return UnsolicitedDataDecision::CACHE;
+            }
+            return UnsolicitedDataDecision::DROP;
+        }
+
         NFD_REGISTER_UNSOLICITED_DATA_POLICY(AdmitAllUnsolicitedDataPolicy, "admit-all");
 
         UnsolicitedDataDecision
@@ -103,6 +103,17 @@ namespace nfd {
             decide(const Face& inFace, const Data& data) const final;
         };
 
+        /** \brief admits unsolicited Data overheard on multi-access faces
+         *
+         *  On a broadcast medium, Data requested by a neighbor is received by every node;
+         *  caching it lets later local requests be answered without another transmission.
+         */
+        class AdmitMultiAccessUnsolicitedDataPolicy : public UnsolicitedDataPolicy {
+        public:
+            virtual UnsolicitedDataDecision
+            decide(const Face& inFace, const Data& data) const final;
+        };
+
         /** \brief admits all unsolicited Data
          */
         class AdmitAllUnsolicitedDataPolicy : public UnsolicitedDataPolicy {
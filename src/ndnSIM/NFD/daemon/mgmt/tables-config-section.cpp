@@ -24,6 +24,7 @@
  */
 
 #include "tables-config-section.hpp"
+#include "table/dead-nonce-list-cuckoo.hpp"
 
 namespace nfd {
 
@@ -85,6 +86,18 @@ namespace nfd {
             processNetworkRegionSection(*networkRegionSection, isDryRun);
         }
 
+        unique_ptr<DeadNonceListBase> deadNonceList;
+        OptionalNode deadNonceListSection = section.get_child_optional("dead_nonce_list");
+        if (deadNonceListSection) {
+            deadNonceList = processDeadNonceListSection(*deadNonceListSection);
+        }
+
+        fw::MultiAccessSuppression::Options suppressionOptions;
+        OptionalNode suppressionSection = section.get_child_optional("multi_access_suppression");
+        if (suppressionSection) {
+            suppressionOptions = processMultiAccessSuppressionSection(*suppressionSection);
+        }
+
         if (isDryRun) {
             return;
         }
@@ -93,6 +106,12 @@ namespace nfd {
 
         m_forwarder.setUnsolicitedDataPolicy(std::move(unsolicitedDataPolicy));
 
+        if (deadNonceList != nullptr) {
+            m_forwarder.setDeadNonceList(std::move(deadNonceList));
+        }
+
+        m_forwarder.getMultiAccessSuppression().setOptions(suppressionOptions);
+
         m_isConfigured = true;
     }
 
@@ -146,4 +165,73 @@ namespace nfd {
         }
     }
 
+    unique_ptr<DeadNonceListBase>
+    TablesConfigSection::processDeadNonceListSection(const ConfigSection& section) {
+        std::string type = section.get<std::string>("type", "classic");
+
+        time::nanoseconds lifetime = DeadNonceList::DEFAULT_LIFETIME;
+        boost::optional<const ConfigSection&> lifetimeNode = section.get_child_optional("lifetime");
+        if (lifetimeNode) {
+            lifetime = time::milliseconds(
+                    ConfigFile::parseNumber<uint32_t>(*lifetimeNode, "lifetime", "tables.dead_nonce_list"));
+        }
+
+        try {
+            if (type == "classic") {
+                return make_unique<DeadNonceList>(lifetime);
+            }
+
+            if (type == "cuckoo") {
+                size_t capacity = CuckooDeadNonceList::DEFAULT_CAPACITY;
+                double fpRate = CuckooDeadNonceList::DEFAULT_FALSE_POSITIVE_RATE;
+                size_t nGenerations = CuckooDeadNonceList::DEFAULT_N_GENERATIONS;
+                for (const auto& option : section) {
+                    if (option.first == "capacity") {
+                        capacity = ConfigFile::parseNumber<size_t>(option, "tables.dead_nonce_list");
+                    } else if (option.first == "false_positive_rate") {
+                        fpRate = ConfigFile::parseNumber<double>(option, "tables.dead_nonce_list");
+                    } else if (option.first == "generations") {
+                        nGenerations = ConfigFile::parseNumber<size_t>(option, "tables.dead_nonce_list");
+                    }
+                }
+                return make_unique<CuckooDeadNonceList>(capacity, fpRate, lifetime, nGenerations);
+            }
+        } catch (const std::invalid_argument& e) {
+            BOOST_THROW_EXCEPTION(ConfigFile::Error(
+                    std::string("Invalid \"dead_nonce_list\" section: ") + e.what()));
+        }
+
+        BOOST_THROW_EXCEPTION(ConfigFile::Error(
+                "Unknown dead_nonce_list type \"" + type + "\" in \"tables\" section"));
+    }
+
+    fw::MultiAccessSuppression::Options
+    TablesConfigSection::processMultiAccessSuppressionSection(const ConfigSection& section) {
+        fw::MultiAccessSuppression::Options options;
+        options.isEnabled = true;
+
+        for (const auto& option : section) {
+            if (option.first == "enabled") {
+                options.isEnabled = ConfigFile::parseYesNo(option, "tables.multi_access_suppression");
+            } else if (option.first == "min_backoff") {
+                options.minBackoff = time::milliseconds(
+                        ConfigFile::parseNumber<uint32_t>(option, "tables.multi_access_suppression"));
+            } else if (option.first == "max_backoff") {
+                options.maxBackoff = time::milliseconds(
+                        ConfigFile::parseNumber<uint32_t>(option, "tables.multi_access_suppression"));
+            } else if (option.first == "defer_data") {
+                options.deferData = ConfigFile::parseYesNo(option, "tables.multi_access_suppression");
+            } else {
+                BOOST_THROW_EXCEPTION(ConfigFile::Error(
+                        "Unrecognized option \"" + option.first + "\" in \"multi_access_suppression\" section"));
+            }
+        }
+
+        if (options.maxBackoff < options.minBackoff) {
+            BOOST_THROW_EXCEPTION(ConfigFile::Error(
+                    "max_backoff is less than min_backoff in \"multi_access_suppression\" section"));
+        }
+        return options;
+    }
+
 } // namespace nfd
@@ -54,6 +54,23 @@ namespace nfd {
      *      /example/region1
      *      /example/region2
      *    }
+     *
+     *    dead_nonce_list
+     *    {
+     *      type cuckoo              ; classic or cuckoo
+     *      lifetime 6000            ; milliseconds
+     *      capacity 16384           ; cuckoo only: Nonces expected per lifetime
+     *      false_positive_rate 0.001 ; cuckoo only
+     *      generations 4            ; cuckoo only: filters in rotation
+     *    }
+     *
+     *    multi_access_suppression
+     *    {
+     *      enabled yes
+     *      min_backoff 0            ; milliseconds
+     *      max_backoff 10           ; milliseconds
+     *      defer_data yes
+     *    }
      *  }
      *  \endcode
      *
@@ -62,6 +79,9 @@ namespace nfd {
      *      defaults are used if an option is omitted.
      *  \li strategy_choice entries are inserted, but old entries are not deleted.
      *  \li network_region is applied; it's kept unchanged if the section is omitted.
+     *  \li dead_nonce_list replaces the Dead Nonce List, discarding its entries;
+     *      it's kept unchanged if the section is omitted.
+     *  \li multi_access_suppression is applied; it's disabled if the section is omitted.
      *
      *  It's necessary to call \p ensureConfigured() after initial configuration and
      *  configuration reload, so that the correct defaults are applied in case
@@ -90,6 +110,12 @@ namespace nfd {
         void
         processNetworkRegionSection(const ConfigSection& section, bool isDryRun);
 
+        unique_ptr<DeadNonceListBase>
+        processDeadNonceListSection(const ConfigSection& section);
+
+        fw::MultiAccessSuppression::Options
+        processMultiAccessSuppressionSection(const ConfigSection& section);
+
     private:
         static const size_t DEFAULT_CS_MAX_PACKETS;
 
@@ -0,0 +1,266 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "dead-nonce-list-cuckoo.hpp"
+#include "core/city-hash.hpp"
+#include "core/logger.hpp"
+
+#include <cmath>
+
+NFD_LOG_INIT("CuckooDeadNonceList");
+
+namespace nfd {
+
+    const size_t CuckooDeadNonceList::DEFAULT_CAPACITY = (1 << 14);
+    const double CuckooDeadNonceList::DEFAULT_FALSE_POSITIVE_RATE = 0.001;
+    const size_t CuckooDeadNonceList::DEFAULT_N_GENERATIONS = 4;
+    const size_t CuckooDeadNonceList::BUCKET_SIZE;
+    const size_t CuckooDeadNonceList::MAX_KICKS;
+
+    /// target load factor of a filter at its expected occupancy
+    static const double TARGET_LOAD = 0.95;
+
+    CuckooDeadNonceList::CuckooDeadNonceList(size_t capacity, double falsePositiveRate,
+            const time::nanoseconds& lifetime, size_t nGenerations)
+    : m_lifetime(lifetime)
+    , m_head(0)
+    , m_nOverflows(0)
+    , m_rng(0x9e3779b9) {
+        if (m_lifetime < DeadNonceList::MIN_LIFETIME) {
+            BOOST_THROW_EXCEPTION(std::invalid_argument("lifetime is less than MIN_LIFETIME"));
+        }
+        if (capacity == 0) {
+            BOOST_THROW_EXCEPTION(std::invalid_argument("capacity must be positive"));
+        }
+        if (!(falsePositiveRate > 0.0 && falsePositiveRate < 1.0)) {
+            BOOST_THROW_EXCEPTION(std::invalid_argument("falsePositiveRate must be in (0,1)"));
+        }
+        if (nGenerations < 2) {
+            BOOST_THROW_EXCEPTION(std::invalid_argument("nGenerations must be at least 2"));
+        }
+
+        m_generationInterval = m_lifetime / (nGenerations - 1);
+        if (m_lifetime % (nGenerations - 1) != time::nanoseconds::zero()) {
+            m_generationInterval += time::nanoseconds(1);
+        }
+
+        // a lookup probes 2 * BUCKET_SIZE slots, each matching with probability 2^-f
+        double bits = std::ceil(std::log2(2.0 * BUCKET_SIZE / falsePositiveRate));
+        m_fpBits = static_cast<size_t> (std::min(32.0, std::max(4.0, bits)));
+        m_fpMask = m_fpBits == 32 ? 0xFFFFFFFF : ((static_cast<Fingerprint> (1) << m_fpBits) - 1);
+
+        size_t perGeneration = (capacity + nGenerations - 2) / (nGenerations - 1);
+        size_t minBuckets = static_cast<size_t> (std::ceil(perGeneration / (BUCKET_SIZE * TARGET_LOAD)));
+        size_t nBuckets = 1;
+        while (nBuckets < minBuckets) {
+            nBuckets <<= 1;
+        }
+        m_bucketMask = nBuckets - 1;
+
+        size_t nWords = (nBuckets * BUCKET_SIZE * m_fpBits + 63) / 64;
+        m_filters.resize(nGenerations);
+        for (Filter& filter : m_filters) {
+            filter.slots.assign(nWords, 0);
+            filter.generation = -1;
+            filter.size = 0;
+        }
+
+        NFD_LOG_DEBUG("generations=" << nGenerations << " buckets=" << nBuckets <<
+                " fingerprint-bits=" << m_fpBits);
+    }
+
+    void
+    CuckooDeadNonceList::hashEntry(const Name& name, uint32_t nonce,
+            size_t& bucket, Fingerprint& fp) const {
+        const Block& nameWire = name.wireEncode();
+        uint64_t h = CityHash64WithSeed(reinterpret_cast<const char*> (nameWire.wire()), nameWire.size(),
+                static_cast<uint64_t> (nonce));
+        bucket = static_cast<size_t> (h) & m_bucketMask;
+        fp = static_cast<Fingerprint> (h >> 32) & m_fpMask;
+        if (fp == 0) {
+            fp = 1;
+        }
+    }
+
+    size_t
+    CuckooDeadNonceList::altBucket(size_t bucket, Fingerprint fp) const {
+        // XOR with a hash of the fingerprint is an involution, so either bucket yields the other
+        return (bucket ^ static_cast<size_t> (fp * 0x5bd1e995U)) & m_bucketMask;
+    }
+
+    int64_t
+    CuckooDeadNonceList::currentGeneration() const {
+        return time::steady_clock::now().time_since_epoch() / m_generationInterval;
+    }
+
+    bool
+    CuckooDeadNonceList::isLive(const Filter& filter, int64_t now) const {
+        return filter.generation >= 0 &&
+                now - filter.generation < static_cast<int64_t> (m_filters.size());
+    }
+
+    CuckooDeadNonceList::Fingerprint
+    CuckooDeadNonceList::getSlot(const Filter& filter, size_t index) const {
+        size_t bit = index * m_fpBits;
+        size_t word = bit / 64;
+        size_t offset = bit % 64;
+        uint64_t value = filter.slots[word] >> offset;
+        if (offset + m_fpBits > 64) {
+            // the slot straddles two words
+            value |= filter.slots[word + 1] << (64 - offset);
+        }
+        return static_cast<Fingerprint> (value) & m_fpMask;
+    }
+
+    void
+    CuckooDeadNonceList::setSlot(Filter& filter, size_t index, Fingerprint fp) const {
+        size_t bit = index * m_fpBits;
+        size_t word = bit / 64;
+        size_t offset = bit % 64;
+        uint64_t mask = static_cast<uint64_t> (m_fpMask);
+        filter.slots[word] = (filter.slots[word] & ~(mask << offset)) | (static_cast<uint64_t> (fp) << offset);
+        if (offset + m_fpBits > 64) {
+            size_t shift = 64 - offset;
+            filter.slots[word + 1] = (filter.slots[word + 1] & ~(mask >> shift)) |
+                    (static_cast<uint64_t> (fp) >> shift);
+        }
+    }
+
+    bool
+    CuckooDeadNonceList::contains(const Filter& filter, size_t bucket, Fingerprint fp) const {
+        size_t bucket2 = this->altBucket(bucket, fp);
+        for (size_t i = 0; i < BUCKET_SIZE; ++i) {
+            if (this->getSlot(filter, bucket * BUCKET_SIZE + i) == fp ||
+                    this->getSlot(filter, bucket2 * BUCKET_SIZE + i) == fp) {
+                return true;
+            }
+        }
+        for (const auto& stashed : filter.stash) {
+            if (stashed.second == fp && (stashed.first == bucket || stashed.first == bucket2)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool
+    CuckooDeadNonceList::insertSlot(Filter& filter, size_t bucket, Fingerprint fp) {
+        for (size_t i = 0; i < BUCKET_SIZE; ++i) {
+            if (this->getSlot(filter, bucket * BUCKET_SIZE + i) == 0) {
+                this->setSlot(filter, bucket * BUCKET_SIZE + i, fp);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void
+    CuckooDeadNonceList::insert(Filter& filter, size_t bucket, Fingerprint fp) {
+        ++filter.size;
+        if (this->insertSlot(filter, bucket, fp)) {
+            return;
+        }
+        bucket = this->altBucket(bucket, fp);
+        if (this->insertSlot(filter, bucket, fp)) {
+            return;
+        }
+
+        for (size_t n = 0; n < MAX_KICKS; ++n) {
+            // xorshift32
+            m_rng ^= m_rng << 13;
+            m_rng ^= m_rng >> 17;
+            m_rng ^= m_rng << 5;
+
+            size_t victim = bucket * BUCKET_SIZE + m_rng % BUCKET_SIZE;
+            Fingerprint evicted = this->getSlot(filter, victim);
+            this->setSlot(filter, victim, fp);
+            fp = evicted;
+            bucket = this->altBucket(bucket, fp);
+            if (this->insertSlot(filter, bucket, fp)) {
+                return;
+            }
+        }
+
+        filter.stash.emplace_back(bucket, fp);
+        ++m_nOverflows;
+        NFD_LOG_DEBUG("filter overflow, stash=" << filter.stash.size());
+    }
+
+    void
+    CuckooDeadNonceList::rotate(int64_t now) {
+        if (m_filters[m_head].generation == now) {
+            return;
+        }
+
+        // the filter following the head is the oldest one
+        m_head = (m_head + 1) % m_filters.size();
+        Filter& filter = m_filters[m_head];
+        std::fill(filter.slots.begin(), filter.slots.end(), 0);
+        filter.stash.clear();
+        filter.generation = now;
+        filter.size = 0;
+    }
+
+    bool
+    CuckooDeadNonceList::has(const Name& name, uint32_t nonce) const {
+        size_t bucket = 0;
+        Fingerprint fp = 0;
+        this->hashEntry(name, nonce, bucket, fp);
+
+        int64_t now = this->currentGeneration();
+        for (const Filter& filter : m_filters) {
+            if (this->isLive(filter, now) && this->contains(filter, bucket, fp)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void
+    CuckooDeadNonceList::add(const Name& name, uint32_t nonce) {
+        size_t bucket = 0;
+        Fingerprint fp = 0;
+        this->hashEntry(name, nonce, bucket, fp);
+
+        this->rotate(this->currentGeneration());
+        Filter& head = m_filters[m_head];
+        if (!this->contains(head, bucket, fp)) {
+            this->insert(head, bucket, fp);
+        }
+    }
+
+    size_t
+    CuckooDeadNonceList::size() const {
+        int64_t now = this->currentGeneration();
+        size_t n = 0;
+        for (const Filter& filter : m_filters) {
+            if (this->isLive(filter, now)) {
+                n += filter.size;
+            }
+        }
+        return n;
+    }
+
+} // namespace nfd
@@ -0,0 +1,183 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2014-2016,  Regents of the University of California,
+ *                           Arizona Board of Regents,
+ *                           Colorado State University,
+ *                           University Pierre & Marie Curie, Sorbonne University,
+ *                           Washington University in St. Louis,
+ *                           Beijing Institute of Technology,
+ *                           The University of Memphis.
+ *
+ * This file is part of NFD (Named Data Networking Forwarding Daemon).
+ * See AUTHORS.md for complete list of NFD authors and contributors.
+ *
+ * NFD is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NFD is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NFD, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NFD_DAEMON_TABLE_DEAD_NONCE_LIST_CUCKOO_HPP
+#define NFD_DAEMON_TABLE_DEAD_NONCE_LIST_CUCKOO_HPP
+
+#include "dead-nonce-list.hpp"
+
+namespace nfd {
+
+    /** \brief Dead Nonce List backed by rotating cuckoo filters
+     *
+     *  Entries are kept in \p nGenerations cuckoo filters; each filter covers
+     *  lifetime / (nGenerations - 1) of simulated time. When the clock enters a new
+     *  generation the oldest filter is cleared and reused, so an entry is remembered for
+     *  at least \p lifetime and at most lifetime * nGenerations / (nGenerations - 1).
+     *  Rotation is computed from time::steady_clock on access; no events are scheduled.
+     *
+     *  Each filter has 4 slots per bucket and stores a fingerprint of
+     *  ceil(log2(8 / falsePositiveRate)) bits, so the false positive rate of a lookup is
+     *  bounded by about falsePositiveRate per live generation. Slots are bit-packed at that
+     *  width, e.g. 13 bits for the default rate of 0.1%. There are no false negatives:
+     *  a fingerprint that cannot be placed after MAX_KICKS relocations is kept in a
+     *  per-filter stash and counted in getNOverflows().
+     *
+     *  Memory use is fixed at construction and does not depend on Name length.
+     */
+    class CuckooDeadNonceList : public DeadNonceListBase {
+    public:
+        /** \brief constructs the Dead Nonce List
+         *  \param capacity expected number of Nonces inserted within \p lifetime
+         *  \param falsePositiveRate target false positive rate of one filter, in (0,1)
+         *  \param lifetime minimum lifetime of an entry
+         *  \param nGenerations number of filters in rotation, at least 2
+         *  \throw std::invalid_argument a parameter is out of range
+         */
+        explicit
+        CuckooDeadNonceList(size_t capacity = DEFAULT_CAPACITY,
+                double falsePositiveRate = DEFAULT_FALSE_POSITIVE_RATE,
+                const time::nanoseconds& lifetime = DeadNonceList::DEFAULT_LIFETIME,
+                size_t nGenerations = DEFAULT_N_GENERATIONS);
+
+        bool
+        has(const Name& name, uint32_t nonce) const override;
+
+        void
+        add(const Name& name, uint32_t nonce) override;
+
+        /** \return number of fingerprints stored in live generations
+         */
+        size_t
+        size() const override;
+
+        const time::nanoseconds&
+        getLifetime() const override {
+            return m_lifetime;
+        }
+
+        /** \return number of bits in a fingerprint
+         */
+        size_t
+        getFingerprintBits() const {
+            return m_fpBits;
+        }
+
+        /** \return number of buckets in each filter
+         */
+        size_t
+        getNBucketsPerFilter() const {
+            return m_bucketMask + 1;
+        }
+
+        /** \return number of bytes of slots in each filter, excluding the stash
+         */
+        size_t
+        getNBytesPerFilter() const {
+            return m_filters.front().slots.size() * sizeof(uint64_t);
+        }
+
+        /** \return number of insertions that ended in the overflow stash
+         */
+        uint64_t
+        getNOverflows() const {
+            return m_nOverflows;
+        }
+
+    public:
+        static const size_t DEFAULT_CAPACITY;
+        static const double DEFAULT_FALSE_POSITIVE_RATE;
+        static const size_t DEFAULT_N_GENERATIONS;
+
+        /// slots per bucket
+        static const size_t BUCKET_SIZE = 4;
+
+        /// maximum number of relocations during one insertion
+        static const size_t MAX_KICKS = 500;
+
+    private:
+        typedef uint32_t Fingerprint;
+
+        /** \brief one generation
+         */
+        struct Filter {
+            /// BUCKET_SIZE slots of m_fpBits bits per bucket packed into words, zero means empty
+            std::vector<uint64_t> slots;
+            /// (bucket, fingerprint) that could not be placed
+            std::vector<std::pair<size_t, Fingerprint>> stash;
+            /// generation number, or -1 if unused
+            int64_t generation;
+            size_t size;
+        };
+
+        void
+        hashEntry(const Name& name, uint32_t nonce, size_t& bucket, Fingerprint& fp) const;
+
+        size_t
+        altBucket(size_t bucket, Fingerprint fp) const;
+
+        int64_t
+        currentGeneration() const;
+
+        bool
+        isLive(const Filter& filter, int64_t now) const;
+
+        /** \return fingerprint in slot \p index of \p filter
+         */
+        Fingerprint
+        getSlot(const Filter& filter, size_t index) const;
+
+        void
+        setSlot(Filter& filter, size_t index, Fingerprint fp) const;
+
+        bool
+        contains(const Filter& filter, size_t bucket, Fingerprint fp) const;
+
+        bool
+        insertSlot(Filter& filter, size_t bucket, Fingerprint fp);
+
+        void
+        insert(Filter& filter, size_t bucket, Fingerprint fp);
+
+        /** \brief make the head filter correspond to generation \p now
+         */
+        void
+        rotate(int64_t now);
+
+    private:
+        time::nanoseconds m_lifetime;
+        time::nanoseconds m_generationInterval;
+        size_t m_fpBits;
+        Fingerprint m_fpMask;
+        size_t m_bucketMask;
+        std::vector<Filter> m_filters;
+        size_t m_head;
+        uint64_t m_nOverflows;
+        uint32_t m_rng;
+    };
+
+} // namespace nfd
+
+#endif // NFD_DAEMON_TABLE_DEAD_NONCE_LIST_CUCKOO_HPP
@@ -34,6 +34,39 @@
 
 namespace nfd {
 
+    /** \brief interface of a Dead Nonce List implementation
+     *
+     *  The Forwarder accesses the Dead Nonce List only through this interface,
+     *  so that the implementation can be chosen per forwarder.
+     *  \sa DeadNonceList, CuckooDeadNonceList
+     */
+    class DeadNonceListBase : noncopyable {
+    public:
+        virtual
+        ~DeadNonceListBase() = default;
+
+        /** \brief determines if name+nonce exists
+         *  \return true if name+nonce exists
+         */
+        virtual bool
+        has(const Name& name, uint32_t nonce) const = 0;
+
+        /** \brief records name+nonce
+         */
+        virtual void
+        add(const Name& name, uint32_t nonce) = 0;
+
+        /** \return number of stored Nonces
+         */
+        virtual size_t
+        size() const = 0;
+
+        /** \return expected lifetime
+         */
+        virtual const time::nanoseconds&
+        getLifetime() const = 0;
+    };
+
     /** \brief represents the Dead Nonce list
      *
      *  The Dead Nonce List is a global table that supplements PIT for loop detection.
@@ -51,7 +84,7 @@ namespace nfd {
      *  The number of MARKs stored in the container reflects the lifetime of entries,
      *  because MARKs are inserted at fixed intervals.
      */
-    class DeadNonceList : noncopyable {
+    class DeadNonceList : public DeadNonceListBase {
     public:
         /** \brief constructs the Dead Nonce List
          *  \param lifetime duration of the expected lifetime of each nonce,
@@ -63,29 +96,29 @@ namespace nfd {
         explicit
         DeadNonceList(const time::nanoseconds& lifetime = DEFAULT_LIFETIME);
 
-        ~DeadNonceList();
+        ~DeadNonceList() override;
 
         /** \brief determines if name+nonce exists
          *  \return true if name+nonce exists
          */
         bool
-        has(const Name& name, uint32_t nonce) const;
+        has(const Name& name, uint32_t nonce) const override;
 
         /** \brief records name+nonce
          */
         void
-        add(const Name& name, uint32_t nonce);
+        add(const Name& name, uint32_t nonce) override;
 
         /** \return number of stored Nonces
          *  \note The return value does not contain non-Nonce entries in the index, if any.
          */
         size_t
-        size() const;
+        size() const override;
 
         /** \return expected lifetime
          */
         const time::nanoseconds&
-        getLifetime() const;
+        getLifetime() const override;
 
     private: // Entry and Index
         typedef uint64_t Entry;
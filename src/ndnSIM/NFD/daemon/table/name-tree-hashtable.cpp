@@ -25,62 +25,105 @@
 
 #include "name-tree-hashtable.hpp"
 #include "core/logger.hpp"
-#include "core/city-hash.hpp"
+
+#include <cstring>
 
 namespace nfd {
     namespace name_tree {
 
         NFD_LOG_INIT("NameTreeHashtable");
 
-        class Hash32 {
+        /** \brief streaming hash over the TLV of successive name components
+         *
+         *  The state after absorbing a component is a complete hash value, so the hash of every
+         *  prefix is available as soon as its last component has been absorbed. Input is consumed
+         *  in 8-byte words, which keeps the inner loop free of per-byte branches.
+         */
+        class PrefixHasher {
         public:
 
-            static HashValue
-            compute(const void* buffer, size_t length) {
-                return static_cast<HashValue> (CityHash32(reinterpret_cast<const char*> (buffer), length));
+            static uint64_t
+            absorb(uint64_t state, const uint8_t* buffer, size_t length) {
+                uint64_t h = (state ^ SEED) + length * PRIME2;
+                const uint8_t* end = buffer + (length & ~static_cast<size_t> (7));
+                for (; buffer != end; buffer += 8) {
+                    uint64_t word;
+                    std::memcpy(&word, buffer, 8);
+                    h = rotl(h ^ (word * PRIME1), 31) * PRIME2;
+                }
+
+                size_t tailLength = length & 7;
+                if (tailLength > 0) {
+                    uint64_t word = 0;
+                    std::memcpy(&word, buffer, tailLength);
+                    h = rotl(h ^ (word * PRIME1), 31) * PRIME2;
+                }
+                return finalize(h);
             }
-        };
 
-        class Hash64 {
-        public:
+        private:
 
-            static HashValue
-            compute(const void* buffer, size_t length) {
-                return static_cast<HashValue> (CityHash64(reinterpret_cast<const char*> (buffer), length));
+            static uint64_t
+            rotl(uint64_t x, int r) {
+                return (x << r) | (x >> (64 - r));
             }
-        };
 
-        /** \brief a type with compute static method to compute hash value from a raw buffer
-         */
-        typedef std::conditional<(sizeof (HashValue) > 4), Hash64, Hash32>::type HashFunc;
+            /** \brief 64-bit finalizer of MurmurHash3
+             */
+            static uint64_t
+            finalize(uint64_t h) {
+                h ^= h >> 33;
+                h *= 0xff51afd7ed558ccdULL;
+                h ^= h >> 33;
+                h *= 0xc4ceb9fe1a85ec53ULL;
+                h ^= h >> 33;
+                return h;
+            }
+
+        private:
+            static const uint64_t SEED = 0x9e3779b97f4a7c15ULL;
+            static const uint64_t PRIME1 = 0x87c37b91114253d5ULL;
+            static const uint64_t PRIME2 = 0x4cf5ad432745937fULL;
+        };
 
         HashValue
         computeHash(const Name& name, ssize_t prefixLen) {
             name.wireEncode(); // ensure wire buffer exists
 
-            HashValue h = 0;
+            uint64_t h = 0;
             for (size_t i = 0, last = prefixLen < 0 ? name.size() : prefixLen; i < last; ++i) {
                 const name::Component& comp = name[i];
-                h ^= HashFunc::compute(comp.wire(), comp.size());
+                h = PrefixHasher::absorb(h, comp.wire(), comp.size());
             }
-            return h;
+            return static_cast<HashValue> (h);
         }
 
         HashSequence
         computeHashes(const Name& name) {
+            HashSequence seq;
+            computeHashes(name, seq);
+            return seq;
+        }
+
+        void
+        computeHashes(const Name& name, HashSequence& seq) {
             name.wireEncode(); // ensure wire buffer exists
 
-            HashSequence seq;
+            seq.clear();
             seq.reserve(name.size() + 1);
 
-            HashValue h = 0;
-            seq.push_back(h);
+            uint64_t h = 0;
+            seq.push_back(static_cast<HashValue> (h));
 
             for (const name::Component& comp : name) {
-                h ^= HashFunc::compute(comp.wire(), comp.size());
-                seq.push_back(h);
+                h = PrefixHasher::absorb(h, comp.wire(), comp.size());
+                seq.push_back(static_cast<HashValue> (h));
             }
-            return seq;
+        }
+
+        HashSequenceTag::HashSequenceTag(const Block& nameWire, HashSequence hashes)
+        : m_nameWire(nameWire)
+        , m_hashes(std::move(hashes)) {
         }
 
         Node::Node(HashValue h, const Name& name)
@@ -28,6 +28,8 @@
 
 #include "name-tree-entry.hpp"
 
+#include <ndn-cxx/tag.hpp>
+
 namespace nfd {
     namespace name_tree {
 
@@ -56,6 +58,87 @@ namespace nfd {
         HashSequence
         computeHashes(const Name& name);
 
+        /** \brief computes hash values for each prefix of name into a caller-owned buffer
+         *  \param[out] seq cleared and refilled; its capacity is reused between calls
+         *  \post seq == computeHashes(name)
+         *
+         *  All prefix hashes are produced in a single pass over the components of the Name
+         *  wire encoding, the hash of each prefix being the running state after its last component.
+         */
+        void
+        computeHashes(const Name& name, HashSequence& seq);
+
+        /** \brief a packet tag caching the hash sequence of the packet Name
+         *
+         *  The tag remembers the wire encoding of the Name it was computed from, so that it is
+         *  ignored once the packet Name is replaced (e.g. after setName).
+         */
+        class HashSequenceTag : public ndn::Tag {
+        public:
+
+            static constexpr int
+            getTypeId() {
+                return 0x60000001;
+            }
+
+            HashSequenceTag(const Block& nameWire, HashSequence hashes);
+
+            /** \return whether the cached hashes were computed from nameWire
+             */
+            bool
+            isValidFor(const Block& nameWire) const {
+                return m_nameWire.wire() == nameWire.wire() && m_nameWire.size() == nameWire.size();
+            }
+
+            const HashSequence&
+            get() const {
+                return m_hashes;
+            }
+
+        private:
+            Block m_nameWire; // keeps the buffer alive, so its address cannot be reused
+            HashSequence m_hashes;
+        };
+
+        /** \brief get hash sequence of pkt.getName(), computing it only if not cached on pkt
+         *  \tparam Packet Interest or Data
+         *  \return a reference valid as long as pkt keeps its HashSequenceTag
+         */
+        template<typename Packet>
+        const HashSequence&
+        getHashes(const Packet& pkt) {
+            const Block& nameWire = pkt.getName().wireEncode();
+            shared_ptr<HashSequenceTag> tag = pkt.template getTag<HashSequenceTag>();
+            if (tag == nullptr || !tag->isValidFor(nameWire)) {
+                HashSequence hashes;
+                computeHashes(pkt.getName(), hashes);
+                tag = make_shared<HashSequenceTag>(nameWire, std::move(hashes));
+                pkt.setTag(tag);
+            }
+            return tag->get();
+        }
+
+        /** \brief when pkt.getName() is a prefix of orig.getName(), derive the hash sequence
+         *         of pkt from the one cached on orig instead of hashing the Name again
+         *  \tparam Packet Interest or Data
+         *
+         *  This is used when a trailing component is stripped from a Name that has been hashed.
+         */
+        template<typename Packet>
+        void
+        inheritPrefixHashes(const Packet& pkt, const Packet& orig) {
+            const Name& name = pkt.getName();
+            shared_ptr<HashSequenceTag> origTag = orig.template getTag<HashSequenceTag>();
+            if (origTag == nullptr || !origTag->isValidFor(orig.getName().wireEncode()) ||
+                    name.size() >= origTag->get().size() || !name.isPrefixOf(orig.getName())) {
+                return;
+            }
+
+            const HashSequence& origHashes = origTag->get();
+            pkt.setTag(make_shared<HashSequenceTag>(name.wireEncode(),
+                    HashSequence(origHashes.begin(), origHashes.begin() + name.size() + 1)));
+        }
+
         /** \brief a hashtable node
          *
          *  Zero or more nodes can be added to a hashtable bucket. They are organized as
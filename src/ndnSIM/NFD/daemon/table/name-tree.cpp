@@ -41,9 +41,14 @@ namespace nfd {
 
         Entry&
         NameTree::lookup(const Name& name) {
+            return this->lookup(name, computeHashes(name));
+        }
+
+        Entry&
+        NameTree::lookup(const Name& name, const HashSequence& hashes) {
             NFD_LOG_TRACE("lookup " << name);
+            BOOST_ASSERT(hashes.size() > name.size());
 
-            HashSequence hashes = computeHashes(name);
             const Node* node = nullptr;
             Entry* parent = nullptr;
 
@@ -143,9 +148,23 @@ namespace nfd {
             return node == nullptr ? nullptr : &node->entry;
         }
 
+        Entry*
+        NameTree::findExactMatch(const Name& name, const HashSequence& hashes) const {
+            BOOST_ASSERT(hashes.size() > name.size());
+            const Node* node = m_ht.find(name, name.size(), hashes);
+            return node == nullptr ? nullptr : &node->entry;
+        }
+
         Entry*
         NameTree::findLongestPrefixMatch(const Name& name, const EntrySelector& entrySelector) const {
-            HashSequence hashes = computeHashes(name);
+            // a local sequence keeps this reentrant: entrySelector may query the tree again
+            return this->findLongestPrefixMatch(name, computeHashes(name), entrySelector);
+        }
+
+        Entry*
+        NameTree::findLongestPrefixMatch(const Name& name, const HashSequence& hashes,
+                const EntrySelector& entrySelector) const {
+            BOOST_ASSERT(hashes.size() > name.size());
 
             for (ssize_t prefixLen = name.size(); prefixLen >= 0; --prefixLen) {
                 const Node* node = m_ht.find(name, prefixLen, hashes);
@@ -219,6 +238,13 @@ namespace nfd {
             return {Iterator(make_shared<PrefixMatchImpl>(*this, entrySelector), entry), end()};
         }
 
+        boost::iterator_range<NameTree::const_iterator>
+        NameTree::findAllMatches(const Name& name, const HashSequence& hashes,
+                const EntrySelector& entrySelector) const {
+            Entry* entry = this->findLongestPrefixMatch(name, hashes, entrySelector);
+            return {Iterator(make_shared<PrefixMatchImpl>(*this, entrySelector), entry), end()};
+        }
+
         boost::iterator_range<NameTree::const_iterator>
         NameTree::fullEnumerate(const EntrySelector& entrySelector) const {
             return {Iterator(make_shared<FullEnumerationImpl>(*this, entrySelector), nullptr), end()};
@@ -73,6 +73,14 @@ namespace nfd {
             Entry&
             lookup(const Name& name);
 
+            /** \brief equivalent to .lookup(name), using precomputed prefix hashes
+             *  \param hashes hash sequence of \p name, or of a longer name that has \p name as prefix
+             *  \pre hashes.size() > name.size()
+             *  \sa getHashes
+             */
+            Entry&
+            lookup(const Name& name, const HashSequence& hashes);
+
             /** \brief equivalent to .lookup(fibEntry.getPrefix())
              *  \param fibEntry a FIB entry attached to this name tree, or Fib::s_emptyEntry
              *  \note This overload is more efficient than .lookup(const Name&) in common cases.
@@ -121,6 +129,12 @@ namespace nfd {
             Entry*
             findExactMatch(const Name& name) const;
 
+            /** \brief equivalent to .findExactMatch(name), using precomputed prefix hashes
+             *  \pre hashes.size() > name.size()
+             */
+            Entry*
+            findExactMatch(const Name& name, const HashSequence& hashes) const;
+
             /** \brief longest prefix matching
              *  \return entry whose name is a prefix of \p name and passes \p entrySelector,
              *          where no other entry with a longer name satisfies those requirements;
@@ -130,6 +144,14 @@ namespace nfd {
             findLongestPrefixMatch(const Name& name,
                     const EntrySelector& entrySelector = AnyEntry()) const;
 
+            /** \brief equivalent to .findLongestPrefixMatch(name, entrySelector),
+             *         using precomputed prefix hashes
+             *  \pre hashes.size() > name.size()
+             */
+            Entry*
+            findLongestPrefixMatch(const Name& name, const HashSequence& hashes,
+                    const EntrySelector& entrySelector = AnyEntry()) const;
+
             /** \brief equivalent to .findLongestPrefixMatch(entry.getName(), entrySelector)
              *  \note This overload is more efficient than
              *        .findLongestPrefixMatch(const Name&, const EntrySelector&) in common cases.
@@ -181,6 +203,13 @@ namespace nfd {
             findAllMatches(const Name& name,
                     const EntrySelector& entrySelector = AnyEntry()) const;
 
+            /** \brief equivalent to .findAllMatches(name, entrySelector), using precomputed prefix hashes
+             *  \pre hashes.size() > name.size()
+             */
+            Range
+            findAllMatches(const Name& name, const HashSequence& hashes,
+                    const EntrySelector& entrySelector = AnyEntry()) const;
+
         public: // enumeration
             typedef Iterator const_iterator;
 
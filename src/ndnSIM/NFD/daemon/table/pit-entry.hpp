@@ -28,7 +28,7 @@
 
 #include "pit-in-record.hpp"
 #include "pit-out-record.hpp"
-#include "core/scheduler.hpp"
+#include "core/timer-wheel.hpp"
 
 namespace nfd {
 
@@ -211,7 +211,7 @@ namespace nfd {
              *  Either this or the straggler timer should be set at all times,
              *  except when this entry is being processed in a pipeline.
              */
-            scheduler::EventId m_unsatisfyTimer;
+            scheduler::TimerWheel::TimerId m_unsatisfyTimer;
 
             /** \brief straggler timer
              *
@@ -221,7 +221,7 @@ namespace nfd {
              *  Either this or the unsatisfy timer should be set at all times,
              *  except when this entry is being processed in a pipeline.
              */
-            scheduler::EventId m_stragglerTimer;
+            scheduler::TimerWheel::TimerId m_stragglerTimer;
 
         private:
             shared_ptr<const Interest> m_interest;
@@ -45,12 +45,16 @@ namespace nfd {
             bool isEndWithDigest = name.size() > 0 && name[-1].isImplicitSha256Digest();
             const Name& nteName = isEndWithDigest ? name.getPrefix(-1) : name;
 
+            // prefix hashes of the Interest name are cached on the Interest,
+            // and also cover nteName when it is one component shorter
+            const name_tree::HashSequence& hashes = name_tree::getHashes(interest);
+
             // ensure NameTree entry exists
             name_tree::Entry* nte = nullptr;
             if (allowInsert) {
-                nte = &m_nameTree.lookup(nteName);
+                nte = &m_nameTree.lookup(nteName, hashes);
             } else {
-                nte = m_nameTree.findExactMatch(nteName);
+                nte = m_nameTree.findExactMatch(nteName, hashes);
                 if (nte == nullptr) {
                     return {nullptr, true};
                 }
@@ -82,7 +86,8 @@ namespace nfd {
 
         DataMatchResult
         Pit::findAllDataMatches(const Data& data) const {
-            auto&& ntMatches = m_nameTree.findAllMatches(data.getName(), &nteHasPitEntries);
+            auto&& ntMatches = m_nameTree.findAllMatches(data.getName(), name_tree::getHashes(data),
+                    &nteHasPitEntries);
 
             DataMatchResult matches;
             for (const name_tree::Entry& nte : ntMatches) {
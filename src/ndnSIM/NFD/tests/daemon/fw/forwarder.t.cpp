@@ -569,7 +569,7 @@ namespace nfd {
             interest->setNonce(61883075);
             interest->setInterestLifetime(time::seconds(2));
 
-            DeadNonceList& dnl = forwarder.getDeadNonceList();
+            DeadNonceListBase& dnl = forwarder.getDeadNonceList();
             dnl.add(interest->getName(), interest->getNonce());
             Pit& pit = forwarder.getPit();
             BOOST_REQUIRE_EQUAL(pit.size(), 0);
@@ -0,0 +1,187 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-consumer-zipf-aimd.hpp"
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/double.h"
+#include "ns3/boolean.h"
+
+#include <ndn-cxx/lp/tags.hpp>
+
+NS_LOG_COMPONENT_DEFINE("ndn.ConsumerZipfAimd");
+
+namespace ns3 {
+    namespace ndn {
+
+        NS_OBJECT_ENSURE_REGISTERED(ConsumerZipfAimd);
+
+        TypeId
+        ConsumerZipfAimd::GetTypeId(void) {
+            static TypeId tid =
+                    TypeId("ns3::ndn::ConsumerZipfAimd")
+                    .SetGroupName("Ndn")
+                    .SetParent<ConsumerZipfMandelbrotV2>()
+                    .AddConstructor<ConsumerZipfAimd>()
+
+                    .AddAttribute("Window", "Initial size of the window", DoubleValue(1.0),
+                    MakeDoubleAccessor(&ConsumerZipfAimd::m_initialWindow),
+                    MakeDoubleChecker<double>(1.0))
+
+                    .AddAttribute("MinWindow", "Size the window is never decreased below", DoubleValue(1.0),
+                    MakeDoubleAccessor(&ConsumerZipfAimd::m_minWindow),
+                    MakeDoubleChecker<double>(1.0))
+
+                    .AddAttribute("MaxWindow", "Size the window is never increased above", DoubleValue(1000.0),
+                    MakeDoubleAccessor(&ConsumerZipfAimd::m_maxWindow),
+                    MakeDoubleChecker<double>(1.0))
+
+                    .AddAttribute("SlowStartThreshold", "Initial window size up to which it grows by one per Data",
+                    DoubleValue(std::numeric_limits<double>::max()),
+                    MakeDoubleAccessor(&ConsumerZipfAimd::m_initialSsthresh),
+                    MakeDoubleChecker<double>())
+
+                    .AddAttribute("AddRate", "Additive increase of the window per RTT, above the slow start threshold",
+                    DoubleValue(1.0),
+                    MakeDoubleAccessor(&ConsumerZipfAimd::m_addRate),
+                    MakeDoubleChecker<double>(0.0))
+
+                    .AddAttribute("Beta", "Multiplicative decrease of the window on congestion", DoubleValue(0.5),
+                    MakeDoubleAccessor(&ConsumerZipfAimd::m_beta),
+                    MakeDoubleChecker<double>(0.0, 1.0))
+
+                    .AddAttribute("ReactToCongestionMarks", "Decrease the window on congestion marked Data",
+                    BooleanValue(true),
+                    MakeBooleanAccessor(&ConsumerZipfAimd::m_reactToMarks),
+                    MakeBooleanChecker())
+
+                    .AddTraceSource("WindowTrace",
+                    "Window that controls how many outstanding interests are allowed",
+                    MakeTraceSourceAccessor(&ConsumerZipfAimd::m_window),
+                    "ns3::ndn::ConsumerZipfAimd::WindowTraceCallback");
+
+            return tid;
+        }
+
+        ConsumerZipfAimd::ConsumerZipfAimd()
+        : m_initialWindow(1.0)
+        , m_minWindow(1.0)
+        , m_maxWindow(1000.0)
+        , m_initialSsthresh(std::numeric_limits<double>::max())
+        , m_addRate(1.0)
+        , m_beta(0.5)
+        , m_reactToMarks(true)
+        , m_ssthresh(std::numeric_limits<double>::max())
+        , m_window(1.0) {
+        }
+
+        void
+        ConsumerZipfAimd::StartApplication() {
+            m_window = std::min(std::max(m_initialWindow, m_minWindow), m_maxWindow);
+            m_ssthresh = m_initialSsthresh;
+            m_lastDecrease = Time::Min();
+            m_nextSend = Simulator::Now();
+
+            ConsumerZipfMandelbrotV2::StartApplication();
+        }
+
+        void
+        ConsumerZipfAimd::ScheduleNextPacket() {
+            m_firstTime = false;
+            if (GetInFlight() >= m_window.Get() || m_sendEvent.IsRunning()) {
+                return;
+            }
+
+            // Frequency bounds the rate, Data from a cache close by would otherwise open the window
+            // without bound and without time passing.
+            Time now = Simulator::Now();
+            Time next = std::max(m_nextSend, now);
+            m_nextSend = next + Seconds(1.0 / m_frequency);
+            m_sendEvent = Simulator::Schedule(next - now, &ConsumerZipfMandelbrotV2::SendPacket, this);
+        }
+
+        void
+        ConsumerZipfAimd::OnData(shared_ptr<const Data> data) {
+            if (!m_active)
+                return;
+
+            ConsumerZipfMandelbrotV2::OnData(data);
+
+            auto congestionMarkTag = data->getTag<lp::CongestionMarkTag>();
+            if (m_reactToMarks && congestionMarkTag != nullptr && *congestionMarkTag > 0) {
+                DecreaseWindow();
+            } else {
+                IncreaseWindow();
+            }
+            NS_LOG_DEBUG("Window: " << m_window << ", InFlight: " << GetInFlight());
+
+            ScheduleNextPacket();
+        }
+
+        void
+        ConsumerZipfAimd::OnNack(shared_ptr<const lp::Nack> nack) {
+            if (!m_active)
+                return;
+
+            ConsumerZipfMandelbrotV2::OnNack(nack);
+
+            if (nack->getReason() == lp::NackReason::CONGESTION) {
+                DecreaseWindow();
+            }
+            NS_LOG_DEBUG("Window: " << m_window << ", InFlight: " << GetInFlight());
+
+            ScheduleNextPacket();
+        }
+
+        void
+        ConsumerZipfAimd::OnTimeout(uint32_t sequenceNumber) {
+            m_rtt->IncreaseMultiplier(); // double the next RTO
+            DecreaseWindow();
+            NS_LOG_DEBUG("Window: " << m_window << ", InFlight: " << GetInFlight());
+
+            ConsumerZipfMandelbrotV2::OnTimeout(sequenceNumber);
+            ScheduleNextPacket();
+        }
+
+        void
+        ConsumerZipfAimd::IncreaseWindow() {
+            double window = m_window.Get();
+            if (window < m_ssthresh) {
+                window += 1.0;
+            } else {
+                window += m_addRate / window;
+            }
+            m_window = std::min(window, m_maxWindow);
+        }
+
+        void
+        ConsumerZipfAimd::DecreaseWindow() {
+            // The losses of a window are signalled within an RTT of each other, respond to them once.
+            Time now = Simulator::Now();
+            if (m_lastDecrease + m_rtt->GetCurrentEstimate() > now) {
+                return;
+            }
+            m_lastDecrease = now;
+
+            m_ssthresh = std::max(m_window.Get() * m_beta, m_minWindow);
+            m_window = m_ssthresh;
+        }
+
+    } // namespace ndn
+} // namespace ns3
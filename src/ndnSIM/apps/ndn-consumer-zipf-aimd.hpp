@@ -0,0 +1,103 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_CONSUMER_ZIPF_AIMD_H
+#define NDN_CONSUMER_ZIPF_AIMD_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ndn-consumer-zipf-mandelbrot-v2.hpp"
+#include "ns3/traced-value.h"
+
+namespace ns3 {
+    namespace ndn {
+
+        /**
+         * @ingroup ndn-apps
+         * @brief Zipf-Mandelbrot consumer whose request window follows AIMD congestion control
+         *
+         * Contents are drawn as in ConsumerZipfMandelbrotV2, but Interests are sent as soon as
+         * fewer than Window are in flight, so the request rate adapts to the network; Frequency
+         * only bounds it.  The window grows by one per Data up to SlowStartThreshold, then by
+         * AddRate / Window, and is multiplied by Beta on an RTO expiry, a congestion Nack or a
+         * congestion marked Data, at most once per RTT.
+         */
+        class ConsumerZipfAimd : public ConsumerZipfMandelbrotV2 {
+        public:
+            static TypeId
+            GetTypeId();
+
+            ConsumerZipfAimd();
+
+            // From App
+            virtual void
+            OnData(shared_ptr<const Data> data);
+
+            virtual void
+            OnNack(shared_ptr<const lp::Nack> nack);
+
+            virtual void
+            OnTimeout(uint32_t sequenceNumber);
+
+        public:
+            typedef void (*WindowTraceCallback)(double, double);
+
+        protected:
+            virtual void
+            StartApplication();
+
+            /**
+             * @brief Send the next Interest as soon as the window and Frequency allow it
+             */
+            virtual void
+            ScheduleNextPacket();
+
+        private:
+            /**
+             * @brief Grow the window on a Data
+             */
+            void
+            IncreaseWindow();
+
+            /**
+             * @brief Shrink the window on a congestion signal, unless it was shrunk within the last RTT
+             */
+            void
+            DecreaseWindow();
+
+        private:
+            double m_initialWindow;
+            double m_minWindow;
+            double m_maxWindow;
+            double m_initialSsthresh;
+            double m_addRate;
+            double m_beta;
+            bool m_reactToMarks;
+
+            double m_ssthresh; // slow start threshold
+            Time m_lastDecrease; // time of the last decrease
+            Time m_nextSend; // earliest time of the next Interest
+
+            TracedValue<double> m_window;
+        };
+
+    } // namespace ndn
+} // namespace ns3
+
+#endif
@@ -23,6 +23,9 @@
 #include "src/core/model/integer.h"
 #include "ndn-producer.hpp"
 #include <math.h>
+#include <algorithm>
+
+#include <ndn-cxx/lp/tags.hpp>
 
 NS_LOG_COMPONENT_DEFINE("ndn.ConsumerZipfMandelbrotV2");
 
@@ -67,7 +70,10 @@ namespace ns3 {
         , m_q(0.7)
         , m_s(0.7)
         , m_own_seq(std::numeric_limits<uint32_t>::max())
-        , m_seqRng(CreateObject<UniformRandomVariable>()) {
+        , m_seqRng(CreateObject<UniformRandomVariable>())
+        , m_nRequests(0)
+        , m_nInFlight(0)
+        , m_lastRequestId(0) {
             // SetNumberOfContents is called by NS-3 object system during the initialization
         }
 
@@ -133,43 +139,55 @@ namespace ns3 {
         }
 
         void
-        ConsumerZipfMandelbrotV2::SendPacket() {
-            if (!m_active)
-                return;
+        ConsumerZipfMandelbrotV2::StartApplication() {
             NS_LOG_FUNCTION_NOARGS();
 
             //Check if this node has a producer application running also.
-
-            if (m_own_seq == std::numeric_limits<uint32_t>::max()) //First time
-            {
-                for (uint32_t idx = 0; idx < (GetNode()->GetNApplications()); idx++) {
-                    if (GetNode()->GetApplication(idx)->GetInstanceTypeId().GetName() == "ns3::ndn::Producer") {
-                        Name own_name_pro = GetNode()->GetApplication(idx)->GetObject<Producer>()->GetPrefix();
-                        int curseq = atoi(own_name_pro.at(-1).toUri().c_str());
-                        m_own_seq = (uint32_t) curseq;
-                        break;
-                    }
-                    m_own_seq = std::numeric_limits<uint32_t>::max() - 1337;
+            m_own_seq = std::numeric_limits<uint32_t>::max() - 1337;
+            for (uint32_t idx = 0; idx < GetNode()->GetNApplications(); idx++) {
+                Ptr<Application> app = GetNode()->GetApplication(idx);
+                if (app->GetInstanceTypeId() == Producer::GetTypeId()) {
+                    Name own_name_pro = app->GetObject<Producer>()->GetPrefix();
+                    m_own_seq = (uint32_t) atoi(own_name_pro.at(-1).toUri().c_str());
+                    break;
                 }
             }
 
-            uint32_t seq = std::numeric_limits<uint32_t>::max(); // invalid
+            // Timeouts are driven by the deadline heap, not by the periodic check of Consumer.
+            Simulator::Cancel(m_retxEvent);
+
+            Consumer::StartApplication();
+        }
 
-            // std::cout << Simulator::Now ().ToDouble (Time::S) << "s max -> " << m_seqMax << "\n";
+        void
+        ConsumerZipfMandelbrotV2::StopApplication() {
+            NS_LOG_FUNCTION_NOARGS();
+
+            Simulator::Cancel(m_deadlineEvent);
+
+            // Traffic is accounted by the application face.
+            if (m_appLink != nullptr) {
+                const AppLinkService::Counters& counters = m_appLink->getCounters();
+                m_tx_bytes = counters.nInBytes;
+                m_rx_bytes = counters.nOutBytes;
+                m_tx_packets = counters.nInInterests;
+                m_rx_packets = counters.nOutData;
+            }
+
+            Consumer::StopApplication();
+        }
+
+        void
+        ConsumerZipfMandelbrotV2::SendPacket() {
+            if (!m_active)
+                return;
+            NS_LOG_FUNCTION_NOARGS();
+
+            uint32_t seq = std::numeric_limits<uint32_t>::max(); // invalid
 
             while (m_retxSeqs.size()) {
                 seq = *m_retxSeqs.begin();
                 m_retxSeqs.erase(m_retxSeqs.begin());
-
-                // NS_ASSERT (m_seqLifetimes.find (seq) != m_seqLifetimes.end ());
-                // if (m_seqLifetimes.find (seq)->time <= Simulator::Now ())
-                //   {
-
-                //     NS_LOG_DEBUG ("Expire " << seq);
-                //     m_seqLifetimes.erase (seq); // lifetime expired. Trying to find another unexpired
-                //     sequence number
-                //     continue;
-                //   }
                 NS_LOG_DEBUG("=interest seq " << seq << " from m_retxSeqs");
                 break;
             }
@@ -195,62 +213,230 @@ namespace ns3 {
 
             }
 
-            // std::cout << Simulator::Now ().ToDouble (Time::S) << "s -> " << seq << "\n";
-            // From here we internchange seq
-            //
-            shared_ptr<Name> nameWithSequence = make_shared<Name>(m_interestName);
-            Name seqname(std::to_string(seq).c_str());
-            nameWithSequence->append(seqname);
-
-            nameWithSequence->appendSequenceNumber(seq);
-            //
+            if (seq >= m_names.size()) {
+                m_names.resize(seq + 1);
+                m_seqRequests.resize(seq + 1, 0);
+            }
+            Name& name = m_names[seq];
+            if (name.empty()) {
+                name = m_interestName;
+                name.append(Name(std::to_string(seq).c_str()));
+                name.appendSequenceNumber(seq);
+            }
 
             shared_ptr<Interest> interest = make_shared<Interest>();
             interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
-            interest->setName(*nameWithSequence);
-            m_tx_bytes += (uint64_t) interest->wireEncode().size();
-            m_tx_packets++;
+            interest->setName(name);
             NS_LOG_INFO("Requesting Interest: \n" << *interest);
             NS_LOG_INFO("> Interest for " << seq << ", Total: " << m_seq << ", face: " << m_face->getId());
-            NS_LOG_DEBUG("Trying to add " << seq << " with " << Simulator::Now() << ". already "
-                    << m_seqTimeouts.size() << " items");
 
-            m_seqTimeouts.insert(SeqTimeout(seq, Simulator::Now()));
-            m_seqFullDelay.insert(SeqTimeout(seq, Simulator::Now()));
+            // A content requested again while outstanding keeps its request: the PIT aggregates
+            // both Interests and a single Data answers them.
+            Time now = Simulator::Now();
+            Request* request = m_seqRequests[seq] != 0 ? FindRequest(m_seqRequests[seq]) : nullptr;
+            if (request == nullptr) {
+                Request newRequest = Request();
+                newRequest.id = ++m_lastRequestId;
+                newRequest.seq = seq;
+                newRequest.firstSent = now;
+                request = InsertRequest(newRequest);
+                m_seqRequests[seq] = newRequest.id;
+            }
+            NS_LOG_DEBUG("Request " << request->id << " for " << seq << ", " << m_nRequests << " outstanding");
+            request->retxCount++;
+            request->inFlight++;
+            m_nInFlight++;
+            request->lastSent = now;
+            request->timedOut = false;
+            m_rtt->SentSeq(SequenceNumber32(request->id), 1);
+            SetDeadline(*request, now + m_rtt->RetransmitTimeout());
+
+            m_transmittedInterests(interest, this, m_face);
+            m_appLink->onReceiveInterest(*interest);
+
+            ScheduleNextPacket();
+        }
+
+        void
+        ConsumerZipfMandelbrotV2::OnData(shared_ptr<const Data> data) {
+            if (!m_active)
+                return;
 
-            m_seqLastDelay.erase(seq);
-            m_seqLastDelay.insert(SeqTimeout(seq, Simulator::Now()));
+            App::OnData(data); // tracing inside
 
-            m_seqRetxCounts[seq]++;
+            NS_LOG_FUNCTION(this << data);
 
-            m_rtt->SentSeq(SequenceNumber32(seq), 1);
+            uint32_t seq = data->getName().at(-1).toSequenceNumber();
+            NS_LOG_INFO("< DATA for " << seq);
 
-            m_transmittedInterests(interest, this, m_face);
-            m_appLink->onReceiveInterest(*interest);
+            int hopCount = 0;
+            auto hopCountTag = data->getTag<lp::HopCountTag>();
+            if (hopCountTag != nullptr) { // e.g., packet came from local node's cache
+                hopCount = *hopCountTag;
+            }
+
+            Request* request = seq < m_seqRequests.size() && m_seqRequests[seq] != 0
+                    ? FindRequest(m_seqRequests[seq]) : nullptr;
+            if (request != nullptr) {
+                Time now = Simulator::Now();
+                m_lastRetransmittedInterestDataDelay(this, seq, now - request->lastSent, hopCount);
+                m_firstInterestDataDelay(this, seq, now - request->firstSent, request->retxCount, hopCount);
+                m_rtt->AckSeq(SequenceNumber32(request->id));
+                EraseRequest(request->id);
+            }
+
+            m_retxSeqs.erase(seq);
+        }
+
+        void
+        ConsumerZipfMandelbrotV2::OnNack(shared_ptr<const lp::Nack> nack) {
+            if (!m_active)
+                return;
+
+            Consumer::OnNack(nack); // tracing inside
+
+            // The request stays until its deadline, in case another of its Interests is answered.
+            uint32_t seq = nack->getInterest().getName().at(-1).toSequenceNumber();
+            Request* request = seq < m_seqRequests.size() && m_seqRequests[seq] != 0
+                    ? FindRequest(m_seqRequests[seq]) : nullptr;
+            if (request != nullptr) {
+                Land(*request, 1);
+            }
+        }
 
-            ConsumerZipfMandelbrotV2::ScheduleNextPacket();
+        ConsumerZipfMandelbrotV2::Request*
+        ConsumerZipfMandelbrotV2::FindRequest(uint64_t id) {
+            if (m_requests.empty()) {
+                return nullptr;
+            }
+            // Request ids are sequential, so they index the table directly.
+            size_t mask = m_requests.size() - 1;
+            for (size_t i = id & mask; m_requests[i].id != 0; i = (i + 1) & mask) {
+                if (m_requests[i].id == id) {
+                    return &m_requests[i];
+                }
+            }
+            return nullptr;
+        }
+
+        ConsumerZipfMandelbrotV2::Request*
+        ConsumerZipfMandelbrotV2::InsertRequest(const Request& request) {
+            if ((m_nRequests + 1) * 2 > m_requests.size()) {
+                std::vector<Request> requests(std::max<size_t>(16, m_requests.size() * 2));
+                requests.swap(m_requests);
+                m_nRequests = 0;
+                for (const Request& old : requests) {
+                    if (old.id != 0) {
+                        InsertRequest(old);
+                    }
+                }
+            }
+
+            size_t mask = m_requests.size() - 1;
+            size_t i = request.id & mask;
+            while (m_requests[i].id != 0) {
+                i = (i + 1) & mask;
+            }
+            m_requests[i] = request;
+            m_nRequests++;
+            return &m_requests[i];
+        }
+
+        void
+        ConsumerZipfMandelbrotV2::EraseRequest(uint64_t id) {
+            Request* request = FindRequest(id);
+            if (request == nullptr) {
+                return;
+            }
+            if (m_seqRequests[request->seq] == id) {
+                m_seqRequests[request->seq] = 0;
+            }
+            Land(*request, request->inFlight);
+
+            // Backward shift deletion: move up the following entries of the probe sequence that
+            // may take the freed slot, so that lookups need no tombstones.
+            size_t mask = m_requests.size() - 1;
+            size_t hole = request - &m_requests[0];
+            for (size_t i = (hole + 1) & mask; m_requests[i].id != 0; i = (i + 1) & mask) {
+                size_t home = m_requests[i].id & mask;
+                if (((i - home) & mask) >= ((i - hole) & mask)) {
+                    m_requests[hole] = m_requests[i];
+                    hole = i;
+                }
+            }
+            m_requests[hole].id = 0;
+            m_nRequests--;
+        }
+
+        void
+        ConsumerZipfMandelbrotV2::Land(Request& request, uint32_t nInterests) {
+            nInterests = std::min(nInterests, request.inFlight);
+            request.inFlight -= nInterests;
+            m_nInFlight -= nInterests;
+        }
+
+        void
+        ConsumerZipfMandelbrotV2::SetDeadline(Request& request, Time deadline) {
+            request.deadline = deadline;
+            m_deadlines.push(Deadline{deadline, request.id});
+            if (!m_deadlineEvent.IsRunning() || deadline < m_deadlineEventTime) {
+                Simulator::Cancel(m_deadlineEvent);
+                m_deadlineEvent = Simulator::Schedule(deadline - Simulator::Now(),
+                        &ConsumerZipfMandelbrotV2::OnDeadline, this);
+                m_deadlineEventTime = deadline;
+            }
+        }
+
+        void
+        ConsumerZipfMandelbrotV2::OnDeadline() {
+            static const Time lifetime = MilliSeconds(::ndn::DEFAULT_INTEREST_LIFETIME.count());
+            Time now = Simulator::Now();
+
+            while (!m_deadlines.empty() && m_deadlines.top().time <= now) {
+                Deadline deadline = m_deadlines.top();
+                m_deadlines.pop();
+
+                Request* request = FindRequest(deadline.id);
+                if (request == nullptr || request->deadline != deadline.time) {
+                    continue; // satisfied or sent again since
+                }
+
+                if (request->timedOut) {
+                    // The Interest has expired in the PITs, Data can no longer come back.
+                    NS_LOG_DEBUG("Request " << request->id << " for " << request->seq << " expired");
+                    EraseRequest(request->id);
+                } else {
+                    uint32_t seq = request->seq;
+                    request->timedOut = true;
+                    Land(*request, request->inFlight);
+                    request->deadline = request->lastSent + lifetime;
+                    m_deadlines.push(Deadline{request->deadline, request->id});
+                    OnTimeout(seq); // may send, and move the table
+                }
+            }
+
+            if (!m_deadlines.empty() && !m_deadlineEvent.IsRunning()) {
+                m_deadlineEventTime = m_deadlines.top().time;
+                m_deadlineEvent = Simulator::Schedule(m_deadlineEventTime - now,
+                        &ConsumerZipfMandelbrotV2::OnDeadline, this);
+            }
         }
 
         uint32_t
         ConsumerZipfMandelbrotV2::GetNextSeq() {
-            uint32_t content_index = 1; //[1, m_N]
-            double p_sum = 0;
-
             double p_random = m_seqRng->GetValue();
             while (p_random == 0) {
                 p_random = m_seqRng->GetValue();
             }
-            // if (p_random == 0)
             NS_LOG_LOGIC("p_random=" << p_random);
-            for (uint32_t i = 1; i <= m_N; i++) {
-                p_sum = m_Pcum[i]; // m_Pcum[i] = m_Pcum[i-1] + p[i], p[0] = 0;   e.g.: p_cum[1] = p[1],
-                // p_cum[2] = p[1] + p[2]
-                if (p_random <= p_sum) {
-                    content_index = i;
-                    break;
-                } // if
-            } // for
-            // content_index = 1;
+
+            // m_Pcum[i] = m_Pcum[i-1] + p[i], p[0] = 0, so the content is the first i in [1, m_N]
+            // with p_random <= m_Pcum[i]; 1 if rounding leaves none.
+            uint32_t content_index = 1;
+            std::vector<double>::const_iterator it = std::lower_bound(m_Pcum.begin() + 1, m_Pcum.end(), p_random);
+            if (it != m_Pcum.end()) {
+                content_index = it - m_Pcum.begin();
+            }
             NS_LOG_DEBUG("RandomNumber=" << content_index);
             return content_index;
         }
@@ -37,6 +37,8 @@
 #include "ns3/double.h"
 #include "ns3/random-variable-stream.h"
 
+#include <queue>
+
 namespace ns3 {
     namespace ndn {
 
@@ -47,6 +49,17 @@ namespace ns3 {
          * The class implements an app which requests contents following Zipf-Mandelbrot Distribution
          * Here is the explaination of Zipf-Mandelbrot Distribution:
          *http://en.wikipedia.org/wiki/Zipf%E2%80%93Mandelbrot_law
+         *
+         * Since the same contents are requested over and over, outstanding requests are kept in
+         * a flat open-addressed table keyed by a request id rather than in the per-sequence
+         * containers of Consumer.  A content requested again while outstanding reuses its request,
+         * as the PIT aggregates both Interests.  A single timer over a min-heap of deadlines
+         * reports RTO expiries through OnTimeout and drops requests once their Interest lifetime
+         * has passed.  The RTT estimator is fed request ids, which increase monotonically, and
+         * bytes are counted by the application face (AppLinkService::Counters).
+         *
+         * Interests sent and neither answered, nacked nor past their RTO are counted as in flight
+         * (GetInFlight), for subclasses that control the request window.
          */
         class ConsumerZipfMandelbrotV2 : public ConsumerCbr {
         public:
@@ -67,10 +80,32 @@ namespace ns3 {
             uint32_t
             GetNextSeq();
 
+            // From App
+            virtual void
+            OnData(shared_ptr<const Data> data);
+
+            virtual void
+            OnNack(shared_ptr<const lp::Nack> nack);
+
         protected:
+            // From App
+            virtual void
+            StartApplication();
+
+            virtual void
+            StopApplication();
+
             virtual void
             ScheduleNextPacket();
 
+            /**
+             * @brief Number of Interests in flight
+             */
+            uint32_t
+            GetInFlight() const {
+                return m_nInFlight;
+            }
+
         private:
             void
             SetNumberOfContents(uint32_t numOfContents);
@@ -96,6 +131,72 @@ namespace ns3 {
             double
             GetS() const;
 
+        private:
+            /**
+             * @brief An outstanding request
+             */
+            struct Request {
+                uint64_t id; ///< @brief request id, 0 for a free slot
+                uint32_t seq; ///< @brief requested content
+                uint32_t retxCount; ///< @brief number of Interests sent for the request
+                uint32_t inFlight; ///< @brief number of Interests sent since the last RTO expiry
+                Time firstSent; ///< @brief time of the first Interest
+                Time lastSent; ///< @brief time of the last Interest
+                Time deadline; ///< @brief RTO expiry, then end of the Interest lifetime
+                bool timedOut; ///< @brief the RTO has expired
+            };
+
+            /**
+             * @brief A deadline in the timer heap, stale once its request is gone or has moved on
+             */
+            struct Deadline {
+                Time time;
+                uint64_t id;
+
+                bool
+                operator>(const Deadline& other) const {
+                    return time > other.time;
+                }
+            };
+
+            /**
+             * @brief Find an outstanding request
+             * @return the request, or nullptr
+             */
+            Request*
+            FindRequest(uint64_t id);
+
+            /**
+             * @brief Add a request, growing the table as needed
+             * @return the request in the table
+             */
+            Request*
+            InsertRequest(const Request& request);
+
+            /**
+             * @brief Remove a request, shifting back the entries of its probe sequence
+             */
+            void
+            EraseRequest(uint64_t id);
+
+            /**
+             * @brief Stop counting Interests of a request as in flight
+             */
+            void
+            Land(Request& request, uint32_t nInterests);
+
+            /**
+             * @brief Push the deadline of a request and reschedule the timer if it is the earliest
+             */
+            void
+            SetDeadline(Request& request, Time deadline);
+
+            /**
+             * @brief Handle the deadlines that have passed
+             */
+            void
+            OnDeadline();
+
         private:
             uint32_t m_N; // number of the contents
             double m_q; // q in (k+q)^s
@@ -104,6 +205,16 @@ namespace ns3 {
             std::vector<double> m_Pcum; // cumulative probability
 
             Ptr<UniformRandomVariable> m_seqRng; // RNG
+
+            std::vector<Name> m_names; // Interest names, by content, built on first use
+            std::vector<Request> m_requests; // open-addressed table of outstanding requests
+            uint32_t m_nRequests; // number of outstanding requests
+            uint32_t m_nInFlight; // number of Interests in flight
+            uint64_t m_lastRequestId; // id of the last request
+            std::vector<uint64_t> m_seqRequests; // outstanding request id by content, 0 if none
+            std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> m_deadlines;
+            EventId m_deadlineEvent; // timer for the earliest deadline
+            Time m_deadlineEventTime; // expiry of m_deadlineEvent
         };
 
     } /* namespace ndn */
@@ -205,7 +205,7 @@ namespace ns3 {
 
             m_transmittedInterests(interest, this, m_face);
             m_appLink->onReceiveInterest(*interest);
-            m_tx_bytes += (uint64_t) interest->wireEncode().size();
+            m_tx_bytes += (uint64_t) interest->wireSize();
             m_tx_packets++;
             ScheduleNextPacket();
         }
@@ -245,7 +245,7 @@ namespace ns3 {
             if (entry != m_seqFullDelay.end()) {
                 m_firstInterestDataDelay(this, seq, Simulator::Now() - entry->time, m_seqRetxCounts[seq], hopCount);
             }
-            m_rx_bytes += (uint64_t) (data->wireEncode().size());
+            m_rx_bytes += (uint64_t) (data->wireSize());
             m_rx_packets++;
             m_seqRetxCounts.erase(seq);
             m_seqFullDelay.erase(seq);
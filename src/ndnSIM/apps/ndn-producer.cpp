@@ -105,29 +105,17 @@ namespace ns3 {
             // dataName.append(m_postfix);
             // dataName.appendVersion();
 
-            auto data = make_shared<Data>();
-            data->setName(dataName);
-            data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
-            std::cout<<::ndn::time::milliseconds(m_freshness.GetMilliSeconds()) <<std::endl;
-            data->setContent(make_shared< ::ndn::Buffer>(m_virtualPayloadSize));
-
-            Signature signature;
-            SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue> (255));
-
-            if (m_keyLocator.size() > 0) {
-                signatureInfo.setKeyLocator(m_keyLocator);
+            ::ndn::time::milliseconds freshness(m_freshness.GetMilliSeconds());
+            if (m_template == nullptr ||
+                    !m_template->matches(m_virtualPayloadSize, freshness, m_signature, m_keyLocator)) {
+                // attributes may change at run time; rebuild the pre-encoded part only when they do
+                m_template = make_unique<DataTemplate>(m_virtualPayloadSize, freshness, m_signature, m_keyLocator);
             }
 
-            signature.setInfo(signatureInfo);
-            signature.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, m_signature));
-
-            data->setSignature(signature);
+            shared_ptr<Data> data = m_template->makeData(dataName);
 
             NS_LOG_INFO("node(" << GetNode()->GetId() << ") responding with Data: " << data->getName());
 
-            // to create real wire encoding
-            data->wireEncode();
-
             m_transmittedDatas(data, this, m_face);
             m_appLink->onReceiveData(*data);
         }
@@ -25,6 +25,8 @@
 #include "ndn-app.hpp"
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 
+#include "ns3/ndnSIM/utils/ndn-data-template.hpp"
+
 #include "ns3/nstime.h"
 #include "ns3/ptr.h"
 
@@ -70,6 +72,8 @@ namespace ns3 {
 
             uint32_t m_signature;
             Name m_keyLocator;
+
+            std::unique_ptr<DataTemplate> m_template;
         };
 
     } // namespace ndn
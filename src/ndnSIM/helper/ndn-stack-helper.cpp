@@ -25,9 +25,12 @@
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/point-to-point-channel.h"
 #include "ns3/loopback-net-device.h"
+#include "ns3/mac16-address.h"
+#include "ns3/mac64-address.h"
 
 #include "model/ndn-l3-protocol.hpp"
 #include "model/ndn-net-device-transport.hpp"
+#include "model/ndn-lowpan-link-service.hpp"
 #include "utils/ndn-time.hpp"
 #include "utils/dummy-keychain.hpp"
 #include "model/cs/ndn-content-store.hpp"
@@ -51,7 +54,12 @@ namespace ns3 {
         , m_isForwarderStatusManagerDisabled(false)
         , m_isStrategyChoiceManagerDisabled(false)
         , m_needSetDefaultRoutes(false)
-        , m_maxCsSize(100) {
+        , m_maxCsSize(100)
+        , m_dnlCapacity(0)
+        , m_dnlFalsePositiveRate(0)
+        , m_isMultiAccessSuppressionEnabled(false)
+        , m_shouldCacheOverheardData(false)
+        , m_isLowPanCompressionEnabled(false) {
             setCustomNdnCxxClocks();
 
             m_csPolicies.insert({"nfd::cs::lru", [] {
@@ -67,6 +75,13 @@ namespace ns3 {
             m_netDeviceCallbacks.push_back(
                     std::make_pair(PointToPointNetDevice::GetTypeId(),
                     MakeCallback(&StackHelper::PointToPointNetDeviceCallback, this)));
+            // looked up by name, as ndnSIM does not depend on lr-wpan
+            TypeId lrWpanNetDevice;
+            if (TypeId::LookupByNameFailSafe("ns3::LrWpanNetDevice", &lrWpanNetDevice)) {
+                m_netDeviceCallbacks.push_back(
+                        std::make_pair(lrWpanNetDevice,
+                        MakeCallback(&StackHelper::LrWpanNetDeviceCallback, this)));
+            }
             // default callback will be fired if non of others callbacks fit or did the job
         }
 
@@ -144,6 +159,30 @@ namespace ns3 {
             }
         }
 
+        void
+        StackHelper::setDeadNonceList(const std::string& type, size_t capacity, double falsePositiveRate) {
+            if (type != "classic" && type != "cuckoo") {
+                NS_FATAL_ERROR("Dead Nonce List type " << type << " not found");
+            }
+            m_dnlType = type;
+            m_dnlCapacity = capacity;
+            m_dnlFalsePositiveRate = falsePositiveRate;
+        }
+
+        void
+        StackHelper::setMultiAccessSuppression(bool enable, Time maxBackoff, bool cacheOverheardData) {
+            m_isMultiAccessSuppressionEnabled = enable;
+            m_multiAccessMaxBackoff = maxBackoff;
+            m_shouldCacheOverheardData = enable && cacheOverheardData;
+        }
+
+        void
+        StackHelper::setLowPanCompression(bool enable, const std::vector<Name>& contexts) {
+            NS_ASSERT_MSG(contexts.size() <= LowPanCompressor::MAX_CONTEXTS, "Too many LowPAN prefix contexts");
+            m_isLowPanCompressionEnabled = enable;
+            m_lowPanContexts = contexts;
+        }
+
         Ptr<FaceContainer>
         StackHelper::Install(const NodeContainer& c) const {
             Ptr<FaceContainer> faces = Create<FaceContainer>();
@@ -188,6 +227,25 @@ namespace ns3 {
 
             ndn->getConfig().put("tables.cs_max_packets", (m_maxCsSize == 0) ? 1 : m_maxCsSize);
 
+            if (!m_dnlType.empty()) {
+                ndn->getConfig().put("tables.dead_nonce_list.type", m_dnlType);
+                if (m_dnlCapacity > 0) {
+                    ndn->getConfig().put("tables.dead_nonce_list.capacity", m_dnlCapacity);
+                }
+                if (m_dnlFalsePositiveRate > 0) {
+                    ndn->getConfig().put("tables.dead_nonce_list.false_positive_rate", m_dnlFalsePositiveRate);
+                }
+            }
+
+            if (m_isMultiAccessSuppressionEnabled) {
+                ndn->getConfig().put("tables.multi_access_suppression.enabled", "yes");
+                ndn->getConfig().put("tables.multi_access_suppression.max_backoff",
+                        m_multiAccessMaxBackoff.GetMilliSeconds());
+            }
+            if (m_shouldCacheOverheardData) {
+                ndn->getConfig().put("tables.cs_unsolicited_policy", "admit-multi-access");
+            }
+
             // Create and aggregate content store if NFD's contest store has been disabled
             if (m_maxCsSize == 0) {
                 ndn->AggregateObject(m_contentStoreFactory.Create<ContentStore>());
@@ -237,17 +295,25 @@ namespace ns3 {
             });
         }
 
-        std::string
-        constructFaceUri(Ptr<NetDevice> netDevice) {
+        static std::string
+        constructFaceUri(const Address& address) {
             std::string uri = "netdev://";
-            Address address = netDevice->GetAddress();
             if (Mac48Address::IsMatchingType(address)) {
                 uri += "[" + boost::lexical_cast<std::string>(Mac48Address::ConvertFrom(address)) + "]";
+            } else if (Mac16Address::IsMatchingType(address)) {
+                uri += "[" + boost::lexical_cast<std::string>(Mac16Address::ConvertFrom(address)) + "]";
+            } else if (Mac64Address::IsMatchingType(address)) {
+                uri += "[" + boost::lexical_cast<std::string>(Mac64Address::ConvertFrom(address)) + "]";
             }
 
             return uri;
         }
 
+        std::string
+        constructFaceUri(Ptr<NetDevice> netDevice) {
+            return constructFaceUri(netDevice->GetAddress());
+        }
+
         shared_ptr<Face>
         StackHelper::DefaultNetDeviceCallback(Ptr<Node> node, Ptr<L3Protocol> ndn,
                 Ptr<NetDevice> netDevice) const {
@@ -260,9 +326,15 @@ namespace ns3 {
 
             auto linkService = make_unique<::nfd::face::GenericLinkService>(opts);
 
+            // broadcast media such as LR-WPAN and CSMA are shared by all neighbors
+            ::ndn::nfd::LinkType linkType = (netDevice->IsBroadcast() && !netDevice->IsPointToPoint()) ?
+                    ::ndn::nfd::LINK_TYPE_MULTI_ACCESS : ::ndn::nfd::LINK_TYPE_POINT_TO_POINT;
+
             auto transport = make_unique<NetDeviceTransport>(node, netDevice,
                     constructFaceUri(netDevice),
-                    "netdev://[ff:ff:ff:ff:ff:ff]");
+                    constructFaceUri(netDevice->GetBroadcast()),
+                    ::ndn::nfd::FACE_SCOPE_NON_LOCAL, ::ndn::nfd::FACE_PERSISTENCY_PERSISTENT,
+                    linkType);
 
             auto face = std::make_shared<Face>(std::move(linkService), std::move(transport));
             face->setMetric(1);
@@ -311,6 +383,35 @@ namespace ns3 {
             return face;
         }
 
+        shared_ptr<Face>
+        StackHelper::LrWpanNetDeviceCallback(Ptr<Node> node, Ptr<L3Protocol> ndn,
+                Ptr<NetDevice> netDevice) const {
+            if (!m_isLowPanCompressionEnabled) {
+                return nullptr; // falls back to DefaultNetDeviceCallback
+            }
+            NS_LOG_DEBUG("Creating LowPAN Face on node " << node->GetId());
+
+            LowPanLinkService::Options opts;
+            opts.contexts = m_lowPanContexts;
+
+            auto linkService = make_unique<LowPanLinkService>(opts);
+
+            auto transport = make_unique<NetDeviceTransport>(node, netDevice,
+                    constructFaceUri(netDevice),
+                    constructFaceUri(netDevice->GetBroadcast()),
+                    ::ndn::nfd::FACE_SCOPE_NON_LOCAL, ::ndn::nfd::FACE_PERSISTENCY_PERSISTENT,
+                    ::ndn::nfd::LINK_TYPE_MULTI_ACCESS);
+
+            auto face = std::make_shared<Face>(std::move(linkService), std::move(transport));
+            face->setMetric(1);
+
+            ndn->addFace(face);
+            NS_LOG_LOGIC("Node " << node->GetId() << ": added Face as face #"
+                    << face->getLocalUri());
+
+            return face;
+        }
+
         Ptr<FaceContainer>
         StackHelper::Install(const std::string& nodeName) const {
             Ptr<Node> node = Names::Find<Node>(nodeName);
@@ -87,6 +87,33 @@ namespace ns3 {
             void
             setPolicy(const std::string& policy);
 
+            /**
+             * @brief Select the Dead Nonce List implementation of NFD
+             * @param type "classic" (exact, self-sizing) or "cuckoo" (fixed memory, approximate)
+             * @param capacity cuckoo only: expected number of Nonces per DNL lifetime, 0 for default
+             * @param falsePositiveRate cuckoo only: target false positive rate, 0 for default
+             */
+            void
+            setDeadNonceList(const std::string& type, size_t capacity = 0, double falsePositiveRate = 0);
+
+            /**
+             * @brief Defer transmissions on broadcast (multi-access) faces by a random backoff
+             *        and cancel them when a neighbor is overheard sending the same packet
+             * @param maxBackoff upper bound of the uniform backoff
+             * @param cacheOverheardData admit unsolicited Data overheard on multi-access faces into the CS
+             */
+            void
+            setMultiAccessSuppression(bool enable, Time maxBackoff = MilliSeconds(10),
+                    bool cacheOverheardData = true);
+
+            /**
+             * @brief Compress the Interest and Data sent on IEEE 802.15.4 (LrWpanNetDevice) faces
+             * @param contexts prefix contexts of the links, the same on all the nodes
+             * @sa LowPanLinkService, LowPanCompressor
+             */
+            void
+            setLowPanCompression(bool enable, const std::vector<Name>& contexts = std::vector<Name>());
+
             /**
              * @brief Set ndnSIM 1.0 content store implementation and its attributes
              * @param contentStoreClass string, representing class of the content store
@@ -256,6 +283,11 @@ namespace ns3 {
             shared_ptr<Face>
             PointToPointNetDeviceCallback(Ptr<Node> node, Ptr<L3Protocol> ndn,
                     Ptr<NetDevice> netDevice) const;
+
+            shared_ptr<Face>
+            LrWpanNetDeviceCallback(Ptr<Node> node, Ptr<L3Protocol> ndn,
+                    Ptr<NetDevice> netDevice) const;
+
             shared_ptr<Face>
             createAndRegisterFace(Ptr<Node> node, Ptr<L3Protocol> ndn, Ptr<NetDevice> device) const;
 
@@ -280,6 +312,17 @@ namespace ns3 {
 
             std::map<std::string, PolicyCreationCallback> m_csPolicies;
 
+            std::string m_dnlType;
+            size_t m_dnlCapacity;
+            double m_dnlFalsePositiveRate;
+
+            bool m_isMultiAccessSuppressionEnabled;
+            Time m_multiAccessMaxBackoff;
+            bool m_shouldCacheOverheardData;
+
+            bool m_isLowPanCompressionEnabled;
+            std::vector<Name> m_lowPanContexts;
+
             typedef std::list<std::pair<TypeId, FaceCreateCallback>> NetDeviceCallbackList;
             NetDeviceCallbackList m_netDeviceCallbacks;
         };
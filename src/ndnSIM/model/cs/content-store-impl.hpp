@@ -167,7 +167,7 @@ namespace ns3 {
             //////////////////////////////////////////
 
             template<class Policy>
-            LogComponent ContentStoreImpl<Policy>::g_log = LogComponent(("ndn.cs." + Policy::GetName()).c_str(), __FILE__);
+            LogComponent ContentStoreImpl<Policy>::g_log(("ndn.cs." + Policy::GetName()).c_str(), __FILE__);
 
             template<class Policy>
             TypeId
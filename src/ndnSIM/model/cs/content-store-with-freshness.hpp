@@ -78,7 +78,7 @@ namespace ns3 {
             //////////////////////////////////////////
 
             template<class Policy>
-            LogComponent ContentStoreWithFreshness<Policy>::g_log = LogComponent(("ndn.cs.Freshness."
+            LogComponent ContentStoreWithFreshness<Policy>::g_log(("ndn.cs.Freshness."
                     + Policy::GetName()).c_str(), __FILE__);
 
             template<class Policy>
@@ -79,7 +79,7 @@ namespace ns3 {
             //////////////////////////////////////////
 
             template<class Policy>
-            LogComponent ContentStoreWithStats<Policy>::g_log = LogComponent(("ndn.cs.Stats."
+            LogComponent ContentStoreWithStats<Policy>::g_log(("ndn.cs.Stats."
                     + Policy::GetName()).c_str(), __FILE__);
 
             template<class Policy>
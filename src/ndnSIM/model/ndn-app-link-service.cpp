@@ -44,6 +44,11 @@ namespace ns3 {
             NS_LOG_FUNCTION_NOARGS();
         }
 
+        const AppLinkService::Counters&
+        AppLinkService::getCounters() const {
+            return *this;
+        }
+
         void
         AppLinkService::doSendInterest(const Interest& interest) {
             NS_LOG_FUNCTION(this << &interest);
@@ -55,6 +60,7 @@ namespace ns3 {
         void
         AppLinkService::doSendData(const Data& data) {
             NS_LOG_FUNCTION(this << &data);
+            nOutBytes += data.wireSize();
 
             // to decouple callbacks
             Simulator::ScheduleNow(&App::OnData, m_app, data.shared_from_this());
@@ -72,6 +78,7 @@ namespace ns3 {
 
         void
         AppLinkService::onReceiveInterest(const Interest& interest) {
+            nInBytes += interest.wireSize();
             this->receiveInterest(interest);
         }
 
@@ -32,14 +32,38 @@ namespace ns3 {
 
         class App;
 
+        /**
+         * \brief counters provided by AppLinkService
+         * \note The type name 'AppLinkServiceCounters' is implementation detail.
+         *       Use 'AppLinkService::Counters' in public API.
+         */
+        class AppLinkServiceCounters : public virtual nfd::face::LinkService::Counters {
+        public:
+            /**
+             * \brief wire size of the Interests sent by the application
+             */
+            nfd::ByteCounter nInBytes;
+
+            /**
+             * \brief wire size of the Data delivered to the application
+             */
+            nfd::ByteCounter nOutBytes;
+        };
+
         /**
          * \ingroup ndn-face
          * \brief Implementation of LinkService for ndnSIM application
          *
          * \see NetDeviceLinkService
          */
-        class AppLinkService : public nfd::face::LinkService {
+        class AppLinkService : public nfd::face::LinkService
+        , protected virtual AppLinkServiceCounters {
         public:
+            /**
+             * \brief counters provided by AppLinkService
+             */
+            typedef AppLinkServiceCounters Counters;
+
             /**
              * \brief Default constructor
              */
@@ -47,6 +71,9 @@ namespace ns3 {
 
             virtual ~AppLinkService();
 
+            virtual const Counters&
+            getCounters() const override;
+
         public:
             void
             onReceiveInterest(const Interest& interest);
@@ -18,6 +18,7 @@
  **/
 
 #include "ndn-block-header.hpp"
+#include "ndn-lowpan-compressor.hpp"
 
 #include <iosfwd>
 #include <boost/iostreams/concepts.hpp>
@@ -137,6 +138,19 @@ namespace ns3 {
                         os << ")";
                         break;
                     }
+                    case LowPanCompressor::CompressedInterest:
+                    case LowPanCompressor::CompressedData:
+                    {
+                        os << "LowPAN(";
+                        try {
+                            decodeAndPrint(LowPanCompressor().decompress(block));
+                        } catch (const tlv::Error&) {
+                            // compressed with a prefix context of the link
+                            os << (block.type() == LowPanCompressor::CompressedInterest ? "Interest" : "Data");
+                        }
+                        os << ")";
+                        break;
+                    }
                     default:
                     {
                         os << "Unrecognized";
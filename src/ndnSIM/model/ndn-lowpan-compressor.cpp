@@ -0,0 +1,382 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-lowpan-compressor.hpp"
+
+#include <ndn-cxx/encoding/tlv.hpp>
+#include <ndn-cxx/encoding/block-helpers.hpp>
+
+#include <algorithm>
+#include <cstring>
+
+namespace ns3 {
+    namespace ndn {
+
+        namespace tlv = ::ndn::tlv;
+
+        enum {
+            TOKEN_FIRST = 0xC0,
+            TOKEN_NAME = 0xC0, // | context (0 = none, i = context i - 1)
+            TOKEN_NONCE = 0xD0,
+            TOKEN_MUST_BE_FRESH = 0xD1,
+            TOKEN_META_INFO = 0xD8, // | number of sub-elements
+            TOKEN_INTEGER = 0xE0, // + field * 4 + size code
+            TOKEN_FAKE_SIGNATURE = 0xEC, // + size code
+            TOKEN_LAST = 0xFC,
+
+            COMPONENT_ESCAPE = 0x80, // followed by the component TLV
+            MAX_META_INFO_ELEMENTS = 7
+        };
+
+        /// TLV-TYPE of the fields of TOKEN_INTEGER
+        static const uint32_t INTEGER_FIELDS[] = {
+            tlv::InterestLifetime, tlv::ContentType, tlv::FreshnessPeriod
+        };
+
+        /// SignatureInfo of the fake signature
+        static const uint8_t FAKE_SIGNATURE_INFO[] = {
+            tlv::SignatureInfo, 3, tlv::SignatureType, 1, 255
+        };
+
+        static const uint8_t MUST_BE_FRESH_SELECTORS[] = {
+            tlv::Selectors, 2, tlv::MustBeFresh, 0
+        };
+
+        static bool
+        isToken(uint32_t type) {
+            return type >= TOKEN_FIRST && type <= TOKEN_LAST;
+        }
+
+        /**
+         * \return whether the TLV-TYPE and TLV-LENGTH of the element are encoded
+         *         as the decompression would encode them
+         */
+        static bool
+        hasMinimalHeader(const Block& element) {
+            return element.size() == tlv::sizeOfVarNumber(element.type()) +
+                    tlv::sizeOfVarNumber(element.value_size()) + element.value_size();
+        }
+
+        /**
+         * \return the size code of an integer value (1, 2, 4 or 8 bytes), or -1
+         */
+        static int
+        getSizeCode(size_t size) {
+            switch (size) {
+                case 1: return 0;
+                case 2: return 1;
+                case 4: return 2;
+                case 8: return 3;
+                default: return -1;
+            }
+        }
+
+        static void
+        appendVarNumber(std::vector<uint8_t>& out, uint64_t number) {
+            if (number < 253) {
+                out.push_back(static_cast<uint8_t> (number));
+                return;
+            }
+
+            size_t size;
+            if (number <= 0xFFFF) {
+                out.push_back(253);
+                size = 2;
+            } else if (number <= 0xFFFFFFFF) {
+                out.push_back(254);
+                size = 4;
+            } else {
+                out.push_back(255);
+                size = 8;
+            }
+            for (size_t i = size; i > 0; --i) {
+                out.push_back(static_cast<uint8_t> (number >> (8 * (i - 1))));
+            }
+        }
+
+        static void
+        appendTlv(std::vector<uint8_t>& out, uint32_t type, const uint8_t* value, size_t size) {
+            appendVarNumber(out, type);
+            appendVarNumber(out, size);
+            out.insert(out.end(), value, value + size);
+        }
+
+        static void
+        append(std::vector<uint8_t>& out, const Block& element) {
+            out.insert(out.end(), element.begin(), element.end());
+        }
+
+        static const uint8_t*
+        take(const uint8_t*& begin, const uint8_t* end, size_t size) {
+            if (static_cast<size_t> (end - begin) < size) {
+                throw tlv::Error("Truncated compressed packet");
+            }
+            const uint8_t* first = begin;
+            begin += size;
+            return first;
+        }
+
+        void
+        LowPanCompressor::addContext(const Name& prefix) {
+            if (m_contexts.size() >= MAX_CONTEXTS) {
+                throw std::length_error("Too many LowPAN prefix contexts");
+            }
+            m_contexts.push_back(prefix);
+
+            const Block& wire = prefix.wireEncode();
+            wire.parse();
+            m_contextComponents.push_back(wire.elements());
+        }
+
+        bool
+        LowPanCompressor::compressName(const Block& name, std::vector<uint8_t>& out) const {
+            if (!hasMinimalHeader(name)) {
+                return false;
+            }
+            name.parse();
+            const Block::element_container& components = name.elements();
+
+            // longest context whose components are the first ones of the name, byte for byte
+            size_t context = 0;
+            size_t nSkipped = 0;
+            for (size_t i = 0; i < m_contextComponents.size(); ++i) {
+                const Block::element_container& prefix = m_contextComponents[i];
+                if (prefix.size() <= nSkipped || prefix.size() > components.size()) {
+                    continue;
+                }
+                bool isPrefix = std::equal(prefix.begin(), prefix.end(), components.begin(),
+                        [] (const Block& a, const Block& b) {
+                            return a.size() == b.size() && std::memcmp(a.wire(), b.wire(), a.size()) == 0;
+                        });
+                if (isPrefix) {
+                    context = i + 1;
+                    nSkipped = prefix.size();
+                }
+            }
+
+            if (components.size() - nSkipped > 0xFF) {
+                return false;
+            }
+            out.push_back(static_cast<uint8_t> (TOKEN_NAME | context));
+            out.push_back(static_cast<uint8_t> (components.size() - nSkipped));
+
+            for (size_t i = nSkipped; i < components.size(); ++i) {
+                const Block& component = components[i];
+                if (component.type() == tlv::NameComponent && component.value_size() < COMPONENT_ESCAPE &&
+                        component.size() == 2 + component.value_size()) {
+                    out.push_back(static_cast<uint8_t> (component.value_size()));
+                    out.insert(out.end(), component.value_begin(), component.value_end());
+                } else {
+                    out.push_back(COMPONENT_ESCAPE);
+                    append(out, component);
+                }
+            }
+            return true;
+        }
+
+        bool
+        LowPanCompressor::compressElement(const Block& element, std::vector<uint8_t>& out) const {
+            if (isToken(element.type())) {
+                // would be taken for a token
+                return false;
+            }
+
+            bool isMinimal = hasMinimalHeader(element);
+            switch (element.type()) {
+                case tlv::Name:
+                {
+                    size_t size = out.size();
+                    if (compressName(element, out)) {
+                        return true;
+                    }
+                    out.resize(size);
+                    break;
+                }
+                case tlv::Nonce:
+                    if (isMinimal && element.value_size() == 4) {
+                        out.push_back(TOKEN_NONCE);
+                        out.insert(out.end(), element.value_begin(), element.value_end());
+                        return true;
+                    }
+                    break;
+                case tlv::Selectors:
+                    if (element.size() == sizeof(MUST_BE_FRESH_SELECTORS) &&
+                            std::equal(element.begin(), element.end(), MUST_BE_FRESH_SELECTORS)) {
+                        out.push_back(TOKEN_MUST_BE_FRESH);
+                        return true;
+                    }
+                    break;
+                case tlv::InterestLifetime:
+                case tlv::ContentType:
+                case tlv::FreshnessPeriod:
+                {
+                    int sizeCode = getSizeCode(element.value_size());
+                    if (isMinimal && sizeCode >= 0) {
+                        size_t field = std::find(std::begin(INTEGER_FIELDS), std::end(INTEGER_FIELDS),
+                                element.type()) - std::begin(INTEGER_FIELDS);
+                        out.push_back(static_cast<uint8_t> (TOKEN_INTEGER + field * 4 + sizeCode));
+                        out.insert(out.end(), element.value_begin(), element.value_end());
+                        return true;
+                    }
+                    break;
+                }
+                case tlv::MetaInfo:
+                    if (isMinimal) {
+                        element.parse();
+                        if (element.elements_size() <= MAX_META_INFO_ELEMENTS) {
+                            out.push_back(static_cast<uint8_t> (TOKEN_META_INFO | element.elements_size()));
+                            for (const Block& subElement : element.elements()) {
+                                if (!compressElement(subElement, out)) {
+                                    return false;
+                                }
+                            }
+                            return true;
+                        }
+                    }
+                    break;
+                default:
+                    break;
+            }
+
+            append(out, element);
+            return true;
+        }
+
+        Block
+        LowPanCompressor::compress(const Block& netPkt) const {
+            if ((netPkt.type() != tlv::Interest && netPkt.type() != tlv::Data) || !hasMinimalHeader(netPkt)) {
+                return netPkt;
+            }
+            netPkt.parse();
+            const Block::element_container& elements = netPkt.elements();
+
+            std::vector<uint8_t> out;
+            out.reserve(netPkt.value_size());
+            for (auto element = elements.begin(); element != elements.end(); ++element) {
+                auto next = element + 1;
+                if (element->type() == tlv::SignatureInfo && next != elements.end() &&
+                        next->type() == tlv::SignatureValue) {
+                    int sizeCode = getSizeCode(next->value_size());
+                    if (element->size() == sizeof(FAKE_SIGNATURE_INFO) &&
+                            std::equal(element->begin(), element->end(), FAKE_SIGNATURE_INFO) &&
+                            hasMinimalHeader(*next) && sizeCode >= 0) {
+                        out.push_back(static_cast<uint8_t> (TOKEN_FAKE_SIGNATURE + sizeCode));
+                        out.insert(out.end(), next->value_begin(), next->value_end());
+                        element = next;
+                        continue;
+                    }
+                }
+
+                if (!compressElement(*element, out)) {
+                    return netPkt;
+                }
+            }
+
+            Block compressed = ::ndn::encoding::makeBinaryBlock(netPkt.type() == tlv::Interest ?
+                    CompressedInterest : CompressedData, out.data(), out.size());
+            if (compressed.size() >= netPkt.size()) {
+                return netPkt;
+            }
+            return compressed;
+        }
+
+        void
+        LowPanCompressor::decompressElement(const uint8_t*& begin, const uint8_t* end,
+                std::vector<uint8_t>& out) const {
+            const uint8_t* first = begin;
+            uint8_t token = *take(begin, end, 1);
+
+            if (!isToken(token)) {
+                // element copied as it was
+                begin = first;
+                uint64_t type;
+                uint64_t length;
+                if (!tlv::readVarNumber(begin, end, type) || !tlv::readVarNumber(begin, end, length)) {
+                    throw tlv::Error("Truncated compressed packet");
+                }
+                take(begin, end, length);
+                out.insert(out.end(), first, begin);
+                return;
+            }
+
+            std::vector<uint8_t> value;
+            if (token < TOKEN_NAME + 0x10) {
+                size_t context = token & 0x0F;
+                if (context > m_contextComponents.size()) {
+                    throw tlv::Error("Unknown LowPAN prefix context");
+                }
+                if (context > 0) {
+                    for (const Block& component : m_contextComponents[context - 1]) {
+                        append(value, component);
+                    }
+                }
+
+                size_t nComponents = *take(begin, end, 1);
+                for (size_t i = 0; i < nComponents; ++i) {
+                    size_t size = *take(begin, end, 1);
+                    if (size < COMPONENT_ESCAPE) {
+                        appendTlv(value, tlv::NameComponent, take(begin, end, size), size);
+                    } else if (size == COMPONENT_ESCAPE) {
+                        decompressElement(begin, end, value);
+                    } else {
+                        throw tlv::Error("Invalid compressed name component");
+                    }
+                }
+                appendTlv(out, tlv::Name, value.data(), value.size());
+            } else if (token == TOKEN_NONCE) {
+                appendTlv(out, tlv::Nonce, take(begin, end, 4), 4);
+            } else if (token == TOKEN_MUST_BE_FRESH) {
+                out.insert(out.end(), std::begin(MUST_BE_FRESH_SELECTORS), std::end(MUST_BE_FRESH_SELECTORS));
+            } else if (token >= TOKEN_META_INFO && token <= TOKEN_META_INFO + MAX_META_INFO_ELEMENTS) {
+                for (size_t i = 0; i < static_cast<size_t> (token - TOKEN_META_INFO); ++i) {
+                    decompressElement(begin, end, value);
+                }
+                appendTlv(out, tlv::MetaInfo, value.data(), value.size());
+            } else if (token >= TOKEN_INTEGER && token < TOKEN_INTEGER + 4 * 3) {
+                size_t size = 1 << ((token - TOKEN_INTEGER) % 4);
+                appendTlv(out, INTEGER_FIELDS[(token - TOKEN_INTEGER) / 4], take(begin, end, size), size);
+            } else if (token >= TOKEN_FAKE_SIGNATURE && token < TOKEN_FAKE_SIGNATURE + 4) {
+                size_t size = 1 << (token - TOKEN_FAKE_SIGNATURE);
+                out.insert(out.end(), std::begin(FAKE_SIGNATURE_INFO), std::end(FAKE_SIGNATURE_INFO));
+                appendTlv(out, tlv::SignatureValue, take(begin, end, size), size);
+            } else {
+                throw tlv::Error("Unknown LowPAN token");
+            }
+        }
+
+        Block
+        LowPanCompressor::decompress(const Block& block) const {
+            if (!isCompressed(block)) {
+                throw tlv::Error("Not a compressed Interest or Data");
+            }
+
+            std::vector<uint8_t> out;
+            out.reserve(block.value_size() + 32);
+            const uint8_t* begin = block.value();
+            const uint8_t* end = begin + block.value_size();
+            while (begin != end) {
+                decompressElement(begin, end, out);
+            }
+
+            return ::ndn::encoding::makeBinaryBlock(block.type() == CompressedInterest ?
+                    tlv::Interest : tlv::Data, out.data(), out.size());
+        }
+
+    } // namespace ndn
+} // namespace ns3
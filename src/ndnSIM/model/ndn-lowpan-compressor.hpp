@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_LOWPAN_COMPRESSOR_HPP
+#define NDN_LOWPAN_COMPRESSOR_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <vector>
+
+namespace ns3 {
+    namespace ndn {
+
+        /**
+         * \ingroup ndn-face
+         * \brief Lossless compression of the TLV framing of Interest and Data, for
+         *        links with small frames such as IEEE 802.15.4
+         *
+         * The elements of the packet are replaced by one-byte tokens in the
+         * 0xC0-0xFC range, which carry the TLV-TYPE and imply or shorten the
+         * TLV-LENGTH:
+         *
+         * - Name: the components are encoded as a length byte and the value, the
+         *   longest matching prefix context of the link is replaced by its index;
+         * - Nonce: the 4 bytes of the value;
+         * - Selectors with only MustBeFresh: the token alone;
+         * - InterestLifetime, ContentType and FreshnessPeriod: the size of the
+         *   integer in the token, then its bytes;
+         * - MetaInfo: the number of sub-elements in the token, then the elements;
+         * - the fake signature of ndnSIM (SignatureInfo of type 255 without
+         *   KeyLocator, and an integer SignatureValue): the size of the integer in
+         *   the token, then its bytes.
+         *
+         * Other elements are copied as they are, their TLV-TYPE being below 0xC0.
+         * The result is a TLV block of type CompressedInterest or CompressedData,
+         * which decompresses into the very same bytes as the original packet.
+         *
+         * Both ends of a link must use the same prefix contexts, as with the
+         * contexts of 6LoWPAN (RFC 6282).
+         */
+        class LowPanCompressor {
+        public:
+            /**
+             * \brief TLV-TYPE of the compressed packets (application range)
+             */
+            enum {
+                CompressedInterest = 0x85,
+                CompressedData = 0x86
+            };
+
+            /**
+             * \brief Maximum number of prefix contexts of a link
+             */
+            static const size_t MAX_CONTEXTS = 15;
+
+            /**
+             * \brief Add a prefix context
+             *
+             * Names under several contexts use the longest one.
+             */
+            void
+            addContext(const Name& prefix);
+
+            const std::vector<Name>&
+            getContexts() const;
+
+            /**
+             * \brief Compress an Interest or Data
+             * \return the compressed block, or \p netPkt if it cannot be made smaller
+             */
+            Block
+            compress(const Block& netPkt) const;
+
+            /**
+             * \brief Restore an Interest or Data from its compressed block
+             * \throw tlv::Error the block is malformed or uses an unknown context
+             */
+            Block
+            decompress(const Block& block) const;
+
+            static bool
+            isCompressed(const Block& block);
+
+        private:
+            bool
+            compressElement(const Block& element, std::vector<uint8_t>& out) const;
+
+            bool
+            compressName(const Block& name, std::vector<uint8_t>& out) const;
+
+            void
+            decompressElement(const uint8_t*& begin, const uint8_t* end, std::vector<uint8_t>& out) const;
+
+        private:
+            std::vector<Name> m_contexts;
+            std::vector<Block::element_container> m_contextComponents;
+        };
+
+        inline const std::vector<Name>&
+        LowPanCompressor::getContexts() const {
+            return m_contexts;
+        }
+
+        inline bool
+        LowPanCompressor::isCompressed(const Block& block) {
+            return block.type() == CompressedInterest || block.type() == CompressedData;
+        }
+
+    } // namespace ndn
+} // namespace ns3
+
+#endif // NDN_LOWPAN_COMPRESSOR_HPP
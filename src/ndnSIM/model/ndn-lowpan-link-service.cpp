@@ -0,0 +1,79 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-lowpan-link-service.hpp"
+
+#include "ns3/log.h"
+
+NS_LOG_COMPONENT_DEFINE("ndn.LowPanLinkService");
+
+namespace ns3 {
+    namespace ndn {
+
+        LowPanLinkService::Options::Options()
+        : allowCompression(true) {
+            allowFragmentation = true;
+            allowReassembly = true;
+        }
+
+        LowPanLinkService::LowPanLinkService(const LowPanLinkService::Options& options)
+        : GenericLinkServiceCounters(m_reassembler)
+        , GenericLinkService(options)
+        , m_allowCompression(options.allowCompression) {
+            for (const Name& prefix : options.contexts) {
+                m_compressor.addContext(prefix);
+            }
+        }
+
+        Block
+        LowPanLinkService::compressNetPacket(const Block& netPkt) {
+            if (!m_allowCompression) {
+                return netPkt;
+            }
+
+            Block compressed = m_compressor.compress(netPkt);
+            if (compressed.size() < netPkt.size()) {
+                ++this->nOutCompressed;
+                this->nOutBytesSaved += netPkt.size() - compressed.size();
+            }
+            return compressed;
+        }
+
+        bool
+        LowPanLinkService::decompressNetPacket(Block& netPkt) {
+            if (!LowPanCompressor::isCompressed(netPkt)) {
+                return true;
+            }
+
+            Block decompressed;
+            try {
+                decompressed = m_compressor.decompress(netPkt);
+            } catch (const ::ndn::tlv::Error& e) {
+                ++this->nInDecompressionErrors;
+                NS_LOG_WARN("decompression error (" << e.what() << "): DROP");
+                return false;
+            }
+            ++this->nInCompressed;
+            this->nInBytesSaved += decompressed.size() - netPkt.size();
+            netPkt = decompressed;
+            return true;
+        }
+
+    } // namespace ndn
+} // namespace ns3
@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_LOWPAN_LINK_SERVICE_HPP
+#define NDN_LOWPAN_LINK_SERVICE_HPP
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/model/ndn-lowpan-compressor.hpp"
+#include "ns3/ndnSIM/NFD/daemon/face/generic-link-service.hpp"
+
+namespace ns3 {
+    namespace ndn {
+
+        /**
+         * \brief counters provided by LowPanLinkService, in addition to those of GenericLinkService
+         * \note The type name 'LowPanLinkServiceCounters' is implementation detail.
+         *       Use 'LowPanLinkService::LowPanCounters' in public API.
+         */
+        class LowPanLinkServiceCounters {
+        public:
+            /**
+             * \brief count of network-layer packets sent compressed
+             */
+            nfd::PacketCounter nOutCompressed;
+
+            /**
+             * \brief bytes removed by the compression of the outgoing packets
+             */
+            nfd::ByteCounter nOutBytesSaved;
+
+            /**
+             * \brief count of compressed network-layer packets received
+             */
+            nfd::PacketCounter nInCompressed;
+
+            /**
+             * \brief bytes restored by the decompression of the incoming packets
+             */
+            nfd::ByteCounter nInBytesSaved;
+
+            /**
+             * \brief count of compressed network-layer packets that could not be decompressed
+             */
+            nfd::PacketCounter nInDecompressionErrors;
+        };
+
+        /**
+         * \ingroup ndn-face
+         * \brief NDNLPv2 link service for IEEE 802.15.4 and other links with small frames
+         *
+         * As SixLowPanNetDevice does for IPv6, the link service compresses the
+         * Interest and Data (see LowPanCompressor) before NDNLP fragments them to
+         * the MTU of the transport, and decompresses them after reassembly.
+         * Uncompressed packets are accepted too.  Everything else is done by
+         * GenericLinkService.
+         */
+        class LowPanLinkService : public nfd::face::GenericLinkService
+        , protected LowPanLinkServiceCounters {
+        public:
+
+            /**
+             * \brief Options that control the behavior of LowPanLinkService
+             *
+             * Fragmentation and reassembly are enabled by default.
+             */
+            class Options : public nfd::face::GenericLinkService::Options {
+            public:
+                Options();
+
+            public:
+                /**
+                 * \brief enables the compression of outgoing packets
+                 */
+                bool allowCompression;
+
+                /**
+                 * \brief prefix contexts of the link, the same at both ends
+                 */
+                std::vector<Name> contexts;
+            };
+
+            /**
+             * \brief counters provided by LowPanLinkService
+             */
+            typedef LowPanLinkServiceCounters LowPanCounters;
+
+            explicit
+            LowPanLinkService(const Options& options = Options());
+
+            const LowPanCounters&
+            getLowPanCounters() const;
+
+        protected:
+            virtual Block
+            compressNetPacket(const Block& netPkt) override;
+
+            virtual bool
+            decompressNetPacket(Block& netPkt) override;
+
+        private:
+            bool m_allowCompression;
+            LowPanCompressor m_compressor;
+        };
+
+        inline const LowPanLinkService::LowPanCounters&
+        LowPanLinkService::getLowPanCounters() const {
+            return *this;
+        }
+
+    } // namespace ndn
+} // namespace ns3
+
+#endif // NDN_LOWPAN_LINK_SERVICE_HPP
@@ -22,10 +22,17 @@
 #include "../helper/ndn-stack-helper.hpp"
 #include "ndn-block-header.hpp"
 #include "../utils/ndn-ns3-packet-tag.hpp"
+#include "ndn-lowpan-compressor.hpp"
+
+#include "ns3/socket.h"
 
 #include <ndn-cxx/encoding/block.hpp>
 #include <ndn-cxx/interest.hpp>
 #include <ndn-cxx/data.hpp>
+#include <ndn-cxx/lp/tlv.hpp>
+#include <ndn-cxx/encoding/block-helpers.hpp>
+
+#include <algorithm>
 
 NS_LOG_COMPONENT_DEFINE("ndn.NetDeviceTransport");
 
@@ -46,13 +53,15 @@ namespace ns3 {
             this->setScope(scope);
             this->setPersistency(persistency);
             this->setLinkType(linkType);
-            // this->setMtu(udp::computeMtu(m_socket.local_endpoint())); // not sure what should be here
 
             NS_LOG_FUNCTION(this << "Creating an ndnSIM transport instance for netDevice with URI"
                     << this->getLocalUri());
 
             NS_ASSERT_MSG(m_netDevice != 0, "NetDeviceFace needs to be assigned a valid NetDevice");
 
+            // the link service fragments the packets that do not fit in a frame of the device
+            this->setMtu(m_netDevice->GetMtu());
+
             m_node->RegisterProtocolHandler(MakeCallback(&NetDeviceTransport::receiveFromNetDevice, this),
                     0, m_netDevice,
                     false /*promiscuous mode*/);
@@ -89,11 +98,49 @@ namespace ns3 {
             Ptr<ns3::Packet> ns3Packet = Create<ns3::Packet>();
             ns3Packet->AddHeader(header);
 
+            if (isControlPacket(packet.packet)) {
+                SocketPriorityTag priorityTag;
+                priorityTag.SetPriority(Socket::NS3_PRIO_CONTROL);
+                ns3Packet->AddPacketTag(priorityTag);
+            }
+
             // send the NS3 packet
             m_netDevice->Send(ns3Packet, m_netDevice->GetBroadcast(),
                     L3Protocol::ETHERNET_FRAME_TYPE);
         }
 
+        bool
+        NetDeviceTransport::isControlPacket(const Block& wire) {
+            if (wire.type() == ::ndn::tlv::Interest || wire.type() == LowPanCompressor::CompressedInterest) {
+                return true;
+            }
+            if (wire.type() != ::ndn::lp::tlv::LpPacket) {
+                return false;
+            }
+
+            Block lpPacket = wire;
+            lpPacket.parse();
+            for (const Block& element : lpPacket.elements()) {
+                switch (element.type()) {
+                    case ::ndn::lp::tlv::Nack:
+                        return true;
+                    case ::ndn::lp::tlv::FragIndex:
+                        // only the first fragment tells the type of the network packet
+                        if (::ndn::readNonNegativeInteger(element) != 0) {
+                            return false;
+                        }
+                        break;
+                    case ::ndn::lp::tlv::Fragment:
+                        return element.value_size() > 0 &&
+                                (*element.value_begin() == ::ndn::tlv::Interest ||
+                                *element.value_begin() == LowPanCompressor::CompressedInterest);
+                    default:
+                        break;
+                }
+            }
+            return false;
+        }
+
         // callback
 
         void
@@ -112,6 +159,13 @@ namespace ns3 {
 
             auto nfdPacket = Packet(std::move(header.getBlock()));
 
+            // fragments are reassembled per sender, several of which share broadcast media
+            uint8_t buffer[Address::MAX_SIZE] = {0};
+            uint32_t size = from.CopyTo(buffer);
+            for (uint32_t i = 0; i < std::min<uint32_t>(size, sizeof(nfdPacket.remoteEndpoint)); ++i) {
+                nfdPacket.remoteEndpoint = (nfdPacket.remoteEndpoint << 8) | buffer[i];
+            }
+
             this->receive(std::move(nfdPacket));
         }
 
@@ -53,6 +53,17 @@ namespace ns3 {
             Ptr<NetDevice>
             GetNetDevice() const;
 
+            /**
+             * \brief Whether a packet sent by the link service is control traffic
+             *
+             * Interests and Nacks are control traffic, bare or in an LpPacket; only
+             * the first fragment of a fragmented Interest is. The frames are marked
+             * with a SocketPriorityTag of NS3_PRIO_CONTROL, which MACs with a
+             * prioritizing transmit queue (LrWpanMac) read.
+             */
+            static bool
+            isControlPacket(const Block& wire);
+
         private:
             virtual void
             beforeChangePersistency(::ndn::nfd::FacePersistency newPersistency) override;
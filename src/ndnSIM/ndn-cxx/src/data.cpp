@@ -34,14 +34,16 @@ namespace ndn {
 
     Data::Data()
     : m_content(tlv::Content) // empty content
-    {
+    , m_wireSize(0) {
     }
 
     Data::Data(const Name& name)
-    : m_name(name) {
+    : m_name(name)
+    , m_wireSize(0) {
     }
 
-    Data::Data(const Block& wire) {
+    Data::Data(const Block& wire)
+    : m_wireSize(0) {
         wireDecode(wire);
     }
 
@@ -112,16 +114,25 @@ namespace ndn {
         if (m_wire.hasWire())
             return m_wire;
 
-        EncodingEstimator estimator;
-        size_t estimatedSize = wireEncode(estimator);
-
-        EncodingBuffer buffer(estimatedSize, 0);
+        EncodingBuffer buffer(wireSize(), 0);
         wireEncode(buffer);
 
         const_cast<Data*> (this)->wireDecode(buffer.block());
         return m_wire;
     }
 
+    size_t
+    Data::wireSize() const {
+        if (m_wire.hasWire())
+            return m_wire.size();
+
+        if (m_wireSize == 0) {
+            EncodingEstimator estimator;
+            m_wireSize = wireEncode(estimator);
+        }
+        return m_wireSize;
+    }
+
     void
     Data::wireDecode(const Block& wire) {
         m_fullName.clear();
@@ -158,7 +169,13 @@ namespace ndn {
 
     Data&
     Data::setName(const Name& name) {
-        onChanged();
+        if (m_wire.hasWire() && m_wire.elements_begin()->type() == tlv::Name) {
+            // the other elements, including the signature, are kept as they are
+            m_wire = replaceSubElement(m_wire, m_wire.elements_begin(), name.wireEncode());
+            m_fullName.clear();
+        } else {
+            onChanged();
+        }
         m_name = name;
 
         return *this;
@@ -275,6 +292,7 @@ namespace ndn {
         // the application to do proper re-signing if necessary
 
         m_wire.reset();
+        m_wireSize = 0;
         m_fullName.clear();
     }
 
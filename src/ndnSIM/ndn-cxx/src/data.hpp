@@ -104,6 +104,16 @@ namespace ndn {
         const Block&
         wireEncode() const;
 
+        /**
+         * @brief Get the size of the wire format
+         *
+         * The size is estimated without encoding the Data when it has no wire format yet,
+         * and kept until the Data changes; wireEncode() then uses it to size the buffer
+         * instead of estimating again.
+         */
+        size_t
+        wireSize() const;
+
         /**
          * @brief Finalize Data packet encoding with the specified SignatureValue
          *
@@ -149,6 +159,9 @@ namespace ndn {
         /**
          * @brief Set name to a copy of the given Name
          *
+         * If wire format already exists, the new Name is spliced into it in place of the old
+         * one, and the other elements, including the signature, are kept as they are.
+         *
          * @return This Data so that you can chain calls to update values
          */
         Data&
@@ -301,6 +314,7 @@ namespace ndn {
         Signature m_signature;
 
         mutable Block m_wire;
+        mutable size_t m_wireSize;
         mutable Name m_fullName;
     };
 
@@ -0,0 +1,143 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "block-element-allocator.hpp"
+
+#include <new>
+
+namespace ndn {
+    namespace encoding {
+
+        const size_t BlockElementPool::MIN_SIZE;
+        const size_t BlockElementPool::N_CLASSES;
+
+        namespace {
+
+            /** @brief free lists of a thread
+             */
+            struct FreeLists {
+                struct Node {
+                    Node* next;
+                };
+
+                FreeLists()
+                : maxCached(256)
+                , nHeapAllocations(0) {
+                    for (size_t i = 0; i < BlockElementPool::N_CLASSES; ++i) {
+                        heads[i] = nullptr;
+                        counts[i] = 0;
+                    }
+                }
+
+                ~FreeLists() {
+                    // Blocks of static storage may still be released by the thread
+                    maxCached = 0;
+                    for (size_t i = 0; i < BlockElementPool::N_CLASSES; ++i) {
+                        release(i, 0);
+                    }
+                }
+
+                /** @brief free the blocks of a class beyond the first \p keep
+                 */
+                void
+                release(size_t sizeClass, size_t keep) {
+                    while (counts[sizeClass] > keep) {
+                        Node* node = heads[sizeClass];
+                        heads[sizeClass] = node->next;
+                        --counts[sizeClass];
+                        ::operator delete(node);
+                    }
+                }
+
+                Node* heads[BlockElementPool::N_CLASSES];
+                size_t counts[BlockElementPool::N_CLASSES];
+                size_t maxCached;
+                uint64_t nHeapAllocations;
+            };
+
+            thread_local FreeLists t_freeLists;
+
+            /** @return the size class of \p size, N_CLASSES if it is too large for one
+             */
+            inline size_t
+            getSizeClass(size_t size) {
+                size_t sizeClass = 0;
+                size_t classSize = BlockElementPool::MIN_SIZE;
+                while (classSize < size && sizeClass < BlockElementPool::N_CLASSES) {
+                    classSize <<= 1;
+                    ++sizeClass;
+                }
+                return sizeClass;
+            }
+
+        } // namespace
+
+        void*
+        BlockElementPool::allocate(size_t size) {
+            FreeLists& lists = t_freeLists;
+            size_t sizeClass = getSizeClass(size);
+            if (sizeClass == N_CLASSES) {
+                ++lists.nHeapAllocations;
+                return ::operator new(size);
+            }
+
+            FreeLists::Node* node = lists.heads[sizeClass];
+            if (node != nullptr) {
+                lists.heads[sizeClass] = node->next;
+                --lists.counts[sizeClass];
+                return node;
+            }
+
+            ++lists.nHeapAllocations;
+            return ::operator new(MIN_SIZE << sizeClass);
+        }
+
+        void
+        BlockElementPool::deallocate(void* p, size_t size) {
+            FreeLists& lists = t_freeLists;
+            size_t sizeClass = getSizeClass(size);
+            if (sizeClass == N_CLASSES || lists.counts[sizeClass] >= lists.maxCached) {
+                ::operator delete(p);
+                return;
+            }
+
+            FreeLists::Node* node = static_cast<FreeLists::Node*> (p);
+            node->next = lists.heads[sizeClass];
+            lists.heads[sizeClass] = node;
+            ++lists.counts[sizeClass];
+        }
+
+        void
+        BlockElementPool::setMaxCached(size_t maxCached) {
+            FreeLists& lists = t_freeLists;
+            lists.maxCached = maxCached;
+            for (size_t i = 0; i < N_CLASSES; ++i) {
+                lists.release(i, maxCached);
+            }
+        }
+
+        uint64_t
+        BlockElementPool::getNHeapAllocations() {
+            return t_freeLists.nHeapAllocations;
+        }
+
+    } // namespace encoding
+} // namespace ndn
@@ -0,0 +1,107 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2016 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_ENCODING_BLOCK_ELEMENT_ALLOCATOR_HPP
+#define NDN_ENCODING_BLOCK_ELEMENT_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ndn {
+    namespace encoding {
+
+        /** @brief Per-thread free lists of the storage of Block sub-elements
+         *
+         *  Storage is handed out in power-of-two size classes, and kept on the free list
+         *  of its class when released, so that the next packets of the same shape parse
+         *  without calling the heap allocator.  Storage released by another thread than
+         *  the one which allocated it simply joins the lists of the releasing thread.
+         */
+        class BlockElementPool {
+        public:
+            /** @brief smallest size class, in bytes
+             */
+            static const size_t MIN_SIZE = 64;
+
+            /** @brief number of size classes; larger storage goes to the heap directly
+             */
+            static const size_t N_CLASSES = 10;
+
+            static void*
+            allocate(size_t size);
+
+            static void
+            deallocate(void* p, size_t size);
+
+            /** @brief set how many free blocks of each size class the calling thread keeps
+             *
+             *  0 disables the free lists, every allocation then goes to the heap.
+             */
+            static void
+            setMaxCached(size_t maxCached);
+
+            /** @brief number of allocations of the calling thread served by the heap
+             */
+            static uint64_t
+            getNHeapAllocations();
+        };
+
+        /** @brief Allocator of Block::element_container, drawing from BlockElementPool
+         */
+        template<class T>
+        class BlockElementAllocator {
+        public:
+            typedef T value_type;
+
+            BlockElementAllocator() noexcept {
+            }
+
+            template<class U>
+            BlockElementAllocator(const BlockElementAllocator<U>&) noexcept {
+            }
+
+            T*
+            allocate(size_t n) {
+                return static_cast<T*> (BlockElementPool::allocate(n * sizeof(T)));
+            }
+
+            void
+            deallocate(T* p, size_t n) noexcept {
+                BlockElementPool::deallocate(p, n * sizeof(T));
+            }
+        };
+
+        template<class T, class U>
+        inline bool
+        operator==(const BlockElementAllocator<T>&, const BlockElementAllocator<U>&) noexcept {
+            return true;
+        }
+
+        template<class T, class U>
+        inline bool
+        operator!=(const BlockElementAllocator<T>&, const BlockElementAllocator<U>&) noexcept {
+            return false;
+        }
+
+    } // namespace encoding
+} // namespace ndn
+
+#endif // NDN_ENCODING_BLOCK_ELEMENT_ALLOCATOR_HPP
@@ -144,5 +144,28 @@ namespace ndn {
             return makeBinaryBlock(type, reinterpret_cast<const uint8_t*> (value), length);
         }
 
+        ////////
+
+        Block
+        replaceSubElement(const Block& wire, Block::element_const_iterator element, const Block& newElement) {
+            size_t valueLength = wire.value_size() - element->size() + newElement.size();
+
+            EncodingEstimator estimator;
+            size_t totalLength = valueLength;
+            totalLength += estimator.prependVarNumber(valueLength);
+            totalLength += estimator.prependVarNumber(wire.type());
+
+            EncodingBuffer encoder(totalLength, 0);
+            encoder.prependRange(element->end(), wire.value_end());
+            encoder.prependBlock(newElement);
+            encoder.prependRange(wire.value_begin(), element->begin());
+            encoder.prependVarNumber(valueLength);
+            encoder.prependVarNumber(wire.type());
+
+            Block result = encoder.block();
+            result.parse();
+            return result;
+        }
+
     } // namespace encoding
 } // namespace ndn
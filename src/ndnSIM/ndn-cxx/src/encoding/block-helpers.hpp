@@ -213,6 +213,19 @@ namespace ndn {
             return encoder.block();
         }
 
+        ////////
+
+        /**
+         * @brief Create a copy of @p wire in which the sub-element @p element is replaced by @p newElement
+         *
+         * The other sub-elements are copied as they are, without being encoded again.
+         * The returned block is parsed.
+         *
+         * @pre @p wire is parsed and @p element is one of its sub-elements
+         */
+        Block
+        replaceSubElement(const Block& wire, Block::element_const_iterator element, const Block& newElement);
+
     } // namespace encoding
 
     using encoding::makeNonNegativeIntegerBlock;
@@ -222,6 +235,7 @@ namespace ndn {
     using encoding::readString;
     using encoding::makeBinaryBlock;
     using encoding::makeNestedBlock;
+    using encoding::replaceSubElement;
 
 } // namespace ndn
 
@@ -306,16 +306,23 @@ namespace ndn {
         Buffer::const_iterator begin = value_begin();
         Buffer::const_iterator end = value_end();
 
+        // count the elements first, so that their storage is allocated once
+        size_t nElements = 0;
+        for (Buffer::const_iterator i = begin; i != end; ++nElements) {
+            tlv::readType(i, end);
+            uint64_t length = tlv::readVarNumber(i, end);
+            if (length > static_cast<uint64_t> (end - i)) {
+                BOOST_THROW_EXCEPTION(tlv::Error("TLV length exceeds buffer length"));
+            }
+            i += length;
+        }
+        m_subBlocks.reserve(nElements);
+
         while (begin != end) {
             Buffer::const_iterator element_begin = begin;
 
             uint32_t type = tlv::readType(begin, end);
             uint64_t length = tlv::readVarNumber(begin, end);
-
-            if (length > static_cast<uint64_t> (end - begin)) {
-                m_subBlocks.clear();
-                BOOST_THROW_EXCEPTION(tlv::Error("TLV length exceeds buffer length"));
-            }
             Buffer::const_iterator element_end = begin + length;
 
             m_subBlocks.push_back(Block(m_buffer,
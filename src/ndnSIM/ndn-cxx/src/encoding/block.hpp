@@ -29,6 +29,7 @@
 #include "buffer.hpp"
 #include "tlv.hpp"
 #include "encoding-buffer-fwd.hpp"
+#include "block-element-allocator.hpp"
 
 namespace boost {
     namespace asio {
@@ -42,7 +43,9 @@ namespace ndn {
      */
     class Block {
     public:
-        typedef std::vector<Block> element_container;
+        /** @brief container of the sub-elements, with storage recycled between packets
+         */
+        typedef std::vector<Block, encoding::BlockElementAllocator<Block>> element_container;
         typedef element_container::iterator element_iterator;
         typedef element_container::const_iterator element_const_iterator;
 
@@ -35,22 +35,26 @@ namespace ndn {
 
     Interest::Interest()
     : m_interestLifetime(time::milliseconds::min())
-    , m_selectedDelegationIndex(INVALID_SELECTED_DELEGATION_INDEX) {
+    , m_selectedDelegationIndex(INVALID_SELECTED_DELEGATION_INDEX)
+    , m_wireSize(0) {
     }
 
     Interest::Interest(const Name& name)
     : m_name(name)
     , m_interestLifetime(time::milliseconds::min())
-    , m_selectedDelegationIndex(INVALID_SELECTED_DELEGATION_INDEX) {
+    , m_selectedDelegationIndex(INVALID_SELECTED_DELEGATION_INDEX)
+    , m_wireSize(0) {
     }
 
     Interest::Interest(const Name& name, const time::milliseconds& interestLifetime)
     : m_name(name)
     , m_interestLifetime(interestLifetime)
-    , m_selectedDelegationIndex(INVALID_SELECTED_DELEGATION_INDEX) {
+    , m_selectedDelegationIndex(INVALID_SELECTED_DELEGATION_INDEX)
+    , m_wireSize(0) {
     }
 
-    Interest::Interest(const Block& wire) {
+    Interest::Interest(const Block& wire)
+    : m_wireSize(0) {
         wireDecode(wire);
     }
 
@@ -75,7 +79,7 @@ namespace ndn {
             m_nonce = makeBinaryBlock(tlv::Nonce,
                     reinterpret_cast<const uint8_t*> (&nonce),
                     sizeof (nonce));
-            m_wire.reset();
+            onChanged();
         }
         return *this;
     }
@@ -261,10 +265,7 @@ namespace ndn {
         if (m_wire.hasWire())
             return m_wire;
 
-        EncodingEstimator estimator;
-        size_t estimatedSize = wireEncode(estimator);
-
-        EncodingBuffer buffer(estimatedSize, 0);
+        EncodingBuffer buffer(wireSize(), 0);
         wireEncode(buffer);
 
         // to ensure that Nonce block points to the right memory location
@@ -273,6 +274,18 @@ namespace ndn {
         return m_wire;
     }
 
+    size_t
+    Interest::wireSize() const {
+        if (m_wire.hasWire())
+            return m_wire.size();
+
+        if (m_wireSize == 0) {
+            EncodingEstimator estimator;
+            m_wireSize = wireEncode(estimator);
+        }
+        return m_wireSize;
+    }
+
     void
     Interest::wireDecode(const Block& wire) {
         m_wire = wire;
@@ -336,6 +349,25 @@ namespace ndn {
         }
     }
 
+    Interest&
+    Interest::setName(const Name& name) {
+        m_name = name;
+        if (m_wire.hasWire() && m_wire.elements_begin()->type() == tlv::Name) {
+            m_wire = replaceSubElement(m_wire, m_wire.elements_begin(), m_name.wireEncode());
+            // to ensure that Nonce block points to the right memory location
+            m_nonce = m_wire.get(tlv::Nonce);
+        } else {
+            onChanged();
+        }
+        return *this;
+    }
+
+    void
+    Interest::onChanged() {
+        m_wire.reset();
+        m_wireSize = 0;
+    }
+
     bool
     Interest::hasLink() const {
         return m_link.hasWire();
@@ -358,7 +390,7 @@ namespace ndn {
         if (!link.hasWire()) {
             BOOST_THROW_EXCEPTION(Error("The given link does not have a wire format"));
         }
-        m_wire.reset();
+        onChanged();
         m_linkCached.reset();
         this->unsetSelectedDelegation();
     }
@@ -366,7 +398,7 @@ namespace ndn {
     void
     Interest::unsetLink() {
         m_link.reset();
-        m_wire.reset();
+        onChanged();
         m_linkCached.reset();
         this->unsetSelectedDelegation();
     }
@@ -392,7 +424,7 @@ namespace ndn {
         } else {
             BOOST_THROW_EXCEPTION(std::invalid_argument("Invalid selected delegation name"));
         }
-        m_wire.reset();
+        onChanged();
     }
 
     void
@@ -401,13 +433,13 @@ namespace ndn {
             BOOST_THROW_EXCEPTION(Error("Invalid selected delegation index"));
         }
         m_selectedDelegationIndex = delegationIndex;
-        m_wire.reset();
+        onChanged();
     }
 
     void
     Interest::unsetSelectedDelegation() {
         m_selectedDelegationIndex = INVALID_SELECTED_DELEGATION_INDEX;
-        m_wire.reset();
+        onChanged();
     }
 
     std::ostream&
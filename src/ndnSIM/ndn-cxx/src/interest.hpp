@@ -93,6 +93,16 @@ namespace ndn {
         const Block&
         wireEncode() const;
 
+        /**
+         * @brief Get the size of the wire format
+         *
+         * The size is estimated without encoding the Interest when it has no wire format
+         * yet, and kept until the Interest changes; wireEncode() then uses it to size
+         * the buffer instead of estimating again.
+         */
+        size_t
+        wireSize() const;
+
         /**
          * @brief Decode from the wire format
          */
@@ -215,12 +225,13 @@ namespace ndn {
             return m_name;
         }
 
+        /** @brief Set Interest's name
+         *
+         *  If wire format already exists, the new Name is spliced into it in place of the
+         *  old one, and the other elements are kept without being encoded again.
+         */
         Interest&
-        setName(const Name& name) {
-            m_name = name;
-            m_wire.reset();
-            return *this;
-        }
+        setName(const Name& name);
 
         const time::milliseconds&
         getInterestLifetime() const {
@@ -230,7 +241,7 @@ namespace ndn {
         Interest&
         setInterestLifetime(const time::milliseconds& interestLifetime) {
             m_interestLifetime = interestLifetime;
-            m_wire.reset();
+            onChanged();
             return *this;
         }
 
@@ -284,7 +295,7 @@ namespace ndn {
         Interest&
         setSelectors(const Selectors& selectors) {
             m_selectors = selectors;
-            m_wire.reset();
+            onChanged();
             return *this;
         }
 
@@ -296,7 +307,7 @@ namespace ndn {
         Interest&
         setMinSuffixComponents(int minSuffixComponents) {
             m_selectors.setMinSuffixComponents(minSuffixComponents);
-            m_wire.reset();
+            onChanged();
             return *this;
         }
 
@@ -308,7 +319,7 @@ namespace ndn {
         Interest&
         setMaxSuffixComponents(int maxSuffixComponents) {
             m_selectors.setMaxSuffixComponents(maxSuffixComponents);
-            m_wire.reset();
+            onChanged();
             return *this;
         }
 
@@ -320,7 +331,7 @@ namespace ndn {
         Interest&
         setPublisherPublicKeyLocator(const KeyLocator& keyLocator) {
             m_selectors.setPublisherPublicKeyLocator(keyLocator);
-            m_wire.reset();
+            onChanged();
             return *this;
         }
 
@@ -332,7 +343,7 @@ namespace ndn {
         Interest&
         setExclude(const Exclude& exclude) {
             m_selectors.setExclude(exclude);
-            m_wire.reset();
+            onChanged();
             return *this;
         }
 
@@ -344,7 +355,7 @@ namespace ndn {
         Interest&
         setChildSelector(int childSelector) {
             m_selectors.setChildSelector(childSelector);
-            m_wire.reset();
+            onChanged();
             return *this;
         }
 
@@ -356,7 +367,7 @@ namespace ndn {
         Interest&
         setMustBeFresh(bool mustBeFresh) {
             m_selectors.setMustBeFresh(mustBeFresh);
-            m_wire.reset();
+            onChanged();
             return *this;
         }
 
@@ -372,6 +383,13 @@ namespace ndn {
             return !(*this == other);
         }
 
+    private:
+        /**
+         * @brief Clear the wire encoding and its size
+         */
+        void
+        onChanged();
+
     private:
         Name m_name;
         Selectors m_selectors;
@@ -382,6 +400,7 @@ namespace ndn {
         mutable shared_ptr<Link> m_linkCached;
         size_t m_selectedDelegationIndex;
         mutable Block m_wire;
+        mutable size_t m_wireSize;
     };
 
     std::ostream&
@@ -0,0 +1,264 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "helper/ndn-stack-helper.hpp"
+#include "model/ndn-l3-protocol.hpp"
+
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/multi-access-suppression.hpp"
+#include "ns3/ndnSIM/NFD/daemon/fw/unsolicited-data-policy.hpp"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+    namespace ndn {
+
+        using nfd::fw::MultiAccessSuppression;
+
+        /** \brief link service recording what the forwarder sends on a test face
+         */
+        class RecordingLinkService : public nfd::face::LinkService {
+        public:
+            using nfd::face::LinkService::receiveInterest;
+            using nfd::face::LinkService::receiveData;
+
+        private:
+
+            void
+            doSendInterest(const Interest& interest) override {
+                sentInterests.push_back(interest);
+            }
+
+            void
+            doSendData(const Data& data) override {
+                sentData.push_back(data);
+            }
+
+            void
+            doSendNack(const lp::Nack& nack) override {
+            }
+
+            void
+            doReceivePacket(nfd::face::Transport::Packet&& packet) override {
+            }
+
+        public:
+            std::vector<Interest> sentInterests;
+            std::vector<Data> sentData;
+        };
+
+        class RecordingTransport : public nfd::face::Transport {
+        public:
+
+            RecordingTransport(::ndn::nfd::FaceScope scope, ::ndn::nfd::LinkType linkType) {
+                this->setLocalUri(FaceUri("dummy://"));
+                this->setRemoteUri(FaceUri("dummy://"));
+                this->setScope(scope);
+                this->setPersistency(::ndn::nfd::FACE_PERSISTENCY_PERSISTENT);
+                this->setLinkType(linkType);
+            }
+
+        private:
+
+            void
+            beforeChangePersistency(::ndn::nfd::FacePersistency newPersistency) override {
+            }
+
+            void
+            doClose() override {
+                this->setState(nfd::face::TransportState::CLOSED);
+            }
+
+            void
+            doSend(Packet&& packet) override {
+            }
+        };
+
+        class MultiAccessSuppressionFixture : public CleanupFixture {
+        public:
+
+            MultiAccessSuppressionFixture() {
+                Ptr<Node> node = CreateObject<Node>();
+                StackHelper helper;
+                helper.Install(node);
+                forwarder = node->GetObject<L3Protocol>()->getForwarder();
+
+                appFace = addFace(::ndn::nfd::FACE_SCOPE_LOCAL, ::ndn::nfd::LINK_TYPE_POINT_TO_POINT, appService);
+                radioFace = addFace(::ndn::nfd::FACE_SCOPE_NON_LOCAL, ::ndn::nfd::LINK_TYPE_MULTI_ACCESS, radioService);
+
+                MultiAccessSuppression::Options options;
+                options.isEnabled = true;
+                options.minBackoff = time::milliseconds(5);
+                options.maxBackoff = time::milliseconds(10);
+                forwarder->getMultiAccessSuppression().setOptions(options);
+            }
+
+            shared_ptr<Face>
+            addFace(::ndn::nfd::FaceScope scope, ::ndn::nfd::LinkType linkType, RecordingLinkService*& service) {
+                auto face = make_shared<Face>(make_unique<RecordingLinkService>(),
+                        make_unique<RecordingTransport>(scope, linkType));
+                service = static_cast<RecordingLinkService*> (face->getLinkService());
+                forwarder->addFace(face);
+                return face;
+            }
+
+            shared_ptr<Data>
+            makeData(const Name& name) {
+                auto data = make_shared<Data>(name);
+                StackHelper::getKeyChain().sign(*data);
+                return data;
+            }
+
+            void
+            advanceClocks(const time::nanoseconds& duration) {
+                Simulator::Stop(NanoSeconds(duration.count()));
+                Simulator::Run();
+            }
+
+            MultiAccessSuppression&
+            suppression() {
+                return forwarder->getMultiAccessSuppression();
+            }
+
+        protected:
+            shared_ptr<nfd::Forwarder> forwarder;
+            shared_ptr<Face> appFace;
+            shared_ptr<Face> radioFace;
+            RecordingLinkService* appService;
+            RecordingLinkService* radioService;
+        };
+
+        BOOST_FIXTURE_TEST_SUITE(NfdFwMultiAccessSuppression, MultiAccessSuppressionFixture)
+
+        BOOST_AUTO_TEST_CASE(InvalidOptions) {
+            MultiAccessSuppression::Options options;
+            options.minBackoff = time::milliseconds(10);
+            options.maxBackoff = time::milliseconds(5);
+            BOOST_CHECK_THROW(suppression().setOptions(options), std::invalid_argument);
+        }
+
+        BOOST_AUTO_TEST_CASE(Disabled) {
+            suppression().setOptions(MultiAccessSuppression::Options());
+            forwarder->getFib().insert("/A").first->addNextHop(*radioFace, 0);
+
+            appService->receiveInterest(Interest("/A/1"));
+            BOOST_CHECK_EQUAL(radioService->sentInterests.size(), 1);
+            BOOST_CHECK_EQUAL(suppression().getCounters().nDeferredInterests, 0);
+        }
+
+        BOOST_AUTO_TEST_CASE(InterestDeferred) {
+            forwarder->getFib().insert("/A").first->addNextHop(*radioFace, 0);
+
+            appService->receiveInterest(Interest("/A/1"));
+            BOOST_CHECK_EQUAL(radioService->sentInterests.size(), 0);
+            BOOST_CHECK_EQUAL(suppression().size(), 1);
+
+            advanceClocks(time::milliseconds(4));
+            BOOST_CHECK_EQUAL(radioService->sentInterests.size(), 0);
+
+            advanceClocks(time::milliseconds(7));
+            BOOST_REQUIRE_EQUAL(radioService->sentInterests.size(), 1);
+            BOOST_CHECK_EQUAL(radioService->sentInterests[0].getName(), "/A/1");
+            BOOST_CHECK_EQUAL(suppression().getCounters().nDeferredInterests, 1);
+            BOOST_CHECK_EQUAL(suppression().getCounters().nSuppressedInterests, 0);
+            BOOST_CHECK_EQUAL(suppression().size(), 0);
+        }
+
+        BOOST_AUTO_TEST_CASE(InterestOverheard) {
+            forwarder->getFib().insert("/A").first->addNextHop(*radioFace, 0);
+
+            appService->receiveInterest(Interest("/A/1"));
+            advanceClocks(time::milliseconds(2));
+
+            // a neighbor transmits the same Interest first
+            radioService->receiveInterest(Interest("/A/1"));
+            advanceClocks(time::milliseconds(20));
+
+            BOOST_CHECK_EQUAL(radioService->sentInterests.size(), 0);
+            BOOST_CHECK_EQUAL(suppression().getCounters().nSuppressedInterests, 1);
+            BOOST_CHECK_EQUAL(suppression().size(), 0);
+        }
+
+        BOOST_AUTO_TEST_CASE(InterestSatisfiedByOverheardData) {
+            forwarder->getFib().insert("/A").first->addNextHop(*radioFace, 0);
+
+            appService->receiveInterest(Interest("/A/1"));
+            advanceClocks(time::milliseconds(2));
+
+            radioService->receiveData(*makeData("/A/1/seg0"));
+            advanceClocks(time::milliseconds(20));
+
+            BOOST_CHECK_EQUAL(radioService->sentInterests.size(), 0);
+            BOOST_CHECK_EQUAL(suppression().getCounters().nSuppressedInterests, 1);
+        }
+
+        BOOST_AUTO_TEST_CASE(DataOverheard) {
+            // the Interest arrives over the radio and is forwarded to a local producer
+            forwarder->getFib().insert("/B").first->addNextHop(*appFace, 0);
+
+            radioService->receiveInterest(Interest("/B/1"));
+            BOOST_REQUIRE_EQUAL(appService->sentInterests.size(), 1);
+
+            appService->receiveData(*makeData("/B/1"));
+            BOOST_CHECK_EQUAL(radioService->sentData.size(), 0);
+            BOOST_CHECK_EQUAL(suppression().getCounters().nDeferredData, 1);
+
+            // another producer on the medium answers first
+            radioService->receiveData(*makeData("/B/1"));
+            advanceClocks(time::milliseconds(20));
+
+            BOOST_CHECK_EQUAL(radioService->sentData.size(), 0);
+            BOOST_CHECK_EQUAL(suppression().getCounters().nSuppressedData, 1);
+        }
+
+        BOOST_AUTO_TEST_CASE(DataNotOverheard) {
+            forwarder->getFib().insert("/B").first->addNextHop(*appFace, 0);
+
+            radioService->receiveInterest(Interest("/B/1"));
+            appService->receiveData(*makeData("/B/1"));
+            advanceClocks(time::milliseconds(20));
+
+            BOOST_REQUIRE_EQUAL(radioService->sentData.size(), 1);
+            BOOST_CHECK_EQUAL(radioService->sentData[0].getName(), "/B/1");
+        }
+
+        BOOST_AUTO_TEST_CASE(CacheOverheardData) {
+            forwarder->setUnsolicitedDataPolicy(make_unique<nfd::fw::AdmitMultiAccessUnsolicitedDataPolicy>());
+            size_t nCached = forwarder->getCs().size();
+
+            radioService->receiveData(*makeData("/C/1"));
+            BOOST_CHECK_EQUAL(suppression().getCounters().nCachedOverheardData, 1);
+            BOOST_CHECK_EQUAL(forwarder->getCs().size(), nCached + 1);
+
+            appService->receiveData(*makeData("/C/2"));
+            BOOST_CHECK_EQUAL(suppression().getCounters().nCachedOverheardData, 1);
+            BOOST_CHECK_EQUAL(forwarder->getCs().size(), nCached + 1);
+        }
+
+        BOOST_AUTO_TEST_CASE(AdmitMultiAccessPolicy) {
+            nfd::fw::AdmitMultiAccessUnsolicitedDataPolicy policy;
+            Data data("/D/1");
+            BOOST_CHECK(policy.decide(*radioFace, data) == nfd::fw::UnsolicitedDataDecision::CACHE);
+            BOOST_CHECK(policy.decide(*appFace, data) == nfd::fw::UnsolicitedDataDecision::DROP);
+        }
+
+        BOOST_AUTO_TEST_SUITE_END()
+
+    } // namespace ndn
+} // namespace ns3
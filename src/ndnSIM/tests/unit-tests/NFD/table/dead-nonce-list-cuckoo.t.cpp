@@ -0,0 +1,149 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "helper/ndn-stack-helper.hpp"
+
+#include "ns3/ndnSIM/NFD/daemon/table/dead-nonce-list-cuckoo.hpp"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+    namespace ndn {
+
+        using nfd::CuckooDeadNonceList;
+
+        class CuckooDeadNonceListFixture : public CleanupFixture {
+        public:
+
+            void
+            advanceClocks(const time::nanoseconds& duration) {
+                Simulator::Stop(NanoSeconds(duration.count()));
+                Simulator::Run();
+            }
+
+        protected:
+            StackHelper m_stackHelper; // sets the ndn-cxx clocks to the simulation time
+        };
+
+        BOOST_FIXTURE_TEST_SUITE(NfdTableCuckooDeadNonceList, CuckooDeadNonceListFixture)
+
+        BOOST_AUTO_TEST_CASE(Basic) {
+            Name nameA("ndn:/A");
+            Name nameB("ndn:/B");
+            const uint32_t nonce1 = 0x53b4eaa8;
+            const uint32_t nonce2 = 0x1f46372b;
+
+            CuckooDeadNonceList dnl;
+            BOOST_CHECK_EQUAL(dnl.size(), 0);
+            BOOST_CHECK_EQUAL(dnl.has(nameA, nonce1), false);
+
+            dnl.add(nameA, nonce1);
+            BOOST_CHECK_EQUAL(dnl.size(), 1);
+            BOOST_CHECK_EQUAL(dnl.has(nameA, nonce1), true);
+            BOOST_CHECK_EQUAL(dnl.has(nameA, nonce2), false);
+            BOOST_CHECK_EQUAL(dnl.has(nameB, nonce1), false);
+
+            dnl.add(nameA, nonce1);
+            BOOST_CHECK_EQUAL(dnl.size(), 1);
+        }
+
+        BOOST_AUTO_TEST_CASE(InvalidParameters) {
+            BOOST_CHECK_THROW(CuckooDeadNonceList(0), std::invalid_argument);
+            BOOST_CHECK_THROW(CuckooDeadNonceList(100, 0.0), std::invalid_argument);
+            BOOST_CHECK_THROW(CuckooDeadNonceList(100, 1.0), std::invalid_argument);
+            BOOST_CHECK_THROW(CuckooDeadNonceList(100, 0.01, time::milliseconds::zero()), std::invalid_argument);
+            BOOST_CHECK_THROW(CuckooDeadNonceList(100, 0.01, time::seconds(1), 1), std::invalid_argument);
+        }
+
+        BOOST_AUTO_TEST_CASE(Sizing) {
+            CuckooDeadNonceList dnl(3000, 0.001, time::seconds(6), 4);
+            // log2(8 / 0.001) = 12.97
+            BOOST_CHECK_EQUAL(dnl.getFingerprintBits(), 13);
+            // 1000 per generation at 4 slots and 95% load
+            BOOST_CHECK_EQUAL(dnl.getNBucketsPerFilter(), 512);
+            // 2048 slots of 13 bits
+            BOOST_CHECK_EQUAL(dnl.getNBytesPerFilter(), 3328);
+
+            CuckooDeadNonceList coarse(100, 0.9);
+            BOOST_CHECK_EQUAL(coarse.getFingerprintBits(), 4);
+        }
+
+        BOOST_AUTO_TEST_CASE(NoFalseNegative) {
+            const size_t N = 4000;
+            // 13, 17 and 32 bit fingerprints: slots straddle words, or fill them exactly
+            for (double falsePositiveRate : {0.001, 0.0001, 1e-12}) {
+                CuckooDeadNonceList dnl(N, falsePositiveRate, time::seconds(6), 4);
+                Name name("ndn:/N");
+                for (uint32_t nonce = 1; nonce <= N; ++nonce) {
+                    dnl.add(name, nonce);
+                }
+
+                size_t nMissing = 0;
+                for (uint32_t nonce = 1; nonce <= N; ++nonce) {
+                    nMissing += dnl.has(name, nonce) ? 0 : 1;
+                }
+                BOOST_CHECK_EQUAL(nMissing, 0);
+
+                size_t nFalsePositives = 0;
+                for (uint32_t nonce = N + 1; nonce <= 2 * N; ++nonce) {
+                    nFalsePositives += dnl.has(name, nonce) ? 1 : 0;
+                }
+                // 4 live generations at the target rate each, with generous slack
+                BOOST_CHECK_LE(nFalsePositives, N * falsePositiveRate * 4 * 3);
+            }
+        }
+
+        BOOST_AUTO_TEST_CASE(Overflow) {
+            // far more Nonces than one generation can hold
+            CuckooDeadNonceList dnl(8, 0.01, time::seconds(6), 2);
+            Name name("ndn:/O");
+            for (uint32_t nonce = 1; nonce <= 200; ++nonce) {
+                dnl.add(name, nonce);
+            }
+            BOOST_CHECK_GT(dnl.getNOverflows(), 0);
+            for (uint32_t nonce = 1; nonce <= 200; ++nonce) {
+                BOOST_CHECK(dnl.has(name, nonce));
+            }
+        }
+
+        BOOST_AUTO_TEST_CASE(Rotation) {
+            const time::nanoseconds LIFETIME = time::milliseconds(300);
+            CuckooDeadNonceList dnl(1000, 0.001, LIFETIME, 4);
+            Name name("ndn:/R");
+
+            dnl.add(name, 1);
+            advanceClocks(LIFETIME);
+            // still remembered after exactly one lifetime
+            BOOST_CHECK_EQUAL(dnl.has(name, 1), true);
+
+            dnl.add(name, 2);
+            advanceClocks(LIFETIME / 2);
+            BOOST_CHECK_EQUAL(dnl.has(name, 1), false);
+            BOOST_CHECK_EQUAL(dnl.has(name, 2), true);
+            BOOST_CHECK_EQUAL(dnl.size(), 1);
+
+            advanceClocks(LIFETIME);
+            BOOST_CHECK_EQUAL(dnl.has(name, 2), false);
+            BOOST_CHECK_EQUAL(dnl.size(), 0);
+        }
+
+        BOOST_AUTO_TEST_SUITE_END()
+
+    } // namespace ndn
+} // namespace ns3
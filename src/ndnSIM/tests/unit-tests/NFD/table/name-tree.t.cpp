@@ -0,0 +1,103 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ns3/ndnSIM/NFD/daemon/table/name-tree.hpp"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+    namespace ndn {
+
+        using nfd::name_tree::HashSequence;
+        using nfd::name_tree::HashSequenceTag;
+        using nfd::name_tree::computeHash;
+        using nfd::name_tree::computeHashes;
+        using nfd::name_tree::getHashes;
+        using nfd::name_tree::inheritPrefixHashes;
+
+        BOOST_FIXTURE_TEST_SUITE(NfdTableNameTree, CleanupFixture)
+
+        BOOST_AUTO_TEST_CASE(StreamingPrefixHashes) {
+            Name prefix("/nohello/world/ndn/research");
+            HashSequence hashes = computeHashes(prefix);
+            BOOST_REQUIRE_EQUAL(hashes.size(), prefix.size() + 1);
+            for (size_t i = 0; i <= prefix.size(); ++i) {
+                BOOST_CHECK_EQUAL(hashes[i], computeHash(prefix, i));
+            }
+
+            Name other("/nohello/world/ndn/development");
+            BOOST_CHECK_NE(computeHash(other), computeHash(prefix));
+            BOOST_CHECK_EQUAL(computeHash(other, 3), computeHash(prefix, 3));
+        }
+
+        BOOST_AUTO_TEST_CASE(ComputeHashesReuseBuffer) {
+            HashSequence seq;
+            computeHashes(Name("/A/B/C/D/E/F"), seq);
+            BOOST_CHECK_EQUAL(seq.size(), 7);
+
+            computeHashes(Name("/A/B"), seq);
+            BOOST_CHECK_EQUAL(seq.size(), 3);
+            BOOST_CHECK(seq == computeHashes(Name("/A/B")));
+        }
+
+        BOOST_AUTO_TEST_CASE(HashSequenceTagCache) {
+            auto interest = make_shared<Interest>(Name("/A/B/C/ovrhd"));
+            const HashSequence& hashes = getHashes(*interest);
+            BOOST_CHECK(hashes == computeHashes(interest->getName()));
+            BOOST_CHECK_EQUAL(&getHashes(*interest), &hashes); // served from tag
+
+            // a copy shares the Name wire encoding, so the cached hashes stay valid
+            auto copy = make_shared<Interest>(*interest);
+            BOOST_CHECK_EQUAL(&getHashes(*copy), &hashes);
+
+            // stripping the last component derives hashes without recomputation
+            copy->setName(interest->getName().getPrefix(-1));
+            inheritPrefixHashes(*copy, *interest);
+            shared_ptr<HashSequenceTag> tag = copy->getTag<HashSequenceTag>();
+            BOOST_REQUIRE(tag != nullptr);
+            BOOST_CHECK(tag->get() == computeHashes(Name("/A/B/C")));
+            BOOST_CHECK_EQUAL(&getHashes(*copy), &tag->get());
+
+            // a replaced Name invalidates the cached hashes
+            copy->setName("/X/Y");
+            BOOST_CHECK(getHashes(*copy) == computeHashes(Name("/X/Y")));
+        }
+
+        BOOST_AUTO_TEST_CASE(ReentrantLongestPrefixMatch) {
+            nfd::NameTree nameTree;
+            nameTree.lookup(Name("/A"));
+            nameTree.lookup(Name("/A/B/C"));
+            nameTree.lookup(Name("/X/Y"));
+
+            // the selector queries the tree with another name while the outer match is running
+            size_t nNested = 0;
+            nfd::name_tree::Entry* match = nameTree.findLongestPrefixMatch(Name("/A/B/C/D"),
+                [&] (const nfd::name_tree::Entry& entry) {
+                    nNested += nameTree.findLongestPrefixMatch(Name("/X/Y/Z")) != nullptr;
+                    return entry.getName().size() == 1;
+                });
+            BOOST_REQUIRE(match != nullptr);
+            BOOST_CHECK_EQUAL(match->getName(), Name("/A"));
+            BOOST_CHECK_GT(nNested, 0);
+        }
+
+        BOOST_AUTO_TEST_SUITE_END()
+
+    } // namespace ndn
+} // namespace ns3
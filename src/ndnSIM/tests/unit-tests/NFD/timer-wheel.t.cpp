@@ -0,0 +1,142 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "helper/ndn-stack-helper.hpp"
+
+#include "ns3/ndnSIM/NFD/core/timer-wheel.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+    namespace ndn {
+
+        using nfd::scheduler::TimerWheel;
+
+        class TimerWheelFixture : public CleanupFixture {
+        public:
+
+            /** \brief run the simulation for \p duration, the wheel timers firing on the way
+             */
+            void
+            advanceClocks(const time::nanoseconds& duration) {
+                Simulator::Stop(NanoSeconds(duration.count()));
+                Simulator::Run();
+            }
+
+        protected:
+            StackHelper m_stackHelper; // sets the ndn-cxx clocks to the simulation time
+        };
+
+        BOOST_FIXTURE_TEST_SUITE(NfdTimerWheel, TimerWheelFixture)
+
+        BOOST_AUTO_TEST_CASE(FireInOrder) {
+            TimerWheel wheel;
+            std::vector<int> fired;
+            wheel.schedule(time::milliseconds(500), [&] { fired.push_back(3); });
+            wheel.schedule(time::milliseconds(10), [&] { fired.push_back(1); });
+            wheel.schedule(time::milliseconds(300), [&] { fired.push_back(2); });
+            BOOST_CHECK_EQUAL(wheel.size(), 3);
+
+            advanceClocks(time::milliseconds(200));
+            BOOST_CHECK(fired == std::vector<int>({1}));
+
+            advanceClocks(time::milliseconds(400));
+            BOOST_CHECK(fired == std::vector<int>({1, 2, 3}));
+            BOOST_CHECK_EQUAL(wheel.size(), 0);
+        }
+
+        BOOST_AUTO_TEST_CASE(NeverEarly) {
+            TimerWheel wheel(time::milliseconds(4));
+            int hit = 0;
+            wheel.schedule(time::milliseconds(10), [&] { ++hit; });
+
+            advanceClocks(time::milliseconds(9));
+            BOOST_CHECK_EQUAL(hit, 0);
+            advanceClocks(time::milliseconds(4)); // rounded up to at most one granularity late
+            BOOST_CHECK_EQUAL(hit, 1);
+        }
+
+        BOOST_AUTO_TEST_CASE(Cancel) {
+            TimerWheel wheel;
+            int hit1 = 0, hit2 = 0;
+            TimerWheel::TimerId t1 = wheel.schedule(time::milliseconds(10), [&] { ++hit1; });
+            wheel.schedule(time::milliseconds(20), [&] { ++hit2; });
+            wheel.cancel(t1);
+            wheel.cancel(t1); // cancelling twice is harmless
+            wheel.cancel(TimerWheel::TimerId());
+            BOOST_CHECK_EQUAL(wheel.size(), 1);
+
+            advanceClocks(time::milliseconds(30));
+            BOOST_CHECK_EQUAL(hit1, 0);
+            BOOST_CHECK_EQUAL(hit2, 1);
+        }
+
+        BOOST_AUTO_TEST_CASE(Cascade) {
+            TimerWheel wheel;
+            // beyond the first level (256 ticks) and the second level (65536 ticks)
+            int hit1 = 0, hit2 = 0;
+            wheel.schedule(time::milliseconds(1000), [&] { ++hit1; });
+            wheel.schedule(time::seconds(100), [&] { ++hit2; });
+
+            advanceClocks(time::milliseconds(999));
+            BOOST_CHECK_EQUAL(hit1, 0);
+            advanceClocks(time::milliseconds(2));
+            BOOST_CHECK_EQUAL(hit1, 1);
+
+            advanceClocks(time::seconds(98));
+            BOOST_CHECK_EQUAL(hit2, 0);
+            advanceClocks(time::seconds(2));
+            BOOST_CHECK_EQUAL(hit2, 1);
+        }
+
+        BOOST_AUTO_TEST_CASE(RescheduleFromCallback) {
+            TimerWheel wheel;
+            int hit = 0;
+            TimerWheel::TimerId other = wheel.schedule(time::milliseconds(30), [&] { hit += 100; });
+            std::function<void()> periodic = [&] {
+                if (++hit < 5) {
+                    wheel.schedule(time::milliseconds(10), periodic);
+                }
+                wheel.cancel(other);
+            };
+            wheel.schedule(time::milliseconds(10), periodic);
+
+            advanceClocks(time::milliseconds(100));
+            BOOST_CHECK_EQUAL(hit, 5);
+            BOOST_CHECK_EQUAL(wheel.size(), 0);
+        }
+
+        BOOST_AUTO_TEST_CASE(DestroyedWithPendingTimers) {
+            auto owner = make_shared<int>(0);
+            {
+                TimerWheel wheel;
+                wheel.schedule(time::milliseconds(10), [owner] { ++*owner; });
+                BOOST_CHECK_EQUAL(owner.use_count(), 2);
+            }
+            // the callbacks, and what they hold, are released with the wheel
+            BOOST_CHECK_EQUAL(owner.use_count(), 1);
+
+            advanceClocks(time::milliseconds(20));
+            BOOST_CHECK_EQUAL(*owner, 0);
+        }
+
+        BOOST_AUTO_TEST_SUITE_END()
+
+    } // namespace ndn
+} // namespace ns3
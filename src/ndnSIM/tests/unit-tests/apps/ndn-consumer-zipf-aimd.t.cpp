@@ -0,0 +1,116 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/ndn-consumer-zipf-aimd.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+    namespace ndn {
+
+        class ConsumerZipfAimdFixture : public ScenarioHelperWithCleanupFixture {
+        public:
+
+            ConsumerZipfAimdFixture()
+            : nSent(0)
+            , nSatisfied(0)
+            , maxWindow(0)
+            , nDecreases(0) {
+                // A 1Mbps bottleneck carries about 110 Data of 1000 bytes per second.
+                Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("1Mbps"));
+                Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+                Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("10"));
+
+                getStackHelper().SetOldContentStore("ns3::ndn::cs::Nocache");
+                createTopology({
+                    {"1", "2"}
+                });
+
+                addRoutes({
+                    {"1", "2", "/prefix", 1}
+                });
+
+                addApps({
+                    {"1", "ns3::ndn::ConsumerZipfAimd",
+                        {
+                            {"Prefix", "/prefix"},
+                            {"Frequency", "1000"},
+                            {"NumberOfContents", "100"}},
+                        "0s", "100s"},
+                    {"2", "ns3::ndn::Producer",
+                        {
+                            {"Prefix", "/prefix"},
+                            {"PayloadSize", "1000"}},
+                        "0s", "100s"}
+                });
+
+                Ptr<Application> app = getNode("1")->GetApplication(0);
+                app->TraceConnectWithoutContext("TransmittedInterests",
+                        MakeCallback(&ConsumerZipfAimdFixture::transmittedInterest, this));
+                app->TraceConnectWithoutContext("ReceivedData",
+                        MakeCallback(&ConsumerZipfAimdFixture::receivedData, this));
+                app->TraceConnectWithoutContext("WindowTrace",
+                        MakeCallback(&ConsumerZipfAimdFixture::window, this));
+            }
+
+            void
+            transmittedInterest(shared_ptr<const Interest> interest, Ptr<App> app, shared_ptr<Face> face) {
+                nSent++;
+            }
+
+            void
+            receivedData(shared_ptr<const Data> data, Ptr<App> app, shared_ptr<Face> face) {
+                nSatisfied++;
+            }
+
+            void
+            window(double oldWindow, double newWindow) {
+                maxWindow = std::max(maxWindow, newWindow);
+                if (newWindow < oldWindow) {
+                    nDecreases++;
+                }
+            }
+
+        public:
+            uint32_t nSent;
+            uint32_t nSatisfied;
+            double maxWindow;
+            uint32_t nDecreases;
+        };
+
+        BOOST_FIXTURE_TEST_SUITE(AppsNdnConsumerZipfAimd, ConsumerZipfAimdFixture)
+
+        BOOST_AUTO_TEST_CASE(WindowAdapts) {
+            Simulator::Stop(Seconds(10));
+            Simulator::Run();
+
+            // The window opens beyond the bandwidth-delay product, overflows the queue and backs off.
+            BOOST_CHECK_GT(maxWindow, 4);
+            BOOST_CHECK_GT(nDecreases, 0);
+
+            // The rate follows the bottleneck, far below Frequency.
+            BOOST_CHECK_LT(nSent, 5000);
+            BOOST_CHECK_GT(nSatisfied, 300);
+            BOOST_CHECK_LE(nSatisfied, 1250);
+        }
+
+        BOOST_AUTO_TEST_SUITE_END()
+
+    } // namespace ndn
+} // namespace ns3
@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "apps/ndn-consumer-zipf-mandelbrot-v2.hpp"
+#include "model/ndn-l3-protocol.hpp"
+#include "model/ndn-app-link-service.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+    namespace ndn {
+
+        class ConsumerZipfMandelbrotV2Fixture : public ScenarioHelperWithCleanupFixture {
+        public:
+
+            ConsumerZipfMandelbrotV2Fixture()
+            : nSentBytes(0)
+            , nSent(0)
+            , nSatisfied(0)
+            , nRetx(0) {
+                Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+                Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+                Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("100"));
+
+                createTopology({
+                    {"1", "2"}
+                });
+
+                addRoutes({
+                    {"1", "2", "/prefix", 1}
+                });
+
+                addApps({
+                    {"1", "ns3::ndn::ConsumerZipfMandelbrotV2",
+                        {
+                            {"Prefix", "/prefix"},
+                            {"Frequency", "200"},
+                            {"NumberOfContents", "10"}},
+                        "0s", "100s"},
+                    {"2", "ns3::ndn::Producer",
+                        {
+                            {"Prefix", "/prefix"},
+                            {"PayloadSize", "100"}},
+                        "0s", "100s"}
+                });
+
+                Ptr<Application> app = getNode("1")->GetApplication(0);
+                app->TraceConnectWithoutContext("TransmittedInterests",
+                        MakeCallback(&ConsumerZipfMandelbrotV2Fixture::transmittedInterest, this));
+                app->TraceConnectWithoutContext("FirstInterestDataDelay",
+                        MakeCallback(&ConsumerZipfMandelbrotV2Fixture::firstDelay, this));
+            }
+
+            void
+            transmittedInterest(shared_ptr<const Interest> interest, Ptr<App> app, shared_ptr<Face> face) {
+                nSentBytes += interest->wireEncode().size();
+                nSent++;
+            }
+
+            void
+            firstDelay(Ptr<App> app, uint32_t seqno, Time delay, uint32_t retxCount, int32_t hopCount) {
+                BOOST_CHECK_LT(seqno, 10);
+                BOOST_CHECK_GE(retxCount, 1);
+                nSatisfied++;
+                nRetx += retxCount;
+            }
+
+            const AppLinkService::Counters&
+            getAppFaceCounters() {
+                for (const Face& face : getNode("1")->GetObject<L3Protocol>()->getForwarder()->getFaceTable()) {
+                    AppLinkService* link = dynamic_cast<AppLinkService*> (face.getLinkService());
+                    if (link != nullptr) {
+                        return link->getCounters();
+                    }
+                }
+                BOOST_FAIL("no application face");
+                throw std::logic_error("no application face");
+            }
+
+        public:
+            uint64_t nSentBytes;
+            uint32_t nSent;
+            uint32_t nSatisfied;
+            uint32_t nRetx;
+        };
+
+        BOOST_FIXTURE_TEST_SUITE(AppsNdnConsumerZipfMandelbrotV2, ConsumerZipfMandelbrotV2Fixture)
+
+        BOOST_AUTO_TEST_CASE(RequestsAndCounters) {
+            Simulator::Stop(Seconds(2));
+            Simulator::Run();
+
+            BOOST_CHECK_GT(nSent, 300);
+            BOOST_CHECK_GT(nSatisfied, 0);
+            // Each Interest is counted by one request; requests of the last RTT are still outstanding.
+            BOOST_CHECK_LE(nRetx, nSent);
+            BOOST_CHECK_GT(nRetx, nSent - 20);
+
+            const AppLinkService::Counters& counters = getAppFaceCounters();
+            BOOST_CHECK_EQUAL(counters.nInInterests, nSent);
+            BOOST_CHECK_EQUAL(counters.nInBytes, nSentBytes);
+            BOOST_CHECK_EQUAL(counters.nOutData, nSatisfied);
+            BOOST_CHECK_GT(counters.nOutBytes, 100 * nSatisfied);
+        }
+
+        BOOST_AUTO_TEST_SUITE_END()
+
+    } // namespace ndn
+} // namespace ns3
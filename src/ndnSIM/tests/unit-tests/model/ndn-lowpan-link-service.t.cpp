@@ -0,0 +1,141 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/ndn-lowpan-link-service.hpp"
+#include "model/ndn-l3-protocol.hpp"
+#include "helper/ndn-stack-helper.hpp"
+#include "helper/ndn-fib-helper.hpp"
+#include "helper/ndn-app-helper.hpp"
+#include "utils/ndn-data-template.hpp"
+
+#include "ns3/lr-wpan-module.h"
+#include "ns3/mobility-module.h"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+    namespace ndn {
+
+        BOOST_FIXTURE_TEST_SUITE(ModelNdnLowPanLinkService, CleanupFixture)
+
+        static bool
+        isSameWire(const Block& a, const Block& b) {
+            return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin());
+        }
+
+        BOOST_AUTO_TEST_CASE(CompressInterest) {
+            Interest interest(Name("/SensorData/node3").appendSequenceNumber(42));
+            interest.setNonce(10);
+            interest.setMustBeFresh(true);
+            interest.setInterestLifetime(time::milliseconds(2000));
+            const Block& wire = interest.wireEncode();
+
+            LowPanCompressor compressor;
+            Block compressed = compressor.compress(wire);
+            BOOST_CHECK_EQUAL(compressed.type(), LowPanCompressor::CompressedInterest);
+            // a byte per component, the Nonce, the InterestLifetime and Selectors
+            BOOST_CHECK_EQUAL(wire.size() - compressed.size(), 3 + 1 + 1 + 3);
+            BOOST_CHECK(isSameWire(compressor.decompress(compressed), wire));
+
+            LowPanCompressor withContext;
+            withContext.addContext("/SensorData");
+            withContext.addContext("/SensorData/node3");
+            Block compressedWithContext = withContext.compress(wire);
+            BOOST_CHECK_EQUAL(compressedWithContext.size() + 17, compressed.size());
+            BOOST_CHECK(isSameWire(withContext.decompress(compressedWithContext), wire));
+
+            // the other end needs the same contexts
+            BOOST_CHECK_THROW(compressor.decompress(compressedWithContext), ::ndn::tlv::Error);
+        }
+
+        BOOST_AUTO_TEST_CASE(CompressData) {
+            shared_ptr<Data> data = DataTemplate::makeDataDirectly("/SensorData/node3/%FE%01", 20,
+                    time::milliseconds(1000), 0, Name());
+            const Block& wire = data->wireEncode();
+
+            LowPanCompressor compressor;
+            Block compressed = compressor.compress(wire);
+            BOOST_CHECK_EQUAL(compressed.type(), LowPanCompressor::CompressedData);
+            // a byte per component, MetaInfo and FreshnessPeriod, 6 bytes of the fake signature
+            BOOST_CHECK_EQUAL(wire.size() - compressed.size(), 3 + 2 + 6);
+            BOOST_CHECK(isSameWire(compressor.decompress(compressed), wire));
+
+            // signed Data are compressed too, their signature being copied as it is
+            Data signedData("/SensorData/node3");
+            StackHelper::getKeyChain().sign(signedData);
+            BOOST_CHECK(isSameWire(compressor.decompress(compressor.compress(signedData.wireEncode())),
+                    signedData.wireEncode()));
+        }
+
+        BOOST_AUTO_TEST_CASE(LrWpanFaces) {
+            NodeContainer nodes;
+            nodes.Create(2);
+
+            MobilityHelper mobility;
+            mobility.SetMobilityModel("ns3::ConstantPositionMobilityModel");
+            mobility.SetPositionAllocator("ns3::GridPositionAllocator",
+                    "MinX", DoubleValue(0.0), "MinY", DoubleValue(0.0),
+                    "DeltaX", DoubleValue(10.0), "GridWidth", UintegerValue(2));
+            mobility.Install(nodes);
+
+            LrWpanHelper lrWpan;
+            NetDeviceContainer devices = lrWpan.Install(nodes);
+            lrWpan.AssociateToPan(devices, 10);
+
+            StackHelper ndnHelper;
+            ndnHelper.setLowPanCompression(true, {"/prefix"});
+            ndnHelper.Install(nodes);
+
+            shared_ptr<Face> face = nodes.Get(0)->GetObject<L3Protocol>()->getFaceByNetDevice(devices.Get(0));
+            BOOST_REQUIRE(face != nullptr);
+            BOOST_CHECK_EQUAL(face->getTransport()->getMtu(), devices.Get(0)->GetMtu());
+            BOOST_CHECK_EQUAL(face->getRemoteUri().toString(), "netdev://[ff:ff]");
+            auto linkService = dynamic_cast<LowPanLinkService*>(face->getLinkService());
+            BOOST_REQUIRE(linkService != nullptr);
+
+            FibHelper::AddRoute(nodes.Get(0), "/prefix", face, 1);
+
+            // Data larger than a frame are fragmented by NDNLP
+            AppHelper consumer("ns3::ndn::ConsumerCbr");
+            consumer.SetPrefix("/prefix");
+            consumer.SetAttribute("Frequency", StringValue("2"));
+            consumer.Install(nodes.Get(0)).Stop(Seconds(5.0));
+
+            AppHelper producer("ns3::ndn::Producer");
+            producer.SetPrefix("/prefix");
+            producer.SetAttribute("PayloadSize", StringValue("200"));
+            producer.Install(nodes.Get(1));
+
+            Simulator::Stop(Seconds(6.0));
+            Simulator::Run();
+
+            BOOST_CHECK_GT(face->getCounters().nOutInterests, 5);
+            BOOST_CHECK_GT(face->getCounters().nInData, 5);
+            BOOST_CHECK_GT(linkService->getLowPanCounters().nOutCompressed, 5);
+            BOOST_CHECK_GT(linkService->getLowPanCounters().nInCompressed, 5);
+            BOOST_CHECK_GT(linkService->getLowPanCounters().nOutBytesSaved, 0);
+            BOOST_CHECK_GT(linkService->getLowPanCounters().nInBytesSaved, 0);
+            BOOST_CHECK_EQUAL(linkService->getCounters().nOutOverMtu, 0);
+            BOOST_CHECK_EQUAL(linkService->getLowPanCounters().nInDecompressionErrors, 0);
+        }
+
+        BOOST_AUTO_TEST_SUITE_END()
+
+    } // namespace ndn
+} // namespace ns3
@@ -0,0 +1,54 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/ndn-net-device-transport.hpp"
+#include "model/ndn-lowpan-compressor.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+    namespace ndn {
+
+        BOOST_FIXTURE_TEST_SUITE(ModelNdnNetDeviceTransport, CleanupFixture)
+
+        static bool
+        isControl(const std::vector<uint8_t>& wire) {
+            return NetDeviceTransport::isControlPacket(Block(wire.data(), wire.size()));
+        }
+
+        BOOST_AUTO_TEST_CASE(ControlPackets) {
+            BOOST_CHECK(isControl({0x05, 0x03, 0x07, 0x01, 0x08})); // Interest
+            BOOST_CHECK(!isControl({0x06, 0x03, 0x07, 0x01, 0x08})); // Data
+            BOOST_CHECK(isControl({LowPanCompressor::CompressedInterest, 0x01, 0x00}));
+            BOOST_CHECK(!isControl({LowPanCompressor::CompressedData, 0x01, 0x00}));
+
+            // LpPacket: Fragment, Nack, FragIndex
+            BOOST_CHECK(isControl({0x64, 0x04, 0x50, 0x02, 0x05, 0x00}));
+            BOOST_CHECK(!isControl({0x64, 0x04, 0x50, 0x02, 0x06, 0x00}));
+            BOOST_CHECK(isControl({0x64, 0x04, 0x50, 0x02, LowPanCompressor::CompressedInterest, 0x00}));
+            BOOST_CHECK(isControl({0x64, 0x08, 0xfd, 0x03, 0x20, 0x00, 0x50, 0x02, 0x06, 0x00}));
+            BOOST_CHECK(isControl({0x64, 0x07, 0x52, 0x01, 0x00, 0x50, 0x02, 0x05, 0x00}));
+            BOOST_CHECK(!isControl({0x64, 0x07, 0x52, 0x01, 0x01, 0x50, 0x02, 0x05, 0x00}));
+            BOOST_CHECK(!isControl({0x64, 0x00})); // IDLE
+        }
+
+        BOOST_AUTO_TEST_SUITE_END()
+
+    } // namespace ndn
+} // namespace ns3
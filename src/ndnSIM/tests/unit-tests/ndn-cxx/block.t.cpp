@@ -0,0 +1,61 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include <ndn-cxx/encoding/block-element-allocator.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+    namespace ndn {
+
+        using ::ndn::encoding::BlockElementPool;
+
+        BOOST_FIXTURE_TEST_SUITE(NdnCxxBlock, CleanupFixture)
+
+        BOOST_AUTO_TEST_CASE(ParseWithoutHeapAllocation) {
+            Interest interest(Name("/SensorData/node1").appendSequenceNumber(7));
+            interest.setNonce(1);
+            interest.setMustBeFresh(true);
+            const Block& wire = interest.wireEncode();
+
+            // the first parse fills the free lists of the thread when the packet is released
+            {
+                Interest warmUp(Block(make_shared< ::ndn::Buffer>(wire.begin(), wire.end())));
+            }
+
+            uint64_t nHeapAllocations = BlockElementPool::getNHeapAllocations();
+            for (int i = 0; i < 100; ++i) {
+                Interest decoded(Block(make_shared< ::ndn::Buffer>(wire.begin(), wire.end())));
+                BOOST_CHECK_EQUAL(decoded.getName(), interest.getName());
+                BOOST_CHECK_EQUAL(decoded.getNonce(), 1);
+            }
+            BOOST_CHECK_EQUAL(BlockElementPool::getNHeapAllocations(), nHeapAllocations);
+        }
+
+        BOOST_AUTO_TEST_CASE(TruncatedElement) {
+            // Name of length 4 whose only component claims 3 bytes out of 2
+            const uint8_t buffer[] = {0x07, 0x04, 0x08, 0x03, 0x61, 0x62};
+            Block block(buffer, sizeof(buffer));
+            BOOST_CHECK_THROW(block.parse(), ::ndn::tlv::Error);
+        }
+
+        BOOST_AUTO_TEST_SUITE_END()
+
+    } // namespace ndn
+} // namespace ns3
@@ -0,0 +1,59 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-data-template.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+    namespace ndn {
+
+        BOOST_FIXTURE_TEST_SUITE(NdnCxxData, CleanupFixture)
+
+        BOOST_AUTO_TEST_CASE(WireSize) {
+            shared_ptr<Data> d = DataTemplate::makeDataDirectly("/local/ndn/prefix", 10,
+                    ::ndn::time::seconds(1), 0, Name());
+
+            d->setFreshnessPeriod(::ndn::time::seconds(10));
+            BOOST_CHECK_EQUAL(d->hasWire(), false);
+            size_t size = d->wireSize();
+            BOOST_CHECK_EQUAL(d->hasWire(), false);
+            BOOST_CHECK_EQUAL(size, d->wireEncode().size());
+            BOOST_CHECK_EQUAL(d->wireSize(), size);
+        }
+
+        BOOST_AUTO_TEST_CASE(SetNameWithWire) {
+            shared_ptr<Data> d = DataTemplate::makeDataDirectly("/local/ndn/prefix", 10,
+                    ::ndn::time::seconds(1), 0, Name());
+            Name fullName = d->getFullName();
+
+            d->setName("/local/ndn/prefix/suffix");
+            BOOST_CHECK_EQUAL(d->hasWire(), true);
+            BOOST_CHECK_NE(d->getFullName(), fullName);
+
+            shared_ptr<Data> expected = DataTemplate::makeDataDirectly("/local/ndn/prefix/suffix", 10,
+                    ::ndn::time::seconds(1), 0, Name());
+            BOOST_CHECK(d->wireEncode() == expected->wireEncode());
+            BOOST_CHECK_EQUAL(Data(d->wireEncode()).getName(), Name("/local/ndn/prefix/suffix"));
+        }
+
+        BOOST_AUTO_TEST_SUITE_END()
+
+    } // namespace ndn
+} // namespace ns3
@@ -0,0 +1,69 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+    namespace ndn {
+
+        BOOST_FIXTURE_TEST_SUITE(NdnCxxInterest, CleanupFixture)
+
+        BOOST_AUTO_TEST_CASE(WireSize) {
+            Interest i(Name("/local/ndn/prefix"));
+            i.setMustBeFresh(true);
+            i.setNonce(1);
+
+            size_t size = i.wireSize();
+            BOOST_CHECK_EQUAL(i.hasWire(), false);
+            BOOST_CHECK_EQUAL(size, i.wireEncode().size());
+
+            i.setMustBeFresh(false);
+            BOOST_CHECK_EQUAL(i.hasWire(), false);
+            BOOST_CHECK_LT(i.wireSize(), size);
+            BOOST_CHECK_EQUAL(i.wireSize(), i.wireEncode().size());
+        }
+
+        BOOST_AUTO_TEST_CASE(SetNameWithWire) {
+            Interest original(Name("/local/ndn/prefix"));
+            original.setInterestLifetime(::ndn::time::seconds(1));
+            original.setNonce(1);
+            original.wireEncode();
+
+            Interest i(original);
+            i.setName("/local/ndn/prefix/suffix");
+            BOOST_CHECK_EQUAL(i.hasWire(), true);
+
+            Interest expected(Name("/local/ndn/prefix/suffix"));
+            expected.setInterestLifetime(::ndn::time::seconds(1));
+            expected.setNonce(1);
+            BOOST_CHECK(i.wireEncode() == expected.wireEncode());
+
+            // Nonce is still replaced in place, without affecting the original
+            const uint8_t* wire = i.wireEncode().wire();
+            i.setNonce(2);
+            BOOST_CHECK_EQUAL(wire, i.wireEncode().wire());
+            BOOST_CHECK_EQUAL(Interest(i.wireEncode()).getNonce(), 2);
+            BOOST_CHECK_EQUAL(Interest(original.wireEncode()).getNonce(), 1);
+            BOOST_CHECK_EQUAL(original.getName(), Name("/local/ndn/prefix"));
+        }
+
+        BOOST_AUTO_TEST_SUITE_END()
+
+    } // namespace ndn
+} // namespace ns3
@@ -0,0 +1,66 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-data-template.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+    namespace ndn {
+
+        BOOST_AUTO_TEST_SUITE(UtilsNdnDataTemplate)
+
+        BOOST_AUTO_TEST_CASE(SameWireAsDirect) {
+            std::vector<Name> names = {"/a", "/prefix/%FE%01", Name("/long").appendSegment(123456789).append(std::string(300, 'x'))};
+
+            for (size_t payloadSize : {0, 1, 1024, 70000}) {
+                for (int freshness : {0, 1000}) {
+                    for (const Name& keyLocator : {Name(), Name("/key/locator")}) {
+                        ::ndn::time::milliseconds period(freshness);
+                        DataTemplate dataTemplate(payloadSize, period, 7, keyLocator);
+
+                        for (const Name& name : names) {
+                            shared_ptr<Data> fromTemplate = dataTemplate.makeData(name);
+                            shared_ptr<Data> direct = DataTemplate::makeDataDirectly(name, payloadSize, period, 7, keyLocator);
+
+                            BOOST_CHECK(fromTemplate->wireEncode() == direct->wireEncode());
+                            BOOST_CHECK_EQUAL(fromTemplate->getName(), name);
+                            BOOST_CHECK_EQUAL(fromTemplate->getContent().value_size(), payloadSize);
+                            BOOST_CHECK_EQUAL(fromTemplate->getFreshnessPeriod(), period);
+                        }
+                    }
+                }
+            }
+        }
+
+        BOOST_AUTO_TEST_CASE(Matches) {
+            ::ndn::time::milliseconds period(1000);
+            DataTemplate dataTemplate(1024, period, 0, Name("/key"));
+
+            BOOST_CHECK(dataTemplate.matches(1024, period, 0, Name("/key")));
+            BOOST_CHECK(!dataTemplate.matches(1023, period, 0, Name("/key")));
+            BOOST_CHECK(!dataTemplate.matches(1024, ::ndn::time::milliseconds(0), 0, Name("/key")));
+            BOOST_CHECK(!dataTemplate.matches(1024, period, 1, Name("/key")));
+            BOOST_CHECK(!dataTemplate.matches(1024, period, 0, Name()));
+        }
+
+        BOOST_AUTO_TEST_SUITE_END()
+
+    } // namespace ndn
+} // namespace ns3
@@ -0,0 +1,158 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-app-delay-histogram-tracer.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/test/output_test_stream.hpp>
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+    namespace ndn {
+
+        const boost::filesystem::path TEST_HISTOGRAM_TRACE = boost::filesystem::path(TEST_CONFIG_PATH) / "histogram-trace.txt";
+
+        class AppDelayHistogramTracerFixture : public ScenarioHelperWithCleanupFixture {
+        public:
+
+            AppDelayHistogramTracerFixture() {
+                boost::filesystem::create_directories(TEST_CONFIG_PATH);
+
+                // same scenario as in AppDelayTracer tests
+                Config::SetDefault("ns3::PointToPointNetDevice::DataRate", StringValue("10Mbps"));
+                Config::SetDefault("ns3::PointToPointChannel::Delay", StringValue("10ms"));
+                Config::SetDefault("ns3::DropTailQueue::MaxPackets", StringValue("20"));
+
+                createTopology({
+                    {"1", "2"},
+                    {"2", "3"}
+                });
+
+                addRoutes({
+                    {"1", "2", "/prefix", 1},
+                    {"2", "3", "/prefix", 1}
+                });
+
+                addApps({
+                    {"1", "ns3::ndn::ConsumerCbr",
+                        {
+                            {"Prefix", "/prefix"},
+                            {"Frequency", "1"}},
+                        "0s", "0.9s"},
+                    {"2", "ns3::ndn::ConsumerCbr",
+                        {
+                            {"Prefix", "/prefix"},
+                            {"Frequency", "1"}},
+                        "2s", "100s"},
+                    {"3", "ns3::ndn::Producer",
+                        {
+                            {"Prefix", "/prefix"},
+                            {"PayloadSize", "1024"}},
+                        "0s", "100s"}
+                });
+            }
+
+            ~AppDelayHistogramTracerFixture() {
+                boost::filesystem::remove(TEST_HISTOGRAM_TRACE);
+                AppDelayHistogramTracer::Destroy(); // additional cleanup
+            }
+
+            std::string
+            readTrace() {
+                std::ifstream t(TEST_HISTOGRAM_TRACE.string().c_str());
+                std::stringstream buffer;
+                buffer << t.rdbuf();
+                return buffer.str();
+            }
+        };
+
+        BOOST_FIXTURE_TEST_SUITE(UtilsTracersNdnAppDelayHistogramTracer, AppDelayHistogramTracerFixture)
+
+        BOOST_AUTO_TEST_CASE(PerApp) {
+            AppDelayHistogramTracer::InstallAll(TEST_HISTOGRAM_TRACE.string());
+
+            Simulator::Stop(Seconds(4));
+            Simulator::Run();
+
+            AppDelayHistogramTracer::Destroy(); // to force statistics to be written
+
+            BOOST_CHECK_EQUAL(readTrace(),
+                    "Time,Node,AppId,Prefix,Type,Count,MinUS,MeanUS,P50US,P90US,P99US,MaxUS,RetxCount,Hops\n"
+                    "4,1,0,/prefix,FullDelay,1,41771,41771,41771,41771,41771,41771,1,2:1\n"
+                    "4,1,0,/prefix,LastDelay,1,41771,41771,41771,41771,41771,41771,0,2:1\n"
+                    "4,2,0,/prefix,FullDelay,2,0,10442.5,0,20885,20885,20885,2,0:1|1:1\n"
+                    "4,2,0,/prefix,LastDelay,2,0,10442.5,0,20885,20885,20885,0,0:1|1:1\n");
+        }
+
+        BOOST_AUTO_TEST_CASE(PerPrefix) {
+            AppDelayHistogramTracer::InstallAll(TEST_HISTOGRAM_TRACE.string(), Seconds(0),
+                    AppDelayHistogramTracer::CSV, AppDelayHistogramTracer::PER_PREFIX);
+
+            Simulator::Stop(Seconds(4));
+            Simulator::Run();
+
+            AppDelayHistogramTracer::Destroy();
+
+            // 20885 is reported as the highest value of its histogram bucket
+            BOOST_CHECK_EQUAL(readTrace(),
+                    "Time,Node,AppId,Prefix,Type,Count,MinUS,MeanUS,P50US,P90US,P99US,MaxUS,RetxCount,Hops\n"
+                    "4,*,*,/prefix,FullDelay,3,0,20885.3,20991,41771,41771,41771,3,0:1|1:1|2:1\n"
+                    "4,*,*,/prefix,LastDelay,3,0,20885.3,20991,41771,41771,41771,0,0:1|1:1|2:1\n");
+        }
+
+        BOOST_AUTO_TEST_CASE(Periodic) {
+            NodeContainer nodes;
+            nodes.Add(getNode("2"));
+
+            auto output = make_shared<boost::test_tools::output_test_stream>();
+            Ptr<AppDelayHistogramTracer> tracer = AppDelayHistogramTracer::Install(nodes, output, Seconds(1.5));
+
+            Simulator::Stop(Seconds(4));
+            Simulator::Run();
+
+            tracer = nullptr; // destroy tracer, writing the last partial period
+
+            BOOST_CHECK(output->is_equal(
+                    "3,2,0,/prefix,FullDelay,1,0,0,0,0,0,0,1,0:1\n"
+                    "3,2,0,/prefix,LastDelay,1,0,0,0,0,0,0,0,0:1\n"
+                    "4,2,0,/prefix,FullDelay,1,20885,20885,20885,20885,20885,20885,1,1:1\n"
+                    "4,2,0,/prefix,LastDelay,1,20885,20885,20885,20885,20885,20885,0,1:1\n"));
+        }
+
+        BOOST_AUTO_TEST_CASE(Binary) {
+            AppDelayHistogramTracer::InstallAll(TEST_HISTOGRAM_TRACE.string(), Seconds(0),
+                    AppDelayHistogramTracer::BINARY);
+
+            Simulator::Stop(Seconds(4));
+            Simulator::Run();
+
+            AppDelayHistogramTracer::Destroy();
+
+            std::string trace = readTrace();
+            BOOST_REQUIRE_GT(trace.size(), 6);
+            BOOST_CHECK_EQUAL(trace.substr(0, 4), "NDNH");
+            BOOST_CHECK_EQUAL(trace[4], 1);
+            BOOST_CHECK_EQUAL(trace[5], static_cast<char> (LatencyHistogram::PRECISION_BITS));
+        }
+
+        BOOST_AUTO_TEST_SUITE_END()
+
+    } // namespace ndn
+} // namespace ns3
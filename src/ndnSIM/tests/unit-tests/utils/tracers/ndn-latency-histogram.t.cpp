@@ -0,0 +1,71 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/tracers/ndn-latency-histogram.hpp"
+
+#include "../../tests-common.hpp"
+
+namespace ns3 {
+    namespace ndn {
+
+        BOOST_AUTO_TEST_SUITE(UtilsTracersNdnLatencyHistogram)
+
+        BOOST_AUTO_TEST_CASE(Buckets) {
+            // exact below 2^PRECISION_BITS
+            BOOST_CHECK_EQUAL(LatencyHistogram::GetBucketIndex(0), 0);
+            BOOST_CHECK_EQUAL(LatencyHistogram::GetBucketIndex(127), 127);
+
+            for (uint64_t value : {uint64_t(128), uint64_t(1000), uint64_t(20885), uint64_t(123456789)}) {
+                size_t index = LatencyHistogram::GetBucketIndex(value);
+                BOOST_CHECK_LE(LatencyHistogram::GetBucketLowerBound(index), value);
+                BOOST_CHECK_GE(LatencyHistogram::GetBucketUpperBound(index), value);
+                BOOST_CHECK_EQUAL(LatencyHistogram::GetBucketUpperBound(index) + 1,
+                        LatencyHistogram::GetBucketLowerBound(index + 1));
+
+                // relative width of a bucket is bounded by the precision
+                double width = LatencyHistogram::GetBucketUpperBound(index) -
+                        LatencyHistogram::GetBucketLowerBound(index) + 1;
+                BOOST_CHECK_LE(width / value, 1.0 / (1 << (LatencyHistogram::PRECISION_BITS - 1)));
+            }
+        }
+
+        BOOST_AUTO_TEST_CASE(Quantiles) {
+            LatencyHistogram histogram;
+            BOOST_CHECK_EQUAL(histogram.GetQuantile(0.5), 0);
+
+            for (uint64_t value = 1; value <= 1000; ++value) {
+                histogram.Record(value);
+            }
+            BOOST_CHECK_EQUAL(histogram.GetCount(), 1000);
+            BOOST_CHECK_EQUAL(histogram.GetMin(), 1);
+            BOOST_CHECK_EQUAL(histogram.GetMax(), 1000);
+            BOOST_CHECK_CLOSE(histogram.GetMean(), 500.5, 0.001);
+            BOOST_CHECK_CLOSE(static_cast<double> (histogram.GetQuantile(0.5)), 500, 1.6);
+            BOOST_CHECK_CLOSE(static_cast<double> (histogram.GetQuantile(0.99)), 990, 1.6);
+            BOOST_CHECK_EQUAL(histogram.GetQuantile(1.0), 1000);
+
+            histogram.Reset();
+            BOOST_CHECK_EQUAL(histogram.GetCount(), 0);
+            BOOST_CHECK(histogram.GetBuckets().empty());
+        }
+
+        BOOST_AUTO_TEST_SUITE_END()
+
+    } // namespace ndn
+} // namespace ns3
@@ -0,0 +1,91 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-data-template.hpp"
+
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+
+namespace ns3 {
+    namespace ndn {
+
+        DataTemplate::DataTemplate(size_t payloadSize, const ::ndn::time::milliseconds& freshness,
+                uint32_t signature, const Name& keyLocator)
+        : m_payloadSize(payloadSize)
+        , m_freshness(freshness)
+        , m_signature(signature)
+        , m_keyLocator(keyLocator) {
+            shared_ptr<Data> prototype = makeDataDirectly(Name(), payloadSize, freshness, signature, keyLocator);
+
+            // everything after the Name element, up to the end of the Data value
+            const Block& wire = prototype->wireEncode();
+            wire.parse();
+            const Block& nameElement = wire.get(::ndn::tlv::Name);
+            m_tail = make_shared< ::ndn::Buffer>(nameElement.end(), wire.value_end());
+        }
+
+        bool
+        DataTemplate::matches(size_t payloadSize, const ::ndn::time::milliseconds& freshness,
+                uint32_t signature, const Name& keyLocator) const {
+            return m_payloadSize == payloadSize && m_freshness == freshness &&
+                    m_signature == signature && m_keyLocator == keyLocator;
+        }
+
+        shared_ptr<Data>
+        DataTemplate::makeData(const Name& name) const {
+            const Block& nameWire = name.wireEncode();
+
+            // reserve exactly what is needed: Data TLV type and length take at most 1 + 9 octets
+            ::ndn::EncodingBuffer encoder(m_tail->size() + nameWire.size() + 10, 0);
+            size_t length = encoder.prependByteArray(m_tail->buf(), m_tail->size());
+            length += encoder.prependByteArray(nameWire.wire(), nameWire.size());
+            encoder.prependVarNumber(length);
+            encoder.prependVarNumber(::ndn::tlv::Data);
+
+            auto data = make_shared<Data>();
+            data->wireDecode(encoder.block());
+            return data;
+        }
+
+        shared_ptr<Data>
+        DataTemplate::makeDataDirectly(const Name& name, size_t payloadSize,
+                const ::ndn::time::milliseconds& freshness, uint32_t signature, const Name& keyLocator) {
+            auto data = make_shared<Data>();
+            data->setName(name);
+            data->setFreshnessPeriod(freshness);
+            data->setContent(make_shared< ::ndn::Buffer>(payloadSize));
+
+            Signature sig;
+            SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue> (255));
+
+            if (keyLocator.size() > 0) {
+                signatureInfo.setKeyLocator(keyLocator);
+            }
+
+            sig.setInfo(signatureInfo);
+            sig.setValue(::ndn::makeNonNegativeIntegerBlock(::ndn::tlv::SignatureValue, signature));
+
+            data->setSignature(sig);
+
+            // to create real wire encoding
+            data->wireEncode();
+            return data;
+        }
+
+    } // namespace ndn
+} // namespace ns3
@@ -0,0 +1,84 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_DATA_TEMPLATE_H
+#define NDN_DATA_TEMPLATE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+namespace ns3 {
+    namespace ndn {
+
+        /**
+         * @ingroup ndn-apps
+         * @brief Pre-encoded Data used to answer Interests without rebuilding the packet
+         *
+         * A template captures everything in a Data packet after the Name: MetaInfo (freshness),
+         * Content (a zero-filled virtual payload), SignatureInfo (fake signature type and optional
+         * KeyLocator) and SignatureValue. These elements are encoded once into a contiguous
+         * buffer. A response for a given Name is made by prepending the Name and the outer Data
+         * TLV header to a copy of that buffer, which yields the same wire encoding as building
+         * and encoding the Data from scratch.
+         */
+        class DataTemplate {
+        public:
+            DataTemplate(size_t payloadSize, const ::ndn::time::milliseconds& freshness,
+                    uint32_t signature, const Name& keyLocator);
+
+            /**
+             * @return whether this template was built from the given parameters
+             */
+            bool
+            matches(size_t payloadSize, const ::ndn::time::milliseconds& freshness,
+                    uint32_t signature, const Name& keyLocator) const;
+
+            /**
+             * @brief Create a wire-encoded Data packet with @p name
+             */
+            shared_ptr<Data>
+            makeData(const Name& name) const;
+
+            /**
+             * @return size of the pre-encoded part (everything after the Name)
+             */
+            size_t
+            getTailSize() const {
+                return m_tail->size();
+            }
+
+            /**
+             * @brief Build Data the way Producer did before templates (used for testing and benchmarking)
+             */
+            static shared_ptr<Data>
+            makeDataDirectly(const Name& name, size_t payloadSize, const ::ndn::time::milliseconds& freshness,
+                    uint32_t signature, const Name& keyLocator);
+
+        private:
+            size_t m_payloadSize;
+            ::ndn::time::milliseconds m_freshness;
+            uint32_t m_signature;
+            Name m_keyLocator;
+
+            shared_ptr<const ::ndn::Buffer> m_tail;
+        };
+
+    } // namespace ndn
+} // namespace ns3
+
+#endif // NDN_DATA_TEMPLATE_H
@@ -0,0 +1,306 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-app-delay-histogram-tracer.hpp"
+#include "ns3/node.h"
+#include "ns3/config.h"
+#include "ns3/names.h"
+#include "ns3/callback.h"
+#include "ns3/string.h"
+
+#include "apps/ndn-app.hpp"
+#include "ns3/simulator.h"
+#include "ns3/node-list.h"
+#include "ns3/log.h"
+
+#include <boost/lexical_cast.hpp>
+
+#include <fstream>
+#include <limits>
+
+NS_LOG_COMPONENT_DEFINE("ndn.AppDelayHistogramTracer");
+
+namespace ns3 {
+    namespace ndn {
+
+        static const uint32_t ANY = std::numeric_limits<uint32_t>::max();
+
+        static std::list<Ptr<AppDelayHistogramTracer>> g_tracers;
+
+        void
+        AppDelayHistogramTracer::Destroy() {
+            g_tracers.clear();
+        }
+
+        void
+        AppDelayHistogramTracer::InstallAll(const std::string& file, Time period, Format format,
+                Granularity granularity) {
+            Install(NodeContainer::GetGlobal(), file, period, format, granularity);
+        }
+
+        void
+        AppDelayHistogramTracer::Install(const NodeContainer& nodes, const std::string& file, Time period,
+                Format format, Granularity granularity) {
+            shared_ptr<std::ostream> outputStream;
+            if (file != "-") {
+                shared_ptr<std::ofstream> os(new std::ofstream());
+                std::ios_base::openmode mode = std::ios_base::out | std::ios_base::trunc;
+                if (format == BINARY) {
+                    mode |= std::ios_base::binary;
+                }
+                os->open(file.c_str(), mode);
+
+                if (!os->is_open()) {
+                    NS_LOG_ERROR("File " << file << " cannot be opened for writing. Tracing disabled");
+                    return;
+                }
+
+                outputStream = os;
+            } else {
+                outputStream = shared_ptr<std::ostream>(&std::cout, std::bind([] {
+                }));
+            }
+
+            Ptr<AppDelayHistogramTracer> tracer = Install(nodes, outputStream, period, format, granularity);
+            tracer->PrintHeader(*outputStream);
+
+            g_tracers.push_back(tracer);
+        }
+
+        Ptr<AppDelayHistogramTracer>
+        AppDelayHistogramTracer::Install(const NodeContainer& nodes, shared_ptr<std::ostream> outputStream,
+                Time period, Format format, Granularity granularity) {
+            Ptr<AppDelayHistogramTracer> tracer =
+                    Create<AppDelayHistogramTracer>(outputStream, period, format, granularity);
+
+            for (NodeContainer::Iterator node = nodes.Begin(); node != nodes.End(); node++) {
+                NS_LOG_DEBUG("Node: " << (*node)->GetId());
+                tracer->Connect(*node);
+            }
+
+            return tracer;
+        }
+
+        //////////////////////////////////////////////////////////////////////////////
+        //////////////////////////////////////////////////////////////////////////////
+        //////////////////////////////////////////////////////////////////////////////
+
+        AppDelayHistogramTracer::AppDelayHistogramTracer(shared_ptr<std::ostream> os, Time period,
+                Format format, Granularity granularity)
+        : m_os(os)
+        , m_period(period)
+        , m_format(format)
+        , m_granularity(granularity)
+        , m_hasSamples(false) {
+            if (!m_period.IsZero()) {
+                m_printEvent = Simulator::Schedule(m_period, &AppDelayHistogramTracer::PeriodicPrinter, this);
+            }
+            m_destroyEvent = Simulator::ScheduleDestroy(&AppDelayHistogramTracer::Flush, this);
+        }
+
+        AppDelayHistogramTracer::~AppDelayHistogramTracer() {
+            m_printEvent.Cancel();
+            m_destroyEvent.Cancel();
+
+            // end-of-run statistics, or the last partial period
+            Flush();
+        }
+
+        void
+        AppDelayHistogramTracer::Connect(Ptr<Node> node) {
+            std::string path = "/NodeList/" + boost::lexical_cast<std::string>(node->GetId());
+
+            Config::ConnectWithoutContext(path + "/ApplicationList/*/LastRetransmittedInterestDataDelay",
+                    MakeCallback(&AppDelayHistogramTracer::LastRetransmittedInterestDataDelay, this));
+
+            Config::ConnectWithoutContext(path + "/ApplicationList/*/FirstInterestDataDelay",
+                    MakeCallback(&AppDelayHistogramTracer::FirstInterestDataDelay, this));
+        }
+
+        AppDelayHistogramTracer::Entry&
+        AppDelayHistogramTracer::Lookup(Ptr<App> app) {
+            auto cached = m_appCache.find(PeekPointer(app));
+            if (cached != m_appCache.end()) {
+                return *cached->second;
+            }
+
+            StringValue prefix("-");
+            app->GetAttributeFailSafe("Prefix", prefix);
+
+            Key key = m_granularity == PER_APP ?
+                    Key(app->GetNode()->GetId(), app->GetId(), prefix.Get()) :
+                    Key(ANY, ANY, prefix.Get());
+
+            Entry* entry = &m_stats[key];
+            m_appCache[PeekPointer(app)] = entry;
+            return *entry;
+        }
+
+        void
+        AppDelayHistogramTracer::LastRetransmittedInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay,
+                int32_t hopCount) {
+            Stats& stats = Lookup(app).second;
+            stats.delay.Record(static_cast<uint64_t> (std::max<int64_t>(0, delay.GetMicroSeconds())));
+            ++stats.hops[hopCount];
+            m_hasSamples = true;
+        }
+
+        void
+        AppDelayHistogramTracer::FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay,
+                uint32_t retxCount, int32_t hopCount) {
+            Stats& stats = Lookup(app).first;
+            stats.delay.Record(static_cast<uint64_t> (std::max<int64_t>(0, delay.GetMicroSeconds())));
+            ++stats.hops[hopCount];
+            stats.retxCount += retxCount;
+            m_hasSamples = true;
+        }
+
+        void
+        AppDelayHistogramTracer::Flush() {
+            if (m_hasSamples) {
+                Print(*m_os);
+            }
+            m_os->flush();
+        }
+
+        void
+        AppDelayHistogramTracer::PeriodicPrinter() {
+            Print(*m_os);
+            m_printEvent = Simulator::Schedule(m_period, &AppDelayHistogramTracer::PeriodicPrinter, this);
+        }
+
+        void
+        AppDelayHistogramTracer::PrintHeader(std::ostream& os) const {
+            if (m_format == BINARY) {
+                const uint8_t version = 1;
+                const uint8_t precision = LatencyHistogram::PRECISION_BITS;
+                os.write("NDNH", 4);
+                os.write(reinterpret_cast<const char*> (&version), sizeof(version));
+                os.write(reinterpret_cast<const char*> (&precision), sizeof(precision));
+                return;
+            }
+
+            os << "Time,Node,AppId,Prefix,Type,Count,MinUS,MeanUS,P50US,P90US,P99US,MaxUS,RetxCount,Hops\n";
+        }
+
+        void
+        AppDelayHistogramTracer::Print(std::ostream& os) {
+            for (auto& item : m_stats) {
+                Stats& full = item.second.first;
+                Stats& last = item.second.second;
+                if (m_format == BINARY) {
+                    PrintBinary(os, item.first, 0, full);
+                    PrintBinary(os, item.first, 1, last);
+                } else {
+                    PrintCsv(os, item.first, "FullDelay", full);
+                    PrintCsv(os, item.first, "LastDelay", last);
+                }
+
+                full = Stats();
+                last = Stats();
+            }
+            m_hasSamples = false;
+        }
+
+        void
+        AppDelayHistogramTracer::PrintCsv(std::ostream& os, const Key& key, const char* type,
+                const Stats& stats) const {
+            if (stats.delay.GetCount() == 0) {
+                return;
+            }
+
+            os << Simulator::Now().ToDouble(Time::S) << ",";
+            if (std::get<0>(key) == ANY) {
+                os << "*,*,";
+            } else {
+                std::string name = Names::FindName(NodeList::GetNode(std::get<0>(key)));
+                if (name.empty()) {
+                    os << std::get<0>(key);
+                } else {
+                    os << name;
+                }
+                os << "," << std::get<1>(key) << ",";
+            }
+            os << std::get<2>(key) << "," << type << ","
+                    << stats.delay.GetCount() << ","
+                    << stats.delay.GetMin() << ","
+                    << stats.delay.GetMean() << ","
+                    << stats.delay.GetQuantile(0.5) << ","
+                    << stats.delay.GetQuantile(0.9) << ","
+                    << stats.delay.GetQuantile(0.99) << ","
+                    << stats.delay.GetMax() << ","
+                    << stats.retxCount << ",";
+
+            bool isFirst = true;
+            for (const auto& hop : stats.hops) {
+                os << (isFirst ? "" : "|") << hop.first << ":" << hop.second;
+                isFirst = false;
+            }
+            os << "\n";
+        }
+
+        template<typename T>
+        static void
+        writeRaw(std::ostream& os, const T& value) {
+            os.write(reinterpret_cast<const char*> (&value), sizeof(T));
+        }
+
+        void
+        AppDelayHistogramTracer::PrintBinary(std::ostream& os, const Key& key, uint8_t type,
+                const Stats& stats) const {
+            if (stats.delay.GetCount() == 0) {
+                return;
+            }
+
+            const std::string& prefix = std::get<2>(key);
+            const std::vector<uint64_t>& buckets = stats.delay.GetBuckets();
+
+            writeRaw(os, Simulator::Now().ToDouble(Time::S));
+            writeRaw(os, std::get<0>(key));
+            writeRaw(os, std::get<1>(key));
+            writeRaw(os, static_cast<uint16_t> (prefix.size()));
+            os.write(prefix.data(), prefix.size());
+            writeRaw(os, type);
+            writeRaw(os, stats.delay.GetCount());
+            writeRaw(os, stats.delay.GetSum());
+            writeRaw(os, stats.delay.GetMin());
+            writeRaw(os, stats.delay.GetMax());
+            writeRaw(os, stats.retxCount);
+
+            uint32_t nBuckets = 0;
+            for (uint64_t count : buckets) {
+                nBuckets += count > 0 ? 1 : 0;
+            }
+            writeRaw(os, nBuckets);
+            for (size_t i = 0; i < buckets.size(); ++i) {
+                if (buckets[i] > 0) {
+                    writeRaw(os, static_cast<uint32_t> (i));
+                    writeRaw(os, buckets[i]);
+                }
+            }
+
+            writeRaw(os, static_cast<uint32_t> (stats.hops.size()));
+            for (const auto& hop : stats.hops) {
+                writeRaw(os, hop.first);
+                writeRaw(os, hop.second);
+            }
+        }
+
+    } // namespace ndn
+} // namespace ns3
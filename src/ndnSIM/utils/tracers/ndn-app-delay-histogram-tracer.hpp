@@ -0,0 +1,192 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_APP_DELAY_HISTOGRAM_TRACER_H
+#define NDN_APP_DELAY_HISTOGRAM_TRACER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ndn-latency-histogram.hpp"
+
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+#include <ns3/nstime.h>
+#include <ns3/event-id.h>
+#include <ns3/node-container.h>
+
+#include <map>
+#include <tuple>
+#include <unordered_map>
+
+namespace ns3 {
+
+    class Node;
+
+    namespace ndn {
+
+        class App;
+
+        /**
+         * @ingroup ndn-tracers
+         * @brief Tracer that aggregates application-level delays into histograms
+         *
+         * Listens to the same trace sources as AppDelayTracer, but instead of writing one line
+         * per retrieved Data it keeps, per application (or per application Prefix), a
+         * LatencyHistogram of FullDelay and LastDelay in microseconds together with the
+         * distribution of hop counts. Statistics are written at Simulator::Destroy (or when the
+         * tracer is destroyed, if earlier) and, if a period is given, every period; statistics
+         * are reset after each write.
+         *
+         * CSV output has one line per key and delay type:
+         * @code
+         * Time,Node,AppId,Prefix,Type,Count,MinUS,MeanUS,P50US,P90US,P99US,MaxUS,RetxCount,Hops
+         * @endcode
+         * where Hops is a list of hopCount:count pairs separated by '|'. Node and AppId are '*'
+         * when aggregating per prefix; Node is the name registered with Names::Add, if any.
+         *
+         * BINARY output starts with the 4-byte magic "NDNH", a uint8 version (1) and a uint8
+         * LatencyHistogram::PRECISION_BITS, followed by one record per key and delay type:
+         * double time; uint32 node; uint32 appId (0xFFFFFFFF if aggregated per prefix);
+         * uint16 length and bytes of the prefix; uint8 type (0 FullDelay, 1 LastDelay);
+         * uint64 count, sum, min, max, retxCount; uint32 number of non-empty buckets followed by
+         * (uint32 bucket, uint64 count) pairs; uint32 number of hop counts followed by
+         * (int32 hopCount, uint64 count) pairs. Integers are in host byte order.
+         */
+        class AppDelayHistogramTracer : public SimpleRefCount<AppDelayHistogramTracer> {
+        public:
+            enum Format {
+                CSV,
+                BINARY
+            };
+
+            enum Granularity {
+                PER_APP, ///< one set of statistics per application instance
+                PER_PREFIX ///< applications with the same Prefix attribute share statistics
+            };
+
+            /**
+             * @brief Helper method to install tracer on all simulation nodes
+             *
+             * @param file File to which statistics will be written.  If filename is -, then std::out is used
+             * @param period How often statistics are written; zero writes them only at the end of the run
+             */
+            static void
+            InstallAll(const std::string& file, Time period = Seconds(0), Format format = CSV,
+                    Granularity granularity = PER_APP);
+
+            /**
+             * @brief Helper method to install tracer on the selected simulation nodes
+             */
+            static void
+            Install(const NodeContainer& nodes, const std::string& file, Time period = Seconds(0),
+                    Format format = CSV, Granularity granularity = PER_APP);
+
+            /**
+             * @brief Helper method to install tracer on the selected simulation nodes
+             *
+             * @returns the tracer, which must be kept for the lifetime of simulation.
+             *          End-of-run statistics are written when it is destroyed.
+             */
+            static Ptr<AppDelayHistogramTracer>
+            Install(const NodeContainer& nodes, shared_ptr<std::ostream> outputStream,
+                    Time period = Seconds(0), Format format = CSV, Granularity granularity = PER_APP);
+
+            /**
+             * @brief Explicit request to remove all statically created tracers, writing their statistics
+             */
+            static void
+            Destroy();
+
+            AppDelayHistogramTracer(shared_ptr<std::ostream> os, Time period, Format format,
+                    Granularity granularity);
+
+            ~AppDelayHistogramTracer();
+
+            /**
+             * @brief Attach to all applications on @p node
+             */
+            void
+            Connect(Ptr<Node> node);
+
+            /**
+             * @brief Print head of the trace (CSV header line or binary file header)
+             */
+            void
+            PrintHeader(std::ostream& os) const;
+
+            /**
+             * @brief Write current statistics and reset them
+             */
+            void
+            Print(std::ostream& os);
+
+        private:
+            struct Stats {
+                LatencyHistogram delay;
+                std::map<int32_t, uint64_t> hops;
+                uint64_t retxCount = 0;
+            };
+
+            /// node id, app id and prefix; node and app id are 0xFFFFFFFF for PER_PREFIX
+            typedef std::tuple<uint32_t, uint32_t, std::string> Key;
+
+            /// FullDelay and LastDelay statistics of one key
+            typedef std::pair<Stats, Stats> Entry;
+
+            Entry&
+            Lookup(Ptr<App> app);
+
+            void
+            LastRetransmittedInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, int32_t hopCount);
+
+            void
+            FirstInterestDataDelay(Ptr<App> app, uint32_t seqno, Time delay, uint32_t rextCount,
+                    int32_t hopCount);
+
+            void
+            PeriodicPrinter();
+
+            /**
+             * @brief Write statistics not yet written (called from Simulator::Destroy)
+             */
+            void
+            Flush();
+
+            void
+            PrintCsv(std::ostream& os, const Key& key, const char* type, const Stats& stats) const;
+
+            void
+            PrintBinary(std::ostream& os, const Key& key, uint8_t type, const Stats& stats) const;
+
+        private:
+            shared_ptr<std::ostream> m_os;
+            Time m_period;
+            Format m_format;
+            Granularity m_granularity;
+            EventId m_printEvent;
+            EventId m_destroyEvent;
+            bool m_hasSamples;
+
+            std::map<Key, Entry> m_stats;
+            std::unordered_map<const App*, Entry*> m_appCache;
+        };
+
+    } // namespace ndn
+} // namespace ns3
+
+#endif // NDN_APP_DELAY_HISTOGRAM_TRACER_H
@@ -298,7 +298,7 @@ const double alpha = 0.8;
             std::get<0>(m_stats[face.getId()]).m_outInterests++;
             if (interest.hasWire()) {
                 std::get<1>(m_stats[face.getId()]).m_outInterests +=
-                        interest.wireEncode().size();
+                        interest.wireSize();
             }
         }
 
@@ -308,7 +308,7 @@ const double alpha = 0.8;
             std::get<0>(m_stats[face.getId()]).m_inInterests++;
             if (interest.hasWire()) {
                 std::get<1>(m_stats[face.getId()]).m_inInterests +=
-                        interest.wireEncode().size();
+                        interest.wireSize();
             }
         }
 
@@ -318,7 +318,7 @@ const double alpha = 0.8;
             std::get<0>(m_stats[face.getId()]).m_outData++;
             if (data.hasWire()) {
                 std::get<1>(m_stats[face.getId()]).m_outData +=
-                        data.wireEncode().size();
+                        data.wireSize();
             }
         }
 
@@ -328,7 +328,7 @@ const double alpha = 0.8;
             std::get<0>(m_stats[face.getId()]).m_inData++;
             if (data.hasWire()) {
                 std::get<1>(m_stats[face.getId()]).m_inData +=
-                        data.wireEncode().size();
+                        data.wireSize();
             }
         }
 
@@ -338,7 +338,7 @@ const double alpha = 0.8;
             std::get<0>(m_stats[face.getId()]).m_outNack++;
             if (nack.getInterest().hasWire()) {
                 std::get<1>(m_stats[face.getId()]).m_outNack +=
-                        nack.getInterest().wireEncode().size();
+                        nack.getInterest().wireSize();
             }
         }
 
@@ -348,7 +348,7 @@ const double alpha = 0.8;
             std::get<0>(m_stats[face.getId()]).m_inNack++;
             if (nack.getInterest().hasWire()) {
                 std::get<1>(m_stats[face.getId()]).m_inNack +=
-                        nack.getInterest().wireEncode().size();
+                        nack.getInterest().wireSize();
             }
         }
 
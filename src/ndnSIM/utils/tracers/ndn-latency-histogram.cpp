@@ -0,0 +1,118 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-latency-histogram.hpp"
+
+#include <algorithm>
+#include <limits>
+
+namespace ns3 {
+    namespace ndn {
+
+        static const uint64_t SUB_BUCKETS = uint64_t(1) << LatencyHistogram::PRECISION_BITS;
+        static const uint64_t HALF_SUB_BUCKETS = SUB_BUCKETS / 2;
+
+        static unsigned
+        mostSignificantBit(uint64_t value) {
+            unsigned msb = 0;
+            while (value >>= 1) {
+                ++msb;
+            }
+            return msb;
+        }
+
+        LatencyHistogram::LatencyHistogram() {
+            Reset();
+        }
+
+        void
+        LatencyHistogram::Reset() {
+            m_buckets.clear();
+            m_count = 0;
+            m_sum = 0;
+            m_min = std::numeric_limits<uint64_t>::max();
+            m_max = 0;
+        }
+
+        size_t
+        LatencyHistogram::GetBucketIndex(uint64_t value) {
+            if (value < SUB_BUCKETS) {
+                return static_cast<size_t> (value);
+            }
+            // top PRECISION_BITS bits of value select the sub-bucket within its power of two
+            unsigned shift = mostSignificantBit(value) - PRECISION_BITS + 1;
+            uint64_t top = value >> shift; // in [HALF_SUB_BUCKETS, SUB_BUCKETS)
+            return static_cast<size_t> (SUB_BUCKETS + (shift - 1) * HALF_SUB_BUCKETS + (top - HALF_SUB_BUCKETS));
+        }
+
+        uint64_t
+        LatencyHistogram::GetBucketLowerBound(size_t index) {
+            if (index < SUB_BUCKETS) {
+                return index;
+            }
+            uint64_t shift = (index - SUB_BUCKETS) / HALF_SUB_BUCKETS + 1;
+            uint64_t top = (index - SUB_BUCKETS) % HALF_SUB_BUCKETS + HALF_SUB_BUCKETS;
+            return top << shift;
+        }
+
+        uint64_t
+        LatencyHistogram::GetBucketUpperBound(size_t index) {
+            if (index < SUB_BUCKETS) {
+                return index;
+            }
+            uint64_t shift = (index - SUB_BUCKETS) / HALF_SUB_BUCKETS + 1;
+            return GetBucketLowerBound(index) + (uint64_t(1) << shift) - 1;
+        }
+
+        void
+        LatencyHistogram::Record(uint64_t value, uint64_t count) {
+            if (count == 0) {
+                return;
+            }
+            size_t index = GetBucketIndex(value);
+            if (index >= m_buckets.size()) {
+                m_buckets.resize(index + 1, 0);
+            }
+            m_buckets[index] += count;
+            m_count += count;
+            m_sum += value * count;
+            m_min = std::min(m_min, value);
+            m_max = std::max(m_max, value);
+        }
+
+        uint64_t
+        LatencyHistogram::GetQuantile(double q) const {
+            if (m_count == 0) {
+                return 0;
+            }
+            q = std::min(1.0, std::max(0.0, q));
+            uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t> (q * m_count + 0.5));
+
+            uint64_t seen = 0;
+            for (size_t i = 0; i < m_buckets.size(); ++i) {
+                seen += m_buckets[i];
+                if (seen >= rank) {
+                    return std::min(GetBucketUpperBound(i), m_max);
+                }
+            }
+            return m_max;
+        }
+
+    } // namespace ndn
+} // namespace ns3
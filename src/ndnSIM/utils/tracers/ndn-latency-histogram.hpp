@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2016  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_LATENCY_HISTOGRAM_H
+#define NDN_LATENCY_HISTOGRAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ns3 {
+    namespace ndn {
+
+        /**
+         * @ingroup ndn-tracers
+         * @brief Log-linear (HDR-style) histogram of non-negative integer values
+         *
+         * Values below 2^PRECISION_BITS are counted exactly. Above that, every power-of-two
+         * range is split into 2^(PRECISION_BITS-1) equal buckets, so a value is reported with a
+         * relative error of at most 2^-(PRECISION_BITS-1) (about 1.6%). Memory grows with the
+         * logarithm of the largest recorded value, and two histograms can be merged by adding
+         * their bucket counts.
+         */
+        class LatencyHistogram {
+        public:
+            static const unsigned PRECISION_BITS = 7;
+
+            LatencyHistogram();
+
+            void
+            Record(uint64_t value, uint64_t count = 1);
+
+            void
+            Reset();
+
+            uint64_t
+            GetCount() const {
+                return m_count;
+            }
+
+            uint64_t
+            GetSum() const {
+                return m_sum;
+            }
+
+            uint64_t
+            GetMin() const {
+                return m_count == 0 ? 0 : m_min;
+            }
+
+            uint64_t
+            GetMax() const {
+                return m_max;
+            }
+
+            double
+            GetMean() const {
+                return m_count == 0 ? 0.0 : static_cast<double> (m_sum) / m_count;
+            }
+
+            /**
+             * @brief Value at quantile @p q in [0, 1]
+             *
+             * Returns the highest value equivalent to the bucket containing the quantile,
+             * clamped to the recorded maximum.
+             */
+            uint64_t
+            GetQuantile(double q) const;
+
+            /**
+             * @brief Raw bucket counts, indexed by bucket
+             */
+            const std::vector<uint64_t>&
+            GetBuckets() const {
+                return m_buckets;
+            }
+
+            static size_t
+            GetBucketIndex(uint64_t value);
+
+            /**
+             * @brief Smallest value that falls into bucket @p index
+             */
+            static uint64_t
+            GetBucketLowerBound(size_t index);
+
+            /**
+             * @brief Largest value that falls into bucket @p index
+             */
+            static uint64_t
+            GetBucketUpperBound(size_t index);
+
+        private:
+            std::vector<uint64_t> m_buckets;
+            uint64_t m_count;
+            uint64_t m_sum;
+            uint64_t m_min;
+            uint64_t m_max;
+        };
+
+    } // namespace ndn
+} // namespace ns3
+
+#endif // NDN_LATENCY_HISTOGRAM_H
@@ -74,6 +74,60 @@ namespace ns3
         return file;
     }
 
+    Ptr<PcapFileWrapper>
+    PcapHelper::CreateInterface(
+            std::string filename,
+            Ptr<NetDevice> device,
+            uint32_t dataLinkType,
+            uint32_t snapLen) {
+        NS_LOG_FUNCTION(filename << device << dataLinkType << snapLen);
+
+        std::ostringstream name;
+        Ptr<Node> node = device->GetNode();
+        std::string nodename = Names::FindName(node);
+        std::string devicename = Names::FindName(device);
+        if (nodename.size()) {
+            name << nodename;
+        } else {
+            name << node->GetId();
+        }
+        name << "-";
+        if (devicename.size()) {
+            name << devicename;
+        } else {
+            name << device->GetIfIndex();
+        }
+
+        Ptr<PcapFileWrapper> file = CreateObject<PcapFileWrapper> ();
+        file->OpenInterface(filename, dataLinkType, name.str(), snapLen);
+        NS_ABORT_MSG_IF(file->Fail(), "Unable to Open " << filename);
+        return file;
+    }
+
+    std::string
+    PcapHelper::GetFilenameFromChannel(std::string prefix, Ptr<Channel> channel, bool useObjectNames) {
+        NS_LOG_FUNCTION(prefix << channel << useObjectNames);
+        NS_ABORT_MSG_UNLESS(prefix.size(), "Empty prefix string");
+
+        std::ostringstream oss;
+        oss << prefix << "-";
+
+        std::string channelname;
+        if (useObjectNames) {
+            channelname = Names::FindName(channel);
+        }
+
+        if (channelname.size()) {
+            oss << channelname;
+        } else {
+            oss << "ch" << channel->GetId();
+        }
+
+        oss << ".pcapng";
+
+        return oss.str();
+    }
+
     std::string
     PcapHelper::GetFilenameFromDevice(std::string prefix, Ptr<NetDevice> device, bool useObjectNames) {
         NS_LOG_FUNCTION(prefix << device << useObjectNames);
@@ -359,9 +413,27 @@ namespace ns3
 
     void
     PcapHelperForDevice::EnablePcap(std::string prefix, Ptr<NetDevice> nd, bool promiscuous, bool explicitFilename) {
+        if (!m_pcapNodeFilter.IsNull() && !m_pcapNodeFilter(nd->GetNode())) {
+            return;
+        }
         EnablePcapInternal(prefix, nd, promiscuous, explicitFilename);
     }
 
+    void
+    PcapHelperForDevice::SetPcapNodeFilter(Callback<bool, Ptr<Node> > filter) {
+        m_pcapNodeFilter = filter;
+    }
+
+    void
+    PcapHelperForDevice::SetPcapMergeChannels(bool merge) {
+        m_pcapMergeChannels = merge;
+    }
+
+    bool
+    PcapHelperForDevice::GetPcapMergeChannels(void) const {
+        return m_pcapMergeChannels;
+    }
+
     void
     PcapHelperForDevice::EnablePcap(std::string prefix, std::string ndName, bool promiscuous, bool explicitFilename) {
         Ptr<NetDevice> nd = Names::Find<NetDevice> (ndName);
@@ -23,6 +23,8 @@
 #include "ns3/net-device-container.h"
 #include "ns3/node-container.h"
 #include "ns3/simulator.h"
+#include "ns3/callback.h"
+#include "ns3/channel.h"
 #include "ns3/pcap-file-wrapper.h"
 #include "ns3/output-stream-wrapper.h"
 
@@ -91,6 +93,17 @@ namespace ns3 {
         std::string GetFilenameFromInterfacePair(std::string prefix, Ptr<Object> object,
                 uint32_t interface, bool useObjectNames = true);
 
+        /**
+         * @brief Let the pcap helper figure out a reasonable filename to use for the
+         * pcapng file shared by all devices attached to a channel.
+         *
+         * @param prefix prefix string
+         * @param channel Channel
+         * @param useObjectNames use the channel name instead of its id
+         * @returns file name
+         */
+        std::string GetFilenameFromChannel(std::string prefix, Ptr<Channel> channel, bool useObjectNames = true);
+
         /**
          * @brief Create and initialize a pcap file.
          * 
@@ -103,6 +116,23 @@ namespace ns3 {
          */
         Ptr<PcapFileWrapper> CreateFile(std::string filename, std::ios::openmode filemode,
                 uint32_t dataLinkType, uint32_t snapLen = std::numeric_limits<uint32_t>::max(), int32_t tzCorrection = 0);
+
+        /**
+         * @brief Add the interface of a device to a pcapng file shared by several
+         * devices, creating the file for the first of them.
+         *
+         * The interface is named after the node and the device, as in
+         * GetFilenameFromDevice.
+         *
+         * @param filename file name
+         * @param device NetDevice
+         * @param dataLinkType data link type of packet data
+         * @param snapLen maximum length of packet data stored in records
+         * @returns a smart pointer to the file wrapper writing on the interface
+         */
+        Ptr<PcapFileWrapper> CreateInterface(std::string filename, Ptr<NetDevice> device,
+                uint32_t dataLinkType, uint32_t snapLen = std::numeric_limits<uint32_t>::max());
+
         /**
          * @brief Hook a trace source to the default trace sink
          * 
@@ -539,7 +569,8 @@ namespace ns3 {
         /**
          * @brief Construct a PcapHelperForDevice
          */
-        PcapHelperForDevice() {
+        PcapHelperForDevice()
+        : m_pcapMergeChannels(false) {
         }
 
         /**
@@ -618,6 +649,36 @@ namespace ns3 {
          * @param promiscuous If true capture all possible packets available at the device.
          */
         void EnablePcapAll(std::string prefix, bool promiscuous = false);
+
+        /**
+         * @brief Restrict pcap output to the devices of the nodes accepted by a filter.
+         *
+         * The filter applies to the devices enabled afterwards, through any of the
+         * EnablePcap methods.  A null callback accepts every node.
+         *
+         * @param filter callback returning true for the nodes to capture on
+         */
+        void SetPcapNodeFilter(Callback<bool, Ptr<Node> > filter);
+
+        /**
+         * @brief Record all devices of a channel in a single pcapng file.
+         *
+         * When enabled, helpers supporting it add each device as an interface of
+         * the file named by PcapHelper::GetFilenameFromChannel (or of the explicit
+         * filename) instead of writing one pcap file per device.
+         *
+         * @param merge true to merge the captures of a channel
+         */
+        void SetPcapMergeChannels(bool merge);
+
+        /**
+         * @returns true if the captures of a channel are merged
+         */
+        bool GetPcapMergeChannels(void) const;
+
+    private:
+        Callback<bool, Ptr<Node> > m_pcapNodeFilter; //!< nodes to capture on
+        bool m_pcapMergeChannels; //!< merge the captures of a channel in a pcapng file
     };
 
     /**
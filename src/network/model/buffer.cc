@@ -50,7 +50,11 @@ namespace ns3{
     NS_LOG_COMPONENT_DEFINE("Buffer");
 
 
+#ifdef NS3_MTP
+    thread_local uint32_t Buffer::g_recommendedStart = 0;
+#else
     uint32_t Buffer::g_recommendedStart = 0;
+#endif
 #ifdef BUFFER_FREE_LIST
     /* The following macros are pretty evil but they are needed to allow us to
      * keep track of 3 possible states for the g_freeList variable:
@@ -248,8 +252,7 @@ namespace ns3{
         NS_ASSERT(CheckInternalState());
         if (m_data != o.m_data) {
             // not assignment to self.
-            m_data->m_count--;
-            if (m_data->m_count == 0) {
+            if (--m_data->m_count == 0) {
                 Recycle(m_data);
             }
             m_data = o.m_data;
@@ -270,8 +273,7 @@ namespace ns3{
         NS_LOG_FUNCTION(this);
         NS_ASSERT(CheckInternalState());
         g_recommendedStart = std::max(g_recommendedStart, m_maxZeroAreaStart);
-        m_data->m_count--;
-        if (m_data->m_count == 0) {
+        if (--m_data->m_count == 0) {
             Recycle(m_data);
         }
     }
@@ -294,7 +296,12 @@ namespace ns3{
     {
         NS_LOG_FUNCTION(this << start);
         NS_ASSERT(CheckInternalState());
+#ifdef NS3_MTP
+        // buffers sharing the data may grow it from other threads, only write to unshared data
+        bool isDirty = m_data->m_count > 1;
+#else
         bool isDirty = m_data->m_count > 1 && m_start > m_data->m_dirtyStart;
+#endif
         if (m_start >= start && !isDirty) {
             /* enough space in the buffer and not dirty. 
              * To add: |..|
@@ -310,8 +317,7 @@ namespace ns3{
             uint32_t newSize = GetInternalSize() + start;
             struct Buffer::Data *newData = Buffer::Create(newSize);
             memcpy(newData->m_data + start, m_data->m_data + m_start, GetInternalSize());
-            m_data->m_count--;
-            if (m_data->m_count == 0) {
+            if (--m_data->m_count == 0) {
                 Buffer::Recycle(m_data);
             }
             m_data = newData;
@@ -336,7 +342,11 @@ namespace ns3{
     {
         NS_LOG_FUNCTION(this << end);
         NS_ASSERT(CheckInternalState());
+#ifdef NS3_MTP
+        bool isDirty = m_data->m_count > 1;
+#else
         bool isDirty = m_data->m_count > 1 && m_end < m_data->m_dirtyEnd;
+#endif
         if (GetInternalEnd() + end <= m_data->m_size && !isDirty) {
             /* enough space in buffer and not dirty
              * Add:    |...|
@@ -352,8 +362,7 @@ namespace ns3{
             uint32_t newSize = GetInternalSize() + end;
             struct Buffer::Data *newData = Buffer::Create(newSize);
             memcpy(newData->m_data, m_data->m_data + m_start, GetInternalSize());
-            m_data->m_count--;
-            if (m_data->m_count == 0) {
+            if (--m_data->m_count == 0) {
                 Buffer::Recycle(m_data);
             }
             m_data = newData;
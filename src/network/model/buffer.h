@@ -25,7 +25,12 @@
 #include <ostream>
 #include "ns3/assert.h"
 
+#ifdef NS3_MTP
+#include <atomic>
+#else
+// the free list is shared by all buffers, the multithreaded simulator goes without it
 #define BUFFER_FREE_LIST 1
+#endif
 
 namespace ns3 {
 
@@ -656,7 +661,11 @@ namespace ns3 {
              * The reference count of an instance of this data structure.
              * Each buffer which references an instance holds a count.
              */
+#ifdef NS3_MTP
+            std::atomic<uint32_t> m_count;
+#else
             uint32_t m_count;
+#endif
             /**
              * the size of the m_data field below.
              */
@@ -760,7 +769,11 @@ namespace ns3 {
          * writing data. i.e., m_start should be initialized to this 
          * value.
          */
+#ifdef NS3_MTP
+        static thread_local uint32_t g_recommendedStart;
+#else
         static uint32_t g_recommendedStart;
+#endif
 
         /**
          * offset to the start of the virtual zero area from the start
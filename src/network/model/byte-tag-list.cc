@@ -21,8 +21,12 @@
 #include "ns3/log.h"
 #include <vector>
 #include <cstring>
-
+#ifdef NS3_MTP
+#include <atomic>
+#else
+// the free list is shared by all packets, the multithreaded simulator goes without it
 #define USE_FREE_LIST 1
+#endif
 #define FREE_LIST_SIZE 1000
 #define OFFSET_MAX (2147483647)
 
@@ -40,7 +44,11 @@ namespace ns3
      */
     struct ByteTagListData {
         uint32_t size; //!< size of the data
+#ifdef NS3_MTP
+        std::atomic<uint32_t> count; //!< use counter (for smart deallocation)
+#else
         uint32_t count; //!< use counter (for smart deallocation)
+#endif
         uint32_t dirty; //!< number of bytes actually in use
         uint8_t data[4]; //!< data
     };
@@ -182,7 +190,12 @@ namespace ns3
             m_used = 0;
         }
         else if (m_data->size < spaceNeeded ||
+#ifdef NS3_MTP
+                // copies of the packet may add tags from other threads, only write to unshared data
+                m_data->count != 1) {
+#else
                 (m_data->count != 1 && m_data->dirty != m_used)) {
+#endif
             struct ByteTagListData *newData = Allocate(spaceNeeded);
             std::memcpy(&newData->data, &m_data->data, m_used);
             Deallocate(m_data);
@@ -330,8 +343,7 @@ namespace ns3
             return;
         }
         g_maxSize = std::max(g_maxSize, data->size);
-        data->count--;
-        if (data->count == 0) {
+        if (--data->count == 0) {
             if (g_freeList.size() > FREE_LIST_SIZE ||
                     data->size < g_maxSize) {
                 uint8_t *buffer = (uint8_t *) data;
@@ -361,8 +373,7 @@ namespace ns3
         if (data == 0) {
             return;
         }
-        data->count--;
-        if (data->count == 0) {
+        if (--data->count == 0) {
             uint8_t *buffer = (uint8_t *) data;
             delete [] buffer;
         }
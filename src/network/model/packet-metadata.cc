@@ -73,8 +73,7 @@ namespace ns3
         struct PacketMetadata::Data *newData = PacketMetadata::Create(m_used + size);
         memcpy(newData->m_data, m_data->m_data, m_used);
         newData->m_dirtyEnd = m_used;
-        m_data->m_count--;
-        if (m_data->m_count == 0) {
+        if (--m_data->m_count == 0) {
             PacketMetadata::Recycle(m_data);
         }
         m_data = newData;
@@ -94,10 +93,16 @@ namespace ns3
     PacketMetadata::Reserve(uint32_t size) {
         NS_LOG_FUNCTION(this << size);
         NS_ASSERT(m_data != 0);
+#ifdef NS3_MTP
+        // copies of the packet may reserve room from other threads, only write to unshared data
+        if (m_data->m_size >= m_used + size &&
+                m_data->m_count == 1) {
+#else
         if (m_data->m_size >= m_used + size &&
                 (m_head == 0xffff ||
                 m_data->m_count == 1 ||
                 m_data->m_dirtyEnd == m_used)) {
+#endif
             /* enough room, not dirty. */
         } else {
             /* (enough room and dirty) or (not enough room) */
@@ -518,6 +523,10 @@ namespace ns3
     struct PacketMetadata::Data *
             PacketMetadata::Create(uint32_t size) {
         NS_LOG_FUNCTION(size);
+#ifdef NS3_MTP
+        // the free list is shared by all packets, the multithreaded simulator goes without it
+        return PacketMetadata::Allocate(size);
+#endif
         NS_LOG_LOGIC("create size=" << size << ", max=" << m_maxSize);
         if (size > m_maxSize) {
             m_maxSize = size;
@@ -540,6 +549,10 @@ namespace ns3
     void
     PacketMetadata::Recycle(struct PacketMetadata::Data * data) {
         NS_LOG_FUNCTION(data);
+#ifdef NS3_MTP
+        PacketMetadata::Deallocate(data);
+        return;
+#endif
         if (!m_enable) {
             PacketMetadata::Deallocate(data);
             return;
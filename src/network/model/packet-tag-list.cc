@@ -35,6 +35,31 @@ namespace ns3
 
     NS_LOG_COMPONENT_DEFINE("PacketTagList");
 
+    /**
+     * Drop one link to a merge, once the list that held it links past it.
+     * With the multithreaded simulator (NS3_MTP) the other links may be
+     * dropped concurrently, so whoever drops the last one frees it, as
+     * PacketTagList::RemoveAll does.
+     *
+     * \param [in] cur The merge
+     */
+    static void
+    Unmerge(struct PacketTagList::TagData * cur) {
+        struct PacketTagList::TagData *prev = 0;
+        for (; cur != 0; cur = cur->next) {
+            if (--cur->count > 0) {
+                break;
+            }
+            if (prev != 0) {
+                delete prev;
+            }
+            prev = cur;
+        }
+        if (prev != 0) {
+            delete prev;
+        }
+    }
+
     bool
     PacketTagList::COWTraverse(Tag & tag, PacketTagList::COWWriter Writer) {
         TypeId tid = tag.GetInstanceTypeId();
@@ -120,7 +145,6 @@ namespace ns3
         while (/* cur && */ cur->tid != tid) {
             NS_ASSERT(cur != 0);
             NS_ASSERT(cur->count > 1);
-            cur->count--; // unmerge cur
             struct TagData * copy = new struct TagData();
             copy->tid = cur->tid;
             copy->count = 1;
@@ -129,6 +153,7 @@ namespace ns3
             copy->next->count++; // mark new merge
             *prevNext = copy; // point prior list at copy
             prevNext = &copy->next; // advance
+            Unmerge(cur); // unmerge cur
             cur = copy->next;
         }
         // Sanity check:
@@ -166,12 +191,12 @@ namespace ns3
             delete cur;
         } else {
             // cur is always a merge at this point
-            // unmerge cur, since we linked around it already
-            cur->count--;
             if (cur->next != 0) {
                 // there's a next, so make it a merge
                 cur->next->count++;
             }
+            // unmerge cur, since we linked around it already
+            Unmerge(cur);
         }
         return found;
     }
@@ -202,7 +227,6 @@ namespace ns3
         } else {
             // cur is always a merge at this point
             // need to copy, replace, and link past cur
-            cur->count--; // unmerge cur
             struct TagData * copy = new struct TagData();
             copy->tid = tag.GetInstanceTypeId();
             copy->count = 1;
@@ -213,6 +237,7 @@ namespace ns3
                 copy->next->count++; // mark new merge
             }
             *prevNext = copy; // point prior list at copy
+            Unmerge(cur); // unmerge cur
         }
         return found;
     }
@@ -27,6 +27,9 @@
 
 #include <stdint.h>
 #include <ostream>
+#ifdef NS3_MTP
+#include <atomic>
+#endif
 #include "ns3/type-id.h"
 
 namespace ns3 {
@@ -163,7 +166,11 @@ namespace ns3 {
             uint8_t data[MAX_SIZE]; /**< Serialization buffer */
             struct TagData * next; /**< Pointer to next in list */
             TypeId tid; /**< Type of the tag serialized into #data */
+#ifdef NS3_MTP
+            std::atomic<uint32_t> count; /**< Number of incoming links */
+#else
             uint32_t count; /**< Number of incoming links */
+#endif
         }; /* struct TagData */
 
         /**
@@ -333,8 +340,7 @@ namespace ns3 {
     PacketTagList::RemoveAll(void) {
         struct TagData *prev = 0;
         for (struct TagData *cur = m_next; cur != 0; cur = cur->next) {
-            cur->count--;
-            if (cur->count > 0) {
+            if (--cur->count > 0) {
                 break;
             }
             if (prev != 0) {
@@ -29,7 +29,11 @@ namespace ns3
 
     NS_LOG_COMPONENT_DEFINE("Packet");
 
+#ifdef NS3_MTP
+    thread_local uint32_t Packet::m_globalUid = 0;
+#else
     uint32_t Packet::m_globalUid = 0;
+#endif
 
     TypeId
     ByteTagIterator::Item::GetTypeId(void) const {
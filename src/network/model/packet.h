@@ -711,7 +711,13 @@ namespace ns3 {
         /* Please see comments above about nix-vector */
         Ptr<NixVector> m_nixVector; //!< the packet's Nix vector
 
+#ifdef NS3_MTP
+        /// Counter of packets Uid of this thread, the multithreaded simulator
+        /// runs one system per thread and the Uid starts with the system id.
+        static thread_local uint32_t m_globalUid;
+#else
         static uint32_t m_globalUid; //!< Global counter of packets Uid
+#endif
     };
 
     /**
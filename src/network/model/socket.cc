@@ -759,4 +759,53 @@ namespace ns3
         os << "IPV6_TCLASS = " << m_ipv6Tclass;
     }
 
+    SocketPriorityTag::SocketPriorityTag()
+    : m_priority(0) {
+    }
+
+    void
+    SocketPriorityTag::SetPriority(uint8_t priority) {
+        m_priority = priority;
+    }
+
+    uint8_t
+    SocketPriorityTag::GetPriority(void) const {
+        return m_priority;
+    }
+
+    TypeId
+    SocketPriorityTag::GetTypeId(void) {
+        static TypeId tid = TypeId("ns3::SocketPriorityTag")
+                .SetParent<Tag> ()
+                .SetGroupName("Network")
+                .AddConstructor<SocketPriorityTag> ()
+                ;
+        return tid;
+    }
+
+    TypeId
+    SocketPriorityTag::GetInstanceTypeId(void) const {
+        return GetTypeId();
+    }
+
+    uint32_t
+    SocketPriorityTag::GetSerializedSize(void) const {
+        return sizeof (uint8_t);
+    }
+
+    void
+    SocketPriorityTag::Serialize(TagBuffer i) const {
+        i.WriteU8(m_priority);
+    }
+
+    void
+    SocketPriorityTag::Deserialize(TagBuffer i) {
+        m_priority = i.ReadU8();
+    }
+
+    void
+    SocketPriorityTag::Print(std::ostream & os) const {
+        os << "SO_PRIORITY = " << static_cast<uint32_t> (m_priority);
+    }
+
 } // namespace ns3
@@ -107,6 +107,22 @@ namespace ns3 {
             NS3_SOCK_RAW
         };
 
+        /**
+         * \enum SocketPriority
+         * \brief Enumeration of the possible socket priorities.
+         *
+         * Names and corresponding values are derived from
+         * the Linux TC_PRIO_* macros
+         */
+        enum SocketPriority {
+            NS3_PRIO_BESTEFFORT = 0,
+            NS3_PRIO_FILLER = 1,
+            NS3_PRIO_BULK = 2,
+            NS3_PRIO_INTERACTIVE_BULK = 4,
+            NS3_PRIO_INTERACTIVE = 6,
+            NS3_PRIO_CONTROL = 7
+        };
+
         /**
          * This method wraps the creation of sockets that is performed
          * on a given node by a SocketFactory specified by TypeId.
@@ -1225,6 +1241,54 @@ namespace ns3 {
         uint8_t m_ipv6Tclass; //!< the Tclass carried by the tag
     };
 
+    /**
+     * \brief indicates the priority of a packet (see Socket::SocketPriority).
+     *
+     * The tag is set by the protocol generating the packet and read by the
+     * lower layers that queue traffic by class.
+     */
+    class SocketPriorityTag : public Tag {
+    public:
+        SocketPriorityTag();
+
+        /**
+         * \brief Set the tag's priority
+         *
+         * \param priority the priority
+         */
+        void SetPriority(uint8_t priority);
+
+        /**
+         * \brief Get the tag's priority
+         *
+         * \returns the priority
+         */
+        uint8_t GetPriority(void) const;
+
+        /**
+         * \brief Get the type ID.
+         * \return the object TypeId
+         */
+        static TypeId GetTypeId(void);
+
+        // inherited function, no need to doc.
+        virtual TypeId GetInstanceTypeId(void) const;
+
+        // inherited function, no need to doc.
+        virtual uint32_t GetSerializedSize(void) const;
+
+        // inherited function, no need to doc.
+        virtual void Serialize(TagBuffer i) const;
+
+        // inherited function, no need to doc.
+        virtual void Deserialize(TagBuffer i);
+
+        // inherited function, no need to doc.
+        virtual void Print(std::ostream &os) const;
+    private:
+        uint8_t m_priority; //!< the priority carried by the tag
+    };
+
 } // namespace ns3
 
 #endif /* NS3_SOCKET_H */
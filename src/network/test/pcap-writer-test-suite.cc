@@ -0,0 +1,210 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <fstream>
+#include <iterator>
+#include <vector>
+#include <cstring>
+
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/packet.h"
+#include "ns3/boolean.h"
+#include "ns3/pcap-file.h"
+#include "ns3/pcap-file-wrapper.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("pcap-writer-test-suite");
+
+/**
+ * \param filename the file name
+ * \return the contents of the file
+ */
+static std::vector<uint8_t>
+ReadFile(std::string filename) {
+    std::ifstream f(filename.c_str(), std::ios::binary);
+    return std::vector<uint8_t> ((std::istreambuf_iterator<char> (f)), std::istreambuf_iterator<char> ());
+}
+
+/**
+ * \param data the buffer
+ * \param offset offset of the word in the buffer
+ * \return the 32-bit word, in host byte order
+ */
+static uint32_t
+Read32(std::vector<uint8_t> const &data, uint32_t offset) {
+    uint32_t value;
+    std::memcpy(&value, &data[offset], sizeof (value));
+    return value;
+}
+
+// ===========================================================================
+// Test case to make sure that a pcap file written asynchronously is the same,
+// byte for byte, as one written synchronously, including when the records
+// wrap around the chunk ring.
+// ===========================================================================
+class AsyncWriteTestCase : public TestCase
+{
+    public :
+    AsyncWriteTestCase();
+
+private:
+    virtual void DoRun(void);
+
+    /**
+     * \brief Write the test records
+     * \param f the pcap file, opened
+     */
+    void WriteRecords(PcapFile &f);};
+
+AsyncWriteTestCase::AsyncWriteTestCase()
+: TestCase("Check that asynchronous pcap output matches synchronous output") {
+}
+
+void
+AsyncWriteTestCase::WriteRecords(PcapFile &f) {
+    f.Init(1, 128);
+    uint8_t data[256];
+    for (uint32_t i = 0; i < sizeof (data); ++i) {
+        data[i] = i;
+    }
+    for (uint32_t i = 0; i < 2000; ++i) {
+        f.Write(i / 100, (i % 100) * 10000, data, 1 + (i * 7) % sizeof (data));
+    }
+}
+
+void
+AsyncWriteTestCase::DoRun(void) {
+    std::string syncName = CreateTempDirFilename("sync.pcap");
+    std::string asyncName = CreateTempDirFilename("async.pcap");
+
+    PcapFile f;
+    f.Open(syncName, std::ios::out);
+    NS_TEST_ASSERT_MSG_EQ(f.Fail(), false, "Open (" << syncName << ") returns error");
+    WriteRecords(f);
+    NS_TEST_EXPECT_MSG_EQ(f.Fail(), false, "Synchronous write must not fail");
+    f.Close();
+
+    // Chunks smaller than a record force the ring to wrap many times.
+    f.OpenAsync(asyncName, 100);
+    NS_TEST_ASSERT_MSG_EQ(f.Fail(), false, "OpenAsync (" << asyncName << ") returns error");
+    WriteRecords(f);
+    NS_TEST_EXPECT_MSG_EQ(f.Fail(), false, "Asynchronous write must not fail");
+    f.Close();
+
+    std::vector<uint8_t> syncData = ReadFile(syncName);
+    std::vector<uint8_t> asyncData = ReadFile(asyncName);
+    NS_TEST_ASSERT_MSG_GT(syncData.size(), 0, "Empty synchronous file");
+    NS_TEST_EXPECT_MSG_EQ(asyncData.size(), syncData.size(), "Files differ in size");
+    NS_TEST_EXPECT_MSG_EQ((asyncData == syncData), true, "Files differ");
+
+    uint32_t sec(0), usec(0), packets(0);
+    bool diff = PcapFile::Diff(syncName, asyncName, sec, usec, packets);
+    NS_TEST_EXPECT_MSG_EQ(diff, false, "PcapFile::Diff finds a difference");
+    NS_TEST_EXPECT_MSG_EQ(packets, 2000, "Unexpected number of packets");
+}
+
+// ===========================================================================
+// Test case to make sure that wrappers sharing a pcapng file each get their
+// interface, with its own snap length, and that their packets are tagged with
+// its ID.
+// ===========================================================================
+class PcapNgInterfaceTestCase : public TestCase
+{
+    public :
+    PcapNgInterfaceTestCase(bool async);
+
+private:
+    virtual void DoRun(void);
+
+    bool m_async; //!< write the file asynchronously
+};
+
+PcapNgInterfaceTestCase::PcapNgInterfaceTestCase(bool async)
+: TestCase(async ? "Check asynchronous pcapng interfaces" : "Check pcapng interfaces"),
+m_async(async) {
+}
+
+void
+PcapNgInterfaceTestCase::DoRun(void) {
+    std::string filename = CreateTempDirFilename("channel.pcapng");
+
+    Ptr<PcapFileWrapper> a = CreateObject<PcapFileWrapper> ();
+    Ptr<PcapFileWrapper> b = CreateObject<PcapFileWrapper> ();
+    a->SetAttribute("Asynchronous", BooleanValue(m_async));
+    a->OpenInterface(filename, 195, "0-0");
+    b->OpenInterface(filename, 1, "1-0", 20);
+    NS_TEST_ASSERT_MSG_EQ(a->Fail() || b->Fail(), false, "OpenInterface (" << filename << ") returns error");
+    NS_TEST_EXPECT_MSG_EQ(a->GetDataLinkType(), 195, "Wrong data link type");
+    NS_TEST_EXPECT_MSG_EQ(b->GetDataLinkType(), 1, "Wrong data link type");
+    NS_TEST_EXPECT_MSG_EQ(b->GetSnapLen(), 20, "Wrong snap length");
+
+    a->Write(MicroSeconds(1), Create<Packet> (50));
+    b->Write(MicroSeconds(2), Create<Packet> (50));
+    a->Write(Seconds(5) + MicroSeconds(3), Create<Packet> (3));
+    a->Close();
+    b->Close();
+
+    std::vector<uint8_t> data = ReadFile(filename);
+    uint32_t offset = 0;
+    std::vector<uint32_t> types;
+    std::vector<uint32_t> interfaces;
+    std::vector<uint32_t> lengths;
+    while (offset + 12 <= data.size()) {
+        uint32_t type = Read32(data, offset);
+        uint32_t length = Read32(data, offset + 4);
+        NS_TEST_ASSERT_MSG_EQ(length % 4, 0, "Block length must be a multiple of 4");
+        NS_TEST_ASSERT_MSG_GT(length, 11, "Block too short");
+        NS_TEST_ASSERT_MSG_EQ((offset + length <= data.size()), true, "Truncated block");
+        NS_TEST_EXPECT_MSG_EQ(Read32(data, offset + length - 4), length, "Trailing block length must match");
+        types.push_back(type);
+        if (type == 6) {
+            interfaces.push_back(Read32(data, offset + 8));
+            lengths.push_back(Read32(data, offset + 20));
+            uint64_t ts = (uint64_t (Read32(data, offset + 12)) << 32) | Read32(data, offset + 16);
+            NS_TEST_EXPECT_MSG_EQ((ts == 1 || ts == 2 || ts == 5000003), true, "Unexpected timestamp " << ts);
+        }
+        offset += length;
+    }
+    NS_TEST_EXPECT_MSG_EQ(offset, data.size(), "Trailing bytes after the last block");
+
+    NS_TEST_ASSERT_MSG_EQ(types.size(), 6, "Expected a section header, two interfaces and three packets");
+    NS_TEST_EXPECT_MSG_EQ(types[0], 0x0A0D0D0A, "Missing section header block");
+    NS_TEST_EXPECT_MSG_EQ(Read32(data, 8), 0x1A2B3C4D, "Wrong byte order magic");
+    NS_TEST_EXPECT_MSG_EQ(types[1], 1, "Missing interface description block");
+    NS_TEST_EXPECT_MSG_EQ(types[2], 1, "Missing interface description block");
+    NS_TEST_EXPECT_MSG_EQ(interfaces[0], 0, "First packet on the first interface");
+    NS_TEST_EXPECT_MSG_EQ(interfaces[1], 1, "Second packet on the second interface");
+    NS_TEST_EXPECT_MSG_EQ(interfaces[2], 0, "Third packet on the first interface");
+    NS_TEST_EXPECT_MSG_EQ(lengths[0], 50, "Captured length of the first packet");
+    NS_TEST_EXPECT_MSG_EQ(lengths[1], 20, "Second packet cut to the snap length");
+    NS_TEST_EXPECT_MSG_EQ(lengths[2], 3, "Captured length of the third packet");
+}
+
+class PcapWriterTestSuite : public TestSuite
+{
+    public :
+    PcapWriterTestSuite();};
+
+PcapWriterTestSuite::PcapWriterTestSuite()
+: TestSuite("pcap-writer", UNIT) {
+    AddTestCase(new AsyncWriteTestCase, TestCase::QUICK);
+    AddTestCase(new PcapNgInterfaceTestCase(false), TestCase::QUICK);
+    AddTestCase(new PcapNgInterfaceTestCase(true), TestCase::QUICK);
+}
+
+static PcapWriterTestSuite pcapWriterTestSuite;
@@ -18,9 +18,11 @@
 
 #include "ns3/log.h"
 #include "ns3/uinteger.h"
+#include "ns3/boolean.h"
 #include "ns3/buffer.h"
 #include "ns3/header.h"
 #include "pcap-file-wrapper.h"
+#include <map>
 
 namespace ns3
 {
@@ -40,11 +42,31 @@ namespace ns3
                 UintegerValue(PcapFile::SNAPLEN_DEFAULT),
                 MakeUintegerAccessor(&PcapFileWrapper::m_snapLen),
                 MakeUintegerChecker<uint32_t> (0, PcapFile::SNAPLEN_DEFAULT))
+                .AddAttribute("Asynchronous",
+                "Buffer the records of files opened for writing and write them from a background thread",
+                BooleanValue(false),
+                MakeBooleanAccessor(&PcapFileWrapper::m_async),
+                MakeBooleanChecker())
+                .AddAttribute("BufferSize",
+                "Size of each of the chunks buffered for an asynchronous file",
+                UintegerValue(65536),
+                MakeUintegerAccessor(&PcapFileWrapper::m_bufferSize),
+                MakeUintegerChecker<uint32_t> (1))
                 ;
         return tid;
     }
 
-    PcapFileWrapper::PcapFileWrapper() {
+    /**
+     * \return the pcapng files open through PcapFileWrapper::OpenInterface, by file name
+     */
+    static std::map<std::string, PcapNgFile *> &
+    GetNgFiles(void) {
+        static std::map<std::string, PcapNgFile *> files;
+        return files;
+    }
+
+    PcapFileWrapper::PcapFileWrapper()
+            : m_ngInterface(0) {
         NS_LOG_FUNCTION(this);
     }
 
@@ -56,6 +78,9 @@ namespace ns3
     bool
     PcapFileWrapper::Fail(void) const {
         NS_LOG_FUNCTION(this);
+        if (m_ngFile != 0) {
+            return m_ngFile->Fail();
+        }
         return m_file.Fail();
     }
 
@@ -74,13 +99,51 @@ namespace ns3
     void
     PcapFileWrapper::Close(void) {
         NS_LOG_FUNCTION(this);
+        if (m_ngFile != 0) {
+            if (m_ngFile->GetReferenceCount() == 1) {
+                // last wrapper on the file
+                std::map<std::string, PcapNgFile *> &files = GetNgFiles();
+                for (std::map<std::string, PcapNgFile *>::iterator i = files.begin(); i != files.end(); ++i) {
+                    if (i->second == PeekPointer(m_ngFile)) {
+                        files.erase(i);
+                        break;
+                    }
+                }
+                m_ngFile->Close();
+            }
+            m_ngFile = 0;
+            return;
+        }
         m_file.Close();
     }
 
     void
     PcapFileWrapper::Open(std::string const &filename, std::ios::openmode mode) {
         NS_LOG_FUNCTION(this << filename << mode);
-        m_file.Open(filename, mode);
+        // the asynchronous writer truncates: leave appending to PcapFile::Open, which rejects it
+        if (m_async && (mode & std::ios::out) && !(mode & (std::ios::in | std::ios::app))) {
+            m_file.OpenAsync(filename, m_bufferSize);
+        } else {
+            m_file.Open(filename, mode);
+        }
+    }
+
+    void
+    PcapFileWrapper::OpenInterface(std::string const &filename, uint32_t dataLinkType, std::string const &name,
+            uint32_t snapLen) {
+        NS_LOG_FUNCTION(this << filename << dataLinkType << name << snapLen);
+        NS_ASSERT_MSG(m_ngFile == 0, "PcapFileWrapper::OpenInterface(): interface already open");
+        std::map<std::string, PcapNgFile *> &files = GetNgFiles();
+        std::map<std::string, PcapNgFile *>::iterator i = files.find(filename);
+        if (i != files.end()) {
+            m_ngFile = i->second;
+        } else {
+            m_ngFile = Create<PcapNgFile> ();
+            m_ngFile->Open(filename, m_async, m_bufferSize);
+            files[filename] = PeekPointer(m_ngFile);
+        }
+        m_ngInterface = m_ngFile->AddInterface(dataLinkType,
+                snapLen != std::numeric_limits<uint32_t>::max() ? snapLen : m_snapLen, name);
     }
 
     void
@@ -103,9 +166,13 @@ namespace ns3
     PcapFileWrapper::Write(Time t, Ptr<const Packet> p) {
         NS_LOG_FUNCTION(this << t << p);
         uint64_t current = t.GetMicroSeconds();
+        if (m_ngFile != 0) {
+            m_ngFile->Write(m_ngInterface, current, p);
+            return;
+        }
         uint64_t s = current / 1000000;
         uint64_t us = current % 1000000;
-        
+
         m_file.Write(s, us, p);
     }
 
@@ -113,6 +180,10 @@ namespace ns3
     PcapFileWrapper::Write(Time t, const Header &header, Ptr<const Packet> p) {
         NS_LOG_FUNCTION(this << t << &header << p);
         uint64_t current = t.GetMicroSeconds();
+        if (m_ngFile != 0) {
+            m_ngFile->Write(m_ngInterface, current, header, p);
+            return;
+        }
         uint64_t s = current / 1000000;
         uint64_t us = current % 1000000;
 
@@ -123,6 +194,10 @@ namespace ns3
     PcapFileWrapper::Write(Time t, uint8_t const *buffer, uint32_t length) {
         NS_LOG_FUNCTION(this << t << &buffer << length);
         uint64_t current = t.GetMicroSeconds();
+        if (m_ngFile != 0) {
+            m_ngFile->Write(m_ngInterface, current, buffer, length);
+            return;
+        }
         uint64_t s = current / 1000000;
         uint64_t us = current % 1000000;
 
@@ -162,12 +237,18 @@ namespace ns3
     uint32_t
     PcapFileWrapper::GetSnapLen(void) {
         NS_LOG_FUNCTION(this);
+        if (m_ngFile != 0) {
+            return m_ngFile->GetSnapLen(m_ngInterface);
+        }
         return m_file.GetSnapLen();
     }
 
     uint32_t
     PcapFileWrapper::GetDataLinkType(void) {
         NS_LOG_FUNCTION(this);
+        if (m_ngFile != 0) {
+            return m_ngFile->GetDataLinkType(m_ngInterface);
+        }
         return m_file.GetDataLinkType();
     }
 
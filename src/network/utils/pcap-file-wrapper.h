@@ -27,6 +27,7 @@
 #include "ns3/object.h"
 #include "ns3/nstime.h"
 #include "pcap-file.h"
+#include "pcapng-file.h"
 
 namespace ns3 {
 
@@ -81,6 +82,24 @@ namespace ns3 {
          */
         void Close(void);
 
+        /**
+         * Add an interface to a pcapng file shared by several wrappers, creating
+         * the file when no other wrapper has it open.  Packets written through
+         * this wrapper are then recorded on that interface; the file is closed
+         * with the last wrapper.  There is no need to call Init.
+         *
+         * \param filename String containing the name of the pcapng file.
+         *
+         * \param dataLinkType A data link type as defined in the pcap library.
+         *
+         * \param name Name of the interface.
+         *
+         * \param snapLen An optional maximum size for packets written on the
+         * interface, defaulting to the CaptureSize attribute.
+         */
+        void OpenInterface(std::string const &filename, uint32_t dataLinkType, std::string const &name,
+                uint32_t snapLen = std::numeric_limits<uint32_t>::max());
+
         /**
          * Initialize the pcap file associated with this wrapper.  This file must have
          * been previously opened with write permissions.
@@ -214,6 +233,10 @@ namespace ns3 {
     private:
         PcapFile m_file; //!< Pcap file
         uint32_t m_snapLen; //!< max length of saved packets
+        bool m_async; //!< write the file from a background thread
+        uint32_t m_bufferSize; //!< size of the chunks of the background writer
+        Ptr<PcapNgFile> m_ngFile; //!< shared pcapng file, if opened with OpenInterface
+        uint32_t m_ngInterface; //!< interface of this wrapper in m_ngFile
     };
 
 } // namespace ns3
@@ -27,6 +27,7 @@
 #include "ns3/header.h"
 #include "ns3/buffer.h"
 #include "pcap-file.h"
+#include "pcap-writer.h"
 #include "ns3/log.h"
 #include "ns3/build-profile.h"
 //
@@ -50,21 +51,26 @@ namespace ns3
 
     PcapFile::PcapFile()
             : m_file(),
+            m_writer(0),
+            m_writerStream(0),
+            m_out(&m_file),
             m_swapMode(false) {
         NS_LOG_FUNCTION(this);
         FatalImpl::RegisterStream(&m_file);
+        FatalImpl::RegisterStream(&m_writerStream);
     }
 
     PcapFile::~PcapFile() {
         NS_LOG_FUNCTION(this);
         FatalImpl::UnregisterStream(&m_file);
+        FatalImpl::UnregisterStream(&m_writerStream);
         Close();
     }
 
     bool
     PcapFile::Fail(void) const {
         NS_LOG_FUNCTION(this);
-        return m_file.fail();
+        return m_out->fail() || (m_writer != 0 && m_writer->Fail());
     }
 
     bool
@@ -76,12 +82,20 @@ namespace ns3
     void
     PcapFile::Clear(void) {
         NS_LOG_FUNCTION(this);
-        m_file.clear();
+        m_out->clear();
     }
 
     void
     PcapFile::Close(void) {
         NS_LOG_FUNCTION(this);
+        if (m_writer != 0) {
+            m_writerStream.rdbuf(0);
+            m_writer->Close();
+            delete m_writer;
+            m_writer = 0;
+            m_out = &m_file;
+            return;
+        }
         m_file.close();
     }
 
@@ -179,7 +193,9 @@ namespace ns3
         // If we're initializing the file, we need to write the pcap file header
         // at the start of the file.
         //
-        m_file.seekp(0, std::ios::beg);
+        if (m_writer == 0) {
+            m_file.seekp(0, std::ios::beg);
+        }
 
         //
         // We have the ability to write out the pcap file header in a foreign endian
@@ -204,13 +220,13 @@ namespace ns3
         // Watch out for memory alignment differences between machines, so write
         // them all individually.
         //
-        m_file.write((const char *) &headerOut->m_magicNumber, sizeof (headerOut->m_magicNumber));
-        m_file.write((const char *) &headerOut->m_versionMajor, sizeof (headerOut->m_versionMajor));
-        m_file.write((const char *) &headerOut->m_versionMinor, sizeof (headerOut->m_versionMinor));
-        m_file.write((const char *) &headerOut->m_zone, sizeof (headerOut->m_zone));
-        m_file.write((const char *) &headerOut->m_sigFigs, sizeof (headerOut->m_sigFigs));
-        m_file.write((const char *) &headerOut->m_snapLen, sizeof (headerOut->m_snapLen));
-        m_file.write((const char *) &headerOut->m_type, sizeof (headerOut->m_type));
+        m_out->write((const char *) &headerOut->m_magicNumber, sizeof (headerOut->m_magicNumber));
+        m_out->write((const char *) &headerOut->m_versionMajor, sizeof (headerOut->m_versionMajor));
+        m_out->write((const char *) &headerOut->m_versionMinor, sizeof (headerOut->m_versionMinor));
+        m_out->write((const char *) &headerOut->m_zone, sizeof (headerOut->m_zone));
+        m_out->write((const char *) &headerOut->m_sigFigs, sizeof (headerOut->m_sigFigs));
+        m_out->write((const char *) &headerOut->m_snapLen, sizeof (headerOut->m_snapLen));
+        m_out->write((const char *) &headerOut->m_type, sizeof (headerOut->m_type));
     }
 
     void
@@ -295,6 +311,18 @@ namespace ns3
         }
     }
 
+    void
+    PcapFile::OpenAsync(std::string const &filename, uint32_t bufferSize) {
+        NS_LOG_FUNCTION(this << filename << bufferSize);
+        NS_ASSERT(!m_file.is_open() && m_writer == 0);
+        m_writer = new PcapWriter(filename, bufferSize);
+        m_writerStream.rdbuf(m_writer);
+        m_out = &m_writerStream;
+        if (m_writer->Fail()) {
+            m_writerStream.setstate(std::ios::failbit);
+        }
+    }
+
     void
     PcapFile::Init(uint32_t dataLinkType, uint32_t snapLen, int32_t timeZoneCorrection, bool swapMode) {
         NS_LOG_FUNCTION(this << dataLinkType << snapLen << timeZoneCorrection << swapMode);
@@ -343,7 +371,7 @@ namespace ns3
     uint32_t
     PcapFile::WritePacketHeader(uint32_t tsSec, uint32_t tsUsec, uint32_t totalLen) {
         NS_LOG_FUNCTION(this << tsSec << tsUsec << totalLen);
-        NS_ASSERT(m_file.good());
+        NS_ASSERT(m_out->good());
 
         uint32_t inclLen = totalLen > m_fileHeader.m_snapLen ? m_fileHeader.m_snapLen : totalLen;
 
@@ -361,10 +389,10 @@ namespace ns3
         // Watch out for memory alignment differences between machines, so write
         // them all individually.
         //
-        m_file.write((const char *) &header.m_tsSec, sizeof (header.m_tsSec));
-        m_file.write((const char *) &header.m_tsUsec, sizeof (header.m_tsUsec));
-        m_file.write((const char *) &header.m_inclLen, sizeof (header.m_inclLen));
-        m_file.write((const char *) &header.m_origLen, sizeof (header.m_origLen));
+        m_out->write((const char *) &header.m_tsSec, sizeof (header.m_tsSec));
+        m_out->write((const char *) &header.m_tsUsec, sizeof (header.m_tsUsec));
+        m_out->write((const char *) &header.m_inclLen, sizeof (header.m_inclLen));
+        m_out->write((const char *) &header.m_origLen, sizeof (header.m_origLen));
         NS_BUILD_DEBUG(m_file.flush());
         return inclLen;
     }
@@ -373,7 +401,7 @@ namespace ns3
     PcapFile::Write(uint32_t tsSec, uint32_t tsUsec, uint8_t const * const data, uint32_t totalLen) {
         NS_LOG_FUNCTION(this << tsSec << tsUsec << &data << totalLen);
         uint32_t inclLen = WritePacketHeader(tsSec, tsUsec, totalLen);
-        m_file.write((const char *) data, inclLen);
+        m_out->write((const char *) data, inclLen);
         NS_BUILD_DEBUG(m_file.flush());
     }
 
@@ -381,7 +409,7 @@ namespace ns3
     PcapFile::Write(uint32_t tsSec, uint32_t tsUsec, Ptr<const Packet> p) {
         NS_LOG_FUNCTION(this << tsSec << tsUsec << p);
         uint32_t inclLen = WritePacketHeader(tsSec, tsUsec, p->GetSize());
-        p->CopyData(&m_file, inclLen);
+        p->CopyData(m_out, inclLen);
         NS_BUILD_DEBUG(m_file.flush());
     }
 
@@ -396,9 +424,9 @@ namespace ns3
         headerBuffer.AddAtStart(headerSize);
         header.Serialize(headerBuffer.Begin());
         uint32_t toCopy = std::min(headerSize, inclLen);
-        headerBuffer.CopyData(&m_file, toCopy);
+        headerBuffer.CopyData(m_out, toCopy);
         inclLen -= toCopy;
-        p->CopyData(&m_file, inclLen);
+        p->CopyData(m_out, inclLen);
     }
 
     void
@@ -29,6 +29,7 @@
 namespace ns3 {
 
     class Packet;
+    class PcapWriter;
     class Header;
 
     /**
@@ -78,6 +79,17 @@ namespace ns3 {
          */
         void Open(std::string const &filename, std::ios::openmode mode);
 
+        /**
+         * Create a pcap file for writing only, through a PcapWriter: records
+         * are buffered and written to the file from a background thread.
+         * As with Open, the file must then be initialized with Init.
+         *
+         * \param filename String containing the name of the file.
+         *
+         * \param bufferSize size of the chunks buffered by the PcapWriter.
+         */
+        void OpenAsync(std::string const &filename, uint32_t bufferSize);
+
         /**
          * Close the underlying file.
          */
@@ -354,6 +366,9 @@ namespace ns3 {
 
         std::string m_filename; //!< file name
         std::fstream m_file; //!< file stream
+        PcapWriter *m_writer; //!< background writer, if opened with OpenAsync
+        std::ostream m_writerStream; //!< stream on m_writer
+        std::ostream *m_out; //!< stream the records are written to: m_file or m_writerStream
         PcapFileHeader m_fileHeader; //!< file header
         bool m_swapMode; //!< swap mode
     };
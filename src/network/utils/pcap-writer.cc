@@ -0,0 +1,348 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "pcap-writer.h"
+#include "ns3/core-config.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include <deque>
+#include <set>
+
+#ifdef HAVE_PTHREAD_H
+#include "ns3/system-thread.h"
+#include "ns3/system-mutex.h"
+#include "ns3/system-condition.h"
+#endif
+
+namespace ns3
+{
+
+    NS_LOG_COMPONENT_DEFINE("PcapWriter");
+
+    /**
+     * \brief The thread writing the chunks of all the PcapWriter instances
+     *
+     * It runs while at least one PcapWriter is open.  Without thread support,
+     * chunks are written as soon as they are queued.
+     */
+    class PcapWriterThread {
+    public:
+        /**
+         * \return the writer thread
+         */
+        static PcapWriterThread &Get(void);
+
+        /**
+         * Close the writers still open, so that their data is not lost
+         * when they are never destroyed.
+         */
+        ~PcapWriterThread();
+
+        /**
+         * \brief Register an open writer, starting the thread if needed
+         * \param writer the writer
+         */
+        void Add(PcapWriter *writer);
+
+        /**
+         * \brief Unregister a writer with no queued chunks, stopping the thread after the last one
+         * \param writer the writer
+         */
+        void Remove(PcapWriter *writer);
+
+        /**
+         * \brief Queue the next chunk of a writer
+         * \param writer the writer
+         */
+        void Queue(PcapWriter *writer);
+
+        /**
+         * \brief Wait until few enough chunks of a writer are queued
+         * \param writer the writer
+         * \param maxQueued the number of chunks that may stay queued
+         */
+        void WaitWritten(PcapWriter *writer, uint32_t maxQueued);
+
+        /// Lock the state shared with the writer thread
+        void Lock(void);
+        /// Unlock the state shared with the writer thread
+        void Unlock(void);
+
+    private:
+        PcapWriterThread();
+
+        /// Main loop of the writer thread
+        void Run(void);
+
+        std::set<PcapWriter *> m_writers; //!< open writers
+#ifdef HAVE_PTHREAD_H
+        static const uint64_t WAIT_NS = 10000000; //!< upper bound of a wait, in case a signal is missed
+
+        SystemMutex m_mutex; //!< protects the queue and the writer state
+        SystemCondition m_work; //!< signaled when a chunk is queued
+        SystemCondition m_written; //!< signaled when a chunk has been written
+        std::deque<PcapWriter *> m_queue; //!< one entry per queued chunk
+        bool m_stop; //!< the thread must stop
+        Ptr<SystemThread> m_thread; //!< the thread
+#endif
+    };
+
+    PcapWriterThread &
+    PcapWriterThread::Get(void) {
+        static PcapWriterThread thread;
+        return thread;
+    }
+
+    PcapWriterThread::~PcapWriterThread() {
+        std::set<PcapWriter *> writers = m_writers;
+        for (std::set<PcapWriter *>::iterator i = writers.begin(); i != writers.end(); ++i) {
+            (*i)->Close();
+        }
+    }
+
+#ifdef HAVE_PTHREAD_H
+
+    PcapWriterThread::PcapWriterThread()
+            : m_stop(false) {
+    }
+
+    void
+    PcapWriterThread::Add(PcapWriter *writer) {
+        NS_LOG_FUNCTION(this << writer);
+        m_mutex.Lock();
+        m_writers.insert(writer);
+        m_stop = false;
+        m_mutex.Unlock();
+        if (m_thread == 0) {
+            m_thread = Create<SystemThread> (MakeCallback(&PcapWriterThread::Run, this));
+            m_thread->Start();
+        }
+    }
+
+    void
+    PcapWriterThread::Remove(PcapWriter *writer) {
+        NS_LOG_FUNCTION(this << writer);
+        m_mutex.Lock();
+        m_writers.erase(writer);
+        bool last = m_writers.empty();
+        m_stop = last;
+        m_mutex.Unlock();
+        if (last && m_thread != 0) {
+            m_work.SetCondition(true);
+            m_work.Signal();
+            m_thread->Join();
+            m_thread = 0;
+        }
+    }
+
+    void
+    PcapWriterThread::Queue(PcapWriter *writer) {
+        m_mutex.Lock();
+        m_queue.push_back(writer);
+        m_mutex.Unlock();
+        m_work.SetCondition(true);
+        m_work.Signal();
+    }
+
+    void
+    PcapWriterThread::WaitWritten(PcapWriter *writer, uint32_t maxQueued) {
+        // The condition is cleared before the check, so that a chunk written
+        // in between sets it again and the wait returns at once.
+        while (true) {
+            m_written.SetCondition(false);
+            if (writer->GetQueued() <= maxQueued) {
+                return;
+            }
+            m_written.TimedWait(WAIT_NS);
+        }
+    }
+
+    void
+    PcapWriterThread::Lock(void) {
+        m_mutex.Lock();
+    }
+
+    void
+    PcapWriterThread::Unlock(void) {
+        m_mutex.Unlock();
+    }
+
+    void
+    PcapWriterThread::Run(void) {
+        while (true) {
+            m_work.SetCondition(false);
+            m_mutex.Lock();
+            PcapWriter *writer = 0;
+            if (!m_queue.empty()) {
+                writer = m_queue.front();
+                m_queue.pop_front();
+            }
+            bool stop = m_stop;
+            m_mutex.Unlock();
+
+            if (writer != 0) {
+                writer->WriteChunk();
+                m_written.SetCondition(true);
+                m_written.Broadcast();
+            } else if (stop) {
+                return;
+            } else {
+                m_work.TimedWait(WAIT_NS);
+            }
+        }
+    }
+
+#else /* HAVE_PTHREAD_H */
+
+    PcapWriterThread::PcapWriterThread() {
+    }
+
+    void
+    PcapWriterThread::Add(PcapWriter *writer) {
+        m_writers.insert(writer);
+    }
+
+    void
+    PcapWriterThread::Remove(PcapWriter *writer) {
+        m_writers.erase(writer);
+    }
+
+    void
+    PcapWriterThread::Queue(PcapWriter *writer) {
+        writer->WriteChunk();
+    }
+
+    void
+    PcapWriterThread::WaitWritten(PcapWriter *writer, uint32_t maxQueued) {
+    }
+
+    void
+    PcapWriterThread::Lock(void) {
+    }
+
+    void
+    PcapWriterThread::Unlock(void) {
+    }
+
+#endif /* HAVE_PTHREAD_H */
+
+    PcapWriter::PcapWriter(std::string const &filename, uint32_t chunkSize, uint32_t chunks)
+            : m_chunks(chunks, std::vector<char> (chunkSize)),
+            m_sizes(chunks, 0),
+            m_head(0),
+            m_tail(0),
+            m_queued(0),
+            m_failed(false) {
+        NS_LOG_FUNCTION(this << filename << chunkSize << chunks);
+        NS_ASSERT_MSG(chunks >= 2 && chunkSize > 0, "PcapWriter needs at least two non-empty chunks");
+        m_file.open(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+        m_open = m_file.is_open();
+        if (m_open) {
+            setp(&m_chunks[0][0], &m_chunks[0][0] + chunkSize);
+            PcapWriterThread::Get().Add(this);
+        }
+    }
+
+    PcapWriter::~PcapWriter() {
+        NS_LOG_FUNCTION(this);
+        Close();
+    }
+
+    bool
+    PcapWriter::Fail(void) const {
+        PcapWriterThread::Get().Lock();
+        bool failed = m_failed;
+        PcapWriterThread::Get().Unlock();
+        return !m_open || failed;
+    }
+
+    void
+    PcapWriter::Close(void) {
+        NS_LOG_FUNCTION(this);
+        if (!m_open) {
+            return;
+        }
+        sync();
+        PcapWriterThread::Get().Remove(this);
+        m_file.close();
+        m_open = false;
+        setp(0, 0);
+    }
+
+    PcapWriter::int_type
+    PcapWriter::overflow(int_type c) {
+        if (!m_open) {
+            return traits_type::eof();
+        }
+        Submit();
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    int
+    PcapWriter::sync(void) {
+        NS_LOG_FUNCTION(this);
+        if (!m_open) {
+            return -1;
+        }
+        Submit();
+        PcapWriterThread::Get().WaitWritten(this, 0);
+        m_file.flush();
+        return Fail() ? -1 : 0;
+    }
+
+    uint32_t
+    PcapWriter::GetQueued(void) const {
+        PcapWriterThread::Get().Lock();
+        uint32_t queued = m_queued;
+        PcapWriterThread::Get().Unlock();
+        return queued;
+    }
+
+    void
+    PcapWriter::Submit(void) {
+        uint32_t size = pptr() - pbase();
+        if (size == 0) {
+            return;
+        }
+        // the chunk after the current one must be free once it is queued
+        PcapWriterThread::Get().WaitWritten(this, m_chunks.size() - 2);
+        m_sizes[m_head] = size;
+        PcapWriterThread::Get().Lock();
+        m_queued++;
+        PcapWriterThread::Get().Unlock();
+        PcapWriterThread::Get().Queue(this);
+
+        m_head = (m_head + 1) % m_chunks.size();
+        std::vector<char> &chunk = m_chunks[m_head];
+        setp(&chunk[0], &chunk[0] + chunk.size());
+    }
+
+    void
+    PcapWriter::WriteChunk(void) {
+        m_file.write(&m_chunks[m_tail][0], m_sizes[m_tail]);
+        bool failed = m_file.fail();
+        PcapWriterThread::Get().Lock();
+        m_tail = (m_tail + 1) % m_chunks.size();
+        m_queued--;
+        m_failed = m_failed || failed;
+        PcapWriterThread::Get().Unlock();
+    }
+
+} // namespace ns3
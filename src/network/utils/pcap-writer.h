@@ -0,0 +1,112 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PCAP_WRITER_H
+#define PCAP_WRITER_H
+
+#include <string>
+#include <fstream>
+#include <streambuf>
+#include <vector>
+#include <stdint.h>
+
+namespace ns3 {
+
+    /**
+     * \brief An output stream buffer which writes a file from a background thread
+     *
+     * The data written to the stream is gathered in a ring of fixed-size
+     * chunks.  Full chunks are handed to a writer thread shared by all the
+     * PcapWriter instances, which writes them to the file, so that the
+     * simulator thread neither waits on the file system nor makes a system
+     * call per record.  If the writer thread falls behind and all the chunks
+     * are full, the simulator thread waits for one to be written.
+     *
+     * Without thread support the chunks are written as soon as they are full.
+     *
+     * Use it through an std::ostream.
+     */
+    class PcapWriter : public std::streambuf {
+    public:
+        /**
+         * \brief Open a file for writing (truncating it)
+         * \param filename file name
+         * \param chunkSize size of a chunk in bytes
+         * \param chunks number of chunks in the ring (at least 2)
+         */
+        PcapWriter(std::string const &filename, uint32_t chunkSize = 65536, uint32_t chunks = 4);
+
+        /**
+         * Write the buffered data and close the file.
+         */
+        virtual ~PcapWriter();
+
+        /**
+         * \return true if the file could not be opened or written
+         */
+        bool Fail(void) const;
+
+        /**
+         * \brief Write the buffered data and close the file.
+         */
+        void Close(void);
+
+    protected:
+        /**
+         * \brief Hand the current chunk over to the writer thread and continue in the next one
+         * \param c the character that did not fit in the current chunk
+         * \return c, or EOF on failure
+         */
+        virtual int_type overflow(int_type c);
+
+        /**
+         * \brief Write all the buffered data to the file before returning
+         * \return 0, or -1 on failure
+         */
+        virtual int sync(void);
+
+    private:
+        /// The writer thread
+        friend class PcapWriterThread;
+
+        /**
+         * \brief Hand the current chunk over to the writer thread, waiting for a free chunk if needed
+         */
+        void Submit(void);
+
+        /**
+         * \brief Write the oldest queued chunk to the file (writer thread)
+         */
+        void WriteChunk(void);
+
+        /**
+         * \return the number of chunks handed over and not yet written
+         */
+        uint32_t GetQueued(void) const;
+
+        std::ofstream m_file; //!< the file, only written by the writer thread once opened
+        std::vector<std::vector<char> > m_chunks; //!< the ring of chunks
+        std::vector<uint32_t> m_sizes; //!< bytes used in each queued chunk
+        uint32_t m_head; //!< chunk being filled
+        uint32_t m_tail; //!< oldest queued chunk
+        uint32_t m_queued; //!< number of queued chunks (protected by the writer thread mutex)
+        bool m_failed; //!< a write failed (protected by the writer thread mutex)
+        bool m_open; //!< the file is open
+    };
+
+} // namespace ns3
+
+#endif /* PCAP_WRITER_H */
@@ -0,0 +1,202 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "pcapng-file.h"
+#include "pcap-writer.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+#include "ns3/packet.h"
+#include "ns3/header.h"
+#include "ns3/buffer.h"
+#include <algorithm>
+
+namespace ns3
+{
+
+    NS_LOG_COMPONENT_DEFINE("PcapNgFile");
+
+    const uint32_t SECTION_HEADER_BLOCK = 0x0a0d0d0a; //!< Section Header Block type
+    const uint32_t INTERFACE_DESCRIPTION_BLOCK = 0x00000001; //!< Interface Description Block type
+    const uint32_t ENHANCED_PACKET_BLOCK = 0x00000006; //!< Enhanced Packet Block type
+    const uint32_t BYTE_ORDER_MAGIC = 0x1a2b3c4d; //!< Byte order magic of the Section Header Block
+    const uint16_t OPT_ENDOFOPT = 0; //!< End of options
+    const uint16_t IF_NAME = 2; //!< Interface name option
+
+    /**
+     * \param length a length in bytes
+     * \return the length padded to 32 bits
+     */
+    static uint32_t
+    Pad32(uint32_t length) {
+        return (length + 3) & ~3U;
+    }
+
+    PcapNgFile::PcapNgFile()
+            : m_writer(0),
+            m_stream(0) {
+        NS_LOG_FUNCTION(this);
+    }
+
+    PcapNgFile::~PcapNgFile() {
+        NS_LOG_FUNCTION(this);
+        Close();
+    }
+
+    void
+    PcapNgFile::Open(std::string const &filename, bool async, uint32_t bufferSize) {
+        NS_LOG_FUNCTION(this << filename << async << bufferSize);
+        NS_ASSERT_MSG(m_stream.rdbuf() == 0, "PcapNgFile::Open(): file already open");
+        if (async) {
+            m_writer = new PcapWriter(filename, bufferSize);
+            m_stream.rdbuf(m_writer);
+            if (m_writer->Fail()) {
+                m_stream.setstate(std::ios::failbit);
+                return;
+            }
+        } else {
+            m_file.open(filename.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+            m_stream.rdbuf(m_file.rdbuf());
+            if (!m_file.is_open()) {
+                m_stream.setstate(std::ios::failbit);
+                return;
+            }
+        }
+
+        Write32(SECTION_HEADER_BLOCK);
+        Write32(28);
+        Write32(BYTE_ORDER_MAGIC);
+        Write16(1); // major version
+        Write16(0); // minor version
+        Write32(0xffffffff); // section length: unknown
+        Write32(0xffffffff);
+        Write32(28);
+    }
+
+    bool
+    PcapNgFile::Fail(void) const {
+        return m_stream.fail() || (m_writer != 0 && m_writer->Fail());
+    }
+
+    void
+    PcapNgFile::Close(void) {
+        NS_LOG_FUNCTION(this);
+        if (m_writer != 0) {
+            m_writer->Close();
+            delete m_writer;
+            m_writer = 0;
+        } else if (m_file.is_open()) {
+            m_file.close();
+        }
+        m_stream.rdbuf(0);
+    }
+
+    uint32_t
+    PcapNgFile::AddInterface(uint32_t dataLinkType, uint32_t snapLen, std::string const &name) {
+        NS_LOG_FUNCTION(this << dataLinkType << snapLen << name);
+        Interface interface;
+        interface.dataLinkType = dataLinkType;
+        interface.snapLen = snapLen;
+        m_interfaces.push_back(interface);
+
+        uint32_t nameLen = name.size();
+        uint32_t length = 20 + 4 + Pad32(nameLen) + 4;
+        Write32(INTERFACE_DESCRIPTION_BLOCK);
+        Write32(length);
+        Write16(dataLinkType);
+        Write16(0); // reserved
+        Write32(snapLen);
+        Write16(IF_NAME);
+        Write16(nameLen);
+        m_stream.write(name.data(), nameLen);
+        m_stream.write("\0\0\0", Pad32(nameLen) - nameLen);
+        Write16(OPT_ENDOFOPT);
+        Write16(0);
+        Write32(length);
+        return m_interfaces.size() - 1;
+    }
+
+    uint32_t
+    PcapNgFile::GetDataLinkType(uint32_t interface) const {
+        return m_interfaces.at(interface).dataLinkType;
+    }
+
+    uint32_t
+    PcapNgFile::GetSnapLen(uint32_t interface) const {
+        return m_interfaces.at(interface).snapLen;
+    }
+
+    uint32_t
+    PcapNgFile::WritePacketHeader(uint32_t interface, uint64_t tsUsec, uint32_t totalLen) {
+        NS_ASSERT(interface < m_interfaces.size());
+        uint32_t inclLen = std::min(totalLen, m_interfaces[interface].snapLen);
+        Write32(ENHANCED_PACKET_BLOCK);
+        Write32(32 + Pad32(inclLen));
+        Write32(interface);
+        Write32(tsUsec >> 32);
+        Write32(tsUsec & 0xffffffff);
+        Write32(inclLen);
+        Write32(totalLen);
+        return inclLen;
+    }
+
+    void
+    PcapNgFile::WritePacketTrailer(uint32_t inclLen) {
+        m_stream.write("\0\0\0", Pad32(inclLen) - inclLen);
+        Write32(32 + Pad32(inclLen));
+    }
+
+    void
+    PcapNgFile::Write(uint32_t interface, uint64_t tsUsec, uint8_t const * const data, uint32_t totalLen) {
+        NS_LOG_FUNCTION(this << interface << tsUsec << &data << totalLen);
+        uint32_t inclLen = WritePacketHeader(interface, tsUsec, totalLen);
+        m_stream.write((const char *) data, inclLen);
+        WritePacketTrailer(inclLen);
+    }
+
+    void
+    PcapNgFile::Write(uint32_t interface, uint64_t tsUsec, Ptr<const Packet> p) {
+        NS_LOG_FUNCTION(this << interface << tsUsec << p);
+        uint32_t inclLen = WritePacketHeader(interface, tsUsec, p->GetSize());
+        p->CopyData(&m_stream, inclLen);
+        WritePacketTrailer(inclLen);
+    }
+
+    void
+    PcapNgFile::Write(uint32_t interface, uint64_t tsUsec, const Header &header, Ptr<const Packet> p) {
+        NS_LOG_FUNCTION(this << interface << tsUsec << &header << p);
+        uint32_t headerSize = header.GetSerializedSize();
+        uint32_t inclLen = WritePacketHeader(interface, tsUsec, headerSize + p->GetSize());
+
+        Buffer headerBuffer;
+        headerBuffer.AddAtStart(headerSize);
+        header.Serialize(headerBuffer.Begin());
+        uint32_t toCopy = std::min(headerSize, inclLen);
+        headerBuffer.CopyData(&m_stream, toCopy);
+        p->CopyData(&m_stream, inclLen - toCopy);
+        WritePacketTrailer(inclLen);
+    }
+
+    void
+    PcapNgFile::Write32(uint32_t value) {
+        m_stream.write((const char *) &value, sizeof (value));
+    }
+
+    void
+    PcapNgFile::Write16(uint16_t value) {
+        m_stream.write((const char *) &value, sizeof (value));
+    }
+
+} // namespace ns3
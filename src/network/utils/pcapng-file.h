@@ -0,0 +1,153 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PCAPNG_FILE_H
+#define PCAPNG_FILE_H
+
+#include <string>
+#include <fstream>
+#include <vector>
+#include <stdint.h>
+#include "ns3/ptr.h"
+#include "ns3/simple-ref-count.h"
+
+namespace ns3 {
+
+    class Packet;
+    class Header;
+    class PcapWriter;
+
+    /**
+     * \brief A pcapng file in which several interfaces are captured
+     *
+     * The file holds one section; each interface gets an Interface
+     * Description Block when it is added and its packets are written as
+     * Enhanced Packet Blocks, with microsecond timestamps, in the byte order
+     * of the host.  Reading pcapng files is not supported.
+     */
+    class PcapNgFile : public SimpleRefCount<PcapNgFile> {
+    public:
+        PcapNgFile();
+        ~PcapNgFile();
+
+        /**
+         * \brief Create the file and write its Section Header Block
+         * \param filename file name
+         * \param async write the file from a background thread (see PcapWriter)
+         * \param bufferSize size of the PcapWriter chunks
+         */
+        void Open(std::string const &filename, bool async, uint32_t bufferSize = 65536);
+
+        /**
+         * \return true if the file could not be opened or written
+         */
+        bool Fail(void) const;
+
+        /**
+         * \brief Write the buffered data and close the file
+         */
+        void Close(void);
+
+        /**
+         * \brief Add an interface to the file
+         * \param dataLinkType data link type of the packets of the interface
+         * \param snapLen maximum length of packet data stored in records
+         * \param name name of the interface
+         * \return the interface ID
+         */
+        uint32_t AddInterface(uint32_t dataLinkType, uint32_t snapLen, std::string const &name);
+
+        /**
+         * \param interface the interface ID
+         * \return the data link type of the interface
+         */
+        uint32_t GetDataLinkType(uint32_t interface) const;
+
+        /**
+         * \param interface the interface ID
+         * \return the snap length of the interface
+         */
+        uint32_t GetSnapLen(uint32_t interface) const;
+
+        /**
+         * \brief Write a packet
+         * \param interface the interface ID
+         * \param tsUsec the timestamp in microseconds
+         * \param data the packet data
+         * \param totalLen the length of the packet
+         */
+        void Write(uint32_t interface, uint64_t tsUsec, uint8_t const * const data, uint32_t totalLen);
+
+        /**
+         * \brief Write a packet
+         * \param interface the interface ID
+         * \param tsUsec the timestamp in microseconds
+         * \param p the packet
+         */
+        void Write(uint32_t interface, uint64_t tsUsec, Ptr<const Packet> p);
+
+        /**
+         * \brief Write a packet, passing its header separately
+         * \param interface the interface ID
+         * \param tsUsec the timestamp in microseconds
+         * \param header the header
+         * \param p the packet payload
+         */
+        void Write(uint32_t interface, uint64_t tsUsec, const Header &header, Ptr<const Packet> p);
+
+    private:
+        /**
+         * \brief Write the start of an Enhanced Packet Block
+         * \param interface the interface ID
+         * \param tsUsec the timestamp in microseconds
+         * \param totalLen the length of the packet
+         * \return the number of packet bytes to store
+         */
+        uint32_t WritePacketHeader(uint32_t interface, uint64_t tsUsec, uint32_t totalLen);
+
+        /**
+         * \brief Write the end of an Enhanced Packet Block
+         * \param inclLen the number of packet bytes stored
+         */
+        void WritePacketTrailer(uint32_t inclLen);
+
+        /**
+         * \brief Write a 32-bit word in host byte order
+         * \param value the word
+         */
+        void Write32(uint32_t value);
+
+        /**
+         * \brief Write a 16-bit word in host byte order
+         * \param value the word
+         */
+        void Write16(uint16_t value);
+
+        /// An interface of the file
+        struct Interface {
+            uint32_t dataLinkType; //!< data link type
+            uint32_t snapLen; //!< snap length
+        };
+
+        std::ofstream m_file; //!< the file, when written synchronously
+        PcapWriter *m_writer; //!< the file, when written from a background thread
+        std::ostream m_stream; //!< stream on the file or writer
+        std::vector<Interface> m_interfaces; //!< interfaces, indexed by ID
+    };
+
+} // namespace ns3
+
+#endif /* PCAPNG_FILE_H */
@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Info statements are compiled out of this file, as with
+// --log-static-level=debug, while debug statements stay.
+#define NS_LOG_STATIC_LEVEL ns3::LOG_LEVEL_DEBUG
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <streambuf>
+#include <string>
+
+#include "ns3/core-module.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE("BenchLog");
+
+// Number of times a log message was built
+static uint64_t g_evaluations = 0;
+
+// Keeps the result of the loops observable
+static volatile uint64_t g_sink = 0;
+
+/**
+ * A message argument as costly as the face URIs of the forwarder logs.
+ */
+static std::string
+Describe(uint32_t i) {
+    ++g_evaluations;
+    return "netdev://[00:00:00:00:00:" + std::to_string(i % 100) + "]";
+}
+
+/**
+ * Discards what is written to it.
+ */
+class NullBuffer : public std::streambuf {
+protected:
+
+    int
+    overflow(int c) {
+        return c;
+    }
+};
+
+/**
+ * Run \p statement \p n times and print the cost of one iteration.
+ */
+template<class Statement>
+static void
+Measure(const std::string& name, uint32_t n, Statement statement) {
+    uint64_t sum = 0;
+    g_evaluations = 0;
+    auto begin = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < n; ++i) {
+        sum += statement(i);
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - begin;
+    g_sink = sum;
+
+    std::cout << std::left << std::setw(40) << name
+            << std::setw(14) << elapsed.count() / n
+            << static_cast<double> (g_evaluations) / n << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    uint32_t n = 10000000;
+
+    CommandLine cmd;
+    cmd.Usage("Benchmark the cost of log statements in a tight loop.\n"
+            "\n"
+            "Compares a loop without logging, an info statement removed\n"
+            "at compile time, a debug statement disabled at run time,\n"
+            "and the same statement enabled with its output discarded.");
+    cmd.AddValue("n", "number of iterations (default 1E7, 1E5 when enabled)", n);
+    cmd.Parse(argc, argv);
+
+#ifndef NS3_LOG_ENABLE
+    std::cout << "Logging is disabled in this build profile: all statements compile to nothing."
+            << std::endl;
+#endif
+
+    std::cout << std::left << std::setw(40) << "Statement"
+            << std::setw(14) << "ns/iteration"
+            << std::setw(14) << "messages/iteration" << std::endl;
+
+    Measure("none", n, [] (uint32_t i) {
+        return i;
+    });
+    Measure("NS_LOG_INFO, compiled out", n, [] (uint32_t i) {
+        NS_LOG_INFO("Link remote: " << Describe(i));
+        return i;
+    });
+    Measure("NS_LOG_DEBUG, disabled at run time", n, [] (uint32_t i) {
+        NS_LOG_DEBUG("Link remote: " << Describe(i));
+        return i;
+    });
+
+    NullBuffer nullBuffer;
+    std::streambuf* clogBuffer = std::clog.rdbuf(&nullBuffer);
+    LogComponentEnable("BenchLog", LOG_LEVEL_DEBUG);
+    Measure("NS_LOG_DEBUG, enabled", std::max<uint32_t>(n / 100, 1), [] (uint32_t i) {
+        NS_LOG_DEBUG("Link remote: " << Describe(i));
+        return i;
+    });
+    LogComponentDisable("BenchLog", LOG_LEVEL_ALL);
+    std::clog.rdbuf(clogBuffer);
+
+    return 0;
+}